@@ -8,6 +8,8 @@
  - Code integrity verification (checksumming, signature validation)
  - Environment detection (debugger tools, analysis tools)
  - Evasion techniques (string obfuscation, API resolution)
+ - Control-flow obfuscation (flattening, opaque predicates)
+ - Early execution (initializers and +load methods run before main)
 
  Copyright (c) 2025 Zeyad Azima. All rights reserved.
  */
@@ -26,7 +28,10 @@
  * - Anti-VM/Sandbox: hardware enumeration, VM artifact checks, sandbox detection
  * - Code Integrity: self-checksumming, signature validation, tamper detection
  * - Environment Detection: debugger/tool string searches, process enumeration
- * - Dynamic API Resolution: dlsym usage, runtime symbol lookup
+ * - Dynamic API Resolution: dlsym usage, runtime symbol lookup, shadow import table of
+ *   the names resolved at dlsym / NSClassFromString / objc_getClass call sites
+ * - Control-Flow Obfuscation: flattened procedures ranked by dispatcher shape, opaque predicates
+ * - Early Execution: __mod_init_func, __init_offsets, +load, C++ static initializers
  */
 @interface AntiAnalysisDetector : NSObject <HopperTool>
 
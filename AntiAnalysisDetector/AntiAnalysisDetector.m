@@ -8,6 +8,17 @@
 @import Foundation;
 
 #import "AntiAnalysisDetector.h"
+#import "SRKCallSites.h"
+#import "SRKInitializers.h"
+#import "SRKControlFlow.h"
+#import "SRKProcedureMetrics.h"
+
+@interface AntiAnalysisDetector ()
+/// Symbol / procedure index of the file being analyzed, built once per run
+@property(strong, nonatomic, nullable) NSDictionary *imageIndex;
+/// Per-procedure metrics table of the file being analyzed, built once per run
+@property(strong, nonatomic, nullable) NSDictionary *procedureMetrics;
+@end
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "OCUnusedClassInspection"
@@ -88,6 +99,8 @@
     }
 
     [document beginToWait:@"Detecting Anti-Analysis Techniques..."];
+    self.imageIndex = SRKBuildImageIndex(file);
+    self.procedureMetrics = SRKBuildProcedureMetrics(file, self.imageIndex);
 
     NSMutableString *report = [NSMutableString string];
 
@@ -157,6 +170,11 @@
         [report appendString:@"\n"];
     }
 
+    // Debugger checks are often gathered in one routine called from several places
+    SRKAppendProcedureAPIReport(report, file, SRKProceduresByAPICalls(self.procedureMetrics, self.imageIndex,
+                                                                      @[@"api_debugging"], nil, 5),
+                                @"Procedures With The Most Debugger-Detection Calls");
+
     NSUInteger totalAntiDebug = ptraceAPIs.count + sysctlChecks.count + timingChecks.count + exceptionAPIs.count;
     if (totalAntiDebug == 0) {
         [report appendString:@"✓ No anti-debugging techniques detected\n\n"];
@@ -311,6 +329,7 @@
     [document logInfoMessage:@"[AntiAnalysisDetector] Phase 5: Detecting Dynamic API Resolution..."];
     [document logInfoMessage:@"[AntiAnalysisDetector] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
     NSArray *dynamicAPIs = [self detectDynamicResolution:file document:document];
+    NSArray *shadowImports = [self resolveDynamicImports:file document:document];
 
     [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n"];
     [report appendString:@"[5] DYNAMIC API RESOLUTION\n"];
@@ -323,14 +342,95 @@
             [report appendFormat:@"  [0x%llx] %@\n", [op[@"address"] unsignedLongLongValue], op[@"string"]];
             [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector]   [0x%llx] %@", [op[@"address"] unsignedLongLongValue], op[@"string"]]];
         }
-    } else {
-        [report appendString:@"✓ No dynamic API resolution detected\n"];
+        [report appendString:@"\n"];
+    }
+
+    if (shadowImports.count > 0) {
+        [report appendFormat:@"Shadow Import Table: %lu\n\n", (unsigned long)shadowImports.count];
+        [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector] ⚠️  Resolved Dynamic Imports: %lu", (unsigned long)shadowImports.count]];
+        for (NSDictionary *import in shadowImports) {
+            NSString *slot = import[@"slot"] ? [NSString stringWithFormat:@" (stored at 0x%llx)", [import[@"slot"] unsignedLongLongValue]] : @"";
+            NSString *line = [NSString stringWithFormat:@"[0x%llx] %@ %@ via %@%@",
+                              [import[@"address"] unsignedLongLongValue], import[@"kind"], import[@"name"], import[@"function"], slot];
+            [report appendFormat:@"  %@\n", line];
+            [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector]   %@", line]];
+        }
+        [report appendString:@"\n"];
+    }
+
+    NSUInteger totalDynamic = dynamicAPIs.count + shadowImports.count;
+    if (totalDynamic == 0) {
+        [report appendString:@"✓ No dynamic API resolution detected\n\n"];
         [document logInfoMessage:@"[AntiAnalysisDetector] ✓ No dynamic API resolution"];
     }
-    [report appendString:@"\n"];
+
+    // Phase 6: Control-Flow Obfuscation
+    [document logInfoMessage:@"[AntiAnalysisDetector] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
+    [document logInfoMessage:@"[AntiAnalysisDetector] Phase 6: Measuring Control-Flow Obfuscation..."];
+    [document logInfoMessage:@"[AntiAnalysisDetector] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
+    NSDictionary *obfuscation = [self detectControlFlowObfuscation:file document:document];
+    NSArray *flattened = obfuscation[@"flattened"];
+    NSArray *opaquePredicates = obfuscation[@"opaque"];
+
+    [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n"];
+    [report appendString:@"[6] CONTROL-FLOW OBFUSCATION\n"];
+    [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n"];
+
+    if (flattened.count > 0) {
+        [report appendFormat:@"Flattened Procedures: %lu (most obfuscated first)\n\n", (unsigned long)flattened.count];
+        [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector] ⚠️  Flattened Procedures: %lu", (unsigned long)flattened.count]];
+        for (NSDictionary *metrics in flattened) {
+            NSString *line = [NSString stringWithFormat:@"[0x%llx] %@ score %.2f: %@ blocks, dispatcher 0x%llx in-degree %@, %@/%@ back edges to it, compare chain %@",
+                              [metrics[@"procedure"] unsignedLongLongValue], metrics[@"name"] ?: @"sub",
+                              [metrics[@"score"] doubleValue], metrics[@"blocks"],
+                              [metrics[@"dispatcher"] unsignedLongLongValue], metrics[@"dispatcher_in_degree"],
+                              metrics[@"dispatcher_back_edges"], metrics[@"back_edges"], metrics[@"compare_chain"]];
+            [report appendFormat:@"  %@\n", line];
+            [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector]   %@", line]];
+        }
+        [report appendString:@"\n"];
+    }
+
+    if (opaquePredicates.count > 0) {
+        [report appendFormat:@"Opaque Predicates (constant-condition branches): %lu\n\n", (unsigned long)opaquePredicates.count];
+        [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector] ⚠️  Opaque Predicates: %lu", (unsigned long)opaquePredicates.count]];
+        for (NSDictionary *op in opaquePredicates) {
+            [report appendFormat:@"  [0x%llx] %@\n", [op[@"address"] unsignedLongLongValue], op[@"string"]];
+            [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector]   [0x%llx] %@", [op[@"address"] unsignedLongLongValue], op[@"string"]]];
+        }
+        [report appendString:@"\n"];
+    }
+
+    NSArray *complexProcedures = obfuscation[@"complex"];
+    if (complexProcedures.count > 0 && [complexProcedures.firstObject[@"cyclomatic"] unsignedIntegerValue] > 1) {
+        [report appendString:@"Highest Cyclomatic Complexity:\n"];
+        for (NSDictionary *procedure in complexProcedures) {
+            [report appendFormat:@"  [0x%llx] %@ (complexity %@, %@ instructions)\n", [procedure[@"address"] unsignedLongLongValue],
+                [file nameForVirtualAddress:[procedure[@"address"] unsignedLongLongValue]] ?: @"sub",
+                procedure[@"cyclomatic"], procedure[@"instructions"]];
+        }
+        [report appendString:@"\n"];
+    }
+
+    NSUInteger totalObfuscation = flattened.count + opaquePredicates.count;
+    if (totalObfuscation == 0) {
+        [report appendString:@"✓ No control-flow obfuscation detected\n\n"];
+        [document logInfoMessage:@"[AntiAnalysisDetector] ✓ No control-flow obfuscation"];
+    }
+
+    // Phase 7: Early Execution
+    [document logInfoMessage:@"[AntiAnalysisDetector] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
+    [document logInfoMessage:@"[AntiAnalysisDetector] Phase 7: Enumerating Initializers & +load Methods..."];
+    [document logInfoMessage:@"[AntiAnalysisDetector] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
+    // Debugger and VM checks placed in constructors fire before a breakpoint on main
+    NSDictionary *earlyExecution = SRKEarlyExecutionSummary(file, self.imageIndex);
+    NSArray *initializers = earlyExecution[@"roots"];
+    for (NSString *line in SRKAppendEarlyExecutionReport(report, earlyExecution, 7)) {
+        [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector] %@", line]];
+    }
 
     // Summary
-    NSUInteger totalFindings = totalAntiDebug + totalAntiVM + totalIntegrity + totalEnv + dynamicAPIs.count;
+    NSUInteger totalFindings = totalAntiDebug + totalAntiVM + totalIntegrity + totalEnv + totalDynamic + totalObfuscation;
 
     [report appendString:@"══════════════════════════════════════════════════════════════════════\n"];
     [report appendString:@"SUMMARY\n"];
@@ -350,7 +450,13 @@
     [report appendFormat:@"    • Checksum: %lu\n", (unsigned long)checksumming.count];
     [report appendFormat:@"    • Memory: %lu\n", (unsigned long)memoryChecks.count];
     [report appendFormat:@"  - Environment Detection: %lu\n", (unsigned long)totalEnv];
-    [report appendFormat:@"  - Dynamic API Resolution: %lu\n\n", (unsigned long)dynamicAPIs.count];
+    [report appendFormat:@"  - Dynamic API Resolution: %lu\n", (unsigned long)totalDynamic];
+    [report appendFormat:@"    • Resolver Strings: %lu\n", (unsigned long)dynamicAPIs.count];
+    [report appendFormat:@"    • Resolved Imports: %lu\n", (unsigned long)shadowImports.count];
+    [report appendFormat:@"  - Control-Flow Obfuscation: %lu\n", (unsigned long)totalObfuscation];
+    [report appendFormat:@"    • Flattened: %lu\n", (unsigned long)flattened.count];
+    [report appendFormat:@"    • Opaque Predicates: %lu\n", (unsigned long)opaquePredicates.count];
+    [report appendFormat:@"  - Early Execution Roots: %lu (not counted)\n\n", (unsigned long)initializers.count];
 
     [document logInfoMessage:@"[AntiAnalysisDetector] ══════════════════════════════════════════════════════════════════════"];
     [document logInfoMessage:@"[AntiAnalysisDetector] SUMMARY"];
@@ -364,7 +470,10 @@
     [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector] Integrity: %lu (Sig:%lu Checksum:%lu Mem:%lu)",
         (unsigned long)totalIntegrity, (unsigned long)signatureChecks.count, (unsigned long)checksumming.count, (unsigned long)memoryChecks.count]];
     [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector] Environment: %lu", (unsigned long)totalEnv]];
-    [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector] Dynamic APIs: %lu", (unsigned long)dynamicAPIs.count]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector] Dynamic APIs: %lu (Strings:%lu Resolved:%lu)",
+        (unsigned long)totalDynamic, (unsigned long)dynamicAPIs.count, (unsigned long)shadowImports.count]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[AntiAnalysisDetector] Control Flow: %lu (Flattened:%lu Opaque:%lu)",
+        (unsigned long)totalObfuscation, (unsigned long)flattened.count, (unsigned long)opaquePredicates.count]];
 
     if (totalFindings > 0) {
         [report appendString:@"⚠️  ANALYSIS EVASION DETECTED\n\n"];
@@ -389,10 +498,14 @@
             [report appendString:@"4. Rename/hide analysis tools or use stealthy techniques\n"];
             [document logInfoMessage:@"[AntiAnalysisDetector] 4. Hide analysis tools"];
         }
-        if (dynamicAPIs.count > 0) {
+        if (totalDynamic > 0) {
             [report appendString:@"5. Monitor runtime API resolution for hidden functionality\n"];
             [document logInfoMessage:@"[AntiAnalysisDetector] 5. Monitor runtime API resolution"];
         }
+        if (totalObfuscation > 0) {
+            [report appendString:@"6. Deobfuscate flattened procedures (symbolic execution of the dispatcher) before reading them\n"];
+            [document logInfoMessage:@"[AntiAnalysisDetector] 6. Deobfuscate flattened procedures"];
+        }
     } else {
         [report appendString:@"✓ No anti-analysis techniques detected\n"];
         [report appendString:@"  Binary appears safe for standard analysis procedures\n\n"];
@@ -414,6 +527,8 @@
     NSError *error = nil;
     [report writeToFile:tmpPath atomically:YES encoding:NSUTF8StringEncoding error:&error];
 
+    self.imageIndex = nil;
+    self.procedureMetrics = nil;
     [document endWaiting];
 
     // Show summary popup
@@ -424,7 +539,8 @@
         @"  • Anti-VM/Sandbox: %lu\n"
         @"  • Code Integrity: %lu\n"
         @"  • Environment Detection: %lu\n"
-        @"  • Dynamic APIs: %lu\n\n"
+        @"  • Dynamic APIs: %lu\n"
+        @"  • Control-Flow Obfuscation: %lu\n\n"
         @"%@\n\n"
         @"Full report saved to:\n%@",
         (unsigned long)totalFindings,
@@ -432,7 +548,8 @@
         (unsigned long)totalAntiVM,
         (unsigned long)totalIntegrity,
         (unsigned long)totalEnv,
-        (unsigned long)dynamicAPIs.count,
+        (unsigned long)totalDynamic,
+        (unsigned long)totalObfuscation,
         totalFindings > 0 ? @"⚠️  Evasion techniques detected!" : @"✓ No evasion detected",
         tmpPath];
 
@@ -627,6 +744,51 @@
     return [results copy];
 }
 
+- (NSArray *)resolveDynamicImports:(NSObject<HPDisassembledFile> *)file
+                          document:(NSObject<HPDocument> *)document {
+    // The image index merges the names resolved at dlsym / NSClassFromString / ... call sites
+    return self.imageIndex[@"dynamic_imports"] ?: @[];
+}
+
+- (NSDictionary *)detectControlFlowObfuscation:(NSObject<HPDisassembledFile> *)file
+                                      document:(NSObject<HPDocument> *)document {
+    NSMutableArray *flattened = [NSMutableArray array];
+    NSMutableArray *opaque = [NSMutableArray array];
+
+    NSDictionary *imageIndex = self.imageIndex;
+    NSDictionary *procedureMetrics = self.procedureMetrics;
+    for (NSDictionary *metrics in SRKFindControlFlowObfuscation(file, imageIndex, procedureMetrics)) {
+        if ([metrics[@"flattened"] boolValue]) {
+            [flattened addObject:metrics];
+        }
+        for (NSNumber *branch in metrics[@"opaque_predicates"]) {
+            if (opaque.count >= 60) break;
+            [opaque addObject:@{
+                @"address": branch,
+                @"string": [NSString stringWithFormat:@"in %@", metrics[@"name"] ?: [NSString stringWithFormat:@"sub_%llx", [metrics[@"procedure"] unsignedLongLongValue]]]
+            }];
+        }
+    }
+
+    // Rank by cyclomatic complexity, the procedures obfuscators and packers tend to bloat
+    NSUInteger procedureCount = 0;
+    NSUInteger entryCount = 0;
+    const uint32_t *cyclomatic = SRKProcedureMetricColumn(procedureMetrics, @"cyclomatic", &procedureCount);
+    const uint32_t *instructions = SRKProcedureMetricColumn(procedureMetrics, @"instructions", &procedureCount);
+    const Address *entries = SRKProcedureEntries(imageIndex, &entryCount);
+    NSMutableArray *complex = [NSMutableArray array];
+    for (NSUInteger i = 0; i < MIN(procedureCount, entryCount); i++) {
+        [complex addObject:@{@"address": @(entries[i]), @"cyclomatic": @(cyclomatic[i]), @"instructions": @(instructions[i])}];
+    }
+    [complex sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"cyclomatic" ascending:NO]]];
+
+    return @{
+        @"flattened": [flattened copy],
+        @"opaque": [opaque copy],
+        @"complex": [complex subarrayWithRange:NSMakeRange(0, MIN(complex.count, (NSUInteger)5))]
+    };
+}
+
 #pragma mark - Helper Methods
 
 - (void)scanStringsForPatterns:(NSArray *)patterns
@@ -9,6 +9,7 @@
  - C2 Frameworks (Cobalt Strike, Metasploit, Empire, Sliver)
  - Data Exfiltration (compression, chunking, steganography)
  - Beaconing & Timing (sleep, jitter, time-based triggers)
+ - Embedded Configuration (JSON, MessagePack and protobuf config blobs)
 
  Copyright (c) 2025 Zeyad Azima. All rights reserved.
  */
@@ -29,6 +30,10 @@
  * - C2 Frameworks: Cobalt Strike, Metasploit, Empire, Sliver signatures
  * - Exfiltration: Data compression, chunking, covert channels
  * - Beaconing: Sleep patterns, jitter, periodic callbacks
+ * - Embedded configs: JSON / MessagePack / protobuf blobs, also base64-encoded,
+ *   decoded into server, sleep, jitter and key findings
+ * - Protocol shapes: request paths, query keys and User-Agents matched
+ *   against the clustered samples (SRKProtocolClusterDirectory())
  */
 @interface C2Analyzer : NSObject <HopperTool>
 
@@ -40,6 +45,36 @@
  */
 - (void)analyzeC2:(nullable id)sender;
 
+/**
+ * Fingerprints the procedures of the current document into the function
+ * corpus (SRKFunctionCorpusDirectory()/unlabelled) for later matching
+ */
+- (void)addSampleToFunctionCorpus:(nullable id)sender;
+
+/**
+ * Files the protocol shapes of the current document into the protocol
+ * shape clusters (SRKProtocolClusterDirectory()); analysis only reads them
+ */
+- (void)addSampleToProtocolClusters:(nullable id)sender;
+
+/**
+ * Recompiles the import similarity index (SRKImportIndexDirectory()) from
+ * the function corpus, after samples were added or moved between families
+ */
+- (void)rebuildImportIndex:(nullable id)sender;
+
+/**
+ * Compiles the *.txt IOC files of SRKIOCDirectory() into the memory-mapped
+ * set every analysis probes its strings and file hashes against
+ */
+- (void)compileIOCSet:(nullable id)sender;
+
+/**
+ * Writes FLIRT-style signatures of the named procedures of the current
+ * document (a library built with symbols) to SRKLibrarySignatureDirectory()
+ */
+- (void)generateLibrarySignatures:(nullable id)sender;
+
 @end
 
 #pragma clang diagnostic pop
@@ -9,11 +9,44 @@
  - Known C2 Framework signatures
  - Data Exfiltration methods
  - Beaconing & Timing patterns
+ - Embedded configuration blobs
 
  Copyright (c) 2025 Zeyad Azima. All rights reserved.
  */
 
 #import "C2Analyzer.h"
+#import "SRKConfigBlobs.h"
+#import "SRKFunctionSimilarity.h"
+#import "SRKFuzzyHash.h"
+#import "SRKImportHash.h"
+#import "SRKIOCSet.h"
+#import "SRKLibraryCode.h"
+#import "SRKProcedureMetrics.h"
+#import "SRKProtocolClusters.h"
+
+// Estimated Jaccard similarity for a procedure to count as a corpus match
+#define C2_FUNCTION_MATCH_THRESHOLD 0.75
+// Closest corpus samples listed in the report
+#define C2_NEAREST_SAMPLES 5
+// Import index neighbours grouped into the closest families
+#define C2_IMPORT_NEIGHBOURS 25
+// Closest families by imports listed in the report
+#define C2_IMPORT_FAMILIES 5
+// Closest protocol shape clusters listed in the report
+#define C2_PROTOCOL_CLUSTERS 5
+// Protocol shapes of each kind listed in the report
+#define C2_PROTOCOL_SHAPES 10
+// Procedures with the most network and crypto calls listed in the report
+#define C2_API_PROCEDURES 5
+
+@interface C2Analyzer ()
+/// Symbol / procedure index of the file being analyzed, built once per run
+@property(strong, nonatomic, nullable) NSDictionary *imageIndex;
+/// Statically linked library procedures, left out of string and function matches
+@property(strong, nonatomic, nullable) NSDictionary *libraryCode;
+/// Per-procedure metrics table of the file being analyzed, built once per run
+@property(strong, nonatomic, nullable) NSDictionary *procedureMetrics;
+@end
 
 @implementation C2Analyzer
 
@@ -71,6 +104,26 @@
         @{
             HPM_TITLE: @"C2 Communication Analyzer",
             HPM_SELECTOR: NSStringFromSelector(@selector(analyzeC2:))
+        },
+        @{
+            HPM_TITLE: @"Add Sample to Function Corpus",
+            HPM_SELECTOR: NSStringFromSelector(@selector(addSampleToFunctionCorpus:))
+        },
+        @{
+            HPM_TITLE: @"Add Sample to Protocol Clusters",
+            HPM_SELECTOR: NSStringFromSelector(@selector(addSampleToProtocolClusters:))
+        },
+        @{
+            HPM_TITLE: @"Rebuild Import Index",
+            HPM_SELECTOR: NSStringFromSelector(@selector(rebuildImportIndex:))
+        },
+        @{
+            HPM_TITLE: @"Compile IOC Set",
+            HPM_SELECTOR: NSStringFromSelector(@selector(compileIOCSet:))
+        },
+        @{
+            HPM_TITLE: @"Generate Library Signatures",
+            HPM_SELECTOR: NSStringFromSelector(@selector(generateLibrarySignatures:))
         }
     ];
 }
@@ -92,12 +145,58 @@
 
     [document logInfoMessage:@"[C2Analyzer] Starting comprehensive C2 communication analysis..."];
 
+    self.imageIndex = SRKBuildImageIndex(file);
+    self.libraryCode = SRKIdentifyLibraryCode(file, self.imageIndex);
+    self.procedureMetrics = SRKBuildProcedureMetrics(file, self.imageIndex);
+    [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] Library procedures skipped: %lu (%@)",
+                              [self.libraryCode[@"procedures"] unsignedLongValue], SRKDescribeLibraryCode(self.libraryCode)]];
+
     NSMutableString *report = [NSMutableString string];
     [report appendString:@"═══════════════════════════════════════════════════════════════\n"];
     [report appendString:@"       COMMAND & CONTROL (C2) COMMUNICATION ANALYSIS\n"];
     [report appendString:@"═══════════════════════════════════════════════════════════════\n\n"];
     [report appendFormat:@"Analysis Date: %@\n\n", [NSDate date]];
 
+    // Near duplicates of corpus samples are listed first so that their review can be cut short
+    [document logInfoMessage:@"[C2Analyzer] Hashing sample for corpus similarity..."];
+    NSDictionary *sampleHashes = SRKComputeSampleHashes(file);
+    NSDictionary *sampleIndex = SRKLoadSampleHashIndex(SRKFunctionCorpusDirectory());
+    NSArray<NSDictionary *> *nearestSamples = sampleIndex ?
+        SRKNearestSamples(sampleIndex, sampleHashes, file.originalFilePath.lastPathComponent, C2_NEAREST_SAMPLES) : @[];
+    NSUInteger nearDuplicates = [self addSampleSimilarityToReport:report hashes:sampleHashes nearest:nearestSamples];
+
+    NSDictionary *importSignature = SRKComputeImportSignature(file);
+    NSString *importIndex = SRKImportIndexDirectory();
+    if (!SRKImportIndexExists(importIndex)) {
+        SRKRebuildImportIndex(importIndex, SRKFunctionCorpusDirectory(), NULL, NULL);
+    }
+    NSArray<NSDictionary *> *importNeighbours = SRKNearestImportSamples(importIndex, importSignature,
+                                                                        file.originalFilePath.lastPathComponent,
+                                                                        C2_IMPORT_NEIGHBOURS);
+    [self addImportSimilarityToReport:report signature:importSignature neighbours:importNeighbours];
+
+    // Only queried here; samples are filed by Add Sample to Protocol Clusters, so results do not depend on what was opened before
+    [document logInfoMessage:@"[C2Analyzer] Clustering request paths, query keys and User-Agents..."];
+    NSDictionary *protocolShapes = SRKCollectProtocolShapes(file, self.libraryCode);
+    NSDictionary *protocolSignature = SRKComputeProtocolSignature(protocolShapes);
+    NSArray<NSDictionary *> *protocolClusters = SRKNearestProtocolClusters(SRKProtocolClusterDirectory(), protocolSignature,
+                                                                           file.originalFilePath.lastPathComponent,
+                                                                           C2_PROTOCOL_CLUSTERS);
+    [self addProtocolClustersToReport:report shapes:protocolShapes clusters:protocolClusters];
+
+    // Every extracted string and the file hashes are probed against the exact IOC set
+    NSDictionary *iocSet = SRKOpenIOCSet(SRKIOCDirectory());
+    NSMutableArray<NSDictionary *> *iocMatches = [NSMutableArray array];
+    if (iocSet) {
+        for (NSDictionary *match in SRKMatchStringIOCs(file, iocSet)) {
+            if (!SRKIsLibraryOnlyReference(file, self.libraryCode, [match[@"address"] unsignedLongLongValue])) {
+                [iocMatches addObject:match];
+            }
+        }
+        [iocMatches addObjectsFromArray:SRKMatchFileHashIOCs(file, iocSet)];
+    }
+    [self addIOCMatchesToReport:report matches:iocMatches iocSet:iocSet];
+
     NSUInteger totalDetections = 0;
 
     // Phase 1: Network Communication Detection
@@ -105,6 +204,11 @@
     NSDictionary *networkResults = [self detectNetworkCommunication:file document:document];
     NSUInteger networkCount = [self addNetworkResultsToReport:report results:networkResults];
     totalDetections += networkCount;
+    // Where the network and crypto calls concentrate is usually the beacon / tasking loop
+    SRKAppendProcedureAPIReport(report, file, SRKProceduresByAPICalls(self.procedureMetrics, self.imageIndex,
+                                                                      @[@"api_network", @"api_crypto"], self.libraryCode,
+                                                                      C2_API_PROCEDURES),
+                                @"Procedures With The Most Network / Crypto Calls");
 
     // Phase 2: Domain Generation Algorithm (DGA) Detection
     [document logInfoMessage:@"[C2Analyzer] Phase 2: Analyzing DGA patterns..."];
@@ -136,11 +240,25 @@
     NSUInteger beaconCount = [self addBeaconResultsToReport:report results:beaconResults];
     totalDetections += beaconCount;
 
+    // Phase 7: Embedded Configuration Detection
+    [document logInfoMessage:@"[C2Analyzer] Phase 7: Analyzing embedded configuration blobs..."];
+    NSArray<NSDictionary *> *configBlobs = SRKFindConfigBlobs(file, self.libraryCode);
+    NSUInteger configCount = [self addConfigBlobsToReport:report blobs:configBlobs];
+    totalDetections += configCount;
+
     // Summary
     [report appendString:@"\n═══════════════════════════════════════════════════════════════\n"];
     [report appendString:@"                         SUMMARY\n"];
     [report appendString:@"═══════════════════════════════════════════════════════════════\n\n"];
-    [report appendFormat:@"Total C2 Communication Indicators: %lu\n\n", (unsigned long)totalDetections];
+    [report appendFormat:@"Total C2 Communication Indicators: %lu\n", (unsigned long)totalDetections];
+    [report appendFormat:@"Library Procedures Skipped: %lu (%@)\n", [self.libraryCode[@"procedures"] unsignedLongValue],
+     SRKDescribeLibraryCode(self.libraryCode)];
+    [report appendFormat:@"Near-Duplicate Corpus Samples: %lu\n", (unsigned long)nearDuplicates];
+    [report appendFormat:@"IOC Matches: %lu\n", (unsigned long)iocMatches.count];
+    [report appendFormat:@"Embedded Config Blobs: %lu\n", (unsigned long)configCount];
+    NSDictionary *nearestCluster = protocolClusters.firstObject;
+    [report appendFormat:@"Nearest Protocol Shape Cluster: %@\n\n", nearestCluster ?
+     [NSString stringWithFormat:@"#%@ (%.0f%%)", nearestCluster[@"cluster"], [nearestCluster[@"similarity"] doubleValue] * 100.0] : @"-"];
 
     if (totalDetections > 0) {
         [report appendString:@"⚠️  C2 COMMUNICATION PATTERNS DETECTED\n\n"];
@@ -184,8 +302,172 @@
     [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] C2 Frameworks: %lu", (unsigned long)frameworkCount]];
     [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] Exfiltration: %lu", (unsigned long)exfilCount]];
     [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] Beaconing: %lu", (unsigned long)beaconCount]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] Embedded configs: %lu", (unsigned long)configCount]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] Near-duplicate samples: %lu", (unsigned long)nearDuplicates]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] IOC matches: %lu", (unsigned long)iocMatches.count]];
+    if (nearestCluster) {
+        [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] Nearest protocol shape cluster: #%@",
+                                  nearestCluster[@"cluster"]]];
+    }
     [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] Report saved to: %@", reportPath]];
     [document logInfoMessage:@"══════════════════════════════════════════════════════"];
+
+    self.imageIndex = nil;
+    self.libraryCode = nil;
+    self.procedureMetrics = nil;
+}
+
+#pragma mark - Sample Similarity
+
+- (NSUInteger)addSampleSimilarityToReport:(NSMutableString *)report
+                                   hashes:(NSDictionary *)hashes
+                                  nearest:(NSArray<NSDictionary *> *)nearest {
+    [report appendString:@"───────────────────────────────────────────────────────────────\n"];
+    [report appendString:@"SAMPLE SIMILARITY\n"];
+    [report appendString:@"───────────────────────────────────────────────────────────────\n\n"];
+
+    NSDictionary *fileHashes = hashes[@"file"];
+    [report appendFormat:@"File (%@ bytes):\n", fileHashes[@"size"]];
+    [report appendFormat:@"  TLSH: %@\n", fileHashes[@"tlsh"] ?: @"(too short)"];
+    [report appendFormat:@"  CTPH: %@\n", fileHashes[@"ctph"]];
+    NSDictionary<NSString *, NSDictionary *> *cstrings = hashes[@"cstrings"];
+    for (NSString *section in [cstrings.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        [report appendFormat:@"  %@ TLSH: %@\n", section, cstrings[section][@"tlsh"] ?: @"(too short)"];
+    }
+    [report appendFormat:@"  Segments hashed: %lu\n\n", (unsigned long)[hashes[@"segments"] count]];
+
+    if (nearest.count == 0) {
+        [report appendString:@"✓ No similar samples in the function corpus\n\n"];
+        return 0;
+    }
+
+    // Only a labelled near duplicate says what the sample is; an unlabelled one was merely seen before
+    NSUInteger nearDuplicates = 0;
+    NSDictionary *labelledDuplicate = nil;
+    NSDictionary *unlabelledDuplicate = nil;
+    [report appendString:@"Closest Corpus Samples:\n"];
+    for (NSDictionary *neighbour in nearest) {
+        NSString *distance = neighbour[@"tlsh_distance"] ? [neighbour[@"tlsh_distance"] stringValue] : @"-";
+        NSString *cstringDistance = neighbour[@"cstring_distance"] ? [neighbour[@"cstring_distance"] stringValue] : @"-";
+        [report appendFormat:@"    • %@/%@: TLSH distance %@, CTPH score %@, __cstring distance %@\n",
+         neighbour[@"family"], neighbour[@"sample"], distance, neighbour[@"ctph_score"], cstringDistance];
+        if (![neighbour[@"near_duplicate"] boolValue]) continue;
+
+        if ([neighbour[@"labelled"] boolValue]) {
+            nearDuplicates++;
+            if (!labelledDuplicate) labelledDuplicate = neighbour;
+        } else if (!unlabelledDuplicate) {
+            unlabelledDuplicate = neighbour;
+        }
+    }
+
+    if (labelledDuplicate) {
+        [report appendFormat:@"\n⚠️  Near duplicate of %@/%@ — full review can be skipped\n",
+         labelledDuplicate[@"family"], labelledDuplicate[@"sample"]];
+    } else if (unlabelledDuplicate) {
+        [report appendFormat:@"\nNear duplicate of %@/%@, which is not labelled yet\n",
+         unlabelledDuplicate[@"family"], unlabelledDuplicate[@"sample"]];
+    }
+    [report appendString:@"\n"];
+    return nearDuplicates;
+}
+
+- (void)addImportSimilarityToReport:(NSMutableString *)report
+                          signature:(NSDictionary *)signature
+                         neighbours:(NSArray<NSDictionary *> *)neighbours {
+    [report appendFormat:@"Imports: %@ symbols from %lu dylibs\n", signature[@"imports"],
+     (unsigned long)[signature[@"dylibs"] count]];
+    [report appendFormat:@"  Symhash: %@\n\n", signature[@"symhash"]];
+
+    NSArray<NSDictionary *> *families = SRKImportFamilies(neighbours);
+    if (families.count == 0) {
+        [report appendString:@"✓ No known families share its imports\n\n"];
+        return;
+    }
+
+    [report appendString:@"Closest Known Families by Imports:\n"];
+    for (NSDictionary *family in [families subarrayWithRange:NSMakeRange(0, MIN(families.count, C2_IMPORT_FAMILIES))]) {
+        [report appendFormat:@"    • %@: %.0f%% import similarity (%@ of the closest samples)\n",
+         family[@"family"], [family[@"similarity"] doubleValue] * 100.0, family[@"samples"]];
+    }
+    NSDictionary *closest = neighbours.firstObject;
+    if ([closest[@"symhash_match"] boolValue]) {
+        [report appendFormat:@"\n  Same symhash as %@/%@\n", closest[@"family"], closest[@"sample"]];
+    }
+    [report appendString:@"\n"];
+}
+
+- (void)addProtocolClustersToReport:(NSMutableString *)report
+                             shapes:(NSDictionary *)shapes
+                           clusters:(NSArray<NSDictionary *> *)clusters {
+    [report appendString:@"───────────────────────────────────────────────────────────────\n"];
+    [report appendString:@"PROTOCOL SHAPE CLUSTERS\n"];
+    [report appendString:@"───────────────────────────────────────────────────────────────\n\n"];
+
+    NSArray<NSString *> *kinds = @[@"paths", @"query_keys", @"user_agents"];
+    NSArray<NSString *> *titles = @[@"Request Paths", @"Query Keys", @"User-Agents"];
+    NSUInteger shapeCount = 0;
+    for (NSUInteger k = 0; k < kinds.count; k++) {
+        NSArray<NSString *> *values = shapes[kinds[k]];
+        if (values.count == 0) continue;
+        shapeCount += values.count;
+        [report appendFormat:@"%@ (%lu):\n", titles[k], (unsigned long)values.count];
+        for (NSString *value in [values subarrayWithRange:NSMakeRange(0, MIN(values.count, C2_PROTOCOL_SHAPES))]) {
+            [report appendFormat:@"    • %@\n", value];
+        }
+        if (values.count > C2_PROTOCOL_SHAPES) {
+            [report appendFormat:@"    ... and %lu more\n", (unsigned long)(values.count - C2_PROTOCOL_SHAPES)];
+        }
+        [report appendString:@"\n"];
+    }
+    if (shapeCount == 0) {
+        [report appendString:@"✓ No request paths, query keys or User-Agents to cluster\n\n"];
+        return;
+    }
+
+    if (clusters.count == 0) {
+        [report appendString:@"No clustered sample shares its protocol shape\n"];
+    } else {
+        [report appendString:@"Nearest Clusters:\n"];
+        for (NSDictionary *cluster in clusters) {
+            NSMutableArray<NSString *> *families = [NSMutableArray array];
+            for (NSDictionary *family in cluster[@"families"]) {
+                [families addObject:[NSString stringWithFormat:@"%@ ×%@", family[@"family"], family[@"samples"]]];
+            }
+            [report appendFormat:@"    • #%@: %.0f%% shape similarity, %@ samples (%@)\n", cluster[@"cluster"],
+             [cluster[@"similarity"] doubleValue] * 100.0, cluster[@"members"],
+             families.count > 0 ? [families componentsJoinedByString:@", "] : @"no labelled samples"];
+        }
+    }
+    [report appendString:@"\n"];
+}
+
+- (void)addIOCMatchesToReport:(NSMutableString *)report
+                      matches:(NSArray<NSDictionary *> *)matches
+                       iocSet:(nullable NSDictionary *)iocSet {
+    [report appendString:@"───────────────────────────────────────────────────────────────\n"];
+    [report appendString:@"IOC MATCHES\n"];
+    [report appendString:@"───────────────────────────────────────────────────────────────\n\n"];
+
+    if (!iocSet) {
+        [report appendFormat:@"No compiled IOC set in %@\n\n", SRKIOCDirectory()];
+        return;
+    }
+    if (matches.count == 0) {
+        [report appendFormat:@"✓ No string or file hash among %@ known IOCs\n\n", iocSet[@"count"]];
+        return;
+    }
+
+    [report appendFormat:@"Known IOCs: %lu\n", (unsigned long)matches.count];
+    for (NSDictionary *match in matches) {
+        if (match[@"address"]) {
+            [report appendFormat:@"    • 0x%llx: %@ [%@]\n", [match[@"address"] unsignedLongLongValue], match[@"value"],
+             match[@"source"]];
+        } else {
+            [report appendFormat:@"    • File %@ %@ [%@]\n", match[@"algorithm"], match[@"value"], match[@"source"]];
+        }
+    }
+    [report appendString:@"\n"];
 }
 
 #pragma mark - Phase 1: Network Communication Detection
@@ -705,8 +987,22 @@
 
     [self scanForC2Frameworks:file results:frameworkSigs frameworkPatterns:frameworkPatterns];
 
+    // Implants strip framework strings, so their code is compared against the labelled corpus too
+    NSArray *functionMatches = @[];
+    NSArray *families = @[];
+    NSDictionary *corpus = SRKLoadFunctionCorpus(SRKFunctionCorpusDirectory());
+    if (corpus) {
+        NSData *fingerprints = [self implantFingerprints:file index:self.imageIndex metrics:self.procedureMetrics
+                                             libraryCode:self.libraryCode];
+        functionMatches = SRKMatchFunctionFingerprints(corpus, self.imageIndex, fingerprints, C2_FUNCTION_MATCH_THRESHOLD);
+        families = SRKFamiliesForFunctionMatches(functionMatches);
+    }
+
     return @{
-        @"frameworks": [frameworkSigs copy]
+        @"frameworks": [frameworkSigs copy],
+        @"function_matches": functionMatches,
+        @"families": families,
+        @"corpus_samples": corpus[@"samples"] ?: @0
     };
 }
 
@@ -736,6 +1032,7 @@
                     if (str && str.length >= 3) {
                         for (NSString *pattern in frameworkPatterns) {
                             if ([str containsString:pattern]) {
+                                if (SRKIsLibraryOnlyReference(file, self.libraryCode, addr)) break;
                                 // Determine framework type
                                 NSString *type = @"Unknown";
                                 if ([str containsString:@"beacon"] || [str containsString:@"Beacon"] ||
@@ -821,7 +1118,182 @@
         [report appendString:@"✓ No known C2 framework signatures detected\n\n"];
     }
 
-    return frameworkSigs.count;
+    NSArray *functionMatches = results[@"function_matches"];
+    NSArray *families = results[@"families"];
+    NSUInteger corpusSamples = [results[@"corpus_samples"] unsignedIntegerValue];
+
+    if (corpusSamples == 0) {
+        [report appendFormat:@"Function Similarity: no corpus at %@\n\n", SRKFunctionCorpusDirectory()];
+        return frameworkSigs.count;
+    }
+
+    [report appendFormat:@"Procedures Matching Known Implant Functions: %lu (corpus: %lu samples)\n",
+     (unsigned long)functionMatches.count, (unsigned long)corpusSamples];
+
+    if (functionMatches.count > 0) {
+        [report appendString:@"\n⚠️  WARNING: Code shared with labelled families!\n\n"];
+        for (NSDictionary *family in families) {
+            [report appendFormat:@"  %@: %lu procedures, mean similarity %.2f (%@)\n",
+             family[@"family"], [family[@"procedures"] unsignedLongValue],
+             [family[@"similarity"] doubleValue], [family[@"samples"] componentsJoinedByString:@", "]];
+        }
+        [report appendString:@"\n"];
+
+        for (NSDictionary *match in [functionMatches subarrayWithRange:NSMakeRange(0, MIN(10, functionMatches.count))]) {
+            [report appendFormat:@"    • 0x%llx ~ %@ in %@/%@ (%.2f%@)\n",
+             [match[@"address"] unsignedLongLongValue], match[@"function"], match[@"family"], match[@"sample"],
+             [match[@"similarity"] doubleValue], [match[@"cfg_match"] boolValue] ? @", same CFG shape" : @""];
+        }
+        if (functionMatches.count > 10) {
+            [report appendFormat:@"    ... and %lu more\n", (unsigned long)(functionMatches.count - 10)];
+        }
+        [report appendString:@"\n"];
+    } else {
+        [report appendString:@"✓ No procedures similar to the corpus\n\n"];
+    }
+
+    return frameworkSigs.count + functionMatches.count;
+}
+
+#pragma mark - Function Corpus & Library Signatures
+
+- (void)addSampleToFunctionCorpus:(nullable id)sender {
+    NSObject<HPDocument> *document = [self.services currentDocument];
+    NSObject<HPDisassembledFile> *file = document.disassembledFile;
+    if (!file) {
+        [self.services logMessage:@"[C2Analyzer] No disassembled file available"];
+        return;
+    }
+
+    NSDictionary *index = SRKBuildImageIndex(file);
+    NSData *fingerprints = [self implantFingerprints:file index:index metrics:SRKBuildProcedureMetrics(file, index)
+                                         libraryCode:SRKIdentifyLibraryCode(file, index)];
+
+    // New samples land in "unlabelled"; moving the file into a family folder labels it
+    NSString *sample = file.originalFilePath.lastPathComponent ?: @"sample";
+    NSString *directory = SRKFunctionCorpusDirectory();
+    NSError *error = nil;
+    NSMutableDictionary *hashes = [SRKComputeSampleHashes(file) mutableCopy];
+    NSDictionary *importSignature = SRKComputeImportSignature(file);
+    hashes[@"imports"] = importSignature;
+    if (SRKWriteFunctionCorpusSample(directory, SRK_UNLABELLED_FAMILY, sample, file, index, fingerprints, hashes, &error)) {
+        [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] Added %@ to %@/%@", sample, directory,
+                                  SRK_UNLABELLED_FAMILY]];
+        if (SRKImportIndexExists(SRKImportIndexDirectory()) &&
+            !SRKAppendImportIndex(SRKImportIndexDirectory(), SRK_UNLABELLED_FAMILY, sample, importSignature, &error)) {
+            [document logErrorStringMessage:[NSString stringWithFormat:@"[C2Analyzer] Could not index the imports of %@: %@",
+                                             sample, error.localizedDescription]];
+        }
+    } else {
+        [document logErrorStringMessage:[NSString stringWithFormat:@"[C2Analyzer] Could not add %@ to the corpus: %@",
+                                         sample, error.localizedDescription]];
+    }
+}
+
+- (void)addSampleToProtocolClusters:(nullable id)sender {
+    NSObject<HPDocument> *document = [self.services currentDocument];
+    NSObject<HPDisassembledFile> *file = document.disassembledFile;
+    if (!file) {
+        [self.services logMessage:@"[C2Analyzer] No disassembled file available"];
+        return;
+    }
+
+    NSString *sample = file.originalFilePath.lastPathComponent ?: @"sample";
+    NSDictionary *index = SRKBuildImageIndex(file);
+    NSDictionary *signature = SRKComputeProtocolSignature(SRKCollectProtocolShapes(file, SRKIdentifyLibraryCode(file, index)));
+    if ([signature[@"tokens"] unsignedIntegerValue] == 0) {
+        [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] %@ has no request paths, query keys or User-Agents to cluster",
+                                  sample]];
+        return;
+    }
+
+    // Filed under the function corpus folder the sample was labelled into, if any
+    NSString *family = SRKFunctionCorpusFamily(SRKFunctionCorpusDirectory(), SRKComputeSampleHashes(file));
+    uint32_t cluster = 0;
+    NSError *error = nil;
+    if (SRKAddToProtocolClusters(SRKProtocolClusterDirectory(), family, sample, signature, &cluster, &error)) {
+        [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] Filed %@ (%@) in protocol shape cluster #%u",
+                                  sample, family, cluster]];
+    } else {
+        [document logErrorStringMessage:[NSString stringWithFormat:@"[C2Analyzer] Could not cluster the protocol shapes of %@: %@",
+                                         sample, error.localizedDescription]];
+    }
+}
+
+/// Function fingerprints with the statically linked library procedures cleared
+- (NSData *)implantFingerprints:(NSObject<HPDisassembledFile> *)file
+                          index:(NSDictionary *)index
+                        metrics:(NSDictionary *)procedureMetrics
+                    libraryCode:(NSDictionary *)libraryCode {
+    NSMutableData *fingerprints = [SRKComputeFunctionFingerprints(file, index, procedureMetrics) mutableCopy];
+    SRKFunctionFingerprint *fingerprint = fingerprints.mutableBytes;
+
+    NSUInteger count = 0;
+    const Address *entries = SRKProcedureEntries(index, &count);
+    for (NSUInteger i = 0; i < count && (i + 1) * sizeof(SRKFunctionFingerprint) <= fingerprints.length; i++) {
+        if (SRKIsLibraryAddress(libraryCode, entries[i])) {
+            memset(&fingerprint[i], 0, sizeof(SRKFunctionFingerprint));
+        }
+    }
+    return fingerprints;
+}
+
+- (void)rebuildImportIndex:(nullable id)sender {
+    NSObject<HPDocument> *document = [self.services currentDocument];
+
+    // Picks up samples moved into family folders since they were added
+    NSString *directory = SRKImportIndexDirectory();
+    NSUInteger count = 0;
+    NSError *error = nil;
+    if (SRKRebuildImportIndex(directory, SRKFunctionCorpusDirectory(), &count, &error)) {
+        NSString *message = [NSString stringWithFormat:@"[C2Analyzer] Indexed the imports of %lu corpus samples in %@",
+                             (unsigned long)count, directory];
+        if (document) {
+            [document logInfoMessage:message];
+        } else {
+            [self.services logMessage:message];
+        }
+    } else {
+        [self.services logMessage:[NSString stringWithFormat:@"[C2Analyzer] Could not rebuild the import index: %@",
+                                   error.localizedDescription]];
+    }
+}
+
+- (void)compileIOCSet:(nullable id)sender {
+    NSString *directory = SRKIOCDirectory();
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+
+    NSUInteger count = 0;
+    NSError *error = nil;
+    if (SRKCompileIOCSet(directory, &count, &error)) {
+        [self.services logMessage:[NSString stringWithFormat:@"[C2Analyzer] Compiled %lu IOCs in %@",
+                                   (unsigned long)count, directory]];
+    } else {
+        [self.services logMessage:[NSString stringWithFormat:@"[C2Analyzer] Could not compile the IOCs in %@: %@",
+                                   directory, error.localizedDescription]];
+    }
+}
+
+- (void)generateLibrarySignatures:(nullable id)sender {
+    NSObject<HPDocument> *document = [self.services currentDocument];
+    NSObject<HPDisassembledFile> *file = document.disassembledFile;
+    if (!file) {
+        [self.services logMessage:@"[C2Analyzer] No disassembled file available"];
+        return;
+    }
+
+    // Meant for a build of the library with symbols; the file name becomes the library name
+    NSString *library = file.originalFilePath.lastPathComponent.stringByDeletingPathExtension ?: @"library";
+    NSString *directory = SRKLibrarySignatureDirectory();
+    NSUInteger count = 0;
+    NSError *error = nil;
+    if (SRKWriteLibrarySignatures(directory, library, file, SRKBuildImageIndex(file), &count, &error)) {
+        [document logInfoMessage:[NSString stringWithFormat:@"[C2Analyzer] Wrote %lu %@ signatures to %@",
+                                  (unsigned long)count, library, directory]];
+    } else {
+        [document logErrorStringMessage:[NSString stringWithFormat:@"[C2Analyzer] Could not write %@ signatures: %@",
+                                         library, error.localizedDescription]];
+    }
 }
 
 #pragma mark - Phase 5: Data Exfiltration Detection
@@ -1075,6 +1547,56 @@
     return total;
 }
 
+#pragma mark - Phase 7: Embedded Configuration Detection
+
+- (NSUInteger)addConfigBlobsToReport:(NSMutableString *)report
+                               blobs:(NSArray<NSDictionary *> *)blobs {
+    [report appendString:@"───────────────────────────────────────────────────────────────\n"];
+    [report appendString:@"Phase 7: EMBEDDED CONFIGURATION DETECTION\n"];
+    [report appendString:@"───────────────────────────────────────────────────────────────\n\n"];
+
+    NSMutableArray<NSDictionary *> *configs = [NSMutableArray array];
+    for (NSDictionary *blob in blobs) {
+        if ([blob[@"config"] boolValue]) [configs addObject:blob];
+    }
+
+    [report appendFormat:@"Serialized Blobs (JSON / MessagePack / protobuf): %lu\n", (unsigned long)blobs.count];
+    [report appendFormat:@"Config-Like Blobs: %lu\n\n", (unsigned long)configs.count];
+    if (blobs.count == 0) {
+        [report appendString:@"✓ No embedded configuration blobs detected\n\n"];
+        return 0;
+    }
+
+    // Config-like blobs first with every finding, then the rest with the findings that carry a role
+    NSMutableArray<NSDictionary *> *ordered = [configs mutableCopy];
+    for (NSDictionary *blob in blobs) {
+        if (![blob[@"config"] boolValue]) [ordered addObject:blob];
+    }
+    for (NSDictionary *blob in [ordered subarrayWithRange:NSMakeRange(0, MIN(10, ordered.count))]) {
+        BOOL config = [blob[@"config"] boolValue];
+        NSString *encoding = blob[@"encoding"] ? [NSString stringWithFormat:@", %@-encoded", blob[@"encoding"]] : @"";
+        [report appendFormat:@"  • 0x%llx: %@, %@ bytes in %@%@%@\n", [blob[@"address"] unsignedLongLongValue],
+         blob[@"format"], blob[@"length"], blob[@"section"], encoding, config ? @" ⚠️  config" : @""];
+
+        NSUInteger listed = 0;
+        for (NSDictionary *finding in blob[@"findings"]) {
+            if (!config && !finding[@"role"]) continue;
+            if (listed++ == 12) {
+                [report appendString:@"      ...\n"];
+                break;
+            }
+            NSString *role = finding[@"role"] ? [NSString stringWithFormat:@" [%@]", finding[@"role"]] : @"";
+            [report appendFormat:@"      %@ = %@%@\n", finding[@"key"], finding[@"value"], role];
+        }
+    }
+    if (ordered.count > 10) {
+        [report appendFormat:@"  ... and %lu more\n", (unsigned long)(ordered.count - 10)];
+    }
+    [report appendString:@"\n"];
+
+    return configs.count;
+}
+
 #pragma mark - Helper Methods
 
 - (void)scanStringsForPatterns:(NSArray *)patterns
@@ -1103,6 +1625,8 @@
                     if (str && str.length >= 3) {
                         for (NSString *pattern in patterns) {
                             if ([str containsString:pattern]) {
+                                // Strings only statically linked library code uses are noise
+                                if (SRKIsLibraryOnlyReference(file, self.libraryCode, addr)) break;
                                 [results addObject:@{
                                     @"address": @(addr),
                                     @"string": str
@@ -23,6 +23,7 @@
  *
  * Automatically performs comprehensive file operation security analysis:
  * - File operation API detection (POSIX, BSD, Darwin-specific)
+ * - Per-call-site paths, open(2) flags and mode bits (write/create/permission-change)
  * - Symlink/hardlink attack vulnerability detection
  * - TOCTOU race condition identification
  * - Insecure temporary file usage patterns
@@ -30,6 +31,7 @@
  * - File permission/ownership security analysis
  * - Directory traversal and creation patterns
  * - Atomic operation verification
+ * - Sensitive location classification (launch agents, TCC, keychains, browser profiles)
  */
 @interface FileOpAnalyzer : NSObject <HopperTool>
 
@@ -11,10 +11,18 @@
 //
 
 #import "FileOpAnalyzer.h"
+#import "SRKCallSites.h"
+#import "SRKPathClassifier.h"
+#import "SRKStackFrame.h"
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "OCUnusedClassInspection"
 
+@interface FileOpAnalyzer ()
+/// Sensitive location classifier of the current run
+@property(strong, nonatomic, nullable) NSDictionary *pathClassifier;
+@end
+
 @implementation FileOpAnalyzer
 
 #pragma mark - Plugin Initialization
@@ -92,6 +100,9 @@
 
     [document beginToWait:@"Analyzing File Operations..."];
 
+    // Bundled sensitive location list plus the user's additions
+    self.pathClassifier = SRKLoadPathClassifier(SRKDefaultPathClassifierFiles([NSBundle bundleForClass:[self class]]));
+
     NSMutableString *report = [NSMutableString string];
 
     [document logInfoMessage:@"[FileOpAnalyzer] ══════════════════════════════════════════════════════════════════════"];
@@ -127,6 +138,7 @@
     [self logAndReportArray:cAPIs[@"perm_ops"] title:@"Permission/Ownership Operations" report:report document:document];
     [self logAndReportArray:cAPIs[@"dir_ops"] title:@"Directory Operations" report:report document:document];
     [self logAndReportArray:cAPIs[@"temp_ops"] title:@"Temporary File Operations" report:report document:document];
+    [self logAndReportArray:cAPIs[@"call_sites"] title:@"Recovered Call Sites (path, flags, mode)" report:report document:document];
 
     // Phase 2: Objective-C File Operation APIs
     [document logInfoMessage:@"[FileOpAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
@@ -172,6 +184,7 @@
 
     [document logInfoMessage:@"[FileOpAnalyzer] [4] FILE PATH STRINGS"];
 
+    [self logAndReportArray:pathStrings[@"sensitive_paths"] title:@"Sensitive Locations" report:report document:document];
     [self logAndReportArray:pathStrings[@"absolute_paths"] title:@"Absolute Paths" report:report document:document];
     [self logAndReportArray:pathStrings[@"relative_paths"] title:@"Relative Paths (../, ./)" report:report document:document];
     [self logAndReportArray:pathStrings[@"home_paths"] title:@"Home Directory Paths (~)" report:report document:document];
@@ -197,6 +210,13 @@
 
     NSUInteger totalSwiftAPIs = [swiftAPIs count];
 
+    NSUInteger writeCalls = 0, createCalls = 0, permissionCalls = 0;
+    for (NSDictionary *callSite in cAPIs[@"call_sites"]) {
+        if ([callSite[@"effects"] containsObject:@"write"]) writeCalls++;
+        if ([callSite[@"effects"] containsObject:@"create"]) createCalls++;
+        if ([callSite[@"effects"] containsObject:@"permission-change"]) permissionCalls++;
+    }
+
     NSUInteger totalPaths = [pathStrings[@"absolute_paths"] count] + [pathStrings[@"relative_paths"] count] +
                             [pathStrings[@"home_paths"] count] + [pathStrings[@"tmp_paths"] count] +
                             [pathStrings[@"extension_patterns"] count];
@@ -207,7 +227,9 @@
     [report appendFormat:@"  • Status Operations:           %lu\n", (unsigned long)[cAPIs[@"stat_ops"] count]];
     [report appendFormat:@"  • Permission Operations:       %lu\n", (unsigned long)[cAPIs[@"perm_ops"] count]];
     [report appendFormat:@"  • Directory Operations:        %lu\n", (unsigned long)[cAPIs[@"dir_ops"] count]];
-    [report appendFormat:@"  • Temporary File Ops:          %lu\n\n", (unsigned long)[cAPIs[@"temp_ops"] count]];
+    [report appendFormat:@"  • Temporary File Ops:          %lu\n", (unsigned long)[cAPIs[@"temp_ops"] count]];
+    [report appendFormat:@"  • Recovered Call Sites:        %lu (%lu write, %lu create, %lu permission change)\n\n",
+        (unsigned long)[cAPIs[@"call_sites"] count], (unsigned long)writeCalls, (unsigned long)createCalls, (unsigned long)permissionCalls];
 
     [report appendFormat:@"Objective-C File APIs Found:     %lu\n", (unsigned long)totalObjCAPIs];
     [report appendFormat:@"  • NSFileManager:               %lu\n", (unsigned long)[objcAPIs[@"nsfilemanager"] count]];
@@ -223,7 +245,9 @@
     [report appendFormat:@"  • Relative Paths:              %lu\n", (unsigned long)[pathStrings[@"relative_paths"] count]];
     [report appendFormat:@"  • Home Paths:                  %lu\n", (unsigned long)[pathStrings[@"home_paths"] count]];
     [report appendFormat:@"  • Temp Paths:                  %lu\n", (unsigned long)[pathStrings[@"tmp_paths"] count]];
-    [report appendFormat:@"  • File Extensions:             %lu\n\n", (unsigned long)[pathStrings[@"extension_patterns"] count]];
+    [report appendFormat:@"  • File Extensions:             %lu\n", (unsigned long)[pathStrings[@"extension_patterns"] count]];
+    [report appendFormat:@"  • Sensitive Locations:         %lu (%lu critical)\n\n",
+        (unsigned long)[pathStrings[@"sensitive_paths"] count], (unsigned long)[pathStrings[@"sensitive_critical"] unsignedIntegerValue]];
 
     [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer] C File APIs Found:               %lu", (unsigned long)totalCAPIs]];
     [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   • Basic Operations:            %lu", (unsigned long)[cAPIs[@"basic_ops"] count]]];
@@ -232,6 +256,8 @@
     [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   • Permission Operations:       %lu", (unsigned long)[cAPIs[@"perm_ops"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   • Directory Operations:        %lu", (unsigned long)[cAPIs[@"dir_ops"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   • Temporary File Ops:          %lu", (unsigned long)[cAPIs[@"temp_ops"] count]]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   • Recovered Call Sites:        %lu (%lu write, %lu create, %lu permission change)",
+        (unsigned long)[cAPIs[@"call_sites"] count], (unsigned long)writeCalls, (unsigned long)createCalls, (unsigned long)permissionCalls]];
 
     [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer] Objective-C File APIs Found:     %lu", (unsigned long)totalObjCAPIs]];
     [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   • NSFileManager:               %lu", (unsigned long)[objcAPIs[@"nsfilemanager"] count]]];
@@ -248,6 +274,8 @@
     [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   • Home Paths:                  %lu", (unsigned long)[pathStrings[@"home_paths"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   • Temp Paths:                  %lu", (unsigned long)[pathStrings[@"tmp_paths"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   • File Extensions:             %lu", (unsigned long)[pathStrings[@"extension_patterns"] count]]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   • Sensitive Locations:         %lu (%lu critical)",
+        (unsigned long)[pathStrings[@"sensitive_paths"] count], (unsigned long)[pathStrings[@"sensitive_critical"] unsignedIntegerValue]]];
 
     [report appendString:@"══════════════════════════════════════════════════════════════════════\n"];
     [report appendString:@"                          END OF REPORT                               \n"];
@@ -264,6 +292,7 @@
     NSError *error = nil;
     [report writeToFile:tmpPath atomically:YES encoding:NSUTF8StringEncoding error:&error];
 
+    self.pathClassifier = nil;
     [document endWaiting];
 
     NSString *summary = [NSString stringWithFormat:
@@ -415,8 +444,214 @@
         @"stat_ops": statOps,
         @"perm_ops": permOps,
         @"dir_ops": dirOps,
-        @"temp_ops": tempOps
+        @"temp_ops": tempOps,
+        @"call_sites": [self recoverFileCallSites:file]
+    };
+}
+
+- (NSDictionary<NSString *, NSDictionary *> *)fileCallSiteArguments {
+    // Argument indexes per function: path arguments, open(2) flags, mode bits,
+    // fopen(3) mode string, owner/group, and the effect when it does not depend on the flags.
+    // variadic_mode: the mode is the first variadic argument, which arm64 passes on the stack
+    return @{
+        @"open": @{@"paths": @[@0], @"flags": @1, @"mode": @2, @"variadic_mode": @YES},
+        @"openat": @{@"paths": @[@1], @"flags": @2, @"mode": @3, @"variadic_mode": @YES},
+        @"creat": @{@"paths": @[@0], @"mode": @1, @"effect": @"create,write"},
+        @"fopen": @{@"paths": @[@0], @"fmode": @1},
+        @"freopen": @{@"paths": @[@0], @"fmode": @1},
+        @"truncate": @{@"paths": @[@0], @"effect": @"write"},
+        @"chmod": @{@"paths": @[@0], @"mode": @1, @"effect": @"permission-change"},
+        @"lchmod": @{@"paths": @[@0], @"mode": @1, @"effect": @"permission-change"},
+        @"fchmodat": @{@"paths": @[@1], @"mode": @2, @"effect": @"permission-change"},
+        @"chown": @{@"paths": @[@0], @"owner": @1, @"effect": @"permission-change"},
+        @"lchown": @{@"paths": @[@0], @"owner": @1, @"effect": @"permission-change"},
+        @"fchownat": @{@"paths": @[@1], @"owner": @2, @"effect": @"permission-change"},
+        @"chflags": @{@"paths": @[@0], @"effect": @"permission-change"},
+        @"lchflags": @{@"paths": @[@0], @"effect": @"permission-change"},
+        @"mkdir": @{@"paths": @[@0], @"mode": @1, @"effect": @"create"},
+        @"mkdirat": @{@"paths": @[@1], @"mode": @2, @"effect": @"create"},
+        @"mkfifo": @{@"paths": @[@0], @"mode": @1, @"effect": @"create"},
+        @"rename": @{@"paths": @[@0, @1], @"effect": @"move"},
+        @"renameat": @{@"paths": @[@1, @3], @"effect": @"move"},
+        @"renamex_np": @{@"paths": @[@0, @1], @"effect": @"move"},
+        @"link": @{@"paths": @[@0, @1], @"effect": @"link"},
+        @"linkat": @{@"paths": @[@1, @3], @"effect": @"link"},
+        @"symlink": @{@"paths": @[@0, @1], @"effect": @"link"},
+        @"symlinkat": @{@"paths": @[@0, @2], @"effect": @"link"},
+        @"copyfile": @{@"paths": @[@0, @1], @"effect": @"create,write"},
+        @"clonefile": @{@"paths": @[@0, @1], @"effect": @"create"},
+        @"unlink": @{@"paths": @[@0], @"effect": @"delete"},
+        @"unlinkat": @{@"paths": @[@1], @"effect": @"delete"},
+        @"remove": @{@"paths": @[@0], @"effect": @"delete"},
+        @"rmdir": @{@"paths": @[@0], @"effect": @"delete"}
+    };
+}
+
+- (NSString *)describeOpenFlags:(uint64_t)flags {
+    static const struct { uint64_t bit; const char *name; } kOpenFlags[] = {
+        {0x00000008, "O_APPEND"},   {0x00000004, "O_NONBLOCK"}, {0x00000010, "O_SHLOCK"},
+        {0x00000020, "O_EXLOCK"},   {0x00000040, "O_ASYNC"},    {0x00000080, "O_SYNC"},
+        {0x00000100, "O_NOFOLLOW"}, {0x00000200, "O_CREAT"},    {0x00000400, "O_TRUNC"},
+        {0x00000800, "O_EXCL"},     {0x00008000, "O_EVTONLY"},  {0x00020000, "O_NOCTTY"},
+        {0x00100000, "O_DIRECTORY"}, {0x00200000, "O_SYMLINK"}, {0x00400000, "O_DSYNC"},
+        {0x01000000, "O_CLOEXEC"},  {0x20000000, "O_NOFOLLOW_ANY"}
     };
+
+    NSMutableArray<NSString *> *names = [NSMutableArray array];
+    switch (flags & 3) {
+        case 0: [names addObject:@"O_RDONLY"]; break;
+        case 1: [names addObject:@"O_WRONLY"]; break;
+        default: [names addObject:@"O_RDWR"]; break;
+    }
+    uint64_t known = 3;
+    for (size_t i = 0; i < sizeof(kOpenFlags) / sizeof(kOpenFlags[0]); i++) {
+        if (flags & kOpenFlags[i].bit) [names addObject:@(kOpenFlags[i].name)];
+        known |= kOpenFlags[i].bit;
+    }
+    if (flags & ~known) [names addObject:[NSString stringWithFormat:@"0x%llx", flags & ~known]];
+    return [names componentsJoinedByString:@"|"];
+}
+
+/// Call address -> variadic mode at the arm64 call sites of the functions, read from [sp] after lifting the caller's frame
+- (NSDictionary<NSNumber *, NSNumber *> *)variadicModes:(NSObject<HPDisassembledFile> *)file
+                                                  index:(NSDictionary *)index
+                                              functions:(NSArray<NSString *> *)functions {
+    NSMutableDictionary<NSNumber *, NSNumber *> *modes = [NSMutableDictionary dictionary];
+
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+    if (lifter.arch != SRKArchitectureARM64) return modes;
+    lifter.slotNames = index[@"dynamic_slots"];
+
+    NSDictionary<NSNumber *, NSString *> *sites = SRKCallSiteAddresses(file, index, functions);
+    NSMutableSet<NSNumber *> *walked = [NSMutableSet set];
+    for (NSNumber *site in [sites.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, index, site.unsignedLongLongValue);
+        if (!procedure || [walked containsObject:@([procedure entryPoint])]) continue;
+        [walked addObject:@([procedure entryPoint])];
+
+        NSMutableDictionary<NSNumber *, NSValue *> *stack = [NSMutableDictionary dictionary];
+        SRKLiftProcedureWithStack(&lifter, procedure, stack, ^(SRKLifter *callLifter, Address callAddress, NSString *callee,
+                                                               SRKRegisterState *state, BOOL *stop) {
+            if (!sites[@(callAddress)]) return;
+
+            // The first stack argument sits at [sp]; mode_t is promoted to int
+            SRKRegisterValue value;
+            if (SRKStackArgumentValue(callLifter, state, stack, 8, 4, &value)) {
+                modes[@(callAddress)] = @(value.value);
+            }
+        });
+    }
+
+    return modes;
+}
+
+- (NSArray *)recoverFileCallSites:(NSObject<HPDisassembledFile> *)file {
+    NSDictionary<NSString *, NSDictionary *> *specs = [self fileCallSiteArguments];
+    NSMutableArray *callSites = [NSMutableArray array];
+
+    // Lifting only the blocks leading to each call keeps this proportional to the call sites
+    NSDictionary *index = SRKBuildImageIndex(file);
+    BOOL stackVariadics = [index[@"arch"] unsignedIntegerValue] == SRKArchitectureARM64;
+    NSMutableArray<NSString *> *variadicFunctions = [NSMutableArray array];
+    for (NSString *function in specs) {
+        if ([specs[function][@"variadic_mode"] boolValue]) [variadicFunctions addObject:function];
+    }
+    NSDictionary<NSNumber *, NSNumber *> *variadicModes = stackVariadics ?
+        [self variadicModes:file index:index functions:variadicFunctions] : @{};
+    for (NSDictionary *callSite in SRKCallSitesForFunctions(file, index, specs.allKeys, 4)) {
+        NSString *function = callSite[@"function"];
+        NSDictionary *spec = specs[function];
+
+        NSMutableArray<NSString *> *paths = [NSMutableArray array];
+        NSMutableArray<NSString *> *arguments = [NSMutableArray array];
+        for (NSNumber *pathIndex in spec[@"paths"]) {
+            NSString *path = SRKCallSiteStringArgument(callSite, pathIndex.unsignedIntegerValue);
+            [paths addObject:path ?: @"?"];
+            [arguments addObject:path ? [NSString stringWithFormat:@"\"%@\"", path] : @"?"];
+        }
+
+        NSMutableOrderedSet<NSString *> *effects = [NSMutableOrderedSet orderedSet];
+        if (spec[@"effect"]) [effects addObjectsFromArray:[spec[@"effect"] componentsSeparatedByString:@","]];
+
+        BOOL creates = [effects containsObject:@"create"];
+        if (spec[@"flags"]) {
+            NSNumber *flags = SRKCallSiteValueArgument(callSite, [spec[@"flags"] unsignedIntegerValue]);
+            if (flags) {
+                uint64_t value = flags.unsignedLongLongValue;
+                [arguments addObject:[self describeOpenFlags:value]];
+                if (value & 0x200) [effects addObject:@"create"];
+                if ((value & 3) != 0 || (value & 0x408)) [effects addObject:@"write"];
+                if (effects.count == 0) [effects addObject:@"read"];
+                creates = (value & 0x200) != 0;
+            } else {
+                [arguments addObject:@"?"];
+            }
+        }
+        if (spec[@"fmode"]) {
+            NSString *mode = SRKCallSiteStringArgument(callSite, [spec[@"fmode"] unsignedIntegerValue]);
+            if (mode) {
+                [arguments addObject:[NSString stringWithFormat:@"\"%@\"", mode]];
+                if ([mode containsString:@"w"] || [mode containsString:@"a"]) [effects addObject:@"create"];
+                if ([mode containsString:@"w"] || [mode containsString:@"a"] || [mode containsString:@"+"]) [effects addObject:@"write"];
+                if (effects.count == 0) [effects addObject:@"read"];
+            } else {
+                [arguments addObject:@"?"];
+            }
+        }
+
+        NSString *modeNote = nil;
+        // open(2) only reads its variadic mode with O_CREAT
+        if (spec[@"mode"] && (creates || !spec[@"flags"])) {
+            // On arm64 x2/x3 hold whatever an earlier call left there, never the mode
+            NSNumber *mode = stackVariadics && [spec[@"variadic_mode"] boolValue] ? variadicModes[callSite[@"address"]] :
+                             SRKCallSiteValueArgument(callSite, [spec[@"mode"] unsignedIntegerValue]);
+            if (mode) {
+                uint64_t bits = mode.unsignedLongLongValue & 07777;
+                [arguments addObject:[NSString stringWithFormat:@"0%llo", bits]];
+                if (bits & 06000) modeNote = @"setuid/setgid";
+                else if (bits & 0002) modeNote = @"world-writable";
+            } else {
+                [arguments addObject:@"?"];
+            }
+        }
+        if (spec[@"owner"]) {
+            NSUInteger ownerIndex = [spec[@"owner"] unsignedIntegerValue];
+            NSNumber *owner = SRKCallSiteValueArgument(callSite, ownerIndex);
+            NSNumber *group = SRKCallSiteValueArgument(callSite, ownerIndex + 1);
+            [arguments addObject:owner ? [NSString stringWithFormat:@"%d", (int)owner.longLongValue] : @"?"];
+            [arguments addObject:group ? [NSString stringWithFormat:@"%d", (int)group.longLongValue] : @"?"];
+            if (owner && (int)owner.longLongValue == 0) modeNote = @"root-owned";
+        }
+        if (effects.count == 0) [effects addObject:@"open"];
+
+        // Most severe sensitive location among the paths
+        NSDictionary *sensitive = nil;
+        for (NSString *path in paths) {
+            NSDictionary *match = self.pathClassifier ? SRKClassifyPath(self.pathClassifier, path) : nil;
+            if (match && SRKPathSeverityRank(match[@"severity"]) > SRKPathSeverityRank(sensitive[@"severity"])) {
+                sensitive = match;
+            }
+        }
+
+        NSMutableString *call = [NSMutableString stringWithFormat:@"%@(%@) -> %@",
+            function, [arguments componentsJoinedByString:@", "], [effects.array componentsJoinedByString:@", "]];
+        if (modeNote) [call appendFormat:@" [%@]", modeNote];
+        if (sensitive) [call appendFormat:@" [%@ %@]", sensitive[@"severity"], sensitive[@"category"]];
+
+        NSMutableDictionary *entry = [NSMutableDictionary dictionaryWithDictionary:@{
+            @"address": callSite[@"address"],
+            @"function": function,
+            @"paths": paths,
+            @"effects": effects.array,
+            @"call": call
+        }];
+        if (sensitive) entry[@"sensitive"] = sensitive;
+        [callSites addObject:entry];
+    }
+
+    return callSites;
 }
 
 - (NSDictionary *)findObjCFileOperations:(NSObject<HPDisassembledFile> *)file {
@@ -583,6 +818,8 @@
     NSMutableArray *homePaths = [NSMutableArray array];
     NSMutableArray *tmpPaths = [NSMutableArray array];
     NSMutableArray *extensions = [NSMutableArray array];
+    NSMutableArray *sensitivePaths = [NSMutableArray array];
+    NSDictionary *classifier = self.pathClassifier ?: @{};
 
     // Scan all string sections
     for (NSObject<HPSegment> *segment in file.segments) {
@@ -598,6 +835,20 @@
                     NSString *str = [self readStringAtAddress:addr file:file maxLength:256];
 
                     if (str && str.length > 2) {
+                        // Classify whole strings only, not every suffix of them
+                        if ([str containsString:@"/"] &&
+                            (addr == section.startAddress || [file readUInt8AtVirtualAddress:addr - 1] == 0)) {
+                            NSDictionary *match = SRKClassifyPath(classifier, str);
+                            if (match) {
+                                [sensitivePaths addObject:@{
+                                    @"address": @(addr),
+                                    @"path": str,
+                                    @"category": match[@"category"],
+                                    @"severity": match[@"severity"]
+                                }];
+                            }
+                        }
+
                         // Absolute paths
                         if ([str hasPrefix:@"/"] && [str containsString:@"/"]) {
                             [absolutePaths addObject:@{@"address": @(addr), @"path": str}];
@@ -633,7 +884,21 @@
         }
     }
 
+    // Most severe first, in address order within a severity
+    [sensitivePaths sortUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+        NSInteger rankA = SRKPathSeverityRank(a[@"severity"]);
+        NSInteger rankB = SRKPathSeverityRank(b[@"severity"]);
+        if (rankA != rankB) return rankA > rankB ? NSOrderedAscending : NSOrderedDescending;
+        return [a[@"address"] compare:b[@"address"]];
+    }];
+    NSUInteger critical = 0;
+    for (NSDictionary *item in sensitivePaths) {
+        if ([item[@"severity"] isEqualToString:@"critical"]) critical++;
+    }
+
     return @{
+        @"sensitive_paths": sensitivePaths,
+        @"sensitive_critical": @(critical),
         @"absolute_paths": absolutePaths,
         @"relative_paths": relativePaths,
         @"home_paths": homePaths,
@@ -650,7 +915,12 @@
         [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer] %@: %lu", title, (unsigned long)items.count]];
 
         for (NSDictionary *item in items) {
-            if (item[@"function"]) {
+            if (item[@"call"]) {
+                [report appendFormat:@"  [0x%llx] %@\n",
+                    [item[@"address"] unsignedLongLongValue], item[@"call"]];
+                [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   [0x%llx] %@",
+                    [item[@"address"] unsignedLongLongValue], item[@"call"]]];
+            } else if (item[@"function"]) {
                 [report appendFormat:@"  [0x%llx] %@\n",
                     [item[@"address"] unsignedLongLongValue], item[@"function"]];
                 [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   [0x%llx] %@",
@@ -665,6 +935,11 @@
                     [item[@"address"] unsignedLongLongValue], item[@"symbol"]];
                 [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   [0x%llx] %@",
                     [item[@"address"] unsignedLongLongValue], item[@"symbol"]]];
+            } else if (item[@"category"]) {
+                [report appendFormat:@"  [0x%llx] [%@] %@: %@\n",
+                    [item[@"address"] unsignedLongLongValue], item[@"severity"], item[@"category"], item[@"path"]];
+                [document logInfoMessage:[NSString stringWithFormat:@"[FileOpAnalyzer]   [0x%llx] [%@] %@: %@",
+                    [item[@"address"] unsignedLongLongValue], item[@"severity"], item[@"category"], item[@"path"]]];
             } else if (item[@"path"]) {
                 [report appendFormat:@"  [0x%llx] %@\n",
                     [item[@"address"] unsignedLongLongValue], item[@"path"]];
@@ -24,6 +24,7 @@
  *
  * Automatically performs comprehensive keychain and credential analysis:
  * - Security.framework Keychain APIs (SecItem*, SecKeychain*)
+ * - SecItem query dictionaries reconstructed at each call site (kSecClass, service, account...)
  * - CommonCrypto operations (CCCrypt, CCHmac, CCKeyDerivation, etc.)
  * - LocalAuthentication (LAContext, biometric authentication)
  * - Password and credential string detection
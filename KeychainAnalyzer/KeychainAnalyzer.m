@@ -8,10 +8,18 @@
 @import Foundation;
 
 #import "KeychainAnalyzer.h"
+#import "SRKLibraryCode.h"
+#import "SRKKeychainQueries.h"
+#import "SRKProcedureMetrics.h"
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "OCUnusedClassInspection"
 
+@interface KeychainAnalyzer ()
+/// Statically linked library procedures of the file being analyzed, whose strings are skipped
+@property(strong, nonatomic, nullable) NSDictionary *libraryCode;
+@end
+
 @implementation KeychainAnalyzer
 
 #pragma mark - Plugin Initialization
@@ -104,6 +112,12 @@
     [report appendFormat:@"Architecture: %@ %@\n", file.cpuFamily, file.cpuSubFamily];
     [report appendFormat:@"Analysis Date: %@\n\n", [NSDate date]];
 
+    NSDictionary *imageIndex = SRKBuildImageIndex(file);
+    self.libraryCode = SRKIdentifyLibraryCode(file, imageIndex);
+    NSUInteger libraryProcedures = [self.libraryCode[@"procedures"] unsignedIntegerValue];
+    [document logInfoMessage:[NSString stringWithFormat:@"[KeychainAnalyzer] Library procedures skipped: %lu (%@)",
+                              (unsigned long)libraryProcedures, SRKDescribeLibraryCode(self.libraryCode)]];
+
     // Phase 1: Keychain API Detection (C & Objective-C)
     [document logInfoMessage:@"[KeychainAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
     [document logInfoMessage:@"[KeychainAnalyzer] Phase 1: Analyzing Keychain APIs (C & Objective-C)..."];
@@ -147,11 +161,39 @@
         [report appendString:@"\n"];
     }
 
+    // Query dictionaries handed to SecItem* at each call site
+    NSArray<NSDictionary *> *secItemQueries = SRKKeychainQueries(file, imageIndex);
+    NSUInteger recoveredQueries = 0;
+    NSUInteger secretReads = 0;
+    if (secItemQueries.count > 0) {
+        [report appendFormat:@"SecItem Call Sites: %lu\n\n", (unsigned long)secItemQueries.count];
+        [document logInfoMessage:[NSString stringWithFormat:@"[KeychainAnalyzer] SecItem Call Sites: %lu", (unsigned long)secItemQueries.count]];
+        for (NSDictionary *query in secItemQueries) {
+            if ([query[@"query"] isKindOfClass:[NSArray class]]) recoveredQueries++;
+            if ([query[@"returns_secret"] boolValue]) secretReads++;
+
+            NSString *marker = [query[@"returns_secret"] boolValue] ? @"  ⚠️  reads secret data" : @"";
+            NSString *line = [NSString stringWithFormat:@"[0x%llx] %@ %@%@", [query[@"address"] unsignedLongLongValue],
+                              query[@"function"], SRKKeychainQueryDescription(query[@"query"]), marker];
+            [report appendFormat:@"  %@\n", line];
+            [document logInfoMessage:[NSString stringWithFormat:@"[KeychainAnalyzer]   %@", line]];
+            if (query[@"attributes"]) {
+                [report appendFormat:@"      attributes to update: %@\n", SRKKeychainQueryDescription(query[@"attributes"])];
+            }
+        }
+        [report appendString:@"\n"];
+    }
+
     NSUInteger totalKeychainAPIs = secItemAPIs.count + legacyAPIs.count + attributeAPIs.count;
     if (totalKeychainAPIs == 0) {
         [report appendString:@"⚠️  No keychain APIs detected\n\n"];
         [document logInfoMessage:@"[KeychainAnalyzer] ⚠️  No keychain APIs detected"];
     }
+    // A credential stealer reads and decrypts in the same few routines
+    NSDictionary *procedureMetrics = SRKBuildProcedureMetrics(file, imageIndex);
+    SRKAppendProcedureAPIReport(report, file, SRKProceduresByAPICalls(procedureMetrics, imageIndex,
+                                                                      @[@"api_keychain", @"api_crypto"], self.libraryCode, 5),
+                                @"Procedures With The Most Keychain / Crypto Calls");
 
     // Phase 2: CommonCrypto & Cryptographic APIs
     [document logInfoMessage:@"[KeychainAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
@@ -328,6 +370,8 @@
     [report appendFormat:@"    • SecItem APIs: %lu\n", (unsigned long)secItemAPIs.count];
     [report appendFormat:@"    • Legacy APIs: %lu\n", (unsigned long)legacyAPIs.count];
     [report appendFormat:@"    • Attributes: %lu\n", (unsigned long)attributeAPIs.count];
+    [report appendFormat:@"    • SecItem queries recovered: %lu of %lu (%lu secret reads)\n", (unsigned long)recoveredQueries,
+     (unsigned long)secItemQueries.count, (unsigned long)secretReads];
     [report appendFormat:@"  - Cryptographic APIs: %lu\n", (unsigned long)totalCryptoAPIs];
     [report appendFormat:@"    • CommonCrypto: %lu\n", (unsigned long)commonCrypto.count];
     [report appendFormat:@"    • SecKey: %lu\n", (unsigned long)secKeyAPIs.count];
@@ -336,13 +380,16 @@
     [report appendFormat:@"    • Objective-C: %lu\n", (unsigned long)objcAuth.count];
     [report appendFormat:@"    • Swift: %lu\n", (unsigned long)swiftAuth.count];
     [report appendFormat:@"  - Certificate/Trust APIs: %lu\n", (unsigned long)totalCertAPIs];
-    [report appendFormat:@"  - Credential Strings: %lu\n\n", (unsigned long)credentials.count];
+    [report appendFormat:@"  - Credential Strings: %lu\n", (unsigned long)credentials.count];
+    [report appendFormat:@"Library Procedures Skipped: %lu (%@)\n\n", (unsigned long)libraryProcedures,
+     SRKDescribeLibraryCode(self.libraryCode)];
 
     [document logInfoMessage:@"[KeychainAnalyzer] ══════════════════════════════════════════════════════════════════════"];
     [document logInfoMessage:@"[KeychainAnalyzer] SUMMARY"];
     [document logInfoMessage:@"[KeychainAnalyzer] ══════════════════════════════════════════════════════════════════════"];
     [document logInfoMessage:[NSString stringWithFormat:@"[KeychainAnalyzer] Total Findings: %lu", (unsigned long)totalFindings]];
     [document logInfoMessage:[NSString stringWithFormat:@"[KeychainAnalyzer] Keychain APIs: %lu (SecItem:%lu Legacy:%lu Attrs:%lu)", (unsigned long)totalKeychainAPIs, (unsigned long)secItemAPIs.count, (unsigned long)legacyAPIs.count, (unsigned long)attributeAPIs.count]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[KeychainAnalyzer] SecItem Queries: %lu of %lu recovered (%lu secret reads)", (unsigned long)recoveredQueries, (unsigned long)secItemQueries.count, (unsigned long)secretReads]];
     [document logInfoMessage:[NSString stringWithFormat:@"[KeychainAnalyzer] Crypto APIs: %lu (CC:%lu SecKey:%lu Enclave:%lu)", (unsigned long)totalCryptoAPIs, (unsigned long)commonCrypto.count, (unsigned long)secKeyAPIs.count, (unsigned long)enclaveAPIs.count]];
     [document logInfoMessage:[NSString stringWithFormat:@"[KeychainAnalyzer] LocalAuth: %lu (ObjC:%lu Swift:%lu)", (unsigned long)totalAuthAPIs, (unsigned long)objcAuth.count, (unsigned long)swiftAuth.count]];
     [document logInfoMessage:[NSString stringWithFormat:@"[KeychainAnalyzer] Certificate/Trust: %lu", (unsigned long)totalCertAPIs]];
@@ -405,6 +452,7 @@
     [report writeToFile:tmpPath atomically:YES encoding:NSUTF8StringEncoding error:&error];
 
     [document endWaiting];
+    self.libraryCode = nil;
 
     // Show summary popup
     NSString *summary = [NSString stringWithFormat:
@@ -663,6 +711,7 @@
                         NSString *lowerStr = [str lowercaseString];
                         for (NSString *keyword in keywords) {
                             if ([lowerStr containsString:keyword]) {
+                                if (SRKIsLibraryOnlyReference(file, self.libraryCode, addr)) break;
                                 [results addObject:@{
                                     @"type": keyword,
                                     @"string": str,
@@ -712,6 +761,8 @@
                     if (str && str.length >= 3) {
                         for (NSString *pattern in patterns) {
                             if ([str containsString:pattern]) {
+                                // Strings only statically linked library code uses are noise
+                                if (SRKIsLibraryOnlyReference(file, self.libraryCode, addr)) break;
                                 [results addObject:@{@"address": @(addr), @"string": str}];
                                 break;
                             }
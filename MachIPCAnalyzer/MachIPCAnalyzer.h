@@ -29,6 +29,7 @@
  * - Message handler and routine descriptor identification
  * - Authorization pattern analysis
  * - Service name extraction
+ * - Service names recovered at bootstrap/XPC call sites (used vs. vended)
  */
 @interface MachIPCAnalyzer : NSObject <HopperTool>
 
@@ -8,6 +8,7 @@
 @import Foundation;
 
 #import "MachIPCAnalyzer.h"
+#import "SRKCallSites.h"
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "OCUnusedClassInspection"
@@ -143,6 +144,7 @@
 
     [self logAndReportArray:bootstrapAPIs[@"bootstrap_ops"] title:@"Bootstrap Operations" report:report document:document];
     [self logAndReportArray:bootstrapAPIs[@"service_names"] title:@"Service Names Found" report:report document:document];
+    [self logAndReportArray:bootstrapAPIs[@"service_calls"] title:@"Service Names at Call Sites" report:report document:document];
 
     // Phase 4: MIG Dispatcher and Handler Detection
     [document logInfoMessage:@"[MachIPCAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
@@ -171,6 +173,7 @@
     NSUInteger totalBootstrap = [bootstrapAPIs[@"bootstrap_ops"] count];
     NSUInteger totalHandlers = [migHandlers[@"dispatchers"] count] + [migHandlers[@"handlers"] count];
     NSUInteger totalServiceNames = [bootstrapAPIs[@"service_names"] count];
+    NSUInteger totalServiceCalls = [bootstrapAPIs[@"service_calls"] count];
 
     [report appendFormat:@"MIG Subsystems Found:        %lu\n", (unsigned long)totalSubsystems];
     [report appendFormat:@"Mach Port APIs Found:        %lu\n", (unsigned long)totalMachAPIs];
@@ -178,6 +181,7 @@
     [report appendFormat:@"  • Message Operations:      %lu\n", (unsigned long)[machAPIs[@"msg_ops"] count]];
     [report appendFormat:@"Bootstrap APIs Found:        %lu\n", (unsigned long)totalBootstrap];
     [report appendFormat:@"Service Names Found:         %lu\n", (unsigned long)totalServiceNames];
+    [report appendFormat:@"Service Call Sites:          %lu\n", (unsigned long)totalServiceCalls];
     [report appendFormat:@"MIG Handlers Found:          %lu\n", (unsigned long)totalHandlers];
     [report appendFormat:@"  • Dispatchers:             %lu\n", (unsigned long)[migHandlers[@"dispatchers"] count]];
     [report appendFormat:@"  • Message Handlers:        %lu\n\n", (unsigned long)[migHandlers[@"handlers"] count]];
@@ -188,6 +192,7 @@
     [document logInfoMessage:[NSString stringWithFormat:@"[MachIPCAnalyzer]   • Message Operations:      %lu", (unsigned long)[machAPIs[@"msg_ops"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[MachIPCAnalyzer] Bootstrap APIs Found:        %lu", (unsigned long)totalBootstrap]];
     [document logInfoMessage:[NSString stringWithFormat:@"[MachIPCAnalyzer] Service Names Found:         %lu", (unsigned long)totalServiceNames]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[MachIPCAnalyzer] Service Call Sites:          %lu", (unsigned long)totalServiceCalls]];
     [document logInfoMessage:[NSString stringWithFormat:@"[MachIPCAnalyzer] MIG Handlers Found:          %lu", (unsigned long)totalHandlers]];
     [document logInfoMessage:[NSString stringWithFormat:@"[MachIPCAnalyzer]   • Dispatchers:             %lu", (unsigned long)[migHandlers[@"dispatchers"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[MachIPCAnalyzer]   • Message Handlers:        %lu", (unsigned long)[migHandlers[@"handlers"] count]]];
@@ -430,9 +435,40 @@
         }
     }
 
+    // Recover the service name passed at each call site
+    NSMutableArray *serviceCalls = [NSMutableArray array];
+    NSDictionary *serviceArguments = @{
+        @"bootstrap_look_up": @1, @"bootstrap_look_up2": @1, @"bootstrap_check_in": @1,
+        @"bootstrap_check_in2": @1, @"bootstrap_register": @1, @"bootstrap_register2": @1,
+        @"xpc_connection_create_mach_service": @0
+    };
+
+    NSDictionary *index = SRKBuildImageIndex(file);
+    for (NSDictionary *callSite in SRKCallSitesForFunctions(file, index, serviceArguments.allKeys, 3)) {
+        NSString *function = callSite[@"function"];
+        NSString *service = SRKCallSiteStringArgument(callSite, [serviceArguments[function] unsignedIntegerValue]);
+
+        // Lookups talk to a service, check-ins and registrations vend one
+        NSString *role = @"uses";
+        if ([function hasPrefix:@"bootstrap_check_in"] || [function hasPrefix:@"bootstrap_register"]) {
+            role = @"vends";
+        } else if ([function isEqualToString:@"xpc_connection_create_mach_service"]) {
+            NSNumber *flags = SRKCallSiteValueArgument(callSite, 2);
+            if (flags && ([flags unsignedLongLongValue] & 1)) {
+                role = @"vends";    // XPC_CONNECTION_MACH_SERVICE_LISTENER
+            }
+        }
+
+        [serviceCalls addObject:@{
+            @"address": callSite[@"address"],
+            @"call": [NSString stringWithFormat:@"%@(\"%@\") [%@]", function, service ?: @"?", role]
+        }];
+    }
+
     return @{
         @"bootstrap_ops": bootstrapOps,
-        @"service_names": serviceNames
+        @"service_names": serviceNames,
+        @"service_calls": serviceCalls
     };
 }
 
@@ -513,7 +549,7 @@
         [document logInfoMessage:[NSString stringWithFormat:@"[MachIPCAnalyzer] %@: %lu", title, (unsigned long)items.count]];
 
         for (NSDictionary *item in items) {
-            NSString *value = item[@"function"] ?: item[@"service"] ?: item[@"info"];
+            NSString *value = item[@"function"] ?: item[@"call"] ?: item[@"service"] ?: item[@"info"];
             [report appendFormat:@"  [0x%llx] %@\n", [item[@"address"] unsignedLongLongValue], value];
             [document logInfoMessage:[NSString stringWithFormat:@"[MachIPCAnalyzer]   [0x%llx] %@",
                 [item[@"address"] unsignedLongLongValue], value]];
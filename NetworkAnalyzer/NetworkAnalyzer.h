@@ -24,10 +24,15 @@
  *
  * Automatically performs comprehensive network operation analysis:
  * - C socket API detection (socket, connect, bind, send, recv, etc.)
+ * - (host, port, protocol) endpoints rebuilt from the sockaddr, getaddrinfo
+ *   and nw_endpoint arguments at each connect/bind/sendto call site
  * - Objective-C network APIs (NSURLSession, NSURLConnection, CFNetwork)
+ * - Objective-C message sends resolved at objc_msgSend call sites
  * - Swift network APIs (URLSession, Network.framework)
  * - TLS/SSL detection (SecureTransport, OpenSSL)
  * - URL and IP address extraction from strings
+ * - URLs parsed and normalized; format-string URL templates ("%@/api/%d")
+ * - Threat intel blocklist matching of the extracted domains and IPs
  * - Protocol detection and analysis
  */
 @interface NetworkAnalyzer : NSObject <HopperTool>
@@ -40,6 +45,12 @@
  */
 - (void)analyzeNetwork:(nullable id)sender;
 
+/**
+ * Compiles the *.txt blocklists of SRKThreatIntelDirectory() into the
+ * memory-mapped file the analysis matches indicators against
+ */
+- (void)compileThreatIntel:(nullable id)sender;
+
 @end
 
 #pragma clang diagnostic pop
@@ -8,10 +8,23 @@
 @import Foundation;
 
 #import "NetworkAnalyzer.h"
+#import "SRKObjCMessages.h"
+#import "SRKLibraryCode.h"
+#import "SRKThreatIntel.h"
+#import "SRKEndpoints.h"
+#import "SRKProcedureMetrics.h"
+#import "SRKURLParser.h"
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "OCUnusedClassInspection"
 
+@interface NetworkAnalyzer ()
+/// Statically linked library procedures of the file being analyzed, left out of the results
+@property(strong, nonatomic, nullable) NSDictionary *libraryCode;
+/// Mapped threat intel blocklists, nil when none were compiled
+@property(strong, nonatomic, nullable) NSDictionary *threatIntel;
+@end
+
 @implementation NetworkAnalyzer
 
 #pragma mark - Plugin Initialization
@@ -68,6 +81,10 @@
         @{
             HPM_TITLE: @"Network Operations Analyzer",
             HPM_SELECTOR: NSStringFromSelector(@selector(analyzeNetwork:))
+        },
+        @{
+            HPM_TITLE: @"Compile Threat Intel Blocklists",
+            HPM_SELECTOR: NSStringFromSelector(@selector(compileThreatIntel:))
         }
     ];
 }
@@ -106,6 +123,15 @@
     [report appendFormat:@"Analysis Date: %@\n", [NSDate date]];
     [report appendString:@"\n"];
 
+    NSDictionary *imageIndex = SRKBuildImageIndex(file);
+    self.libraryCode = SRKIdentifyLibraryCode(file, imageIndex);
+    NSUInteger libraryProcedures = [self.libraryCode[@"procedures"] unsignedIntegerValue];
+    [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer] Library procedures skipped: %lu (%@)",
+                              (unsigned long)libraryProcedures, SRKDescribeLibraryCode(self.libraryCode)]];
+
+    // Mapping the compiled blocklists costs next to nothing, so intel matching always runs
+    self.threatIntel = SRKOpenThreatIntel(SRKThreatIntelDirectory());
+
     // Phase 1: C Socket API Detection
     [document logInfoMessage:@"[NetworkAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
     [document logInfoMessage:@"[NetworkAnalyzer] Phase 1: Detecting C socket APIs..."];
@@ -120,11 +146,20 @@
     [self logAndReportArray:cAPIs[@"dns_ops"] title:@"DNS Operations" report:report document:document];
     [self logAndReportArray:cAPIs[@"ssl_ops"] title:@"SSL/TLS Operations" report:report document:document];
 
+    NSArray *endpoints = [self recoverEndpoints:file index:imageIndex];
+    NSUInteger concreteEndpoints = [[endpoints valueForKeyPath:@"@sum.concrete"] unsignedIntegerValue];
+    [self logAndReportArray:endpoints title:@"Recovered Endpoints (host, port, protocol)" report:report document:document];
+    NSDictionary *procedureMetrics = SRKBuildProcedureMetrics(file, imageIndex);
+    SRKAppendProcedureAPIReport(report, file, SRKProceduresByAPICalls(procedureMetrics, imageIndex, @[@"api_network"],
+                                                                      self.libraryCode, 5),
+                                @"Procedures With The Most Network Calls");
+
     // Phase 2: Objective-C Network API Detection
     [document logInfoMessage:@"[NetworkAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
     [document logInfoMessage:@"[NetworkAnalyzer] Phase 2: Detecting Objective-C network APIs..."];
     [document logInfoMessage:@"[NetworkAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
-    NSDictionary *objcAPIs = [self findObjCNetworkAPIs:file];
+    NSDictionary *messageIndex = SRKBuildObjCMessageIndex(file, imageIndex);
+    NSDictionary *objcAPIs = [self findObjCNetworkAPIs:file messageIndex:messageIndex];
 
     [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n"];
     [report appendString:@"[2] OBJECTIVE-C NETWORK API DETECTION\n"];
@@ -134,6 +169,7 @@
     [self logAndReportArray:objcAPIs[@"nsurlconnection"] title:@"NSURLConnection APIs" report:report document:document];
     [self logAndReportArray:objcAPIs[@"cfnetwork"] title:@"CFNetwork APIs" report:report document:document];
     [self logAndReportArray:objcAPIs[@"nsstream"] title:@"NSStream APIs" report:report document:document];
+    [self logAndReportArray:objcAPIs[@"message_sends"] title:@"Resolved Message Sends" report:report document:document];
 
     // Phase 3: Swift Network API Detection
     [document logInfoMessage:@"[NetworkAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
@@ -158,17 +194,35 @@
     [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n"];
 
     [self logAndReportArray:networkStrings[@"urls"] title:@"URLs Found" report:report document:document];
+    [self logAndReportArray:networkStrings[@"url_templates"] title:@"URL Templates (normalized)" report:report document:document];
     [self logAndReportArray:networkStrings[@"ips"] title:@"IP Addresses" report:report document:document];
     [self logAndReportArray:networkStrings[@"domains"] title:@"Domain Names" report:report document:document];
     [self logAndReportArray:networkStrings[@"ports"] title:@"Port Numbers" report:report document:document];
 
+    // Phase 5: Threat Intel Matching
+    [document logInfoMessage:@"[NetworkAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
+    [document logInfoMessage:@"[NetworkAnalyzer] Phase 5: Matching indicators against threat intel..."];
+    [document logInfoMessage:@"[NetworkAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
+    NSArray *intelMatches = [self matchThreatIntel:networkStrings];
+
+    [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n"];
+    [report appendString:@"[5] THREAT INTEL MATCHES\n"];
+    [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n"];
+
+    if (!self.threatIntel) {
+        [report appendFormat:@"No compiled blocklists in %@\n\n", SRKThreatIntelDirectory()];
+    } else if (intelMatches.count == 0) {
+        [report appendString:@"✓ No extracted indicator is listed\n\n"];
+    }
+    [self logAndReportArray:intelMatches title:@"Listed Indicators" report:report document:document];
+
     // Summary
     [document logInfoMessage:@"[NetworkAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
-    [document logInfoMessage:@"[NetworkAnalyzer] [5] ANALYSIS SUMMARY"];
+    [document logInfoMessage:@"[NetworkAnalyzer] [6] ANALYSIS SUMMARY"];
     [document logInfoMessage:@"[NetworkAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
 
     [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n"];
-    [report appendString:@"[5] ANALYSIS SUMMARY\n"];
+    [report appendString:@"[6] ANALYSIS SUMMARY\n"];
     [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n"];
 
     NSUInteger totalCAPIs = [cAPIs[@"socket_ops"] count] + [cAPIs[@"dns_ops"] count] + [cAPIs[@"ssl_ops"] count];
@@ -182,33 +236,45 @@
     [report appendFormat:@"  • Socket Operations:       %lu\n", (unsigned long)[cAPIs[@"socket_ops"] count]];
     [report appendFormat:@"  • DNS Operations:          %lu\n", (unsigned long)[cAPIs[@"dns_ops"] count]];
     [report appendFormat:@"  • SSL/TLS Operations:      %lu\n", (unsigned long)[cAPIs[@"ssl_ops"] count]];
+    [report appendFormat:@"  • Endpoints Recovered:     %lu of %lu call sites\n", (unsigned long)concreteEndpoints,
+     (unsigned long)endpoints.count];
     [report appendFormat:@"Objective-C APIs Found:      %lu\n", (unsigned long)totalObjCAPIs];
     [report appendFormat:@"  • NSURLSession:            %lu\n", (unsigned long)[objcAPIs[@"nsurlsession"] count]];
     [report appendFormat:@"  • NSURLConnection:         %lu\n", (unsigned long)[objcAPIs[@"nsurlconnection"] count]];
     [report appendFormat:@"  • CFNetwork:               %lu\n", (unsigned long)[objcAPIs[@"cfnetwork"] count]];
     [report appendFormat:@"  • NSStream:                %lu\n", (unsigned long)[objcAPIs[@"nsstream"] count]];
+    [report appendFormat:@"  • Resolved Sends:          %lu\n", (unsigned long)[objcAPIs[@"message_sends"] count]];
     [report appendFormat:@"Swift Network APIs Found:    %lu\n", (unsigned long)totalSwiftAPIs];
     [report appendFormat:@"Network Strings Found:       %lu\n", (unsigned long)totalStrings];
     [report appendFormat:@"  • URLs:                    %lu\n", (unsigned long)[networkStrings[@"urls"] count]];
+    [report appendFormat:@"  • URL Templates:           %lu\n", (unsigned long)[networkStrings[@"url_templates"] count]];
     [report appendFormat:@"  • IP Addresses:            %lu\n", (unsigned long)[networkStrings[@"ips"] count]];
     [report appendFormat:@"  • Domain Names:            %lu\n", (unsigned long)[networkStrings[@"domains"] count]];
-    [report appendFormat:@"  • Port Numbers:            %lu\n\n", (unsigned long)[networkStrings[@"ports"] count]];
+    [report appendFormat:@"  • Port Numbers:            %lu\n", (unsigned long)[networkStrings[@"ports"] count]];
+    [report appendFormat:@"Threat Intel Matches:        %lu\n", (unsigned long)intelMatches.count];
+    [report appendFormat:@"Library Procedures Skipped:  %lu (%@)\n\n", (unsigned long)libraryProcedures,
+     SRKDescribeLibraryCode(self.libraryCode)];
 
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer] C Socket APIs Found:         %lu", (unsigned long)totalCAPIs]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • Socket Operations:       %lu", (unsigned long)[cAPIs[@"socket_ops"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • DNS Operations:          %lu", (unsigned long)[cAPIs[@"dns_ops"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • SSL/TLS Operations:      %lu", (unsigned long)[cAPIs[@"ssl_ops"] count]]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • Endpoints Recovered:     %lu of %lu call sites", (unsigned long)concreteEndpoints, (unsigned long)endpoints.count]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer] Objective-C APIs Found:      %lu", (unsigned long)totalObjCAPIs]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • NSURLSession:            %lu", (unsigned long)[objcAPIs[@"nsurlsession"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • NSURLConnection:         %lu", (unsigned long)[objcAPIs[@"nsurlconnection"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • CFNetwork:               %lu", (unsigned long)[objcAPIs[@"cfnetwork"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • NSStream:                %lu", (unsigned long)[objcAPIs[@"nsstream"] count]]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • Resolved Sends:          %lu", (unsigned long)[objcAPIs[@"message_sends"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer] Swift Network APIs Found:    %lu", (unsigned long)totalSwiftAPIs]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer] Network Strings Found:       %lu", (unsigned long)totalStrings]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • URLs:                    %lu", (unsigned long)[networkStrings[@"urls"] count]]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • URL Templates:           %lu", (unsigned long)[networkStrings[@"url_templates"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • IP Addresses:            %lu", (unsigned long)[networkStrings[@"ips"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • Domain Names:            %lu", (unsigned long)[networkStrings[@"domains"] count]]];
     [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   • Port Numbers:            %lu", (unsigned long)[networkStrings[@"ports"] count]]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer] Threat Intel Matches:        %lu", (unsigned long)intelMatches.count]];
+    [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer] Library Procedures Skipped:  %lu", (unsigned long)libraryProcedures]];
 
     [report appendString:@"══════════════════════════════════════════════════════════════════════\n"];
     [report appendString:@"                          END OF REPORT                               \n"];
@@ -226,18 +292,22 @@
     [report writeToFile:tmpPath atomically:YES encoding:NSUTF8StringEncoding error:&error];
 
     [document endWaiting];
+    self.libraryCode = nil;
+    self.threatIntel = nil;
 
     NSString *summary = [NSString stringWithFormat:
         @"Network Operations Analysis Complete\n\n"
         @"C APIs: %lu\n"
         @"Objective-C APIs: %lu\n"
         @"Swift APIs: %lu\n"
-        @"Network Strings: %lu\n\n"
+        @"Network Strings: %lu\n"
+        @"Threat Intel Matches: %lu\n\n"
         @"Full report saved to:\n%@",
         (unsigned long)totalCAPIs,
         (unsigned long)totalObjCAPIs,
         (unsigned long)totalSwiftAPIs,
         (unsigned long)totalStrings,
+        (unsigned long)intelMatches.count,
         tmpPath
     ];
 
@@ -292,7 +362,8 @@
             while (addr < endAddr) {
                 NSString *name = [file nameForVirtualAddress:addr];
 
-                if (name && name.length > 0) {
+                // Statically linked OpenSSL/curl procedures carry these names too
+                if (name && name.length > 0 && !SRKIsLibraryAddress(self.libraryCode, addr)) {
                     // Check socket operations
                     for (NSString *func in socketFunctions) {
                         if ([name containsString:func]) {
@@ -330,11 +401,31 @@
     };
 }
 
-- (NSDictionary *)findObjCNetworkAPIs:(NSObject<HPDisassembledFile> *)file {
+/// Endpoints rebuilt at connect/bind/sendto/getaddrinfo/nw_endpoint_create_host call sites, grouped by procedure
+- (NSArray *)recoverEndpoints:(NSObject<HPDisassembledFile> *)file index:(NSDictionary *)index {
+    NSMutableArray *items = [NSMutableArray array];
+    for (NSDictionary *endpoint in SRKNetworkEndpoints(file, index)) {
+        Address procedure = [endpoint[@"procedure"] unsignedLongLongValue];
+        if (SRKIsLibraryAddress(self.libraryCode, procedure)) continue;
+
+        NSString *procedureName = [file nameForVirtualAddress:procedure];
+        if (procedureName.length == 0) procedureName = [NSString stringWithFormat:@"sub_%llx", procedure];
+        [items addObject:@{
+            @"address": endpoint[@"address"],
+            @"endpoint": [NSString stringWithFormat:@"%@ → %@ (in %@)", endpoint[@"function"],
+                          SRKEndpointDescription(endpoint), procedureName],
+            @"concrete": @(SRKEndpointIsConcrete(endpoint))
+        }];
+    }
+    return items;
+}
+
+- (NSDictionary *)findObjCNetworkAPIs:(NSObject<HPDisassembledFile> *)file messageIndex:(NSDictionary *)messageIndex {
     NSMutableArray *nsurlsession = [NSMutableArray array];
     NSMutableArray *nsurlconnection = [NSMutableArray array];
     NSMutableArray *cfnetwork = [NSMutableArray array];
     NSMutableArray *nsstream = [NSMutableArray array];
+    NSMutableArray *messageSends = [NSMutableArray array];
 
     NSArray *urlSessionMethods = @[
         @"NSURLSession", @"dataTaskWithURL", @"dataTaskWithRequest",
@@ -368,7 +459,7 @@
             while (addr < endAddr) {
                 NSString *name = [file nameForVirtualAddress:addr];
 
-                if (name && name.length > 0) {
+                if (name && name.length > 0 && !SRKIsLibraryAddress(self.libraryCode, addr)) {
                     // Check NSURLSession
                     for (NSString *method in urlSessionMethods) {
                         if ([name containsString:method]) {
@@ -407,11 +498,33 @@
         }
     }
 
+    // Message sends resolved at objc_msgSend call sites
+    NSArray *networkClasses = @[
+        @"NSURLSession", @"NSURLConnection", @"NSURLRequest", @"NSMutableURLRequest",
+        @"NSInputStream", @"NSOutputStream", @"NSStream", @"NSHost", @"NSNetService"
+    ];
+    NSMutableArray *networkSelectors = [NSMutableArray arrayWithArray:urlSessionMethods];
+    [networkSelectors addObjectsFromArray:urlConnectionMethods];
+    [networkSelectors addObjectsFromArray:streamMethods];
+
+    for (NSDictionary *send in messageIndex[@"sends"]) {
+        BOOL isNetworkSend = [networkClasses containsObject:send[@"class"] ?: @""];
+        for (NSString *selector in networkSelectors) {
+            if (isNetworkSend) break;
+            isNetworkSend = [send[@"selector"] hasPrefix:selector];
+        }
+
+        if (isNetworkSend && !SRKIsLibraryAddress(self.libraryCode, [send[@"address"] unsignedLongLongValue])) {
+            [messageSends addObject:@{@"address": send[@"address"], @"send": SRKObjCSendDescription(send)}];
+        }
+    }
+
     return @{
         @"nsurlsession": nsurlsession,
         @"nsurlconnection": nsurlconnection,
         @"cfnetwork": cfnetwork,
-        @"nsstream": nsstream
+        @"nsstream": nsstream,
+        @"message_sends": messageSends
     };
 }
 
@@ -433,7 +546,7 @@
             while (addr < endAddr) {
                 NSString *name = [file nameForVirtualAddress:addr];
 
-                if (name && name.length > 0) {
+                if (name && name.length > 0 && !SRKIsLibraryAddress(self.libraryCode, addr)) {
                     // Skip non-Swift symbols
                     if ([name containsString:@"objc_"] || [name containsString:@"cfstring"] ||
                         [name hasPrefix:@"-["] || [name hasPrefix:@"+["] ||
@@ -468,6 +581,9 @@
     NSMutableArray *ips = [NSMutableArray array];
     NSMutableArray *domains = [NSMutableArray array];
     NSMutableArray *ports = [NSMutableArray array];
+    NSMutableArray *templates = [NSMutableArray array];
+    NSSet<NSString *> *urlSchemes = [NSSet setWithArray:@[@"http", @"https", @"ws", @"wss", @"ftp", @"ftps"]];
+    NSSet<NSString *> *webExtensions = [NSSet setWithArray:@[@"php", @"asp", @"aspx", @"jsp", @"cgi", @"html", @"json"]];
 
     // Scan all string sections
     for (NSObject<HPSegment> *segment in file.segments) {
@@ -482,12 +598,26 @@
                 while (addr < endAddr) {
                     NSString *str = [self readStringAtAddress:addr file:file maxLength:512];
 
-                    if (str && str.length > 3) {
-                        // URLs (http://, https://, ws://, wss://, ftp://)
-                        if ([str hasPrefix:@"http://"] || [str hasPrefix:@"https://"] ||
-                            [str hasPrefix:@"ws://"] || [str hasPrefix:@"wss://"] ||
-                            [str hasPrefix:@"ftp://"] || [str hasPrefix:@"ftps://"]) {
-                            [urls addObject:@{@"address": @(addr), @"url": str}];
+                    if (str && str.length > 3 && !SRKIsLibraryOnlyReference(file, self.libraryCode, addr)) {
+                        // URLs (http://, https://, ws://, wss://, ftp://) and format-string URL templates
+                        NSDictionary *components = [str containsString:@"/"] ? SRKURLComponents(str, YES) : nil;
+                        NSString *scheme = components[@"scheme"];
+                        if (scheme && [urlSchemes containsObject:scheme]) {
+                            [urls addObject:@{@"address": @(addr), @"url": str, @"normalized": components[@"normalized"],
+                                              @"host": components[@"host"] ?: @""}];
+                        }
+                        if ([components[@"template"] boolValue] && components[@"host"]) {
+                            // A templated host without a scheme ("%@/%@") is as likely a file path
+                            NSString *host = components[@"host"];
+                            NSString *lastSegment = [components[@"path_segments"] lastObject];
+                            BOOL webShaped = scheme || ![host hasPrefix:@"%"] || components[@"query"] ||
+                                             [components[@"path_segments"] containsObject:@"api"] ||
+                                             (lastSegment.pathExtension.length > 0 &&
+                                              [webExtensions containsObject:lastSegment.pathExtension.lowercaseString]);
+                            if (webShaped) {
+                                [templates addObject:@{@"address": @(addr), @"template": components[@"normalized"],
+                                                       @"format": str}];
+                            }
                         }
 
                         // IP addresses (simple pattern: X.X.X.X)
@@ -540,12 +670,56 @@
 
     return @{
         @"urls": urls,
+        @"url_templates": templates,
         @"ips": ips,
         @"domains": domains,
         @"ports": ports
     };
 }
 
+#pragma mark - Threat Intel
+
+/// Extracted IPs, domains and URL hosts listed by the compiled blocklists
+- (NSArray *)matchThreatIntel:(NSDictionary *)networkStrings {
+    NSMutableArray *matches = [NSMutableArray array];
+    if (!self.threatIntel) return matches;
+
+    NSArray *candidates = @[
+        @[networkStrings[@"ips"] ?: @[], @"ip"],
+        @[networkStrings[@"domains"] ?: @[], @"domain"],
+        @[networkStrings[@"urls"] ?: @[], @"url"]
+    ];
+    for (NSArray *candidate in candidates) {
+        for (NSDictionary *item in candidate[0]) {
+            NSDictionary *match = SRKThreatIntelMatch(self.threatIntel, item[candidate[1]]);
+            if (!match) continue;
+
+            [matches addObject:@{
+                @"address": item[@"address"],
+                @"intel": [NSString stringWithFormat:@"%@ (listed as %@ by %@)", item[candidate[1]], match[@"match"],
+                           match[@"source"]]
+            }];
+        }
+    }
+    return matches;
+}
+
+- (void)compileThreatIntel:(nullable id)sender {
+    NSString *directory = SRKThreatIntelDirectory();
+    [[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES attributes:nil error:nil];
+
+    NSDictionary *counts = nil;
+    NSError *error = nil;
+    if (SRKCompileThreatIntel(directory, &counts, &error)) {
+        [self.services logMessage:[NSString stringWithFormat:
+            @"[NetworkAnalyzer] Compiled %@ domains and %@ address ranges from %@ blocklists in %@",
+            counts[@"domains"], counts[@"ranges"], counts[@"sources"], directory]];
+    } else {
+        [self.services logMessage:[NSString stringWithFormat:@"[NetworkAnalyzer] Could not compile the blocklists in %@: %@",
+                                   directory, error.localizedDescription]];
+    }
+}
+
 #pragma mark - Helper Methods
 
 - (void)logAndReportArray:(NSArray *)items title:(NSString *)title report:(NSMutableString *)report document:(NSObject<HPDocument> *)document {
@@ -555,7 +729,8 @@
 
         for (NSDictionary *item in items) {
             NSString *value = item[@"function"] ?: item[@"method"] ?: item[@"api"] ?: item[@"symbol"] ?:
-                             item[@"url"] ?: item[@"ip"] ?: item[@"domain"] ?: item[@"port"];
+                             item[@"send"] ?: item[@"url"] ?: item[@"ip"] ?: item[@"domain"] ?: item[@"port"] ?: item[@"intel"] ?:
+                             item[@"endpoint"] ?: item[@"template"];
             [report appendFormat:@"  [0x%llx] %@\n", [item[@"address"] unsignedLongLongValue], value];
             [document logInfoMessage:[NSString stringWithFormat:@"[NetworkAnalyzer]   [0x%llx] %@",
                 [item[@"address"] unsignedLongLongValue], value]];
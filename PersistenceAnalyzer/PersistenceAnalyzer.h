@@ -9,6 +9,7 @@
  - Kernel Extensions (kext loading, IOKit)
  - Browser Extensions (Safari, Chrome, Firefox)
  - Dylib Injection (DYLD_INSERT_LIBRARIES, interposing)
+ - Early Execution (initializers and +load methods run before main)
 
  Copyright (c) 2025 Zeyad Azima. All rights reserved.
  */
@@ -30,6 +31,7 @@
  * - Browser Extensions: Safari/Chrome/Firefox extension paths
  * - Dylib Injection: DYLD environment variables, dylib interposing
  * - System Modification: rc.common, sudoers, periodic scripts
+ * - Early Execution: __mod_init_func, __init_offsets, +load, C++ static initializers
  */
 @interface PersistenceAnalyzer : NSObject <HopperTool>
 
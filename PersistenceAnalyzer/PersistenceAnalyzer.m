@@ -8,6 +8,8 @@
 @import Foundation;
 
 #import "PersistenceAnalyzer.h"
+#import "SRKInitializers.h"
+#import "SRKPathClassifier.h"
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "OCUnusedClassInspection"
@@ -132,8 +134,8 @@
         [report appendFormat:@"Launch Agent/Daemon Paths: %lu\n\n", (unsigned long)launchPaths.count];
         [document logInfoMessage:[NSString stringWithFormat:@"[PersistenceAnalyzer] ⚠️  Launch Paths: %lu", (unsigned long)launchPaths.count]];
         for (NSDictionary *op in launchPaths) {
-            [report appendFormat:@"  [0x%llx] [%@] \"%@\"\n",
-                [op[@"address"] unsignedLongLongValue], op[@"type"], op[@"string"]];
+            [report appendFormat:@"  [0x%llx] [%@, %@] \"%@\"\n",
+                [op[@"address"] unsignedLongLongValue], op[@"type"], op[@"severity"], op[@"string"]];
             NSString *displayStr = [op[@"string"] length] > 60 ?
                 [[op[@"string"] substringToIndex:60] stringByAppendingString:@"..."] : op[@"string"];
             [document logInfoMessage:[NSString stringWithFormat:@"[PersistenceAnalyzer]   [0x%llx] %@",
@@ -336,6 +338,17 @@
         [document logInfoMessage:@"[PersistenceAnalyzer] ✓ No Dylib Injection persistence"];
     }
 
+    // Phase 7: Early Execution
+    [document logInfoMessage:@"[PersistenceAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
+    [document logInfoMessage:@"[PersistenceAnalyzer] Phase 7: Enumerating Initializers & +load Methods..."];
+    [document logInfoMessage:@"[PersistenceAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
+    // Code run by dyld before main is where installers re-arm their persistence
+    NSDictionary *earlyExecution = SRKEarlyExecutionSummary(file, SRKBuildImageIndex(file));
+    NSArray *initializers = earlyExecution[@"roots"];
+    for (NSString *line in SRKAppendEarlyExecutionReport(report, earlyExecution, 7)) {
+        [document logInfoMessage:[NSString stringWithFormat:@"[PersistenceAnalyzer] %@", line]];
+    }
+
     // Summary
     NSUInteger totalFindings = totalLaunch + totalLogin + totalCron + totalKext + browserExt.count + totalDylib;
 
@@ -359,7 +372,8 @@
     [report appendFormat:@"  - Browser Extensions: %lu\n", (unsigned long)browserExt.count];
     [report appendFormat:@"  - Dylib Injection: %lu\n", (unsigned long)totalDylib];
     [report appendFormat:@"    • Environment: %lu\n", (unsigned long)dylibEnv.count];
-    [report appendFormat:@"    • Interposing: %lu\n\n", (unsigned long)interposing.count];
+    [report appendFormat:@"    • Interposing: %lu\n", (unsigned long)interposing.count];
+    [report appendFormat:@"  - Early Execution Roots: %lu (not counted)\n\n", (unsigned long)initializers.count];
 
     [document logInfoMessage:@"[PersistenceAnalyzer] ══════════════════════════════════════════════════════════════════════"];
     [document logInfoMessage:@"[PersistenceAnalyzer] SUMMARY"];
@@ -475,14 +489,8 @@
         @"SMLoginItemSetEnabled"
     ];
 
-    // Launch Agent/Daemon paths
-    NSArray *launchPathPatterns = @[
-        @"/Library/LaunchAgents", @"/Library/LaunchDaemons",
-        @"~/Library/LaunchAgents", @"/System/Library/LaunchAgents",
-        @"/System/Library/LaunchDaemons",
-        @"LaunchAgents/", @"LaunchDaemons/",
-        @".plist"
-    ];
+    // Launch Agent/Daemon locations come from the shared sensitive path list
+    NSDictionary *classifier = SRKLoadPathClassifier(SRKDefaultPathClassifierFiles([NSBundle bundleForClass:[self class]]));
 
     // Plist manipulation
     NSArray *plistPatterns = @[
@@ -492,7 +500,7 @@
     ];
 
     [self scanStringsForPatterns:smJobPatterns inFile:file results:smJobAPIs maxResults:50];
-    [self scanForLaunchPaths:file results:launchPaths pathPatterns:launchPathPatterns];
+    [self scanForLaunchPaths:file results:launchPaths classifier:classifier];
     [self scanStringsForPatterns:plistPatterns inFile:file results:plistAPIs maxResults:80];
 
     return @{
@@ -691,7 +699,7 @@
 
 - (void)scanForLaunchPaths:(NSObject<HPDisassembledFile> *)file
                    results:(NSMutableArray *)results
-              pathPatterns:(NSArray *)pathPatterns {
+                classifier:(NSDictionary *)classifier {
     for (NSObject<HPSegment> *segment in file.segments) {
         if (![segment.segmentName isEqualToString:@"__TEXT"] &&
             ![segment.segmentName isEqualToString:@"__DATA"]) continue;
@@ -709,20 +717,23 @@
                     NSString *str = [self readStringAtAddress:addr file:file maxLength:512];
 
                     if (str && str.length >= 5) {
-                        for (NSString *pathPattern in pathPatterns) {
-                            if ([str containsString:pathPattern]) {
-                                NSString *type = @"Path";
-                                if ([str containsString:@"LaunchAgents"]) type = @"LaunchAgent";
-                                else if ([str containsString:@"LaunchDaemons"]) type = @"LaunchDaemon";
-                                else if ([str containsString:@".plist"]) type = @"Plist";
-
-                                [results addObject:@{
-                                    @"address": @(addr),
-                                    @"type": type,
-                                    @"string": str
-                                }];
-                                break;
-                            }
+                        NSDictionary *match = SRKClassifyPath(classifier, str);
+                        NSString *category = match[@"category"];
+                        NSString *type = nil;
+                        if ([category isEqualToString:@"persistence.launch_agent"]) type = @"LaunchAgent";
+                        else if ([category isEqualToString:@"persistence.launch_daemon"]) type = @"LaunchDaemon";
+                        // Fragments joined to a prefix at run time ("LaunchAgents/%@.plist")
+                        else if ([str containsString:@"LaunchAgents/"]) type = @"LaunchAgent";
+                        else if ([str containsString:@"LaunchDaemons/"]) type = @"LaunchDaemon";
+                        else if ([str containsString:@".plist"]) type = @"Plist";
+
+                        if (type) {
+                            [results addObject:@{
+                                @"address": @(addr),
+                                @"type": type,
+                                @"severity": match[@"severity"] ?: @"medium",
+                                @"string": str
+                            }];
                         }
                         addr += str.length + 1;
                     } else {
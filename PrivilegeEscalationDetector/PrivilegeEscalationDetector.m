@@ -14,6 +14,7 @@
  */
 
 #import "PrivilegeEscalationDetector.h"
+#import "SRKIOKit.h"
 
 @implementation PrivilegeEscalationDetector
 
@@ -521,11 +522,15 @@
     [self scanStringsForPatterns:vulnPatterns inFile:file results:vulnerabilityAPIs maxResults:100];
     [self scanStringsForPatterns:bypassPatterns inFile:file results:bypassAPIs maxResults:100];
 
+    // Kernel attack surface reached from user space
+    NSDictionary *userClients = SRKIOKitUserClients(file, SRKBuildImageIndex(file));
+
     return @{
         @"exploit": [exploitAPIs copy],
         @"corruption": [memCorruptAPIs copy],
         @"vulnerability": [vulnerabilityAPIs copy],
-        @"bypass": [bypassAPIs copy]
+        @"bypass": [bypassAPIs copy],
+        @"user_clients": userClients
     };
 }
 
@@ -602,6 +607,8 @@
     }
     total += bypassAPIs.count;
 
+    SRKIOKitAppendReport(report, results[@"user_clients"], @"⚠️  Kernel user clients reached - external method selectors per client");
+
     if (total == 0) {
         [report appendString:@"✓ No kernel exploit patterns detected\n\n"];
     }
@@ -8,6 +8,7 @@
  - Mach-based injection (task_for_pid, mach_port, vm_* operations)
  - Process manipulation (ptrace, anti-debugging)
  - Privilege escalation patterns
+ - Early execution (initializers and +load methods run before main)
 
  Copyright (c) 2025 Zeyad Azima. All rights reserved.
  */
@@ -30,6 +31,7 @@
  * - Mach injection vectors (task_for_pid, thread_create, vm_*)
  * - Ptrace and debugging operations
  * - Privilege escalation (setuid, Authorization*, SMJobBless)
+ * - Early execution roots (__mod_init_func, __init_offsets, +load, C++ initializers)
  */
 @interface ProcessInjectionAnalyzer : NSObject <HopperTool>
 
@@ -8,6 +8,16 @@
 @import Foundation;
 
 #import "ProcessInjectionAnalyzer.h"
+#import "SRKObjCMessages.h"
+#import "SRKInitializers.h"
+#import "SRKProcedureMetrics.h"
+
+@interface ProcessInjectionAnalyzer ()
+/// Symbol / procedure index of the file being analyzed, built once per run
+@property(strong, nonatomic, nullable) NSDictionary *imageIndex;
+/// Per-procedure metrics table of the file being analyzed, built once per run
+@property(strong, nonatomic, nullable) NSDictionary *procedureMetrics;
+@end
 
 #pragma clang diagnostic push
 #pragma ide diagnostic ignored "OCUnusedClassInspection"
@@ -88,6 +98,8 @@
     }
 
     [document beginToWait:@"Analyzing Process & Code Injection..."];
+    self.imageIndex = SRKBuildImageIndex(file);
+    self.procedureMetrics = SRKBuildProcedureMetrics(file, self.imageIndex);
 
     NSMutableString *report = [NSMutableString string];
 
@@ -172,6 +184,10 @@
         [document logInfoMessage:@"[ProcessInjectionAnalyzer] ⚠️  No Mach injection vectors detected"];
     }
     [report appendString:@"\n"];
+    // An injector keeps its task, VM and spawn calls together
+    SRKAppendProcedureAPIReport(report, file, SRKProceduresByAPICalls(self.procedureMetrics, self.imageIndex,
+                                                                      @[@"api_memory", @"api_process"], nil, 5),
+                                @"Procedures With The Most Memory / Process Calls");
 
     // Phase 4: Ptrace & Debugging
     [document logInfoMessage:@"[ProcessInjectionAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
@@ -219,6 +235,17 @@
     }
     [report appendString:@"\n"];
 
+    // Phase 6: Early Execution
+    [document logInfoMessage:@"[ProcessInjectionAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
+    [document logInfoMessage:@"[ProcessInjectionAnalyzer] Phase 6: Enumerating Initializers & +load Methods..."];
+    [document logInfoMessage:@"[ProcessInjectionAnalyzer] ━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━"];
+    // Injectors loaded through DYLD_INSERT_LIBRARIES do their work from these
+    NSDictionary *earlyExecution = SRKEarlyExecutionSummary(file, self.imageIndex);
+    NSArray *initializers = earlyExecution[@"roots"];
+    for (NSString *line in SRKAppendEarlyExecutionReport(report, earlyExecution, 6)) {
+        [document logInfoMessage:[NSString stringWithFormat:@"[ProcessInjectionAnalyzer] %@", line]];
+    }
+
     // Summary
     NSUInteger totalFindings = processCreation.count + dynamicLoading.count + machInjection.count +
                                debugging.count + privEsc.count;
@@ -231,7 +258,8 @@
     [report appendFormat:@"  - Dynamic Library Loading: %lu\n", (unsigned long)dynamicLoading.count];
     [report appendFormat:@"  - Mach Injection Vectors: %lu\n", (unsigned long)machInjection.count];
     [report appendFormat:@"  - Ptrace/Debugging: %lu\n", (unsigned long)debugging.count];
-    [report appendFormat:@"  - Privilege Escalation: %lu\n\n", (unsigned long)privEsc.count];
+    [report appendFormat:@"  - Privilege Escalation: %lu\n", (unsigned long)privEsc.count];
+    [report appendFormat:@"  - Early Execution Roots: %lu (not counted)\n\n", (unsigned long)initializers.count];
 
     [document logInfoMessage:@"[ProcessInjectionAnalyzer] ══════════════════════════════════════════════════════════════════════"];
     [document logInfoMessage:@"[ProcessInjectionAnalyzer] SUMMARY"];
@@ -304,6 +332,8 @@
     NSError *error = nil;
     [report writeToFile:tmpPath atomically:YES encoding:NSUTF8StringEncoding error:&error];
 
+    self.imageIndex = nil;
+    self.procedureMetrics = nil;
     [document endWaiting];
 
     // Show summary popup
@@ -388,6 +418,35 @@
         if (results.count > 100) break;
     }
 
+    // NSTask / NSWorkspace sends resolved at objc_msgSend call sites
+    NSDictionary *messageIndex = SRKBuildObjCMessageIndex(file, self.imageIndex);
+    NSArray *processSelectors = @[
+        @"launch", @"launchAndReturnError:", @"launchedTaskWithLaunchPath:arguments:",
+        @"launchedTaskWithExecutableURL:arguments:error:terminationHandler:",
+        @"setLaunchPath:", @"setExecutableURL:", @"setArguments:",
+        @"launchApplication:", @"openApplicationAtURL:configuration:completionHandler:",
+        @"openURL:", @"openFile:"
+    ];
+
+    // The selectors are common words, so a send to any other known class is not a process launch
+    NSSet<NSString *> *processClasses = [NSSet setWithArray:@[@"NSTask", @"NSWorkspace"]];
+    processClasses = [processClasses setByAddingObjectsFromSet:SRKObjCImageSubclasses(file, processClasses)];
+
+    for (NSString *selector in processSelectors) {
+        for (NSDictionary *send in SRKObjCSendsForSelector(messageIndex, selector)) {
+            if (results.count > 100) break;
+            if (send[@"class"] && ![processClasses containsObject:send[@"class"]]) continue;
+            [results addObject:@{@"address": send[@"address"], @"string": SRKObjCSendDescription(send)}];
+        }
+    }
+    for (NSString *className in [processClasses.allObjects sortedArrayUsingSelector:@selector(compare:)]) {
+        for (NSDictionary *send in SRKObjCSendsForClass(messageIndex, className)) {
+            if (results.count > 100) break;
+            if ([processSelectors containsObject:send[@"selector"]]) continue;
+            [results addObject:@{@"address": send[@"address"], @"string": SRKObjCSendDescription(send)}];
+        }
+    }
+
     return [results copy];
 }
 
@@ -24,6 +24,7 @@
  *
  * Automatically detects rootkit techniques and kernel-level malware:
  * - Kernel Extension Loading: kextload, IOKit services, kernel modules
+ * - Kext Images: kmod_info, __PRELINK_INFO and IOKit personalities of kexts/kernelcaches
  * - System Call Hooking: syscall table manipulation, sysent hooking
  * - Function Hooking: Method swizzling, DYLD interposing, inline hooks
  * - Kernel Memory Access: kernel memory read/write, DKOM techniques
@@ -14,6 +14,15 @@
  */
 
 #import "RootkitDetector.h"
+#import "SRKIOKit.h"
+#import "SRKPointerTables.h"
+#import "SRKSwizzling.h"
+#import "SRKTrampolines.h"
+
+@interface RootkitDetector ()
+/// Symbol / procedure index of the file being analyzed, built once per run
+@property(strong, nonatomic, nullable) NSDictionary *imageIndex;
+@end
 
 @implementation RootkitDetector
 
@@ -99,6 +108,7 @@
     [report appendFormat:@"Analysis Date: %@\n\n", [NSDate date]];
 
     NSUInteger totalDetections = 0;
+    self.imageIndex = SRKBuildImageIndex(file);
 
     // Phase 1: Kernel Extension Detection
     [document logInfoMessage:@"[RootkitDetector] Phase 1: Analyzing kernel extension APIs..."];
@@ -186,6 +196,8 @@
     [document logInfoMessage:[NSString stringWithFormat:@"[RootkitDetector] Privilege Escalation: %lu", (unsigned long)privescCount]];
     [document logInfoMessage:[NSString stringWithFormat:@"[RootkitDetector] Report saved to: %@", reportPath]];
     [document logInfoMessage:@"══════════════════════════════════════════════════════"];
+
+    self.imageIndex = nil;
 }
 
 #pragma mark - Phase 1: Kernel Extension Detection
@@ -258,11 +270,19 @@
     [self scanStringsForPatterns:kernelPatterns inFile:file results:kernelAPIs maxResults:100];
     [self scanStringsForPatterns:pathPatterns inFile:file results:kextPaths maxResults:100];
 
+    // Which user clients are opened and which external methods they are sent
+    NSDictionary *userClients = SRKIOKitUserClients(file, self.imageIndex);
+
+    // The binary itself may be a kext or a kernelcache
+    NSArray *kextImages = [self analyzeKextImages:file document:document];
+
     return @{
         @"kext": [kextAPIs copy],
         @"iokit": [iokitAPIs copy],
         @"kernel": [kernelAPIs copy],
-        @"paths": [kextPaths copy]
+        @"paths": [kextPaths copy],
+        @"user_clients": userClients,
+        @"kext_images": kextImages
     };
 }
 
@@ -309,6 +329,8 @@
     }
     total += iokitAPIs.count;
 
+    SRKIOKitAppendReport(report, results[@"user_clients"], @"External method selectors called per user client");
+
     [report appendFormat:@"Kernel-Level APIs: %lu\n", (unsigned long)kernelAPIs.count];
     if (kernelAPIs.count > 0) {
         [report appendString:@"  Kernel task operations detected - direct kernel interaction\n"];
@@ -339,6 +361,31 @@
     }
     total += kextPaths.count;
 
+    NSArray *kextImages = results[@"kext_images"];
+    if (kextImages.count > 0) {
+        [report appendFormat:@"Kext Images: %lu\n", (unsigned long)kextImages.count];
+        [report appendString:@"  Binary is a kernel extension or kernelcache\n"];
+        for (NSDictionary *kext in [kextImages subarrayWithRange:NSMakeRange(0, MIN(50, kextImages.count))]) {
+            [report appendFormat:@"  • %@ %@\n", kext[@"bundle_id"] ?: @"(unknown)", kext[@"version"] ?: @""];
+            if (kext[@"load_address"]) {
+                [report appendFormat:@"      Load Address: 0x%llx\n", [kext[@"load_address"] unsignedLongLongValue]];
+            }
+            if (kext[@"start"]) {
+                [report appendFormat:@"      Start: 0x%llx %@\n", [kext[@"start"] unsignedLongLongValue], kext[@"start_name"] ?: @""];
+            }
+            if (kext[@"stop"]) {
+                [report appendFormat:@"      Stop:  0x%llx %@\n", [kext[@"stop"] unsignedLongLongValue], kext[@"stop_name"] ?: @""];
+            }
+            for (NSString *provider in kext[@"providers"]) {
+                [report appendFormat:@"      Personality: %@\n", provider];
+            }
+        }
+        if (kextImages.count > 50) {
+            [report appendFormat:@"  ... and %lu more\n", (unsigned long)(kextImages.count - 50)];
+        }
+        [report appendString:@"\n"];
+    }
+
     if (total == 0) {
         [report appendString:@"✓ No kernel extension operations detected\n\n"];
     }
@@ -346,6 +393,223 @@
     return total;
 }
 
+#pragma mark - Phase 1: Kext Image Analysis
+
+// sizeof(kmod_info_t) on 64-bit, the structure is declared with #pragma pack(4)
+#define KMOD_INFO_SIZE          196
+#define KMOD_INFO_NAME_OFFSET   16
+#define KMOD_INFO_VERSION_OFFSET 80
+#define KMOD_INFO_START_OFFSET  180
+#define KMOD_INFO_STOP_OFFSET   188
+#define KMOD_MAX_NAME           64
+
+- (NSArray *)analyzeKextImages:(NSObject<HPDisassembledFile> *)file
+                      document:(NSObject<HPDocument> *)document {
+    NSMutableArray *entries = [NSMutableArray array];
+
+    // Kernelcache: one entry per prelinked kext
+    NSDictionary *prelinkInfo = [self prelinkInfoDictionary:file];
+    for (id entry in prelinkInfo[@"_PrelinkInfoDictionary"]) {
+        if ([entry isKindOfClass:[NSDictionary class]]) {
+            [entries addObject:entry];
+        }
+    }
+
+    // Standalone kext: its own kmod_info
+    if (entries.count == 0) {
+        for (NSString *symbol in @[@"_kmod_info", @"kmod_info"]) {
+            Address kmodInfo = [file findVirtualAddressNamed:symbol];
+            if (kmodInfo != BAD_ADDRESS && kmodInfo != 0) {
+                [entries addObject:@{@"_PrelinkKmodInfo": @(kmodInfo)}];
+                break;
+            }
+        }
+    }
+
+    if (entries.count == 0) {
+        return @[];
+    }
+
+    [document logInfoMessage:[NSString stringWithFormat:@"[RootkitDetector] Parsing %lu kext images...", (unsigned long)entries.count]];
+
+    // Snapshot the mapped data so the kexts can be parsed off the main thread
+    NSMutableArray *segments = [NSMutableArray array];
+    for (NSObject<HPSegment> *segment in file.segments) {
+        NSData *data = segment.mappedData;
+        if (data.length > 0) {
+            [segments addObject:@{@"start": @(segment.startAddress), @"data": data}];
+        }
+    }
+
+    NSMutableArray *kexts = [NSMutableArray arrayWithCapacity:entries.count];
+    for (NSUInteger i = 0; i < entries.count; i++) {
+        [kexts addObject:[NSNull null]];
+    }
+
+    dispatch_apply(entries.count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        NSMutableDictionary *kext = [self parseKextEntry:entries[i] segments:segments];
+        @synchronized (kexts) {
+            kexts[i] = kext;
+        }
+    });
+
+    // Routine pointers may still carry chained-fixup bits, decode and name them here
+    for (NSMutableDictionary *kext in kexts) {
+        for (NSString *key in @[@"start", @"stop"]) {
+            NSNumber *raw = kext[key];
+            if (!raw) continue;
+
+            Address routine = SRKDecodePointer(file, raw.unsignedLongLongValue);
+            if (routine == 0) {
+                [kext removeObjectForKey:key];
+                continue;
+            }
+
+            kext[key] = @(routine);
+            NSString *name = [file nameForVirtualAddress:routine];
+            if (name) {
+                kext[[key stringByAppendingString:@"_name"]] = name;
+            }
+        }
+    }
+
+    return [kexts copy];
+}
+
+- (NSMutableDictionary *)parseKextEntry:(NSDictionary *)entry segments:(NSArray *)segments {
+    NSMutableDictionary *kext = [NSMutableDictionary dictionary];
+
+    if ([entry[@"CFBundleIdentifier"] isKindOfClass:[NSString class]]) {
+        kext[@"bundle_id"] = entry[@"CFBundleIdentifier"];
+    }
+    if ([entry[@"CFBundleVersion"] isKindOfClass:[NSString class]]) {
+        kext[@"version"] = entry[@"CFBundleVersion"];
+    }
+    if ([entry[@"_PrelinkExecutableLoadAddr"] isKindOfClass:[NSNumber class]]) {
+        kext[@"load_address"] = entry[@"_PrelinkExecutableLoadAddr"];
+    }
+
+    NSNumber *kmodInfo = entry[@"_PrelinkKmodInfo"];
+    if ([kmodInfo isKindOfClass:[NSNumber class]] && kmodInfo.unsignedLongLongValue != 0) {
+        NSData *data = [self bytesAtAddress:kmodInfo.unsignedLongLongValue length:KMOD_INFO_SIZE segments:segments];
+        if (data.length == KMOD_INFO_SIZE) {
+            const uint8_t *bytes = data.bytes;
+            kext[@"kmod_info"] = kmodInfo;
+
+            if (!kext[@"bundle_id"]) {
+                const char *name = (const char *)bytes + KMOD_INFO_NAME_OFFSET;
+                kext[@"bundle_id"] = [[NSString alloc] initWithBytes:name length:strnlen(name, KMOD_MAX_NAME) encoding:NSUTF8StringEncoding];
+            }
+            if (!kext[@"version"]) {
+                const char *version = (const char *)bytes + KMOD_INFO_VERSION_OFFSET;
+                kext[@"version"] = [[NSString alloc] initWithBytes:version length:strnlen(version, KMOD_MAX_NAME) encoding:NSUTF8StringEncoding];
+            }
+
+            uint64_t start = 0;
+            uint64_t stop = 0;
+            memcpy(&start, bytes + KMOD_INFO_START_OFFSET, sizeof(start));
+            memcpy(&stop, bytes + KMOD_INFO_STOP_OFFSET, sizeof(stop));
+            if (start != 0) kext[@"start"] = @(start);
+            if (stop != 0) kext[@"stop"] = @(stop);
+        }
+    }
+
+    // IOKit personalities: which driver class attaches to which provider
+    NSMutableArray *providers = [NSMutableArray array];
+    NSDictionary *personalities = entry[@"IOKitPersonalities"];
+    if ([personalities isKindOfClass:[NSDictionary class]]) {
+        for (NSString *name in [personalities.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+            NSDictionary *personality = personalities[name];
+            if (![personality isKindOfClass:[NSDictionary class]]) continue;
+
+            [providers addObject:[NSString stringWithFormat:@"%@ on %@",
+                                  personality[@"IOClass"] ?: name,
+                                  personality[@"IOProviderClass"] ?: @"?"]];
+        }
+    }
+    kext[@"providers"] = providers;
+
+    return kext;
+}
+
+- (NSDictionary *)prelinkInfoDictionary:(NSObject<HPDisassembledFile> *)file {
+    NSObject<HPSegment> *segment = [file segmentNamed:@"__PRELINK_INFO"];
+    NSData *data = segment.mappedData;
+    if (!data) {
+        return nil;
+    }
+
+    NSObject<HPSection> *section = [segment sectionNamed:@"__info"];
+    Address start = section ? section.startAddress : segment.startAddress;
+    Address end = section ? section.endAddress : segment.endAddress;
+    if (start < segment.startAddress || start - segment.startAddress >= data.length) {
+        return nil;
+    }
+
+    NSUInteger offset = (NSUInteger)(start - segment.startAddress);
+    NSUInteger available = (NSUInteger)MIN((uint64_t)(end - start), (uint64_t)(data.length - offset));
+    const char *bytes = (const char *)data.bytes + offset;
+    NSString *xml = [[NSString alloc] initWithBytes:bytes length:strnlen(bytes, available) encoding:NSUTF8StringEncoding];
+    if (!xml) {
+        return nil;
+    }
+
+    NSData *plistData = [[self resolvePlistReferences:xml] dataUsingEncoding:NSUTF8StringEncoding];
+    id plist = [NSPropertyListSerialization propertyListWithData:plistData
+                                                         options:NSPropertyListImmutable
+                                                          format:NULL
+                                                           error:NULL];
+    return [plist isKindOfClass:[NSDictionary class]] ? plist : nil;
+}
+
+- (NSString *)resolvePlistReferences:(NSString *)xml {
+    // The kernel serializer dedupes values with ID="n" / IDREF="n", which
+    // NSPropertyListSerialization does not understand: inline them back
+    NSRegularExpression *definitions = [NSRegularExpression regularExpressionWithPattern:@"<(string|integer|data)([^>]*) ID=\"([0-9]+)\"([^>]*)>([^<]*)</\\1>"
+                                                                                 options:0
+                                                                                   error:NULL];
+    NSMutableDictionary *values = [NSMutableDictionary dictionary];
+    for (NSTextCheckingResult *match in [definitions matchesInString:xml options:0 range:NSMakeRange(0, xml.length)]) {
+        NSString *tag = [xml substringWithRange:[match rangeAtIndex:1]];
+        NSString *identifier = [xml substringWithRange:[match rangeAtIndex:3]];
+        NSString *value = [xml substringWithRange:[match rangeAtIndex:5]];
+        values[identifier] = [NSString stringWithFormat:@"<%@>%@</%@>", tag, value, tag];
+    }
+    if (values.count == 0) {
+        return xml;
+    }
+
+    NSRegularExpression *references = [NSRegularExpression regularExpressionWithPattern:@"<(string|integer|data)[^>]* IDREF=\"([0-9]+)\"[^>]*/>"
+                                                                                options:0
+                                                                                  error:NULL];
+    NSMutableString *resolved = [NSMutableString stringWithCapacity:xml.length];
+    __block NSUInteger position = 0;
+    [references enumerateMatchesInString:xml options:0 range:NSMakeRange(0, xml.length)
+                              usingBlock:^(NSTextCheckingResult *match, NSMatchingFlags flags, BOOL *stop) {
+        NSString *value = values[[xml substringWithRange:[match rangeAtIndex:2]]];
+        if (!value) return;
+
+        [resolved appendString:[xml substringWithRange:NSMakeRange(position, match.range.location - position)]];
+        [resolved appendString:value];
+        position = NSMaxRange(match.range);
+    }];
+    [resolved appendString:[xml substringFromIndex:position]];
+
+    return resolved;
+}
+
+- (NSData *)bytesAtAddress:(Address)address length:(NSUInteger)length segments:(NSArray *)segments {
+    for (NSDictionary *segment in segments) {
+        Address start = [segment[@"start"] unsignedLongLongValue];
+        NSData *data = segment[@"data"];
+
+        if (address >= start && address - start + length <= data.length) {
+            return [data subdataWithRange:NSMakeRange((NSUInteger)(address - start), length)];
+        }
+    }
+    return nil;
+}
+
 #pragma mark - Phase 2: System Call Hooking Detection
 
 - (NSDictionary *)detectSyscallHooking:(NSObject<HPDisassembledFile> *)file
@@ -393,10 +657,16 @@
     [self scanStringsForPatterns:tablePatterns inFile:file results:tableAPIs maxResults:100];
     [self scanStringsForPatterns:hookPatterns inFile:file results:hookAPIs maxResults:100];
 
+    // Arrays of procedure pointers in the data sections and the code overwriting their records
+    NSArray *pointerTables = SRKFindPointerTables(file, self.imageIndex, SRK_POINTER_TABLE_MIN_ENTRIES);
+    NSArray *tableWrites = SRKFindPointerTableWrites(file, self.imageIndex, pointerTables);
+
     return @{
         @"syscall": [syscallAPIs copy],
         @"table": [tableAPIs copy],
-        @"hook": [hookAPIs copy]
+        @"hook": [hookAPIs copy],
+        @"pointer_tables": pointerTables,
+        @"table_writes": tableWrites
     };
 }
 
@@ -457,6 +727,51 @@
     }
     total += hookAPIs.count;
 
+    NSArray *pointerTables = results[@"pointer_tables"];
+    NSArray *tableWrites = results[@"table_writes"];
+    NSPredicate *sysentPredicate = [NSPredicate predicateWithFormat:@"sysent == YES"];
+    NSArray *sysentTables = [pointerTables filteredArrayUsingPredicate:sysentPredicate];
+
+    [report appendFormat:@"Function Pointer Tables: %lu (%lu sysent-like)\n",
+     (unsigned long)pointerTables.count, (unsigned long)sysentTables.count];
+    if (pointerTables.count > 0) {
+        [report appendString:@"  Arrays of procedure pointers in data sections (dispatch tables)\n"];
+        NSMutableArray *listed = [NSMutableArray arrayWithArray:sysentTables];
+        for (NSDictionary *table in pointerTables) {
+            if (![table[@"sysent"] boolValue]) [listed addObject:table];
+        }
+        for (NSDictionary *table in [listed subarrayWithRange:NSMakeRange(0, MIN(5, listed.count))]) {
+            [report appendFormat:@"  • 0x%llx: %@ %lu entries, stride %lu%@ %@\n",
+             [table[@"address"] unsignedLongLongValue],
+             table[@"section"],
+             [table[@"count"] unsignedLongValue],
+             [table[@"stride"] unsignedLongValue],
+             [table[@"sysent"] boolValue] ? @" [sysent-like]" : @"",
+             table[@"name"] ?: @""];
+        }
+        if (listed.count > 5) {
+            [report appendFormat:@"  ... and %lu more\n", (unsigned long)(listed.count - 5)];
+        }
+        [report appendString:@"\n"];
+    }
+    total += sysentTables.count;
+
+    [report appendFormat:@"Table Entry Writes: %lu\n", (unsigned long)tableWrites.count];
+    if (tableWrites.count > 0) {
+        [report appendString:@"  ⚠️  Code overwrites function pointer table entries - dispatch table hooking\n"];
+        for (NSDictionary *write in [tableWrites subarrayWithRange:NSMakeRange(0, MIN(5, tableWrites.count))]) {
+            [report appendFormat:@"  • 0x%llx: table 0x%llx entry %lu\n",
+             [write[@"address"] unsignedLongLongValue],
+             [write[@"table"] unsignedLongLongValue],
+             [write[@"entry"] unsignedLongValue]];
+        }
+        if (tableWrites.count > 5) {
+            [report appendFormat:@"  ... and %lu more\n", (unsigned long)(tableWrites.count - 5)];
+        }
+        [report appendString:@"\n"];
+    }
+    total += tableWrites.count;
+
     if (total == 0) {
         [report appendString:@"✓ No syscall hooking detected\n\n"];
     }
@@ -468,27 +783,10 @@
 
 - (NSDictionary *)detectFunctionHooking:(NSObject<HPDisassembledFile> *)file
                                document:(NSObject<HPDocument> *)document {
-    NSMutableArray *swizzleAPIs = [NSMutableArray array];
     NSMutableArray *interposeAPIs = [NSMutableArray array];
     NSMutableArray *inlineHooks = [NSMutableArray array];
     NSMutableArray *dynamicAPIs = [NSMutableArray array];
 
-    // Method swizzling (Objective-C) (15 patterns)
-    NSArray *swizzlePatterns = @[
-        @"method_exchangeImplementations",
-        @"method_setImplementation",
-        @"class_replaceMethod",
-        @"method_getImplementation",
-        @"class_getInstanceMethod",
-        @"class_getClassMethod",
-        @"swizzle", @"Swizzle", @"SWIZZLE",
-        @"method_exchange",
-        @"IMP", @"Method",
-        @"objc_msgSend",
-        @"_objc_msgForward",
-        @"objc_setHook_getClass"
-    ];
-
     // DYLD interposing (12 patterns)
     NSArray *interposePatterns = @[
         @"DYLD_INTERPOSE", @"__interpose",
@@ -526,16 +824,30 @@
         @"NSGetSelectorName"
     ];
 
-    [self scanStringsForPatterns:swizzlePatterns inFile:file results:swizzleAPIs maxResults:100];
     [self scanStringsForPatterns:interposePatterns inFile:file results:interposeAPIs maxResults:100];
     [self scanStringsForPatterns:inlinePatterns inFile:file results:inlineHooks maxResults:100];
     [self scanStringsForPatterns:dynamicPatterns inFile:file results:dynamicAPIs maxResults:100];
 
+    // Method swizzling (Objective-C): the methods actually swapped at each swizzling call
+    NSArray *swizzles = SRKFindMethodSwizzles(file, self.imageIndex);
+
+    // The actual hook map, straight from the __interpose tuples
+    NSArray *interposeTuples = [self parseInterposeTuples:file];
+
+    // Absolute-jump trampolines and the code making __text writable to install them
+    NSArray *trampolines = SRKFindPrologueTrampolines(file, self.imageIndex);
+    NSArray *trampolineTemplates = SRKFindTrampolineTemplates(file);
+    NSArray *hookInstallers = SRKFindHookInstallers(file, self.imageIndex, trampolines, trampolineTemplates);
+
     return @{
-        @"swizzle": [swizzleAPIs copy],
+        @"swizzle": swizzles,
         @"interpose": [interposeAPIs copy],
         @"inline": [inlineHooks copy],
-        @"dynamic": [dynamicAPIs copy]
+        @"dynamic": [dynamicAPIs copy],
+        @"interpose_tuples": interposeTuples,
+        @"trampolines": trampolines,
+        @"trampoline_templates": trampolineTemplates,
+        @"hook_installers": hookInstallers
     };
 }
 
@@ -547,25 +859,27 @@
 
     NSUInteger total = 0;
 
-    NSArray *swizzleAPIs = results[@"swizzle"];
+    NSArray *swizzles = results[@"swizzle"];
     NSArray *interposeAPIs = results[@"interpose"];
     NSArray *inlineHooks = results[@"inline"];
     NSArray *dynamicAPIs = results[@"dynamic"];
 
-    [report appendFormat:@"Method Swizzling (ObjC): %lu\n", (unsigned long)swizzleAPIs.count];
-    if (swizzleAPIs.count > 0) {
+    [report appendFormat:@"Method Swizzling (ObjC): %lu\n", (unsigned long)swizzles.count];
+    if (swizzles.count > 0) {
         [report appendString:@"  Objective-C method swizzling detected\n"];
-        for (NSDictionary *match in [swizzleAPIs subarrayWithRange:NSMakeRange(0, MIN(5, swizzleAPIs.count))]) {
-            [report appendFormat:@"  • 0x%llx: %@\n",
-             [match[@"address"] unsignedLongLongValue],
-             match[@"string"]];
+        for (NSDictionary *swizzle in [swizzles subarrayWithRange:NSMakeRange(0, MIN(20, swizzles.count))]) {
+            [report appendFormat:@"  • 0x%llx: %@ ⇄ %@ (%@)\n",
+             [swizzle[@"address"] unsignedLongLongValue],
+             swizzle[@"method"],
+             swizzle[@"replacement"],
+             swizzle[@"function"]];
         }
-        if (swizzleAPIs.count > 5) {
-            [report appendFormat:@"  ... and %lu more\n", (unsigned long)(swizzleAPIs.count - 5)];
+        if (swizzles.count > 20) {
+            [report appendFormat:@"  ... and %lu more\n", (unsigned long)(swizzles.count - 20)];
         }
         [report appendString:@"\n"];
     }
-    total += swizzleAPIs.count;
+    total += swizzles.count;
 
     [report appendFormat:@"DYLD Interposing: %lu\n", (unsigned long)interposeAPIs.count];
     if (interposeAPIs.count > 0) {
@@ -582,6 +896,24 @@
     }
     total += interposeAPIs.count;
 
+    NSArray *interposeTuples = results[@"interpose_tuples"];
+    if (interposeTuples.count > 0) {
+        [report appendFormat:@"Interposed Functions: %lu\n", (unsigned long)interposeTuples.count];
+        [report appendString:@"  ⚠️  __interpose tuples - every call to the import is redirected\n"];
+        for (NSDictionary *tuple in [interposeTuples subarrayWithRange:NSMakeRange(0, MIN(50, interposeTuples.count))]) {
+            [report appendFormat:@"  • 0x%llx: %@ → %@ (0x%llx)\n",
+             [tuple[@"address"] unsignedLongLongValue],
+             tuple[@"replacee"],
+             tuple[@"replacement_name"] ?: @"(unnamed)",
+             [tuple[@"replacement"] unsignedLongLongValue]];
+        }
+        if (interposeTuples.count > 50) {
+            [report appendFormat:@"  ... and %lu more\n", (unsigned long)(interposeTuples.count - 50)];
+        }
+        [report appendString:@"\n"];
+    }
+    total += interposeTuples.count;
+
     [report appendFormat:@"Inline Hooking: %lu\n", (unsigned long)inlineHooks.count];
     if (inlineHooks.count > 0) {
         [report appendString:@"  ⚠️  Inline hook patterns detected - code patching\n"];
@@ -597,6 +929,69 @@
     }
     total += inlineHooks.count;
 
+    NSArray *trampolines = results[@"trampolines"];
+    NSArray *trampolineTemplates = results[@"trampoline_templates"];
+    NSMutableArray *allTrampolines = [NSMutableArray arrayWithArray:trampolines];
+    [allTrampolines addObjectsFromArray:trampolineTemplates];
+
+    [report appendFormat:@"Trampolines: %lu (%lu at procedure entries, %lu data templates)\n",
+     (unsigned long)allTrampolines.count, (unsigned long)trampolines.count, (unsigned long)trampolineTemplates.count];
+    if (allTrampolines.count > 0) {
+        [report appendString:@"  ⚠️  Absolute-jump trampolines - detour or hook stub code\n"];
+        for (NSDictionary *trampoline in [allTrampolines subarrayWithRange:NSMakeRange(0, MIN(5, allTrampolines.count))]) {
+            [report appendFormat:@"  • 0x%llx: %@ %@ → 0x%llx %@\n",
+             [trampoline[@"address"] unsignedLongLongValue],
+             trampoline[@"name"] ?: trampoline[@"section"] ?: @"",
+             trampoline[@"kind"],
+             [trampoline[@"target"] unsignedLongLongValue],
+             trampoline[@"target_name"] ?: @""];
+        }
+        if (allTrampolines.count > 5) {
+            [report appendFormat:@"  ... and %lu more\n", (unsigned long)(allTrampolines.count - 5)];
+        }
+        [report appendString:@"\n"];
+    }
+    total += allTrampolines.count;
+
+    NSMutableDictionary<NSNumber *, NSString *> *trampolineNames = [NSMutableDictionary dictionary];
+    for (NSDictionary *trampoline in trampolines) {
+        if (trampoline[@"name"]) trampolineNames[trampoline[@"address"]] = trampoline[@"name"];
+    }
+
+    NSArray *hookInstallers = results[@"hook_installers"];
+    [report appendFormat:@"Hook Installers: %lu\n", (unsigned long)hookInstallers.count];
+    if (hookInstallers.count > 0) {
+        [report appendString:@"  ⚠️  Procedures making code writable before patching it\n"];
+        for (NSDictionary *installer in [hookInstallers subarrayWithRange:NSMakeRange(0, MIN(5, hookInstallers.count))]) {
+            [report appendFormat:@"  • 0x%llx: %@\n",
+             [installer[@"procedure"] unsignedLongLongValue],
+             installer[@"name"] ?: @"(unnamed)"];
+            for (NSDictionary *protect in installer[@"protect"]) {
+                [report appendFormat:@"      0x%llx: %@ %@ prot %@\n",
+                 [protect[@"address"] unsignedLongLongValue],
+                 protect[@"function"],
+                 protect[@"target"] ? [NSString stringWithFormat:@"0x%llx", [protect[@"target"] unsignedLongLongValue]] : @"?",
+                 protect[@"protection"] ? [NSString stringWithFormat:@"0x%llx", [protect[@"protection"] unsignedLongLongValue]] : @"?"];
+            }
+            for (NSDictionary *patch in installer[@"patches"]) {
+                NSMutableString *line = [NSMutableString stringWithFormat:@"      0x%llx: %@",
+                                         [patch[@"address"] unsignedLongLongValue], patch[@"function"]];
+                if (patch[@"target"]) [line appendFormat:@" → 0x%llx", [patch[@"target"] unsignedLongLongValue]];
+                if (patch[@"template"]) [line appendFormat:@" from template 0x%llx", [patch[@"template"] unsignedLongLongValue]];
+                [report appendFormat:@"%@\n", line];
+            }
+            for (NSNumber *entry in installer[@"trampolines"]) {
+                [report appendFormat:@"      patches trampoline at 0x%llx %@\n",
+                 entry.unsignedLongLongValue, trampolineNames[entry] ?: @""];
+            }
+        }
+        if (hookInstallers.count > 5) {
+            [report appendFormat:@"  ... and %lu more\n", (unsigned long)(hookInstallers.count - 5)];
+        }
+        [report appendString:@"\n"];
+    }
+    total += hookInstallers.count;
+
     [report appendFormat:@"Dynamic Resolution: %lu\n", (unsigned long)dynamicAPIs.count];
     if (dynamicAPIs.count > 0) {
         [report appendString:@"  Dynamic function resolution detected\n"];
@@ -619,6 +1014,104 @@
     return total;
 }
 
+#pragma mark - Phase 3: Interpose Tuples
+
+// struct { const void *replacement; const void *replacee; } as laid out by DYLD_INTERPOSE
+#define INTERPOSE_TUPLE_SIZE 16
+
+- (NSArray *)parseInterposeTuples:(NSObject<HPDisassembledFile> *)file {
+    NSMutableArray *tuples = [NSMutableArray array];
+
+    for (NSObject<HPSegment> *segment in file.segments) {
+        for (NSObject<HPSection> *section in segment.sections) {
+            // __DATA,__interpose as well as its __DATA_CONST / __AUTH_CONST variants
+            if (![section.sectionName containsString:@"interpose"]) continue;
+
+            for (Address tuple = section.startAddress;
+                 tuple + INTERPOSE_TUPLE_SIZE <= section.endAddress;
+                 tuple += INTERPOSE_TUPLE_SIZE) {
+                Address replacement = SRKReadPointer(file, tuple);
+                NSString *replacee = [self interposeReplaceeAtSlot:tuple segment:segment file:file];
+                if (replacement == 0 && !replacee) continue;
+
+                NSMutableDictionary *entry = [NSMutableDictionary dictionary];
+                entry[@"address"] = @(tuple);
+                entry[@"section"] = section.sectionName;
+                entry[@"replacement"] = @(replacement);
+                entry[@"replacee"] = replacee ?: @"(unresolved import)";
+
+                NSObject<HPProcedure> *procedure = replacement ? [file procedureAt:replacement] : nil;
+                if (procedure) {
+                    entry[@"procedure"] = @([procedure entryPoint]);
+                }
+                NSString *name = replacement ? [file nameForVirtualAddress:replacement] : nil;
+                if (name) {
+                    entry[@"replacement_name"] = name;
+                }
+
+                [tuples addObject:entry];
+            }
+        }
+    }
+
+    return [tuples copy];
+}
+
+- (NSString *)interposeReplaceeAtSlot:(Address)tuple
+                              segment:(NSObject<HPSegment> *)segment
+                                 file:(NSObject<HPDisassembledFile> *)file {
+    Address slot = tuple + sizeof(uint64_t);
+
+    // Hopper binds the import slot to the external symbol
+    for (NSNumber *target in [segment referencesFromAddress:slot]) {
+        NSString *name = [file nameForVirtualAddress:target.unsignedLongLongValue];
+        if (name.length > 0) {
+            return SRKNormalizedSymbolName(name);
+        }
+    }
+
+    // Rebased pointer to a local definition or an already resolved external
+    Address target = SRKReadPointer(file, slot);
+    if (target != 0) {
+        NSString *name = [file nameForVirtualAddress:target];
+        if (name.length > 0) {
+            return SRKNormalizedSymbolName(name);
+        }
+    }
+
+    NSString *slotName = [file nameForVirtualAddress:slot];
+    if (slotName.length > 0) {
+        return SRKNormalizedSymbolName(slotName);
+    }
+
+    // ARM64E: bit 63 marks authenticated pointers, bit 62 binds; a DYLD_CHAINED_PTR_64 bind keeps bits 32-50 clear
+    uint64_t raw = [file readUInt64AtVirtualAddress:slot];
+    BOOL arm64e = [file.cpuSubFamily.lowercaseString containsString:@"arm64e"];
+    BOOL authenticated = (raw >> 63) & 1;
+    BOOL arm64eBind = (raw >> 62) & 1;
+
+    if (authenticated && !arm64eBind && (arm64e || (raw & 0x0007FFFF00000000ULL) != 0)) {
+        // DYLD_CHAINED_PTR_ARM64E auth rebase: image offset of a local definition, never an import
+        NSObject<HPSegment> *text = [file segmentNamed:@"__TEXT"];
+        Address rebase = (text ? text.startAddress : [file fileBaseAddress]) + (raw & 0xFFFFFFFFULL);
+        NSString *name = [file segmentForVirtualAddress:rebase] ? [file nameForVirtualAddress:rebase] : nil;
+        if (name.length > 0) {
+            return SRKNormalizedSymbolName(name);
+        }
+        return [NSString stringWithFormat:@"(unresolved auth rebase 0x%llx)", rebase];
+    }
+
+    // Unresolved chained fixup bind: report the import ordinal
+    if (arm64eBind && (arm64e || !authenticated)) {
+        return [NSString stringWithFormat:@"(bind ordinal %llu)", raw & 0xFFFFULL];      // DYLD_CHAINED_PTR_ARM64E
+    }
+    if (authenticated) {
+        return [NSString stringWithFormat:@"(bind ordinal %llu)", raw & 0xFFFFFFULL];    // DYLD_CHAINED_PTR_64
+    }
+
+    return nil;
+}
+
 #pragma mark - Phase 4: Kernel Memory Manipulation Detection
 
 - (NSDictionary *)detectKernelMemory:(NSObject<HPDisassembledFile> *)file
@@ -0,0 +1,95 @@
+/*
+ SRKCallSites.h
+ Import index and call site argument recovery for HopperSRK analyzers
+
+ Finds the call sites of imported functions through Hopper's cross
+ references (following stubs and GOT slots) and lifts only the basic
+ blocks leading to each call, so argument recovery costs per-call-site
+ work instead of a full sweep of the binary.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKLifter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Invoked once per call site with the register state right before the call.
+ * function is the requested name the call site was reached from.
+ */
+typedef void (^SRKCallSiteHandler)(Address callAddress, NSString *function,
+                                   NSObject<HPProcedure> * _Nullable procedure,
+                                   SRKLifter *lifter, SRKRegisterState *state);
+
+#pragma mark - Image Index
+
+/**
+ * Builds the per-file index shared by the call site helpers:
+ * - @"symbols":    normalized symbol name -> NSArray of addresses (stubs, GOT slots, externals)
+ * - @"procedures": NSData holding the sorted entry points of every procedure
+ * - @"arch":       SRKArchitecture of the file
+ * plus the run-time imports of SRKMergeDynamicImports(), so symbol lookups
+ * also reach functions only resolved through dlsym and friends.
+ */
+NSDictionary *SRKBuildImageIndex(NSObject<HPDisassembledFile> *file);
+
+/// Addresses carrying the given normalized symbol name
+NSArray<NSNumber *> *SRKAddressesForSymbol(NSDictionary *index, NSString *name);
+
+/// Sorted procedure entry points of the index, usable from any thread
+const Address *SRKProcedureEntries(NSDictionary *index, NSUInteger *count);
+BOOL SRKIsProcedureEntry(const Address *entries, NSUInteger count, Address address);
+
+/// Procedure whose body contains the address, found by binary search over the entry points
+NSObject<HPProcedure> * _Nullable SRKProcedureContaining(NSObject<HPDisassembledFile> *file, NSDictionary *index, Address address);
+
+#pragma mark - Call Sites
+
+/// Call instruction address -> requested function name, for every code reference to the functions
+NSDictionary<NSNumber *, NSString *> *SRKCallSiteAddresses(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                                           NSArray<NSString *> *functions);
+
+void SRKEnumerateCallSites(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                           NSArray<NSString *> *functions, SRKCallSiteHandler handler);
+
+/**
+ * Call sites of the functions with their first argumentCount arguments.
+ * Each entry is @{@"address", @"function", @"procedure", @"arguments"} where
+ * arguments holds SRKDescribeValue() results.
+ */
+NSArray<NSDictionary *> *SRKCallSitesForFunctions(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                                  NSArray<NSString *> *functions, NSUInteger argumentCount);
+
+/// @{@"value", @"slot", @"string", @"class"} for a tracked value, NSNull when nothing is known
+id SRKDescribeValue(NSObject<HPDisassembledFile> *file, SRKRegisterValue value);
+
+/// String argument of a SRKCallSitesForFunctions() entry, or nil
+NSString * _Nullable SRKCallSiteStringArgument(NSDictionary *callSite, NSUInteger argumentIndex);
+
+/// Integer argument of a SRKCallSitesForFunctions() entry, or nil when unknown
+NSNumber * _Nullable SRKCallSiteValueArgument(NSDictionary *callSite, NSUInteger argumentIndex);
+
+#pragma mark - Dynamic Imports
+
+/**
+ * Shadow import table: the names passed to dlsym, dlopen, CFBundleGetFunctionPointerForName,
+ * NSClassFromString, objc_getClass, NSSelectorFromString... at each call site:
+ * @{@"address", @"procedure", @"function", @"kind", @"name", @"slot"?}
+ * kind is function, data, library, class or selector; slot is the global the
+ * resolved function pointer is stored into.
+ */
+NSArray<NSDictionary *> *SRKResolveDynamicImports(NSObject<HPDisassembledFile> *file, NSDictionary *index);
+
+/**
+ * Copy of the index with the imports appended to @"dynamic_imports", and each
+ * stored function pointer slot added to @"symbols" under the resolved name and
+ * to @"dynamic_slots" (slot -> name), which names the indirect calls through it.
+ * SRKCallSiteAddresses() reports those calls at the indirect branch, not at
+ * the load of the slot.
+ */
+NSDictionary *SRKMergeDynamicImports(NSDictionary *index, NSArray<NSDictionary *> *dynamicImports);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,462 @@
+/*
+ SRKCallSites.m
+ Import index and call site argument recovery for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKCallSites.h"
+
+// How many stub/GOT hops are followed from an imported symbol
+#define SRK_CALL_SITE_MAX_DEPTH         2
+// Fall-through predecessors lifted before the block holding the call
+#define SRK_CALL_SITE_MAX_PREDECESSORS  2
+// Procedure chunks checked when resolving the procedure holding an address
+#define SRK_PROCEDURE_LOOKBACK          4
+// Fall-through blocks searched for the store of a dlsym result
+#define SRK_DYNAMIC_IMPORT_MAX_BLOCKS   3
+// Synthetic value standing for a dlsym result while looking for its store
+#define SRK_DYNAMIC_IMPORT_TOKEN        0x44594E0000000000ULL
+
+static int SRKCompareAddresses(const void *a, const void *b) {
+    Address left = *(const Address *)a;
+    Address right = *(const Address *)b;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+#pragma mark - Image Index
+
+static NSDictionary *SRKBuildStaticImageIndex(NSObject<HPDisassembledFile> *file) {
+    NSMutableDictionary<NSString *, NSMutableArray<NSNumber *> *> *symbols = [NSMutableDictionary dictionary];
+
+    for (NSNumber *address in [file allNamedAddresses]) {
+        NSString *name = [file nameForVirtualAddress:address.unsignedLongLongValue];
+        if (name.length == 0) continue;
+
+        NSString *normalized = SRKNormalizedSymbolName(name);
+        NSMutableArray<NSNumber *> *addresses = symbols[normalized];
+        if (!addresses) {
+            addresses = [NSMutableArray array];
+            symbols[normalized] = addresses;
+        }
+        [addresses addObject:address];
+    }
+
+    NSMutableData *procedures = [NSMutableData data];
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        if ([segment procedureCount] == 0) continue;
+
+        for (NSObject<HPProcedure> *procedure in [segment procedures]) {
+            Address entry = [procedure entryPoint];
+            [procedures appendBytes:&entry length:sizeof(Address)];
+        }
+    }
+    qsort(procedures.mutableBytes, procedures.length / sizeof(Address), sizeof(Address), SRKCompareAddresses);
+
+    return @{
+        @"symbols": symbols,
+        @"procedures": procedures,
+        @"arch": @(SRKArchitectureForFile(file))
+    };
+}
+
+NSDictionary *SRKBuildImageIndex(NSObject<HPDisassembledFile> *file) {
+    NSDictionary *index = SRKBuildStaticImageIndex(file);
+    return SRKMergeDynamicImports(index, SRKResolveDynamicImports(file, index));
+}
+
+NSArray<NSNumber *> *SRKAddressesForSymbol(NSDictionary *index, NSString *name) {
+    NSArray<NSNumber *> *addresses = index[@"symbols"][name];
+    return addresses ?: @[];
+}
+
+const Address *SRKProcedureEntries(NSDictionary *index, NSUInteger *count) {
+    NSData *entries = index[@"procedures"];
+    *count = entries.length / sizeof(Address);
+    return entries.bytes;
+}
+
+BOOL SRKIsProcedureEntry(const Address *entries, NSUInteger count, Address address) {
+    NSUInteger low = 0;
+    NSUInteger high = count;
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        if (entries[middle] == address) return YES;
+        if (entries[middle] < address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return NO;
+}
+
+NSObject<HPProcedure> *SRKProcedureContaining(NSObject<HPDisassembledFile> *file, NSDictionary *index, Address address) {
+    NSUInteger count = 0;
+    const Address *list = SRKProcedureEntries(index, &count);
+
+    // First entry point strictly above the address
+    NSUInteger low = 0;
+    NSUInteger high = count;
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        if (list[middle] <= address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    // Procedures can be split into chunks, so check a few of the closest entries
+    for (NSUInteger i = low; i > 0 && low - i < SRK_PROCEDURE_LOOKBACK; i--) {
+        NSObject<HPProcedure> *procedure = [file procedureAt:list[i - 1]];
+        if (procedure && [procedure basicBlockContainingInstructionAt:address]) {
+            return procedure;
+        }
+    }
+
+    return nil;
+}
+
+#pragma mark - Call Sites
+
+/// Indirect calls through a run-time slot, found by lifting the block that loads it; the load itself calls nothing
+static void SRKAddDynamicSlotCalls(NSObject<HPDisassembledFile> *file, NSDictionary *index, SRKLifter *lifter,
+                                   Address reference, NSString *name, NSString *function,
+                                   NSMutableDictionary<NSNumber *, NSString *> *sites) {
+    NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, index, reference);
+    NSObject<HPBasicBlock> *block = [procedure basicBlockContainingInstructionAt:reference];
+    if (!block) return;
+
+    SRKRegisterState state;
+    SRKRegisterStateReset(&state);
+    SRKLiftRange(lifter, block.from, block.to, &state, ^(SRKLifter *callLifter, Address callAddress, NSString *callee,
+                                                         SRKRegisterState *callState, BOOL *stop) {
+        if (callAddress >= reference && [callee isEqualToString:name] && !sites[@(callAddress)]) {
+            sites[@(callAddress)] = function;
+        }
+    });
+}
+
+NSDictionary<NSNumber *, NSString *> *SRKCallSiteAddresses(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                                           NSArray<NSString *> *functions) {
+    NSMutableDictionary<NSNumber *, NSString *> *sites = [NSMutableDictionary dictionary];
+    NSArray<NSObject<HPSegment> *> *segments = [file segments];
+    NSDictionary<NSNumber *, NSString *> *dynamicSlots = index[@"dynamic_slots"];
+
+    NSObject<CPUContext> *cpu = nil;
+    SRKLifter lifter;
+    lifter.arch = SRKArchitectureUnknown;
+
+    for (NSString *function in functions) {
+        NSArray<NSNumber *> *frontier = SRKAddressesForSymbol(index, function);
+        NSMutableSet<NSNumber *> *visited = [NSMutableSet setWithArray:frontier];
+
+        for (NSUInteger depth = 0; depth <= SRK_CALL_SITE_MAX_DEPTH && frontier.count > 0; depth++) {
+            NSMutableArray<NSNumber *> *next = [NSMutableArray array];
+
+            for (NSNumber *target in frontier) {
+                for (NSObject<HPSegment> *segment in segments) {
+                    for (NSNumber *reference in [segment referencesToAddress:target.unsignedLongLongValue]) {
+                        if ([visited containsObject:reference]) continue;
+                        [visited addObject:reference];
+
+                        Address from = reference.unsignedLongLongValue;
+                        NSString *sectionName = [file sectionForVirtualAddress:from].sectionName ?: @"";
+
+                        if ([sectionName containsString:@"stub"]) {
+                            // Stub body loading a GOT slot: continue from the stub entry
+                            NSObject<HPProcedure> *stub = SRKProcedureContaining(file, index, from);
+                            NSNumber *entry = stub ? @([stub entryPoint]) : reference;
+                            if (stub && [visited containsObject:entry]) continue;
+                            [visited addObject:entry];
+                            [next addObject:entry];
+                        } else if ([sectionName containsString:@"got"] || [sectionName containsString:@"symbol_ptr"]) {
+                            [next addObject:reference];
+                        } else if (dynamicSlots[target] && [file hasCodeAt:from]) {
+                            if (!cpu) {
+                                cpu = [file buildCPUContext];
+                                SRKLifterInit(&lifter, file, cpu);
+                                lifter.slotNames = dynamicSlots;
+                            }
+                            if (lifter.arch != SRKArchitectureUnknown) {
+                                SRKAddDynamicSlotCalls(file, index, &lifter, from, dynamicSlots[target], function, sites);
+                            }
+                        } else if ([file hasCodeAt:from] && !sites[reference]) {
+                            sites[reference] = function;
+                        }
+                    }
+                }
+            }
+
+            frontier = next;
+        }
+    }
+
+    return sites;
+}
+
+void SRKEnumerateCallSites(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                           NSArray<NSString *> *functions, SRKCallSiteHandler handler) {
+    NSDictionary<NSNumber *, NSString *> *sites = SRKCallSiteAddresses(file, index, functions);
+    if (sites.count == 0) return;
+
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+    if (lifter.arch == SRKArchitectureUnknown) return;
+    lifter.slotNames = index[@"dynamic_slots"];
+
+    NSSet<NSString *> *wanted = [NSSet setWithArray:functions];
+    NSMutableSet<NSNumber *> *reported = [NSMutableSet set];
+    NSArray<NSNumber *> *addresses = [sites.allKeys sortedArrayUsingSelector:@selector(compare:)];
+
+    for (NSNumber *siteNumber in addresses) {
+        if ([reported containsObject:siteNumber]) continue;
+
+        Address site = siteNumber.unsignedLongLongValue;
+        NSString *function = sites[siteNumber];
+        NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, index, site);
+        NSObject<HPBasicBlock> *block = [procedure basicBlockContainingInstructionAt:site];
+        Address from;
+        Address to;
+
+        if (block) {
+            from = block.from;
+            to = MAX(block.to, site + 1);
+
+            // Address materialization is often split from the call by a fall-through edge
+            for (NSUInteger i = 0; i < SRK_CALL_SITE_MAX_PREDECESSORS; i++) {
+                NSArray<NSObject<HPBasicBlock> *> *predecessors = block.predecessors;
+                if (predecessors.count != 1 || predecessors.firstObject.to != block.from) break;
+                block = predecessors.firstObject;
+                from = block.from;
+            }
+        } else if (lifter.arch == SRKArchitectureARM64) {
+            // No procedure: a short fixed-width window still catches adrp/add pairs
+            from = site >= 64 ? site - 64 : 0;
+            to = site + 1;
+        } else {
+            from = site;
+            to = site + 1;
+        }
+
+        SRKRegisterState state;
+        SRKRegisterStateReset(&state);
+        SRKLiftRange(&lifter, from, to, &state, ^(SRKLifter *callLifter, Address callAddress, NSString *callee,
+                                                   SRKRegisterState *callState, BOOL *stop) {
+            BOOL isSite = callAddress == site;
+            BOOL isWanted = callee != nil && [wanted containsObject:callee];
+            if (!isSite && !isWanted) return;
+            if ([reported containsObject:@(callAddress)]) return;
+
+            [reported addObject:@(callAddress)];
+            handler(callAddress, isWanted ? callee : function, procedure, callLifter, callState);
+
+            if (isSite) {
+                *stop = YES;
+            }
+        });
+    }
+}
+
+NSArray<NSDictionary *> *SRKCallSitesForFunctions(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                                  NSArray<NSString *> *functions, NSUInteger argumentCount) {
+    NSMutableArray<NSDictionary *> *results = [NSMutableArray array];
+
+    SRKEnumerateCallSites(file, index, functions, ^(Address callAddress, NSString *function,
+                                                    NSObject<HPProcedure> *procedure,
+                                                    SRKLifter *lifter, SRKRegisterState *state) {
+        NSMutableArray *arguments = [NSMutableArray arrayWithCapacity:argumentCount];
+        for (NSUInteger i = 0; i < argumentCount; i++) {
+            [arguments addObject:SRKDescribeValue(file, SRKArgumentValue(state, lifter->arch, i))];
+        }
+
+        [results addObject:@{
+            @"address": @(callAddress),
+            @"function": function,
+            @"procedure": @(procedure ? [procedure entryPoint] : callAddress),
+            @"arguments": arguments
+        }];
+    });
+
+    [results sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"address" ascending:YES]]];
+    return results;
+}
+
+id SRKDescribeValue(NSObject<HPDisassembledFile> *file, SRKRegisterValue value) {
+    if (!value.known && value.objcClass == 0) {
+        return [NSNull null];
+    }
+
+    NSMutableDictionary *description = [NSMutableDictionary dictionary];
+    if (value.known) {
+        description[@"value"] = @(value.value);
+    }
+    if (value.slot != 0) {
+        description[@"slot"] = @(value.slot);
+    }
+
+    NSString *string = SRKStringForValue(file, value);
+    if (string) {
+        description[@"string"] = string;
+    }
+
+    if (value.objcClass != 0) {
+        NSString *className = SRKObjCClassNameAtAddress(file, value.objcClass);
+        if (className) {
+            description[@"class"] = className;
+        }
+    }
+
+    return description;
+}
+
+NSString *SRKCallSiteStringArgument(NSDictionary *callSite, NSUInteger argumentIndex) {
+    NSArray *arguments = callSite[@"arguments"];
+    if (argumentIndex >= arguments.count) return nil;
+
+    id argument = arguments[argumentIndex];
+    return [argument isKindOfClass:[NSDictionary class]] ? argument[@"string"] : nil;
+}
+
+NSNumber *SRKCallSiteValueArgument(NSDictionary *callSite, NSUInteger argumentIndex) {
+    NSArray *arguments = callSite[@"arguments"];
+    if (argumentIndex >= arguments.count) return nil;
+
+    id argument = arguments[argumentIndex];
+    return [argument isKindOfClass:[NSDictionary class]] ? argument[@"value"] : nil;
+}
+
+#pragma mark - Dynamic Imports
+
+static NSDictionary<NSString *, NSArray *> *SRKDynamicResolvers(void) {
+    // Argument holding the name and what the call resolves
+    return @{
+        @"dlsym": @[@1, @"function"],
+        @"CFBundleGetFunctionPointerForName": @[@1, @"function"],
+        @"CFBundleGetDataPointerForName": @[@1, @"data"],
+        @"dlopen": @[@0, @"library"],
+        @"NSClassFromString": @[@0, @"class"],
+        @"objc_getClass": @[@0, @"class"],
+        @"objc_lookUpClass": @[@0, @"class"],
+        @"objc_getRequiredClass": @[@0, @"class"],
+        @"NSSelectorFromString": @[@0, @"selector"],
+        @"sel_registerName": @[@0, @"selector"],
+        @"sel_getUid": @[@0, @"selector"]
+    };
+}
+
+static Address SRKDynamicImportSlot(SRKLifter *lifter, NSObject<HPProcedure> *procedure, Address callAddress) {
+    NSObject<HPBasicBlock> *block = [procedure basicBlockContainingInstructionAt:callAddress];
+    if (!block) return 0;
+
+    // The null check of the result usually splits the store into a fall-through block
+    Address end = block.to;
+    for (NSUInteger i = 1; i < SRK_DYNAMIC_IMPORT_MAX_BLOCKS; i++) {
+        NSObject<HPBasicBlock> *next = [procedure basicBlockContainingInstructionAt:end];
+        if (!next || next.from != end) break;
+        end = next.to;
+    }
+
+    NSUInteger length = SRKLifterDecode(lifter, callAddress);
+    if (length == 0) return 0;
+
+    SRKRegisterState state;
+    SRKRegisterStateReset(&state);
+    NSUInteger resultRegister = SRKReturnRegister(lifter->arch);
+    state.regs[resultRegister].known = YES;
+    state.regs[resultRegister].value = SRK_DYNAMIC_IMPORT_TOKEN;
+
+    for (Address address = callAddress + length; address < end; address += length) {
+        length = SRKLifterDecode(lifter, address);
+        if (length == 0) break;
+
+        DisasmBranchType branchType = lifter->disasm.instruction.branchType;
+        if (branchType == DISASM_BRANCH_CALL || branchType == DISASM_BRANCH_JMP || branchType == DISASM_BRANCH_RET) break;
+
+        Address destination;
+        SRKRegisterValue stored;
+        if (SRKLifterStoreAddress(lifter, &state, &destination) && SRKLifterStoredValue(lifter, &state, &stored) &&
+            stored.known && stored.value == SRK_DYNAMIC_IMPORT_TOKEN) {
+            return destination;
+        }
+
+        BOOL stop = NO;
+        SRKLifterExecute(lifter, &state, nil, &stop);
+    }
+
+    return 0;
+}
+
+NSArray<NSDictionary *> *SRKResolveDynamicImports(NSObject<HPDisassembledFile> *file, NSDictionary *index) {
+    NSDictionary<NSString *, NSArray *> *resolvers = SRKDynamicResolvers();
+    NSMutableArray<NSMutableDictionary *> *imports = [NSMutableArray array];
+
+    SRKEnumerateCallSites(file, index, resolvers.allKeys, ^(Address callAddress, NSString *function,
+                                                            NSObject<HPProcedure> *procedure,
+                                                            SRKLifter *lifter, SRKRegisterState *state) {
+        NSArray *resolver = resolvers[function];
+        SRKRegisterValue argument = SRKArgumentValue(state, lifter->arch, [resolver[0] unsignedIntegerValue]);
+
+        NSString *name = SRKStringForValue(file, argument);
+        if (name.length == 0) return;
+
+        NSString *kind = resolver[1];
+        if ([kind isEqualToString:@"function"] || [kind isEqualToString:@"data"]) {
+            name = SRKNormalizedSymbolName(name);
+        }
+
+        [imports addObject:[NSMutableDictionary dictionaryWithDictionary:@{
+            @"address": @(callAddress),
+            @"procedure": @(procedure ? [procedure entryPoint] : callAddress),
+            @"function": function,
+            @"kind": kind,
+            @"name": name
+        }]];
+    });
+    if (imports.count == 0) return imports;
+
+    // Where each resolved function pointer is kept, so later indirect calls can be named
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+
+    for (NSMutableDictionary *import in imports) {
+        if (![import[@"kind"] isEqualToString:@"function"] || lifter.arch == SRKArchitectureUnknown) continue;
+
+        NSObject<HPProcedure> *procedure = [file procedureAt:[import[@"procedure"] unsignedLongLongValue]];
+        Address slot = procedure ? SRKDynamicImportSlot(&lifter, procedure, [import[@"address"] unsignedLongLongValue]) : 0;
+        if (slot != 0 && [file segmentForVirtualAddress:slot] != nil) {
+            import[@"slot"] = @(slot);
+        }
+    }
+
+    [imports sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"address" ascending:YES]]];
+    return imports;
+}
+
+NSDictionary *SRKMergeDynamicImports(NSDictionary *index, NSArray<NSDictionary *> *dynamicImports) {
+    NSMutableDictionary *merged = [index mutableCopy];
+    NSMutableDictionary<NSString *, NSArray<NSNumber *> *> *symbols = [index[@"symbols"] mutableCopy];
+    NSMutableDictionary<NSNumber *, NSString *> *slots = [NSMutableDictionary dictionaryWithDictionary:index[@"dynamic_slots"] ?: @{}];
+
+    for (NSDictionary *import in dynamicImports) {
+        NSNumber *slot = import[@"slot"];
+        if (!slot || slots[slot]) continue;
+
+        NSString *name = import[@"name"];
+        slots[slot] = name;
+        symbols[name] = [(symbols[name] ?: @[]) arrayByAddingObject:slot];
+    }
+
+    NSMutableArray *allImports = [NSMutableArray arrayWithArray:index[@"dynamic_imports"] ?: @[]];
+    [allImports addObjectsFromArray:dynamicImports];
+
+    merged[@"symbols"] = symbols;
+    merged[@"dynamic_slots"] = slots;
+    merged[@"dynamic_imports"] = allImports;
+    return merged;
+}
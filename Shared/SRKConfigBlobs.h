@@ -0,0 +1,61 @@
+/*
+ SRKConfigBlobs.h
+ Embedded configuration blob detection for HopperSRK analyzers
+
+ Implant configurations are often compiled in as a JSON document or a
+ binary serialized blob rather than as loose strings. The string and data
+ sections, and the base64 strings once decoded, are swept for the bytes
+ that can open one (vectorized, 16 bytes at a time), and each candidate is
+ checked by:
+ - a structural JSON validator: an iterative state machine with an object /
+   array bit stack, whose string scanning skips 16 bytes per step with
+   NEON or SSE2 compares
+ - a MessagePack matcher for maps of two or more string keys
+ - a protobuf matcher for runs of three or more well-formed fields in
+   field-number order, holding at least one string
+ Every check stops at the first byte that cannot continue valid input, so
+ random data is rejected within a few bytes. Accepted blobs are decoded
+ into key / value findings, keys mapped to config roles (server, port,
+ sleep, jitter, key, user_agent, id). Protobuf carries no key names; its
+ fields are named "#N" and only server-shaped values get a role.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Shortest blob reported
+#define SRK_CONFIG_MIN_BLOB 8
+/// Deepest JSON / MessagePack nesting accepted
+#define SRK_CONFIG_MAX_DEPTH 64
+
+/// Length of the JSON object or array at bytes[0], 0 when the bytes do not start one
+size_t SRKValidateJSON(const uint8_t *bytes, size_t length);
+
+/// Length of the MessagePack map with string keys at bytes[0], 0 when there is none
+size_t SRKMatchMsgPack(const uint8_t *bytes, size_t length);
+
+/// Length of the protobuf field run at bytes[0], 0 when it is too short or malformed
+size_t SRKMatchProtobuf(const uint8_t *bytes, size_t length);
+
+/// Config role of a key ("server", "port", "sleep", "jitter", "key", "user_agent", "id"), nil for other keys
+NSString * _Nullable SRKConfigRole(NSString *key);
+
+/**
+ * Key / value pairs of a blob a matcher accepted, format being @"json",
+ * @"msgpack" or @"protobuf": @[@{@"key", @"value", @"role" (when known)}].
+ * Nested keys are joined with ".".
+ */
+NSArray<NSDictionary *> *SRKConfigBlobFindings(const uint8_t *bytes, size_t length, NSString *format);
+
+/**
+ * Blobs of the image with at least one finding, library-only ones left out:
+ * @{@"address", @"length", @"format", @"section", @"encoding": @"base64" (for decoded strings),
+ *   @"findings", @"roles": sorted roles found, @"config": YES when two or more roles are}
+ */
+NSArray<NSDictionary *> *SRKFindConfigBlobs(NSObject<HPDisassembledFile> *file, NSDictionary * _Nullable libraryCode);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,880 @@
+/*
+ SRKConfigBlobs.m
+ Embedded configuration blob detection for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#if defined(__ARM_NEON)
+#import <arm_neon.h>
+#elif defined(__SSE2__)
+#import <emmintrin.h>
+#endif
+#import "SRKConfigBlobs.h"
+#import "SRKLibraryCode.h"
+#import "SRKURLParser.h"
+
+// Highest protobuf field number taken for a config field
+#define SRK_PROTOBUF_MAX_FIELD 1024
+// Fewest protobuf fields for a run to count as a message
+#define SRK_PROTOBUF_MIN_FIELDS 3
+// Longest MessagePack key accepted
+#define SRK_MSGPACK_MAX_KEY 64
+// Shortest base64 string decoded and swept
+#define SRK_CONFIG_MIN_BASE64 24
+// Findings kept per blob
+#define SRK_CONFIG_MAX_FINDINGS 64
+// Longest value kept in a finding; binary values are shown as this many hex digits
+#define SRK_CONFIG_MAX_VALUE 256
+// Blobs reported per image
+#define SRK_CONFIG_MAX_BLOBS 256
+
+#pragma mark - Vector Scans
+
+#if defined(__ARM_NEON)
+/// One bit per lane set to 0xFF, as SSE2 movemask gives it
+static inline uint32_t SRKNeonMovemask(uint8x16_t mask) {
+    static const uint8_t weights[16] = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+    uint8x16_t bits = vandq_u8(mask, vld1q_u8(weights));
+    return vaddv_u8(vget_low_u8(bits)) | ((uint32_t)vaddv_u8(vget_high_u8(bits)) << 8);
+}
+#endif
+
+/// Bit i set when bytes[i] ends the run of plain string bytes: '"', '\\' or a control byte
+static inline uint32_t SRKJSONStringStops16(const uint8_t *bytes) {
+#if defined(__ARM_NEON)
+    uint8x16_t v = vld1q_u8(bytes);
+    uint8x16_t stops = vorrq_u8(vorrq_u8(vceqq_u8(v, vdupq_n_u8('"')), vceqq_u8(v, vdupq_n_u8('\\'))),
+                                vcltq_u8(v, vdupq_n_u8(0x20)));
+    return SRKNeonMovemask(stops);
+#elif defined(__SSE2__)
+    __m128i v = _mm_loadu_si128((const __m128i *)bytes);
+    __m128i quote = _mm_cmpeq_epi8(v, _mm_set1_epi8('"'));
+    __m128i backslash = _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'));
+    // Unsigned v < 0x20 as min(v, 0x1F) == v
+    __m128i control = _mm_cmpeq_epi8(_mm_min_epu8(v, _mm_set1_epi8(0x1F)), v);
+    return (uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(quote, backslash), control));
+#else
+    uint32_t stops = 0;
+    for (uint32_t i = 0; i < 16; i++) {
+        if (bytes[i] == '"' || bytes[i] == '\\' || bytes[i] < 0x20) stops |= 1U << i;
+    }
+    return stops;
+#endif
+}
+
+/**
+ * Bit i set when bytes[i] may open a blob: '{' or '[' (JSON), 0x82-0x8F,
+ * 0xDE or 0xDF (MessagePack map) and, with protobuf, 0x0A (field 1 bytes)
+ */
+static inline uint32_t SRKBlobStarts16(const uint8_t *bytes, BOOL protobuf) {
+#if defined(__ARM_NEON)
+    uint8x16_t v = vld1q_u8(bytes);
+    uint8x16_t starts = vorrq_u8(vceqq_u8(v, vdupq_n_u8('{')), vceqq_u8(v, vdupq_n_u8('[')));
+    starts = vorrq_u8(starts, vcltq_u8(vsubq_u8(v, vdupq_n_u8(0x82)), vdupq_n_u8(14)));
+    starts = vorrq_u8(starts, vceqq_u8(vandq_u8(v, vdupq_n_u8(0xFE)), vdupq_n_u8(0xDE)));
+    if (protobuf) starts = vorrq_u8(starts, vceqq_u8(v, vdupq_n_u8(0x0A)));
+    return SRKNeonMovemask(starts);
+#elif defined(__SSE2__)
+    __m128i v = _mm_loadu_si128((const __m128i *)bytes);
+    __m128i starts = _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('{')), _mm_cmpeq_epi8(v, _mm_set1_epi8('[')));
+    // Unsigned v - 0x82 <= 13 as min(v - 0x82, 13) == v - 0x82
+    __m128i offset = _mm_sub_epi8(v, _mm_set1_epi8((char)0x82));
+    starts = _mm_or_si128(starts, _mm_cmpeq_epi8(_mm_min_epu8(offset, _mm_set1_epi8(13)), offset));
+    starts = _mm_or_si128(starts, _mm_cmpeq_epi8(_mm_and_si128(v, _mm_set1_epi8((char)0xFE)), _mm_set1_epi8((char)0xDE)));
+    if (protobuf) starts = _mm_or_si128(starts, _mm_cmpeq_epi8(v, _mm_set1_epi8(0x0A)));
+    return (uint32_t)_mm_movemask_epi8(starts);
+#else
+    uint32_t starts = 0;
+    for (uint32_t i = 0; i < 16; i++) {
+        uint8_t c = bytes[i];
+        if (c == '{' || c == '[' || (c >= 0x82 && c <= 0x8F) || c == 0xDE || c == 0xDF || (protobuf && c == 0x0A)) {
+            starts |= 1U << i;
+        }
+    }
+    return starts;
+#endif
+}
+
+#pragma mark - JSON
+
+typedef NS_ENUM(NSUInteger, SRKJSONState) {
+    SRKJSONExpectValue,
+    /// Right after '[': a value or ']'
+    SRKJSONExpectValueOrEnd,
+    /// Right after '{': a key or '}'
+    SRKJSONExpectKeyOrEnd,
+    SRKJSONExpectKey,
+    SRKJSONExpectColon,
+    SRKJSONAfterValue
+};
+
+static inline BOOL SRKJSONIsSpace(uint8_t c) {
+    return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static inline BOOL SRKIsHexDigit(uint8_t c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+/// Offset just past the closing quote of the string opening at bytes[start], 0 when it is invalid
+static size_t SRKSkipJSONString(const uint8_t *bytes, size_t length, size_t start) {
+    size_t i = start + 1;
+    for (;;) {
+        while (i + 16 <= length) {
+            uint32_t stops = SRKJSONStringStops16(bytes + i);
+            if (stops) {
+                i += (size_t)__builtin_ctz(stops);
+                break;
+            }
+            i += 16;
+        }
+        while (i < length && bytes[i] != '"' && bytes[i] != '\\' && bytes[i] >= 0x20) i++;
+        if (i >= length || bytes[i] < 0x20) return 0;
+        if (bytes[i] == '"') return i + 1;
+
+        if (i + 1 >= length) return 0;
+        uint8_t escape = bytes[i + 1];
+        if (escape == 'u') {
+            if (i + 6 > length || !SRKIsHexDigit(bytes[i + 2]) || !SRKIsHexDigit(bytes[i + 3]) ||
+                !SRKIsHexDigit(bytes[i + 4]) || !SRKIsHexDigit(bytes[i + 5])) {
+                return 0;
+            }
+            i += 6;
+        } else if (escape && strchr("\"\\/bfnrt", escape)) {
+            i += 2;
+        } else {
+            return 0;
+        }
+    }
+}
+
+/// Offset just past the number starting at bytes[start], 0 when it is invalid
+static size_t SRKSkipJSONNumber(const uint8_t *bytes, size_t length, size_t start) {
+    size_t i = start;
+    if (i < length && bytes[i] == '-') i++;
+    if (i >= length) return 0;
+    if (bytes[i] == '0') {
+        i++;
+    } else if (bytes[i] >= '1' && bytes[i] <= '9') {
+        while (i < length && bytes[i] >= '0' && bytes[i] <= '9') i++;
+    } else {
+        return 0;
+    }
+
+    if (i < length && bytes[i] == '.') {
+        size_t digits = ++i;
+        while (i < length && bytes[i] >= '0' && bytes[i] <= '9') i++;
+        if (i == digits) return 0;
+    }
+    if (i < length && (bytes[i] == 'e' || bytes[i] == 'E')) {
+        i++;
+        if (i < length && (bytes[i] == '+' || bytes[i] == '-')) i++;
+        size_t digits = i;
+        while (i < length && bytes[i] >= '0' && bytes[i] <= '9') i++;
+        if (i == digits) return 0;
+    }
+    return i;
+}
+
+/// Offset past the string, number or literal starting at bytes[start], 0 when it is invalid
+static size_t SRKSkipJSONScalar(const uint8_t *bytes, size_t length, size_t start) {
+    uint8_t c = bytes[start];
+    if (c == '"') return SRKSkipJSONString(bytes, length, start);
+    if (c == '-' || (c >= '0' && c <= '9')) return SRKSkipJSONNumber(bytes, length, start);
+
+    static const char *const literals[] = {"true", "false", "null"};
+    for (size_t l = 0; l < 3; l++) {
+        size_t literalLength = strlen(literals[l]);
+        if (start + literalLength <= length && memcmp(bytes + start, literals[l], literalLength) == 0) {
+            return start + literalLength;
+        }
+    }
+    return 0;
+}
+
+size_t SRKValidateJSON(const uint8_t *bytes, size_t length) {
+    if (length < 2 || (bytes[0] != '{' && bytes[0] != '[')) return 0;
+
+    // Bit d set when the container at depth d is an object
+    uint64_t objects = 0;
+    size_t depth = 0;
+    SRKJSONState state = SRKJSONExpectValue;
+    size_t i = 0;
+
+    for (;;) {
+        while (i < length && SRKJSONIsSpace(bytes[i])) i++;
+        if (i >= length) return 0;
+        uint8_t c = bytes[i];
+        BOOL close = NO;
+
+        switch (state) {
+            case SRKJSONExpectValueOrEnd:
+                if (c == ']') {
+                    close = YES;
+                    break;
+                }
+                // fall through
+            case SRKJSONExpectValue:
+                if (c == '{' || c == '[') {
+                    if (depth >= SRK_CONFIG_MAX_DEPTH) return 0;
+                    if (c == '{') objects |= 1ULL << depth;
+                    else objects &= ~(1ULL << depth);
+                    depth++;
+                    state = c == '{' ? SRKJSONExpectKeyOrEnd : SRKJSONExpectValueOrEnd;
+                    i++;
+                    continue;
+                }
+                i = SRKSkipJSONScalar(bytes, length, i);
+                if (i == 0) return 0;
+                state = SRKJSONAfterValue;
+                continue;
+
+            case SRKJSONExpectKeyOrEnd:
+                if (c == '}') {
+                    close = YES;
+                    break;
+                }
+                // fall through
+            case SRKJSONExpectKey:
+                if (c != '"') return 0;
+                i = SRKSkipJSONString(bytes, length, i);
+                if (i == 0) return 0;
+                state = SRKJSONExpectColon;
+                continue;
+
+            case SRKJSONExpectColon:
+                if (c != ':') return 0;
+                i++;
+                state = SRKJSONExpectValue;
+                continue;
+
+            case SRKJSONAfterValue: {
+                BOOL object = (objects >> (depth - 1)) & 1;
+                if (c == ',') {
+                    i++;
+                    state = object ? SRKJSONExpectKey : SRKJSONExpectValue;
+                    continue;
+                }
+                if (c != (object ? '}' : ']')) return 0;
+                close = YES;
+                break;
+            }
+        }
+
+        if (close) {
+            i++;
+            if (--depth == 0) return i;
+            state = SRKJSONAfterValue;
+        }
+    }
+}
+
+#pragma mark - MessagePack
+
+static inline uint64_t SRKReadBigEndian(const uint8_t *bytes, size_t size) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < size; i++) value = (value << 8) | bytes[i];
+    return value;
+}
+
+static BOOL SRKIsPrintable(const uint8_t *bytes, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        if (bytes[i] < 0x20 || bytes[i] >= 0x7F) return NO;
+    }
+    return YES;
+}
+
+static NSString *SRKHexPreview(const uint8_t *bytes, size_t length) {
+    NSMutableString *hex = [NSMutableString stringWithCapacity:SRK_CONFIG_MAX_VALUE + 1];
+    for (size_t i = 0; i < length && hex.length + 2 <= SRK_CONFIG_MAX_VALUE; i++) [hex appendFormat:@"%02x", bytes[i]];
+    if (hex.length < length * 2) [hex appendString:@"…"];
+    return hex;
+}
+
+static NSString *SRKTruncatedString(const uint8_t *bytes, size_t length) {
+    NSString *value = [[NSString alloc] initWithBytes:bytes length:MIN(length, SRK_CONFIG_MAX_VALUE)
+                                             encoding:NSUTF8StringEncoding];
+    if (!value) return SRKHexPreview(bytes, length);
+    return length > SRK_CONFIG_MAX_VALUE ? [value stringByAppendingString:@"…"] : value;
+}
+
+static void SRKAddFinding(NSMutableArray<NSDictionary *> *findings, NSString *key, NSString *value, NSString *role) {
+    if (findings.count >= SRK_CONFIG_MAX_FINDINGS) return;
+    NSMutableDictionary *finding = [@{@"key": key, @"value": value} mutableCopy];
+    if (role) finding[@"role"] = role;
+    [findings addObject:finding];
+}
+
+static NSString *SRKNestedKey(NSString *parent, NSString *key) {
+    return parent.length > 0 ? [NSString stringWithFormat:@"%@.%@", parent, key] : key;
+}
+
+/**
+ * Offset past the MessagePack value at bytes[position], 0 when it is
+ * malformed. With findings, scalars are added under key; without, nothing
+ * is allocated.
+ */
+static size_t SRKMsgPackValue(const uint8_t *bytes, size_t length, size_t position, NSUInteger depth,
+                              NSString *key, NSMutableArray<NSDictionary *> *findings) {
+    if (position >= length || depth > SRK_CONFIG_MAX_DEPTH) return 0;
+    uint8_t c = bytes[position++];
+    size_t remaining = length - position;
+
+    uint64_t count = 0;
+    size_t sizeBytes = 0;
+    enum { SRKMsgPackScalar, SRKMsgPackString, SRKMsgPackBinary, SRKMsgPackArray, SRKMsgPackMap } kind = SRKMsgPackScalar;
+    size_t scalarSize = 0;
+    NSString *scalar = nil;
+
+    if (c <= 0x7F) {
+        if (findings) scalar = [NSString stringWithFormat:@"%u", c];
+    } else if (c <= 0x8F) {
+        kind = SRKMsgPackMap;
+        count = c & 0x0F;
+    } else if (c <= 0x9F) {
+        kind = SRKMsgPackArray;
+        count = c & 0x0F;
+    } else if (c <= 0xBF) {
+        kind = SRKMsgPackString;
+        count = c & 0x1F;
+    } else if (c >= 0xE0) {
+        if (findings) scalar = [NSString stringWithFormat:@"%d", (int8_t)c];
+    } else {
+        switch (c) {
+            case 0xC0: if (findings) scalar = @"null"; break;
+            case 0xC2: if (findings) scalar = @"false"; break;
+            case 0xC3: if (findings) scalar = @"true"; break;
+            case 0xC4: case 0xC5: case 0xC6: kind = SRKMsgPackBinary; sizeBytes = 1U << (c - 0xC4); break;
+            case 0xCA: scalarSize = 4; break;
+            case 0xCB: scalarSize = 8; break;
+            case 0xCC: case 0xCD: case 0xCE: case 0xCF: scalarSize = 1U << (c - 0xCC); break;
+            case 0xD0: case 0xD1: case 0xD2: case 0xD3: scalarSize = 1U << (c - 0xD0); break;
+            case 0xD9: case 0xDA: case 0xDB: kind = SRKMsgPackString; sizeBytes = 1U << (c - 0xD9); break;
+            case 0xDC: case 0xDD: kind = SRKMsgPackArray; sizeBytes = 2U << (c - 0xDC); break;
+            case 0xDE: case 0xDF: kind = SRKMsgPackMap; sizeBytes = 2U << (c - 0xDE); break;
+            // 0xC1 is never used; extension types do not appear in configs
+            default: return 0;
+        }
+    }
+
+    if (scalarSize > 0) {
+        if (remaining < scalarSize) return 0;
+        if (findings) {
+            uint64_t raw = SRKReadBigEndian(bytes + position, scalarSize);
+            if (c == 0xCA) {
+                uint32_t bits = (uint32_t)raw;
+                float value;
+                memcpy(&value, &bits, sizeof(value));
+                scalar = [NSString stringWithFormat:@"%g", value];
+            } else if (c == 0xCB) {
+                double value;
+                memcpy(&value, &raw, sizeof(value));
+                scalar = [NSString stringWithFormat:@"%g", value];
+            } else if (c >= 0xD0) {
+                // Sign-extend the big-endian integer from its width
+                int64_t value = (int64_t)(raw << (64 - scalarSize * 8)) >> (64 - scalarSize * 8);
+                scalar = [NSString stringWithFormat:@"%lld", value];
+            } else {
+                scalar = [NSString stringWithFormat:@"%llu", raw];
+            }
+        }
+        position += scalarSize;
+    }
+    if (sizeBytes > 0) {
+        if (remaining < sizeBytes) return 0;
+        count = SRKReadBigEndian(bytes + position, sizeBytes);
+        position += sizeBytes;
+        remaining -= sizeBytes;
+    }
+
+    switch (kind) {
+        case SRKMsgPackScalar:
+            if (findings && key) SRKAddFinding(findings, key, scalar, SRKConfigRole(key));
+            return position;
+
+        case SRKMsgPackString:
+        case SRKMsgPackBinary:
+            if (count > remaining) return 0;
+            if (findings && key) {
+                BOOL text = kind == SRKMsgPackString && SRKIsPrintable(bytes + position, (size_t)count);
+                NSString *value = text ? SRKTruncatedString(bytes + position, (size_t)count) :
+                                         SRKHexPreview(bytes + position, (size_t)count);
+                SRKAddFinding(findings, key, value, SRKConfigRole(key));
+            }
+            return position + (size_t)count;
+
+        case SRKMsgPackArray:
+            // Every element takes a byte at least
+            if (count > remaining) return 0;
+            for (uint64_t e = 0; e < count; e++) {
+                position = SRKMsgPackValue(bytes, length, position, depth + 1, key, findings);
+                if (position == 0) return 0;
+            }
+            return position;
+
+        case SRKMsgPackMap:
+            if (count * 2 > remaining) return 0;
+            for (uint64_t e = 0; e < count; e++) {
+                // String keys only: configs are keyed by name
+                if (position >= length) return 0;
+                uint8_t keyByte = bytes[position];
+                size_t keyLength;
+                size_t keyStart;
+                if (keyByte >= 0xA1 && keyByte <= 0xBF) {
+                    keyLength = keyByte & 0x1F;
+                    keyStart = position + 1;
+                } else if (keyByte == 0xD9 && position + 1 < length) {
+                    keyLength = bytes[position + 1];
+                    keyStart = position + 2;
+                } else {
+                    return 0;
+                }
+                if (keyLength == 0 || keyLength > SRK_MSGPACK_MAX_KEY || keyStart + keyLength > length ||
+                    !SRKIsPrintable(bytes + keyStart, keyLength)) {
+                    return 0;
+                }
+
+                NSString *member = nil;
+                if (findings) {
+                    member = [[NSString alloc] initWithBytes:bytes + keyStart length:keyLength encoding:NSASCIIStringEncoding];
+                    member = SRKNestedKey(key, member);
+                }
+                position = SRKMsgPackValue(bytes, length, keyStart + keyLength, depth + 1, member, findings);
+                if (position == 0) return 0;
+            }
+            return position;
+    }
+    return 0;
+}
+
+size_t SRKMatchMsgPack(const uint8_t *bytes, size_t length) {
+    if (length < SRK_CONFIG_MIN_BLOB) return 0;
+    uint8_t c = bytes[0];
+    size_t countBytes = c == 0xDE ? 2 : 4;
+    BOOL map = (c >= 0x82 && c <= 0x8F) ||
+               ((c == 0xDE || c == 0xDF) && length > countBytes && SRKReadBigEndian(bytes + 1, countBytes) >= 2);
+    if (!map) return 0;
+
+    size_t end = SRKMsgPackValue(bytes, length, 0, 0, nil, nil);
+    return end >= SRK_CONFIG_MIN_BLOB ? end : 0;
+}
+
+#pragma mark - Protobuf
+
+/// Offset past the varint at bytes[position], 0 when it runs off the end or past 10 bytes
+static size_t SRKReadVarint(const uint8_t *bytes, size_t length, size_t position, uint64_t *value) {
+    *value = 0;
+    for (size_t shift = 0; shift < 64 && position < length; shift += 7) {
+        uint8_t byte = bytes[position++];
+        *value |= (uint64_t)(byte & 0x7F) << shift;
+        if (!(byte & 0x80)) return position;
+    }
+    return 0;
+}
+
+/**
+ * Offset past the protobuf field at bytes[position], 0 when malformed or
+ * numbered below minimumField. payload receives a length-delimited field's
+ * range, value a scalar field's value.
+ */
+static size_t SRKProtobufField(const uint8_t *bytes, size_t length, size_t position, uint64_t minimumField,
+                               uint64_t *field, uint32_t *wireType, NSRange *payload, uint64_t *value) {
+    uint64_t tag;
+    position = SRKReadVarint(bytes, length, position, &tag);
+    if (position == 0) return 0;
+    *field = tag >> 3;
+    *wireType = (uint32_t)(tag & 7);
+    *payload = NSMakeRange(NSNotFound, 0);
+    if (*field == 0 || *field > SRK_PROTOBUF_MAX_FIELD || *field < minimumField) return 0;
+
+    switch (*wireType) {
+        case 0:
+            return SRKReadVarint(bytes, length, position, value);
+        case 1:
+            if (length - position < 8) return 0;
+            *value = 0;
+            for (size_t i = 0; i < 8; i++) *value |= (uint64_t)bytes[position + i] << (i * 8);
+            return position + 8;
+        case 5:
+            if (length - position < 4) return 0;
+            *value = 0;
+            for (size_t i = 0; i < 4; i++) *value |= (uint64_t)bytes[position + i] << (i * 8);
+            return position + 4;
+        case 2: {
+            uint64_t size;
+            position = SRKReadVarint(bytes, length, position, &size);
+            if (position == 0 || size > length - position) return 0;
+            *payload = NSMakeRange(position, (NSUInteger)size);
+            return position + (size_t)size;
+        }
+        default:
+            // Groups are deprecated and 6 / 7 are no wire types
+            return 0;
+    }
+}
+
+/// Fields of the run and the offset it ends at; serializers emit fields in field-number order
+static size_t SRKProtobufRun(const uint8_t *bytes, size_t length, NSUInteger *fields, NSUInteger *strings) {
+    size_t position = 0;
+    uint64_t lastField = 1;
+    *fields = 0;
+    *strings = 0;
+    while (position < length) {
+        uint64_t field;
+        uint32_t wireType;
+        NSRange payload;
+        uint64_t value;
+        size_t next = SRKProtobufField(bytes, length, position, lastField, &field, &wireType, &payload, &value);
+        if (next == 0) break;
+
+        (*fields)++;
+        if (payload.location != NSNotFound && payload.length >= 4 && SRKIsPrintable(bytes + payload.location, payload.length)) {
+            (*strings)++;
+        }
+        lastField = field;
+        position = next;
+    }
+    return position;
+}
+
+size_t SRKMatchProtobuf(const uint8_t *bytes, size_t length) {
+    NSUInteger fields;
+    NSUInteger strings;
+    size_t end = SRKProtobufRun(bytes, length, &fields, &strings);
+    return fields >= SRK_PROTOBUF_MIN_FIELDS && strings > 0 && end >= SRK_CONFIG_MIN_BLOB ? end : 0;
+}
+
+#pragma mark - Findings
+
+NSString *SRKConfigRole(NSString *key) {
+    static NSDictionary<NSString *, NSString *> *roles;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSMutableDictionary *table = [NSMutableDictionary dictionary];
+        NSDictionary<NSString *, NSArray<NSString *> *> *names = @{
+            @"server": @[@"server", @"servers", @"host", @"hosts", @"c2", @"c2server", @"c2servers", @"cc", @"url", @"urls",
+                         @"domain", @"domains", @"address", @"addr", @"endpoint", @"endpoints", @"callback",
+                         @"callbackurl", @"gate", @"panel", @"ip", @"ips"],
+            @"port": @[@"port", @"ports", @"c2port"],
+            @"sleep": @[@"sleep", @"sleeptime", @"interval", @"beacon", @"beaconinterval", @"delay", @"callbackinterval",
+                        @"checkin", @"checkininterval", @"timeout", @"wait", @"period"],
+            @"jitter": @[@"jitter", @"jitterpercent", @"jitterpct"],
+            @"key": @[@"key", @"aeskey", @"enckey", @"encryptionkey", @"cryptkey", @"xorkey", @"rc4key", @"secret",
+                      @"pubkey", @"publickey", @"rsakey", @"privatekey", @"psk", @"password", @"passwd", @"token",
+                      @"iv", @"salt"],
+            @"user_agent": @[@"useragent", @"ua"],
+            @"id": @[@"id", @"botid", @"implantid", @"campaign", @"campaignid", @"group", @"tag", @"mutex", @"build",
+                     @"buildid", @"uuid"]
+        };
+        for (NSString *role in names) {
+            for (NSString *name in names[role]) table[name] = role;
+        }
+        roles = table;
+    });
+
+    // The last path component, lowercased without separators: "C2.Sleep_Time" -> "sleeptime"
+    NSString *name = [key componentsSeparatedByString:@"."].lastObject.lowercaseString;
+    NSCharacterSet *separators = [NSCharacterSet characterSetWithCharactersInString:@"_- "];
+    name = [[name componentsSeparatedByCharactersInSet:separators] componentsJoinedByString:@""];
+    return roles[name];
+}
+
+/// Whether a value names a server: a URL, "host.tld[:port]" or an IPv4 address
+static BOOL SRKConfigValueIsServer(NSString *value) {
+    const char *text = value.UTF8String;
+    SRKURLParts parts;
+    if (!text || !SRKParseURL(text, strlen(text), YES, &parts) || parts.host.length == 0) return NO;
+    return (parts.flags & (SRKURLHasScheme | SRKURLHostIPv4 | SRKURLHostIPv6)) ||
+           memchr(text + parts.host.offset, '.', parts.host.length) != NULL;
+}
+
+typedef struct {
+    const uint8_t *bytes;
+    size_t length;
+    size_t position;
+} SRKJSONReader;
+
+static void SRKJSONSkipSpace(SRKJSONReader *reader) {
+    while (reader->position < reader->length && SRKJSONIsSpace(reader->bytes[reader->position])) reader->position++;
+}
+
+/// Decoded string at the reader, past its closing quote; \u escapes outside ASCII become '?'
+static NSString *SRKJSONReadString(SRKJSONReader *reader) {
+    size_t end = SRKSkipJSONString(reader->bytes, reader->length, reader->position);
+    if (end == 0) {
+        reader->position = reader->length;
+        return @"";
+    }
+
+    NSMutableData *decoded = [NSMutableData dataWithCapacity:end - reader->position];
+    for (size_t i = reader->position + 1; i + 1 < end; i++) {
+        char c = (char)reader->bytes[i];
+        if (c == '\\') {
+            char escape = (char)reader->bytes[++i];
+            if (escape == 'u') {
+                unsigned int code = 0;
+                sscanf((const char *)reader->bytes + i + 1, "%4x", &code);
+                c = code < 0x80 ? (char)code : '?';
+                i += 4;
+            } else {
+                const char *from = "bfnrt";
+                const char *to = "\b\f\n\r\t";
+                const char *mapped = strchr(from, escape);
+                c = mapped ? to[mapped - from] : escape;
+            }
+        }
+        [decoded appendBytes:&c length:1];
+    }
+    reader->position = end;
+    NSString *string = [[NSString alloc] initWithData:decoded encoding:NSUTF8StringEncoding];
+    return string ?: SRKHexPreview(decoded.bytes, decoded.length);
+}
+
+/// Walks a validated value, adding its scalars under key
+static void SRKJSONReadValue(SRKJSONReader *reader, NSString *key, NSMutableArray<NSDictionary *> *findings) {
+    SRKJSONSkipSpace(reader);
+    if (reader->position >= reader->length) return;
+    uint8_t c = reader->bytes[reader->position];
+
+    if (c == '{' || c == '[') {
+        uint8_t close = c == '{' ? '}' : ']';
+        reader->position++;
+        for (;;) {
+            SRKJSONSkipSpace(reader);
+            if (reader->position >= reader->length) return;
+            if (reader->bytes[reader->position] == close) {
+                reader->position++;
+                return;
+            }
+            if (reader->bytes[reader->position] == ',') {
+                reader->position++;
+                continue;
+            }
+
+            if (c == '{') {
+                NSString *member = SRKJSONReadString(reader);
+                SRKJSONSkipSpace(reader);
+                if (reader->position < reader->length && reader->bytes[reader->position] == ':') reader->position++;
+                SRKJSONReadValue(reader, SRKNestedKey(key, member), findings);
+            } else {
+                SRKJSONReadValue(reader, key, findings);
+            }
+        }
+    }
+
+    NSString *value;
+    if (c == '"') {
+        value = SRKJSONReadString(reader);
+        if (value.length > SRK_CONFIG_MAX_VALUE) {
+            value = [[value substringToIndex:SRK_CONFIG_MAX_VALUE] stringByAppendingString:@"…"];
+        }
+    } else {
+        size_t end = SRKSkipJSONScalar(reader->bytes, reader->length, reader->position);
+        if (end == 0) {
+            reader->position = reader->length;
+            return;
+        }
+        value = [[NSString alloc] initWithBytes:reader->bytes + reader->position length:end - reader->position
+                                       encoding:NSASCIIStringEncoding];
+        reader->position = end;
+    }
+    if (key.length > 0) SRKAddFinding(findings, key, value ?: @"?", SRKConfigRole(key));
+}
+
+static void SRKProtobufFindings(const uint8_t *bytes, size_t length, NSString *prefix, NSUInteger depth,
+                                NSMutableArray<NSDictionary *> *findings) {
+    size_t position = 0;
+    uint64_t lastField = 1;
+    while (position < length) {
+        uint64_t field;
+        uint32_t wireType;
+        NSRange payload;
+        uint64_t value = 0;
+        size_t next = SRKProtobufField(bytes, length, position, lastField, &field, &wireType, &payload, &value);
+        if (next == 0) break;
+
+        NSString *key = SRKNestedKey(prefix, [NSString stringWithFormat:@"#%llu", field]);
+        if (payload.location == NSNotFound) {
+            SRKAddFinding(findings, key, [NSString stringWithFormat:@"%llu", value], nil);
+        } else if (SRKIsPrintable(bytes + payload.location, payload.length)) {
+            NSString *string = SRKTruncatedString(bytes + payload.location, payload.length);
+            SRKAddFinding(findings, key, string, SRKConfigValueIsServer(string) ? @"server" : nil);
+        } else {
+            // A nested message when its bytes parse to the end as fields, raw bytes otherwise
+            NSUInteger fields;
+            NSUInteger strings;
+            BOOL nested = depth < 4 && payload.length > 0 &&
+                          SRKProtobufRun(bytes + payload.location, payload.length, &fields, &strings) == payload.length;
+            if (nested) {
+                SRKProtobufFindings(bytes + payload.location, payload.length, key, depth + 1, findings);
+            } else {
+                SRKAddFinding(findings, key, SRKHexPreview(bytes + payload.location, payload.length), nil);
+            }
+        }
+        lastField = field;
+        position = next;
+    }
+}
+
+NSArray<NSDictionary *> *SRKConfigBlobFindings(const uint8_t *bytes, size_t length, NSString *format) {
+    NSMutableArray<NSDictionary *> *findings = [NSMutableArray array];
+    if ([format isEqualToString:@"json"]) {
+        SRKJSONReader reader = {bytes, length, 0};
+        SRKJSONReadValue(&reader, @"", findings);
+    } else if ([format isEqualToString:@"msgpack"]) {
+        SRKMsgPackValue(bytes, length, 0, 0, @"", findings);
+    } else if ([format isEqualToString:@"protobuf"]) {
+        SRKProtobufFindings(bytes, length, @"", 0, findings);
+    }
+    return findings;
+}
+
+#pragma mark - Sweep
+
+/// Calls found for each blob of bytes; protobuf is only tried outside text, where '\n' opens most candidates
+static void SRKSweepConfigBlobs(const uint8_t *bytes, size_t length, BOOL text,
+                                void (^found)(size_t offset, size_t blobLength, NSString *format)) {
+    size_t i = 0;
+    while (i < length) {
+        while (i + 16 <= length) {
+            uint32_t starts = SRKBlobStarts16(bytes + i, !text);
+            if (starts) {
+                i += (size_t)__builtin_ctz(starts);
+                break;
+            }
+            i += 16;
+        }
+        if (i >= length) break;
+
+        uint8_t c = bytes[i];
+        size_t matched = 0;
+        NSString *format = nil;
+        if (c == '{' || c == '[') {
+            matched = SRKValidateJSON(bytes + i, length - i);
+            format = @"json";
+        } else if (c == 0x0A) {
+            if (!text) matched = SRKMatchProtobuf(bytes + i, length - i);
+            format = @"protobuf";
+        } else if (c >= 0x82) {
+            matched = SRKMatchMsgPack(bytes + i, length - i);
+            format = @"msgpack";
+        }
+
+        if (matched >= SRK_CONFIG_MIN_BLOB) {
+            found(i, matched, format);
+            i += matched;
+        } else {
+            i++;
+        }
+    }
+}
+
+/// Decoded bytes of a base64 string, nil when it is not one
+static NSData *SRKDecodeBase64(const uint8_t *bytes, size_t length) {
+    static int8_t values[256];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        memset(values, -1, sizeof(values));
+        const char *alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (int8_t v = 0; v < 64; v++) values[(uint8_t)alphabet[v]] = v;
+    });
+
+    while (length > 0 && bytes[length - 1] == '=') length--;
+    if (length % 4 == 1) return nil;
+
+    NSMutableData *decoded = [NSMutableData dataWithLength:length * 3 / 4];
+    uint8_t *output = decoded.mutableBytes;
+    uint32_t accumulator = 0;
+    size_t bits = 0;
+    size_t written = 0;
+    for (size_t i = 0; i < length; i++) {
+        int8_t value = values[bytes[i]];
+        if (value < 0) return nil;
+        accumulator = (accumulator << 6) | (uint32_t)value;
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            output[written++] = (uint8_t)(accumulator >> bits);
+        }
+    }
+    decoded.length = written;
+    return decoded;
+}
+
+static NSDictionary *SRKConfigBlob(Address address, size_t length, NSString *format, NSString *section,
+                                   NSArray<NSDictionary *> *findings, NSString *encoding) {
+    NSMutableSet<NSString *> *roles = [NSMutableSet set];
+    for (NSDictionary *finding in findings) {
+        if (finding[@"role"]) [roles addObject:finding[@"role"]];
+    }
+
+    NSMutableDictionary *blob = [@{
+        @"address": @(address),
+        @"length": @(length),
+        @"format": format,
+        @"section": section ?: @"?",
+        @"findings": findings,
+        @"roles": [roles.allObjects sortedArrayUsingSelector:@selector(compare:)],
+        @"config": @(roles.count >= 2)
+    } mutableCopy];
+    if (encoding) blob[@"encoding"] = encoding;
+    return blob;
+}
+
+NSArray<NSDictionary *> *SRKFindConfigBlobs(NSObject<HPDisassembledFile> *file, NSDictionary *libraryCode) {
+    NSMutableArray<NSDictionary *> *blobs = [NSMutableArray array];
+
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length == 0) continue;
+        const uint8_t *bytes = data.bytes;
+
+        for (NSObject<HPSection> *section in [segment sections]) {
+            NSString *name = section.sectionName;
+            BOOL text = [name containsString:@"string"];
+            if ([name hasPrefix:@"__objc"] || (!text && ![name containsString:@"const"] && ![name containsString:@"data"])) continue;
+            if (section.startAddress < segment.startAddress) continue;
+
+            NSUInteger start = (NSUInteger)(section.startAddress - segment.startAddress);
+            NSUInteger end = MIN(data.length, (NSUInteger)(section.endAddress - segment.startAddress));
+            if (start >= end) continue;
+
+            SRKSweepConfigBlobs(bytes + start, end - start, text, ^(size_t offset, size_t blobLength, NSString *format) {
+                Address address = section.startAddress + offset;
+                if (blobs.count >= SRK_CONFIG_MAX_BLOBS) return;
+                if (libraryCode && SRKIsLibraryOnlyReference(file, libraryCode, address)) return;
+
+                NSArray<NSDictionary *> *findings = SRKConfigBlobFindings(bytes + start + offset, blobLength, format);
+                if (findings.count > 0) [blobs addObject:SRKConfigBlob(address, blobLength, format, name, findings, nil)];
+            });
+
+            // Base64 strings are decoded and swept as payloads of their own
+            for (NSUInteger i = start; text && i < end && blobs.count < SRK_CONFIG_MAX_BLOBS;) {
+                NSUInteger j = i;
+                while (j < end && bytes[j] >= 32 && bytes[j] < 127) j++;
+                size_t length = j - i;
+                Address address = segment.startAddress + i;
+                const uint8_t *string = bytes + i;
+                i = j + 1;
+                if (length < SRK_CONFIG_MIN_BASE64 || length % 4 != 0) continue;
+
+                NSData *decoded = SRKDecodeBase64(string, length);
+                if (decoded.length < SRK_CONFIG_MIN_BLOB) continue;
+                if (libraryCode && SRKIsLibraryOnlyReference(file, libraryCode, address)) continue;
+
+                const uint8_t *payload = decoded.bytes;
+                SRKSweepConfigBlobs(payload, decoded.length, NO, ^(size_t offset, size_t blobLength, NSString *format) {
+                    if (blobs.count >= SRK_CONFIG_MAX_BLOBS) return;
+                    NSArray<NSDictionary *> *findings = SRKConfigBlobFindings(payload + offset, blobLength, format);
+                    if (findings.count > 0) {
+                        [blobs addObject:SRKConfigBlob(address, blobLength, format, name, findings, @"base64")];
+                    }
+                });
+            }
+        }
+    }
+    return blobs;
+}
@@ -0,0 +1,37 @@
+/*
+ SRKControlFlow.h
+ Control-flow obfuscation metrics for HopperSRK analyzers
+
+ Reads the flattened control-flow graph of SRKBuildProcedureMetrics() and
+ computes the shape metrics of control-flow flattening in parallel with
+ O(blocks + edges) work per procedure: the in-degree of the dispatcher
+ block, the back edges returning to it, and the chains of small blocks
+ comparing a state variable against constants. Conditional branches whose
+ condition the lifter can evaluate are reported as opaque predicates.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+#import "SRKProcedureMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Procedures with fewer blocks are never reported as flattened
+#define SRK_FLATTENING_MIN_BLOCKS 8
+
+/**
+ * Procedures showing flattening or opaque predicates, most obfuscated first:
+ * @{@"procedure", @"blocks", @"edges", @"dispatcher", @"dispatcher_in_degree",
+ *   @"back_edges", @"dispatcher_back_edges", @"compare_chain", @"state_compares",
+ *   @"opaque_predicates", @"score", @"flattened", @"name"?}
+ * dispatcher is the address of the block with the highest in-degree,
+ * opaque_predicates the addresses of the constant-condition branches and
+ * score a 0..1 flattening estimate.
+ */
+NSArray<NSDictionary *> *SRKFindControlFlowObfuscation(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                                      NSDictionary *procedureMetrics);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,335 @@
+/*
+ SRKControlFlow.m
+ Control-flow obfuscation metrics for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKControlFlow.h"
+
+// Block flags recorded while snapshotting
+#define SRK_FLOW_COMPARE        0x01U   // small block testing a register against a constant
+#define SRK_FLOW_STATE_CONSTANT 0x02U   // ... a constant too wide for a loop bound or an enum
+#define SRK_FLOW_OPAQUE         0x04U   // conditional branch on a condition known at lift time
+
+// Dispatcher tests are a compare and a branch, plus the constant materialization
+#define SRK_FLOW_COMPARE_MAX_INSTRUCTIONS 4
+#define SRK_FLOW_STATE_CONSTANT_MIN       0x10000ULL
+
+// Procedures measured per dispatch_apply iteration
+#define SRK_FLOW_CHUNK 256
+
+#define SRK_FLOW_NO_BLOCK UINT32_MAX
+
+typedef struct {
+    uint32_t edges;
+    uint32_t dispatcher;
+    uint32_t dispatcherInDegree;
+    uint32_t backEdges;
+    uint32_t dispatcherBackEdges;
+    uint32_t compareChain;
+    uint32_t stateCompares;
+    uint32_t opaque;
+    double score;
+} SRKFlowMetrics;
+
+typedef NS_ENUM(NSUInteger, SRKFlagEffect) {
+    SRKFlagEffectNone = 0,
+    SRKFlagEffectCompare,
+    SRKFlagEffectClobber
+};
+
+#pragma mark - Block Decoding
+
+static BOOL SRKIsConditionalBranch(DisasmBranchType branch) {
+    return branch != DISASM_BRANCH_NONE && branch != DISASM_BRANCH_JMP &&
+           branch != DISASM_BRANCH_CALL && branch != DISASM_BRANCH_RET;
+}
+
+/// How the instruction in lifter->disasm affects the condition flags, with the compared operands
+static SRKFlagEffect SRKInstructionFlagEffect(SRKLifter *lifter, NSUInteger *lhs, NSUInteger *rhs) {
+    const char *mnemonic = lifter->disasm.instruction.mnemonic;
+
+    if (lifter->disasm.instruction.branchType == DISASM_BRANCH_CALL) return SRKFlagEffectClobber;
+
+    if (lifter->arch == SRKArchitectureARM64) {
+        if (strcmp(mnemonic, "cmp") == 0 || strcmp(mnemonic, "cmn") == 0 || strcmp(mnemonic, "tst") == 0) {
+            *lhs = 0;
+            *rhs = 1;
+            return SRKFlagEffectCompare;
+        }
+        if (strcmp(mnemonic, "subs") == 0 || strcmp(mnemonic, "adds") == 0 || strcmp(mnemonic, "ands") == 0) {
+            *lhs = 1;
+            *rhs = 2;
+            return SRKFlagEffectCompare;
+        }
+        static const char *setters[] = {"bics", "negs", "ngcs", "adcs", "sbcs", "ccmp", "ccmn", "fcmp", "fccmp", NULL};
+        for (NSUInteger i = 0; setters[i]; i++) {
+            if (strncmp(mnemonic, setters[i], strlen(setters[i])) == 0) return SRKFlagEffectClobber;
+        }
+        return SRKFlagEffectNone;
+    }
+
+    if (strcmp(mnemonic, "cmp") == 0 || strcmp(mnemonic, "test") == 0) {
+        *lhs = 0;
+        *rhs = 1;
+        return SRKFlagEffectCompare;
+    }
+    // Nearly every other x86 ALU instruction writes the flags
+    static const char *preserving[] = {"mov", "lea", "push", "pop", "nop", "xchg", "cmov", "set", "bswap", NULL};
+    for (NSUInteger i = 0; preserving[i]; i++) {
+        if (strncmp(mnemonic, preserving[i], strlen(preserving[i])) == 0) return SRKFlagEffectNone;
+    }
+    return SRKFlagEffectClobber;
+}
+
+/// Lifts a two-way block on its own and classifies its terminating conditional branch
+static uint32_t SRKConditionalBlockFlags(SRKLifter *lifter, Address from, Address to, Address *branchAddress) {
+    SRKRegisterState state;
+    SRKRegisterStateReset(&state);
+
+    BOOL flagsKnown = NO;
+    BOOL comparesConstant = NO;
+    uint64_t constant = 0;
+    NSUInteger instructions = 0;
+    Address address = from;
+    BOOL stop = NO;
+
+    while (address < to) {
+        NSUInteger length = SRKLifterDecode(lifter, address);
+        if (length == 0) break;
+        instructions++;
+
+        if (address + length >= to && SRKIsConditionalBranch(lifter->disasm.instruction.branchType)) {
+            *branchAddress = address;
+
+            // cbz / cbnz / tbz / tbnz test their register operand directly
+            const char *mnemonic = lifter->disasm.instruction.mnemonic;
+            if (lifter->arch == SRKArchitectureARM64 && (strncmp(mnemonic, "cb", 2) == 0 || strncmp(mnemonic, "tb", 2) == 0)) {
+                SRKRegisterValue tested;
+                flagsKnown = SRKLifterOperandValue(lifter, &state, 0, &tested) && tested.known;
+                comparesConstant = NO;
+            }
+
+            if (flagsKnown) return SRK_FLOW_OPAQUE;
+            if (!comparesConstant || instructions > SRK_FLOW_COMPARE_MAX_INSTRUCTIONS) return 0;
+            return SRK_FLOW_COMPARE | ((constant & 0xFFFFFFFFULL) >= SRK_FLOW_STATE_CONSTANT_MIN ? SRK_FLOW_STATE_CONSTANT : 0);
+        }
+
+        NSUInteger lhs = 0;
+        NSUInteger rhs = 0;
+        switch (SRKInstructionFlagEffect(lifter, &lhs, &rhs)) {
+            case SRKFlagEffectCompare: {
+                SRKRegisterValue left;
+                SRKRegisterValue right;
+                BOOL decoded = SRKLifterOperandValue(lifter, &state, lhs, &left) &&
+                               SRKLifterOperandValue(lifter, &state, rhs, &right);
+                flagsKnown = decoded && left.known && right.known;
+                comparesConstant = decoded && !left.known && right.known;
+                constant = comparesConstant ? right.value : 0;
+                break;
+            }
+            case SRKFlagEffectClobber:
+                flagsKnown = NO;
+                comparesConstant = NO;
+                break;
+            case SRKFlagEffectNone:
+                break;
+        }
+
+        SRKLifterExecute(lifter, &state, nil, &stop);
+        address += length;
+    }
+
+    return 0;
+}
+
+#pragma mark - Metrics
+
+static void SRKMeasureProcedure(const SRKProcedureBlock *blocks, const uint32_t *flags, uint32_t count,
+                                uint32_t entryBlock, const uint32_t *allEdges, SRKFlowMetrics *metrics) {
+    if (count == 0 || entryBlock >= count) return;
+
+    uint32_t *inDegree = calloc(count, sizeof(uint32_t));
+    uint32_t *cursor = calloc(count, sizeof(uint32_t));
+    uint32_t *stack = malloc(count * sizeof(uint32_t));
+    uint32_t *backEdgesTo = calloc(count, sizeof(uint32_t));
+    uint32_t *chain = calloc(count, sizeof(uint32_t));
+    uint8_t *color = calloc(count, sizeof(uint8_t));
+
+    if (inDegree && cursor && stack && backEdgesTo && chain && color) {
+        for (uint32_t b = 0; b < count; b++) {
+            for (uint32_t e = 0; e < blocks[b].edgeCount; e++) {
+                inDegree[allEdges[blocks[b].firstEdge + e]]++;
+            }
+            metrics->edges += blocks[b].edgeCount;
+            if (flags[b] & SRK_FLOW_OPAQUE) metrics->opaque++;
+            if (flags[b] & SRK_FLOW_STATE_CONSTANT) metrics->stateCompares++;
+        }
+
+        for (uint32_t b = 1; b < count; b++) {
+            if (inDegree[b] > inDegree[metrics->dispatcher]) metrics->dispatcher = b;
+        }
+        metrics->dispatcherInDegree = inDegree[metrics->dispatcher];
+
+        // Iterative DFS from the entry block: an edge to a block still on the stack is a back edge
+        uint32_t depth = 0;
+        stack[depth++] = entryBlock;
+        color[entryBlock] = 1;
+        while (depth > 0) {
+            uint32_t node = stack[depth - 1];
+            if (cursor[node] < blocks[node].edgeCount) {
+                uint32_t target = allEdges[blocks[node].firstEdge + cursor[node]++];
+                if (color[target] == 0) {
+                    color[target] = 1;
+                    stack[depth++] = target;
+                } else if (color[target] == 1) {
+                    metrics->backEdges++;
+                    backEdgesTo[target]++;
+                }
+            } else {
+                color[node] = 2;
+                depth--;
+            }
+        }
+
+        // Cases either jump back to the dispatcher or funnel through one block that does
+        uint32_t dispatcher = metrics->dispatcher;
+        uint32_t header = SRK_FLOW_NO_BLOCK;
+        if (backEdgesTo[dispatcher] > 0) {
+            header = dispatcher;
+        } else if (blocks[dispatcher].edgeCount == 1 && backEdgesTo[allEdges[blocks[dispatcher].firstEdge]] > 0) {
+            header = allEdges[blocks[dispatcher].firstEdge];
+        }
+        metrics->dispatcherBackEdges = header != SRK_FLOW_NO_BLOCK ? backEdgesTo[header] : 0;
+
+        // Longest run of compare blocks, following edges forward in block order
+        for (uint32_t b = count; b-- > 0;) {
+            if (!(flags[b] & SRK_FLOW_COMPARE)) continue;
+            uint32_t longest = 0;
+            for (uint32_t e = 0; e < blocks[b].edgeCount; e++) {
+                uint32_t target = allEdges[blocks[b].firstEdge + e];
+                if (target > b && chain[target] > longest) longest = chain[target];
+            }
+            chain[b] = longest + 1;
+            if (chain[b] > metrics->compareChain) metrics->compareChain = chain[b];
+        }
+
+        if (header != SRK_FLOW_NO_BLOCK && count >= SRK_FLATTENING_MIN_BLOCKS) {
+            // Every case block of a flattened procedure returns to the dispatcher
+            double inShare = MIN(1.0, (double)metrics->dispatcherInDegree / ((double)count * 0.3));
+            double chainShare = MIN(1.0, (double)metrics->compareChain / 4.0);
+            metrics->score = 0.2 + 0.5 * inShare + 0.3 * chainShare;
+        }
+    }
+
+    free(inDegree);
+    free(cursor);
+    free(stack);
+    free(backEdgesTo);
+    free(chain);
+    free(color);
+}
+
+static BOOL SRKIsFlattened(uint32_t blockCount, const SRKFlowMetrics *metrics) {
+    return blockCount >= SRK_FLATTENING_MIN_BLOCKS && metrics->dispatcherInDegree >= 4 && metrics->score >= 0.6;
+}
+
+#pragma mark - Obfuscation Scan
+
+NSArray<NSDictionary *> *SRKFindControlFlowObfuscation(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                                      NSDictionary *procedureMetrics) {
+    NSUInteger entryCount = 0;
+    const Address *entries = SRKProcedureEntries(index, &entryCount);
+    NSUInteger columnCount = 0;
+    const uint32_t *firstBlock = SRKProcedureMetricColumn(procedureMetrics, @"first_block", &columnCount);
+    const uint32_t *blockCounts = SRKProcedureMetricColumn(procedureMetrics, @"blocks", &columnCount);
+    const uint32_t *entryBlocks = SRKProcedureMetricColumn(procedureMetrics, @"entry_block", &columnCount);
+    const uint32_t *edges = SRKProcedureEdges(procedureMetrics);
+    if (entryCount == 0 || columnCount != entryCount || !firstBlock || !blockCounts || !entryBlocks) return @[];
+
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+    if (lifter.arch == SRKArchitectureUnknown) return @[];
+
+    NSUInteger blockTotal = firstBlock[entryCount - 1] + blockCounts[entryCount - 1];
+    uint32_t *flags = calloc(MAX(blockTotal, 1), sizeof(uint32_t));
+    Address *branches = calloc(MAX(blockTotal, 1), sizeof(Address));
+    SRKFlowMetrics *metrics = calloc(entryCount, sizeof(SRKFlowMetrics));
+    if (!flags || !branches || !metrics) {
+        free(flags);
+        free(branches);
+        free(metrics);
+        return @[];
+    }
+
+    // The CPU context stays on this thread: classify the two-way blocks of the shared graph first
+    for (NSUInteger i = 0; i < entryCount; i++) {
+        NSUInteger blockCount = 0;
+        const SRKProcedureBlock *procedureBlocks = SRKProcedureBlocks(procedureMetrics, i, &blockCount);
+        for (uint32_t b = 0; b < blockCount; b++) {
+            if (procedureBlocks[b].edgeCount != 2) continue;
+            NSUInteger global = firstBlock[i] + b;
+            flags[global] = SRKConditionalBlockFlags(&lifter, procedureBlocks[b].from, procedureBlocks[b].to, &branches[global]);
+        }
+    }
+
+    NSUInteger chunks = (entryCount + SRK_FLOW_CHUNK - 1) / SRK_FLOW_CHUNK;
+    dispatch_apply(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+        NSUInteger last = MIN(entryCount, (chunk + 1) * SRK_FLOW_CHUNK);
+        for (NSUInteger i = chunk * SRK_FLOW_CHUNK; i < last; i++) {
+            NSUInteger blockCount = 0;
+            const SRKProcedureBlock *procedureBlocks = SRKProcedureBlocks(procedureMetrics, i, &blockCount);
+            if (blockCount < 2) continue;
+            SRKMeasureProcedure(procedureBlocks, flags + firstBlock[i], (uint32_t)blockCount, entryBlocks[i], edges, &metrics[i]);
+        }
+    });
+
+    NSMutableArray<NSDictionary *> *results = [NSMutableArray array];
+    for (NSUInteger i = 0; i < entryCount; i++) {
+        const SRKFlowMetrics *metric = &metrics[i];
+        BOOL flattened = SRKIsFlattened(blockCounts[i], metric);
+        if (!flattened && metric->opaque == 0) continue;
+
+        NSUInteger blockCount = 0;
+        const SRKProcedureBlock *procedureBlocks = SRKProcedureBlocks(procedureMetrics, i, &blockCount);
+        NSMutableArray<NSNumber *> *opaque = [NSMutableArray array];
+        for (uint32_t b = 0; b < blockCount; b++) {
+            if (flags[firstBlock[i] + b] & SRK_FLOW_OPAQUE) [opaque addObject:@(branches[firstBlock[i] + b])];
+        }
+
+        NSMutableDictionary *result = [NSMutableDictionary dictionaryWithDictionary:@{
+            @"procedure": @(entries[i]),
+            @"blocks": @(blockCounts[i]),
+            @"edges": @(metric->edges),
+            @"dispatcher": @(procedureBlocks[metric->dispatcher].from),
+            @"dispatcher_in_degree": @(metric->dispatcherInDegree),
+            @"back_edges": @(metric->backEdges),
+            @"dispatcher_back_edges": @(metric->dispatcherBackEdges),
+            @"compare_chain": @(metric->compareChain),
+            @"state_compares": @(metric->stateCompares),
+            @"opaque_predicates": opaque,
+            @"score": @(metric->score),
+            @"flattened": @(flattened)
+        }];
+        NSString *name = [file nameForVirtualAddress:entries[i]];
+        if (name.length > 0) result[@"name"] = name;
+        [results addObject:result];
+    }
+
+    free(flags);
+    free(branches);
+    free(metrics);
+
+    [results sortUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+        NSComparisonResult byFlattening = [b[@"flattened"] compare:a[@"flattened"]];
+        if (byFlattening != NSOrderedSame) return byFlattening;
+        NSComparisonResult byScore = [b[@"score"] compare:a[@"score"]];
+        if (byScore != NSOrderedSame) return byScore;
+        return [@([b[@"opaque_predicates"] count]) compare:@([a[@"opaque_predicates"] count])];
+    }];
+    return results;
+}
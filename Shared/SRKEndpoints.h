@@ -0,0 +1,44 @@
+/*
+ SRKEndpoints.h
+ Network endpoint recovery at socket call sites for HopperSRK analyzers
+
+ Lifts the procedures calling connect, bind, sendto, getaddrinfo and
+ nw_endpoint_create_host over an SRKStackFrame and rebuilds the endpoint
+ each call is handed:
+ - sockaddr_in / sockaddr_in6 / sockaddr_un from __const or from the stack
+   stores that built it, the port in network byte order as compilers fold
+   htons() constants; real htons/inet_addr/inet_aton/inet_pton calls are
+   evaluated so their results land in the structure
+ - the protocol from the socket() call whose descriptor reaches the call,
+   or from the ai_socktype / ai_protocol of getaddrinfo hints
+ - getaddrinfo and nw_endpoint_create_host host and service strings
+ The result is concrete (host, port, protocol) endpoints per procedure
+ rather than ":NNNN" substrings. Values computed at run time stay "?".
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * One entry per call site:
+ * @{@"address", @"function", @"procedure",
+ *   @"family": @"ipv4" / @"ipv6" / @"unix" / @"?",
+ *   @"host": address, host name or socket path, absent when unknown,
+ *   @"port": NSNumber, absent when unknown,
+ *   @"service": getaddrinfo / nw_endpoint service name that is no number,
+ *   @"protocol": @"tcp" / @"udp" / @"raw" / @"?"}
+ */
+NSArray<NSDictionary *> *SRKNetworkEndpoints(NSObject<HPDisassembledFile> *file, NSDictionary *index);
+
+/// "tcp 93.184.216.34:443", "udp [2001:db8::1]:53", "unix /var/run/x.sock", "? example.com:?"
+NSString *SRKEndpointDescription(NSDictionary *endpoint);
+
+/// Whether the host and either the port or the service were recovered
+BOOL SRKEndpointIsConcrete(NSDictionary *endpoint);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,309 @@
+/*
+ SRKEndpoints.m
+ Network endpoint recovery at socket call sites for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import <arpa/inet.h>
+#import "SRKEndpoints.h"
+#import "SRKStackFrame.h"
+
+// Address families as the target (Darwin) numbers them
+#define SRK_AF_UNIX 1
+#define SRK_AF_INET 2
+#define SRK_AF_INET6 30
+#define SRK_SOCKADDR_IN_SIZE 16
+#define SRK_SOCKADDR_IN6_SIZE 28
+// sun_path length
+#define SRK_SOCKADDR_UN_PATH 104
+// Offsets in struct addrinfo
+#define SRK_ADDRINFO_FAMILY 4
+#define SRK_ADDRINFO_SOCKTYPE 8
+#define SRK_ADDRINFO_PROTOCOL 12
+/**
+ * Synthetic socket() result: 0x7E, then domain, type and protocol bytes
+ * (0xFF when unknown). Fits in 32 bits so it survives int spills.
+ */
+#define SRK_SOCKET_TAG 0x7E000000U
+#define SRK_SOCKET_TAG_MASK 0xFF000000U
+
+static NSDictionary<NSString *, NSNumber *> *SRKEndpointSockaddrArguments(void) {
+    // Argument holding the sockaddr; its length follows it
+    return @{@"connect": @1, @"bind": @1, @"sendto": @4};
+}
+
+static NSArray<NSString *> *SRKEndpointFunctions(void) {
+    return @[@"connect", @"bind", @"sendto", @"getaddrinfo", @"nw_endpoint_create_host"];
+}
+
+#pragma mark - Values
+
+static SRKRegisterValue SRKEndpointKnown(uint64_t value) {
+    SRKRegisterValue result;
+    memset(&result, 0, sizeof(SRKRegisterValue));
+    result.known = YES;
+    result.value = value;
+    return result;
+}
+
+static NSString *SRKSocketProtocolName(uint32_t type, uint32_t protocol) {
+    if (protocol == IPPROTO_TCP || type == SOCK_STREAM) return @"tcp";
+    if (protocol == IPPROTO_UDP || type == SOCK_DGRAM) return @"udp";
+    if (type == SOCK_RAW) return @"raw";
+    return @"?";
+}
+
+/// Protocol of the socket() descriptor a value carries, nil when it carries none
+static NSString *SRKSocketTagProtocol(SRKRegisterValue descriptor) {
+    if (!descriptor.known || (descriptor.value & 0xFFFFFFFF00000000ULL) ||
+        (descriptor.value & SRK_SOCKET_TAG_MASK) != SRK_SOCKET_TAG) return nil;
+    return SRKSocketProtocolName((descriptor.value >> 8) & 0xFF, descriptor.value & 0xFF);
+}
+
+/// Bytes of a structure at a stack or file address; returns the mask of known bytes
+static uint64_t SRKEndpointReadBytes(NSObject<HPDisassembledFile> *file, NSDictionary *stack, SRKRegisterValue pointer,
+                                     uint8_t *bytes, NSUInteger length) {
+    memset(bytes, 0, length);
+    if (!pointer.known || pointer.value == 0) return 0;
+    if (SRKIsStackAddress(pointer.value)) return SRKStackReadBytes(stack, pointer.value, bytes, length);
+
+    if ([file segmentForVirtualAddress:pointer.value] == nil ||
+        [file segmentForVirtualAddress:pointer.value + length - 1] == nil) return 0;
+    for (NSUInteger i = 0; i < length; i++) bytes[i] = [file readUInt8AtVirtualAddress:pointer.value + i];
+    return length >= 64 ? UINT64_MAX : (1ULL << length) - 1;
+}
+
+static BOOL SRKEndpointBytesKnown(uint64_t mask, NSUInteger offset, NSUInteger length) {
+    uint64_t wanted = ((1ULL << length) - 1) << offset;
+    return (mask & wanted) == wanted;
+}
+
+#pragma mark - Structures
+
+/// Fills family, host and port from a sockaddr; length is the socklen_t argument when known
+static void SRKEndpointParseSockaddr(NSObject<HPDisassembledFile> *file, NSDictionary *stack, SRKRegisterValue pointer,
+                                     SRKRegisterValue length, NSMutableDictionary *endpoint) {
+    uint8_t bytes[SRK_SOCKADDR_IN6_SIZE];
+    uint64_t mask = SRKEndpointReadBytes(file, stack, pointer, bytes, sizeof(bytes));
+
+    // sin_len, sin_family, then the port in network byte order
+    NSUInteger family = 0;
+    if (SRKEndpointBytesKnown(mask, 1, 1)) {
+        family = bytes[1];
+    } else if (length.known && length.value == SRK_SOCKADDR_IN_SIZE) {
+        family = SRK_AF_INET;
+    } else if (length.known && length.value == SRK_SOCKADDR_IN6_SIZE) {
+        family = SRK_AF_INET6;
+    }
+
+    if (family == SRK_AF_UNIX) {
+        endpoint[@"family"] = @"unix";
+        NSString *path = nil;
+        if (pointer.known && !SRKIsStackAddress(pointer.value)) path = SRKReadCString(file, pointer.value + 2, SRK_SOCKADDR_UN_PATH);
+        if (path.length > 0) endpoint[@"host"] = path;
+        return;
+    }
+    if (family != SRK_AF_INET && family != SRK_AF_INET6) {
+        endpoint[@"family"] = @"?";
+        return;
+    }
+
+    endpoint[@"family"] = family == SRK_AF_INET ? @"ipv4" : @"ipv6";
+    if (SRKEndpointBytesKnown(mask, 2, 2)) endpoint[@"port"] = @((bytes[2] << 8) | bytes[3]);
+
+    char text[INET6_ADDRSTRLEN];
+    if (family == SRK_AF_INET && SRKEndpointBytesKnown(mask, 4, 4)) {
+        inet_ntop(AF_INET, bytes + 4, text, sizeof(text));
+        endpoint[@"host"] = @(text);
+    } else if (family == SRK_AF_INET6 && SRKEndpointBytesKnown(mask, 8, 16)) {
+        inet_ntop(AF_INET6, bytes + 8, text, sizeof(text));
+        endpoint[@"host"] = @(text);
+    }
+}
+
+/// Numeric services become the port, named ones stay a service
+static void SRKEndpointSetService(NSString *service, NSMutableDictionary *endpoint) {
+    if (service.length == 0) return;
+    NSCharacterSet *nonDigits = [[NSCharacterSet decimalDigitCharacterSet] invertedSet];
+    if ([service rangeOfCharacterFromSet:nonDigits].location == NSNotFound && service.length <= 5 &&
+        service.integerValue <= UINT16_MAX) {
+        endpoint[@"port"] = @(service.integerValue);
+    } else {
+        endpoint[@"service"] = service;
+    }
+}
+
+static void SRKEndpointParseHints(NSObject<HPDisassembledFile> *file, NSDictionary *stack, SRKRegisterValue hints,
+                                  NSMutableDictionary *endpoint) {
+    uint8_t bytes[SRK_ADDRINFO_PROTOCOL + 4];
+    uint64_t mask = SRKEndpointReadBytes(file, stack, hints, bytes, sizeof(bytes));
+
+    if (SRKEndpointBytesKnown(mask, SRK_ADDRINFO_FAMILY, 4)) {
+        uint32_t family = bytes[SRK_ADDRINFO_FAMILY];
+        endpoint[@"family"] = family == SRK_AF_INET ? @"ipv4" : family == SRK_AF_INET6 ? @"ipv6" : @"?";
+    }
+    uint32_t type = SRKEndpointBytesKnown(mask, SRK_ADDRINFO_SOCKTYPE, 4) ? bytes[SRK_ADDRINFO_SOCKTYPE] : 0;
+    uint32_t protocol = SRKEndpointBytesKnown(mask, SRK_ADDRINFO_PROTOCOL, 4) ? bytes[SRK_ADDRINFO_PROTOCOL] : 0;
+    endpoint[@"protocol"] = SRKSocketProtocolName(type, protocol);
+}
+
+#pragma mark - Helper Calls
+
+/// Evaluates socket() and the address conversion helpers so their results reach the sockaddr
+static void SRKEndpointApplyCall(NSObject<HPDisassembledFile> *file, NSMutableDictionary *stack, SRKArchitecture arch,
+                                 NSString *callee, SRKRegisterState *state) {
+    SRKRegisterValue (^argument)(NSUInteger) = ^SRKRegisterValue(NSUInteger index) {
+        return SRKArgumentValue(state, arch, index);
+    };
+
+    if ([callee isEqualToString:@"socket"]) {
+        uint32_t parts[3];
+        for (NSUInteger i = 0; i < 3; i++) {
+            SRKRegisterValue value = argument(i);
+            parts[i] = value.known && value.value < 0xFF ? (uint32_t)value.value : 0xFF;
+        }
+        state->result = SRKEndpointKnown(SRK_SOCKET_TAG | (parts[0] << 16) | (parts[1] << 8) | parts[2]);
+    } else if ([callee isEqualToString:@"htons"] || [callee isEqualToString:@"ntohs"]) {
+        SRKRegisterValue port = argument(0);
+        if (port.known) state->result = SRKEndpointKnown(((port.value & 0xFF) << 8) | ((port.value >> 8) & 0xFF));
+    } else if ([callee isEqualToString:@"inet_addr"] || [callee isEqualToString:@"inet_aton"]) {
+        NSString *text = SRKStringForValue(file, argument(0));
+        struct in_addr address;
+        if (!text || inet_pton(AF_INET, text.UTF8String, &address) != 1) return;
+
+        // Network byte order in memory, read back little-endian like the target does
+        const uint8_t *raw = (const uint8_t *)&address;
+        uint64_t value = raw[0] | (raw[1] << 8) | (raw[2] << 16) | ((uint64_t)raw[3] << 24);
+        if ([callee isEqualToString:@"inet_addr"]) {
+            state->result = SRKEndpointKnown(value);
+        } else {
+            SRKRegisterValue destination = argument(1);
+            if (destination.known && SRKIsStackAddress(destination.value)) {
+                SRKStackStore(stack, destination.value, SRKEndpointKnown(value), 4);
+            }
+            state->result = SRKEndpointKnown(1);
+        }
+    } else if ([callee isEqualToString:@"inet_pton"]) {
+        SRKRegisterValue family = argument(0);
+        SRKRegisterValue destination = argument(2);
+        NSString *text = SRKStringForValue(file, argument(1));
+        if (!family.known || !text || !destination.known || !SRKIsStackAddress(destination.value)) return;
+
+        uint8_t raw[16];
+        if (family.value == SRK_AF_INET && inet_pton(AF_INET, text.UTF8String, raw) == 1) {
+            uint64_t value = raw[0] | (raw[1] << 8) | (raw[2] << 16) | ((uint64_t)raw[3] << 24);
+            SRKStackStore(stack, destination.value, SRKEndpointKnown(value), 4);
+        } else if (family.value == SRK_AF_INET6 && inet_pton(AF_INET6, text.UTF8String, raw) == 1) {
+            for (NSUInteger half = 0; half < 2; half++) {
+                uint64_t value = 0;
+                for (NSUInteger i = 0; i < 8; i++) value |= (uint64_t)raw[half * 8 + i] << (i * 8);
+                SRKStackStore(stack, destination.value + half * 8, SRKEndpointKnown(value), 8);
+            }
+        } else {
+            return;
+        }
+        state->result = SRKEndpointKnown(1);
+    }
+}
+
+#pragma mark - Public API
+
+NSArray<NSDictionary *> *SRKNetworkEndpoints(NSObject<HPDisassembledFile> *file, NSDictionary *index) {
+    NSDictionary<NSString *, NSNumber *> *sockaddrArguments = SRKEndpointSockaddrArguments();
+    NSDictionary<NSNumber *, NSString *> *sites = SRKCallSiteAddresses(file, index, SRKEndpointFunctions());
+    NSMutableArray<NSDictionary *> *endpoints = [NSMutableArray array];
+    if (sites.count == 0) return endpoints;
+
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+    if (lifter.arch == SRKArchitectureUnknown) return endpoints;
+    lifter.slotNames = index[@"dynamic_slots"];
+    SRKArchitecture arch = lifter.arch;
+
+    NSMutableSet<NSNumber *> *walked = [NSMutableSet set];
+    NSMutableSet<NSNumber *> *found = [NSMutableSet set];
+    for (NSNumber *site in [sites.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, index, site.unsignedLongLongValue);
+        if (!procedure || [walked containsObject:@([procedure entryPoint])]) continue;
+        [walked addObject:@([procedure entryPoint])];
+
+        Address entry = [procedure entryPoint];
+        NSMutableDictionary<NSNumber *, NSValue *> *stack = [NSMutableDictionary dictionary];
+        SRKLiftProcedureWithStack(&lifter, procedure, stack, ^(SRKLifter *callLifter, Address callAddress, NSString *callee,
+                                                               SRKRegisterState *state, BOOL *stop) {
+            if (!callee) return;
+            if (!sites[@(callAddress)]) {
+                SRKEndpointApplyCall(file, stack, arch, callee, state);
+                return;
+            }
+            if ([found containsObject:@(callAddress)]) return;
+            [found addObject:@(callAddress)];
+
+            NSMutableDictionary *endpoint = [NSMutableDictionary dictionaryWithDictionary:@{
+                @"address": @(callAddress), @"function": callee, @"procedure": @(entry),
+                @"family": @"?", @"protocol": @"?"
+            }];
+
+            NSNumber *sockaddrArgument = sockaddrArguments[callee];
+            if (sockaddrArgument) {
+                NSUInteger argumentIndex = sockaddrArgument.unsignedIntegerValue;
+                SRKRegisterValue destination = SRKArgumentValue(state, arch, argumentIndex);
+                SRKEndpointParseSockaddr(file, stack, destination, SRKArgumentValue(state, arch, argumentIndex + 1), endpoint);
+                NSString *protocol = SRKSocketTagProtocol(SRKArgumentValue(state, arch, 0));
+                // sendto with a destination only makes sense on a datagram socket; with NULL it is send()
+                BOOL datagram = [callee isEqualToString:@"sendto"] && destination.known && destination.value != 0;
+                endpoint[@"protocol"] = protocol ?: (datagram ? @"udp" : @"?");
+            } else if ([callee isEqualToString:@"getaddrinfo"]) {
+                SRKRegisterValue node = SRKArgumentValue(state, arch, 0);
+                NSString *host = SRKStringForValue(file, node);
+                if (host) endpoint[@"host"] = host;
+                else if (node.known && node.value == 0) endpoint[@"host"] = @"*";
+                SRKEndpointSetService(SRKStringForValue(file, SRKArgumentValue(state, arch, 1)), endpoint);
+                SRKEndpointParseHints(file, stack, SRKArgumentValue(state, arch, 2), endpoint);
+            } else {
+                // nw_endpoint_create_host(hostname, port), both C strings
+                NSString *host = SRKStringForValue(file, SRKArgumentValue(state, arch, 0));
+                if (host) endpoint[@"host"] = host;
+                SRKEndpointSetService(SRKStringForValue(file, SRKArgumentValue(state, arch, 1)), endpoint);
+            }
+            [endpoints addObject:endpoint];
+        });
+    }
+
+    // Call sites the walk did not reach still show up, with nothing recovered
+    for (NSNumber *site in sites) {
+        if ([found containsObject:site]) continue;
+        NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, index, site.unsignedLongLongValue);
+        [endpoints addObject:@{
+            @"address": site, @"function": sites[site],
+            @"procedure": @(procedure ? [procedure entryPoint] : site.unsignedLongLongValue),
+            @"family": @"?", @"protocol": @"?"
+        }];
+    }
+
+    [endpoints sortUsingDescriptors:@[
+        [NSSortDescriptor sortDescriptorWithKey:@"procedure" ascending:YES],
+        [NSSortDescriptor sortDescriptorWithKey:@"address" ascending:YES]
+    ]];
+    return endpoints;
+}
+
+NSString *SRKEndpointDescription(NSDictionary *endpoint) {
+    NSString *host = endpoint[@"host"] ?: @"?";
+    if ([endpoint[@"family"] isEqualToString:@"unix"]) return [NSString stringWithFormat:@"unix %@", host];
+
+    NSString *port = endpoint[@"port"] ? [endpoint[@"port"] stringValue] : endpoint[@"service"] ?: @"?";
+    if ([endpoint[@"family"] isEqualToString:@"ipv6"] || [host containsString:@":"]) {
+        host = [NSString stringWithFormat:@"[%@]", host];
+    }
+    return [NSString stringWithFormat:@"%@ %@:%@", endpoint[@"protocol"] ?: @"?", host, port];
+}
+
+BOOL SRKEndpointIsConcrete(NSDictionary *endpoint) {
+    if ([endpoint[@"family"] isEqualToString:@"unix"]) return endpoint[@"host"] != nil;
+    return endpoint[@"host"] != nil && (endpoint[@"port"] != nil || endpoint[@"service"] != nil);
+}
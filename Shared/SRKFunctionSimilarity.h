@@ -0,0 +1,81 @@
+/*
+ SRKFunctionSimilarity.h
+ Position-independent function fingerprints for HopperSRK analyzers
+
+ Every procedure gets a MinHash signature over normalized instruction
+ trigrams (mnemonic plus operand kinds, so addresses, registers and
+ immediates do not matter) and a hash of its control-flow graph shape.
+ Fingerprints of labelled samples are kept on disk as a corpus, one file
+ per sample; loading it builds an LSH band index so that the procedures of
+ a new sample are matched against known implant functions without
+ comparing every pair.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+#import "SRKProcedureMetrics.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define SRK_MINHASH_SIZE 64
+/// Signatures are split into SRK_LSH_BANDS bands of SRK_MINHASH_SIZE / SRK_LSH_BANDS rows
+#define SRK_LSH_BANDS 16
+/// Procedures with fewer instructions are too generic to fingerprint
+#define SRK_FINGERPRINT_MIN_INSTRUCTIONS 24
+
+typedef struct {
+    uint32_t minhash[SRK_MINHASH_SIZE];
+    uint64_t cfgHash;
+    uint32_t instructions;
+    uint32_t blocks;
+} SRKFunctionFingerprint;
+
+/**
+ * Fingerprints indexed by procedure id (see SRKProcedureMetrics.h). Procedures
+ * below SRK_FINGERPRINT_MIN_INSTRUCTIONS keep a zeroed fingerprint.
+ */
+NSData *SRKComputeFunctionFingerprints(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                       NSDictionary *procedureMetrics);
+
+/// Estimated Jaccard similarity of the two trigram sets, 0..1
+double SRKFingerprintSimilarity(const SRKFunctionFingerprint *a, const SRKFunctionFingerprint *b);
+
+#pragma mark - Corpus
+
+/// Folder new samples are added to; its samples are never attributed to a family
+#define SRK_UNLABELLED_FAMILY @"unlabelled"
+
+/// ~/Library/Application Support/HopperSRK/FunctionCorpus
+NSString *SRKFunctionCorpusDirectory(void);
+
+/**
+ * Writes the fingerprinted procedures of a sample to <directory>/<family>/<sha256>.plist,
+ * keyed by the SHA-256 of the file so that samples sharing a name do not
+ * overwrite each other and adding a sample twice keeps one copy. The family
+ * of a corpus file is the name of the folder it sits in. The sample hashes
+ * of SRKComputeSampleHashes(), when given, are kept with it.
+ */
+BOOL SRKWriteFunctionCorpusSample(NSString *directory, NSString *family, NSString *sample,
+                                  NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                  NSData *fingerprints, NSDictionary * _Nullable hashes, NSError **error);
+
+/// Family folder holding the sample with the SHA-256 of its hashes, SRK_UNLABELLED_FAMILY when none is labelled
+NSString *SRKFunctionCorpusFamily(NSString *directory, NSDictionary * _Nullable hashes);
+
+/// Loads every labelled sample below the directory and builds the LSH band index, nil when it holds none
+NSDictionary * _Nullable SRKLoadFunctionCorpus(NSString *directory);
+
+/**
+ * Best corpus match of every fingerprinted procedure at or above the threshold:
+ * @{@"address", @"family", @"sample", @"function", @"similarity", @"cfg_match"}
+ */
+NSArray<NSDictionary *> *SRKMatchFunctionFingerprints(NSDictionary *corpus, NSDictionary *index,
+                                                      NSData *fingerprints, double threshold);
+
+/// Matches grouped by family, most matched procedures first: @{@"family", @"procedures", @"similarity", @"samples"}
+NSArray<NSDictionary *> *SRKFamiliesForFunctionMatches(NSArray<NSDictionary *> *matches);
+
+NS_ASSUME_NONNULL_END
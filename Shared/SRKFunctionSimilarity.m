@@ -0,0 +1,494 @@
+/*
+ SRKFunctionSimilarity.m
+ Position-independent function fingerprints for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import <CommonCrypto/CommonDigest.h>
+#import "SRKFunctionSimilarity.h"
+
+// Procedures fingerprinted or matched per dispatch_apply iteration
+#define SRK_FINGERPRINT_CHUNK 256
+// Separates the tokens of two basic blocks, trigrams never span it
+#define SRK_BLOCK_SEPARATOR 0
+// Corpus functions compared per procedure, at most
+#define SRK_MAX_CANDIDATES 512
+#define SRK_CORPUS_FORMAT 1
+
+typedef struct {
+    uint64_t key;
+    uint32_t function;
+    uint32_t reserved;
+} SRKBandEntry;
+
+static inline uint64_t SRKMix64(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+#pragma mark - Tokens
+
+/// Mnemonic and operand kinds of the instruction held in lifter->disasm, never SRK_BLOCK_SEPARATOR
+static uint32_t SRKInstructionToken(const DisasmStruct *disasm) {
+    uint32_t hash = 2166136261U;
+    for (const char *c = disasm->instruction.mnemonic; *c; c++) {
+        hash = (hash ^ (uint8_t)tolower(*c)) * 16777619U;
+    }
+
+    for (NSUInteger i = 0; i < DISASM_MAX_OPERANDS; i++) {
+        DisasmOperandType type = disasm->operand[i].type;
+        if (type == 0 || (type & DISASM_OPERAND_NO_OPERAND)) break;
+
+        char kind = 'o';
+        if (type & DISASM_OPERAND_REGISTER_TYPE) kind = 'r';
+        else if (type & DISASM_OPERAND_CONSTANT_TYPE) kind = 'i';
+        else if (type & DISASM_OPERAND_MEMORY_TYPE) kind = 'm';
+        hash = (hash ^ (uint8_t)kind) * 16777619U;
+    }
+    return hash | 1;
+}
+
+static int SRKCompareUInt32(const void *a, const void *b) {
+    uint32_t left = *(const uint32_t *)a;
+    uint32_t right = *(const uint32_t *)b;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+/// Sorted (out-degree, in-degree, loop) triples of the blocks, so the hash ignores block order
+static uint64_t SRKControlFlowShapeHash(const SRKProcedureBlock *blocks, NSUInteger count, const uint32_t *edges) {
+    if (count == 0) return 0;
+
+    uint32_t *inDegree = calloc(count, sizeof(uint32_t));
+    uint32_t *shape = calloc(count, sizeof(uint32_t));
+    uint8_t *loops = calloc(count, sizeof(uint8_t));
+    if (!inDegree || !shape || !loops) {
+        free(inDegree);
+        free(shape);
+        free(loops);
+        return 0;
+    }
+
+    for (NSUInteger b = 0; b < count; b++) {
+        for (uint32_t e = 0; e < blocks[b].edgeCount; e++) {
+            uint32_t target = edges[blocks[b].firstEdge + e];
+            if (target >= count) continue;
+            inDegree[target]++;
+            if (blocks[target].from <= blocks[b].from) loops[b] = 1;
+        }
+    }
+    for (NSUInteger b = 0; b < count; b++) {
+        shape[b] = (MIN(blocks[b].edgeCount, 15U) << 5) | (MIN(inDegree[b], 15U) << 1) | loops[b];
+    }
+    qsort(shape, count, sizeof(uint32_t), SRKCompareUInt32);
+
+    uint64_t hash = SRKMix64(count);
+    for (NSUInteger b = 0; b < count; b++) {
+        hash = SRKMix64(hash ^ shape[b]);
+    }
+
+    free(inDegree);
+    free(shape);
+    free(loops);
+    return hash;
+}
+
+#pragma mark - Fingerprints
+
+NSData *SRKComputeFunctionFingerprints(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                       NSDictionary *procedureMetrics) {
+    NSUInteger count = 0;
+    const Address *entries = SRKProcedureEntries(index, &count);
+    NSUInteger metricCount = 0;
+    const uint32_t *instructions = SRKProcedureMetricColumn(procedureMetrics, @"instructions", &metricCount);
+
+    NSMutableData *fingerprintData = [NSMutableData dataWithLength:count * sizeof(SRKFunctionFingerprint)];
+    if (!instructions || metricCount != count) return fingerprintData;
+
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+
+    // The CPU plugin is not thread safe: decode to tokens here, hash in parallel
+    NSMutableData *tokenData = [NSMutableData data];
+    uint32_t *firstToken = calloc(MAX(count, 1), sizeof(uint32_t));
+    uint32_t *tokenCounts = calloc(MAX(count, 1), sizeof(uint32_t));
+    if (!firstToken || !tokenCounts) {
+        free(firstToken);
+        free(tokenCounts);
+        return fingerprintData;
+    }
+
+    for (NSUInteger i = 0; i < count; i++) {
+        firstToken[i] = (uint32_t)(tokenData.length / sizeof(uint32_t));
+        if (instructions[i] < SRK_FINGERPRINT_MIN_INSTRUCTIONS) continue;
+
+        NSUInteger blockCount = 0;
+        const SRKProcedureBlock *blocks = SRKProcedureBlocks(procedureMetrics, i, &blockCount);
+        for (NSUInteger b = 0; b < blockCount; b++) {
+            uint32_t separator = SRK_BLOCK_SEPARATOR;
+            [tokenData appendBytes:&separator length:sizeof(uint32_t)];
+
+            for (Address address = blocks[b].from; address < blocks[b].to;) {
+                NSUInteger length = SRKLifterDecode(&lifter, address);
+                if (length == 0) break;
+                uint32_t token = SRKInstructionToken(&lifter.disasm);
+                [tokenData appendBytes:&token length:sizeof(uint32_t)];
+                address += length;
+            }
+        }
+        tokenCounts[i] = (uint32_t)(tokenData.length / sizeof(uint32_t)) - firstToken[i];
+    }
+
+    uint64_t seeds[SRK_MINHASH_SIZE];
+    for (NSUInteger k = 0; k < SRK_MINHASH_SIZE; k++) {
+        seeds[k] = SRKMix64(0x9E3779B97F4A7C15ULL * (k + 1));
+    }
+
+    const uint32_t *tokens = tokenData.bytes;
+    const uint32_t *edges = SRKProcedureEdges(procedureMetrics);
+    SRKFunctionFingerprint *fingerprints = fingerprintData.mutableBytes;
+    NSUInteger chunks = (count + SRK_FINGERPRINT_CHUNK - 1) / SRK_FINGERPRINT_CHUNK;
+    dispatch_apply(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+        NSUInteger last = MIN(count, (chunk + 1) * SRK_FINGERPRINT_CHUNK);
+        for (NSUInteger i = chunk * SRK_FINGERPRINT_CHUNK; i < last; i++) {
+            if (tokenCounts[i] < 3) continue;
+
+            SRKFunctionFingerprint *fingerprint = &fingerprints[i];
+            memset(fingerprint->minhash, 0xFF, sizeof(fingerprint->minhash));
+
+            const uint32_t *procedureTokens = tokens + firstToken[i];
+            uint32_t trigrams = 0;
+            for (uint32_t t = 2; t < tokenCounts[i]; t++) {
+                uint32_t a = procedureTokens[t - 2];
+                uint32_t b = procedureTokens[t - 1];
+                uint32_t c = procedureTokens[t];
+                if (a == SRK_BLOCK_SEPARATOR || b == SRK_BLOCK_SEPARATOR || c == SRK_BLOCK_SEPARATOR) continue;
+
+                uint64_t trigram = SRKMix64(((uint64_t)a << 32 | b) ^ ((uint64_t)c * 0x9E3779B97F4A7C15ULL));
+                for (NSUInteger k = 0; k < SRK_MINHASH_SIZE; k++) {
+                    uint32_t value = (uint32_t)SRKMix64(trigram ^ seeds[k]);
+                    if (value < fingerprint->minhash[k]) fingerprint->minhash[k] = value;
+                }
+                trigrams++;
+            }
+
+            if (trigrams == 0) {
+                memset(fingerprint, 0, sizeof(SRKFunctionFingerprint));
+                continue;
+            }
+
+            NSUInteger blockCount = 0;
+            const SRKProcedureBlock *blocks = SRKProcedureBlocks(procedureMetrics, i, &blockCount);
+            fingerprint->cfgHash = edges ? SRKControlFlowShapeHash(blocks, blockCount, edges) : 0;
+            fingerprint->instructions = instructions[i];
+            fingerprint->blocks = (uint32_t)blockCount;
+        }
+    });
+
+    free(firstToken);
+    free(tokenCounts);
+    return fingerprintData;
+}
+
+double SRKFingerprintSimilarity(const SRKFunctionFingerprint *a, const SRKFunctionFingerprint *b) {
+    NSUInteger equal = 0;
+    for (NSUInteger k = 0; k < SRK_MINHASH_SIZE; k++) {
+        if (a->minhash[k] == b->minhash[k]) equal++;
+    }
+    return (double)equal / SRK_MINHASH_SIZE;
+}
+
+#pragma mark - Corpus
+
+NSString *SRKFunctionCorpusDirectory(void) {
+    NSString *support = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES).firstObject;
+    if (!support) support = [NSHomeDirectory() stringByAppendingPathComponent:@"Library/Application Support"];
+    return [support stringByAppendingPathComponent:@"HopperSRK/FunctionCorpus"];
+}
+
+/// SHA-256 of the sample from its hashes, of the mapped segments when they lack one
+static NSString *SRKCorpusSampleKey(NSObject<HPDisassembledFile> *file, NSDictionary *hashes) {
+    NSString *sha256 = [hashes[@"file"] isKindOfClass:[NSDictionary class]] ? hashes[@"file"][@"sha256"] : nil;
+    if ([sha256 isKindOfClass:[NSString class]] && sha256.length > 0) return sha256;
+
+    CC_SHA256_CTX context;
+    CC_SHA256_Init(&context);
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length > 0) CC_SHA256_Update(&context, data.bytes, (CC_LONG)data.length);
+    }
+    uint8_t digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &context);
+
+    NSMutableString *key = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (NSUInteger i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) [key appendFormat:@"%02x", digest[i]];
+    return key;
+}
+
+BOOL SRKWriteFunctionCorpusSample(NSString *directory, NSString *family, NSString *sample,
+                                  NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                  NSData *fingerprints, NSDictionary *hashes, NSError **error) {
+    NSUInteger count = 0;
+    const Address *entries = SRKProcedureEntries(index, &count);
+    const SRKFunctionFingerprint *fingerprint = fingerprints.bytes;
+    if (fingerprints.length < count * sizeof(SRKFunctionFingerprint)) count = 0;
+
+    NSMutableArray<NSDictionary *> *functions = [NSMutableArray array];
+    for (NSUInteger i = 0; i < count; i++) {
+        if (fingerprint[i].instructions == 0) continue;
+
+        NSString *name = [file nameForVirtualAddress:entries[i]];
+        [functions addObject:@{
+            @"name": name.length > 0 ? name : [NSString stringWithFormat:@"sub_%llx", (unsigned long long)entries[i]],
+            @"minhash": [NSData dataWithBytes:fingerprint[i].minhash length:sizeof(fingerprint[i].minhash)],
+            @"cfg": @(fingerprint[i].cfgHash),
+            @"instructions": @(fingerprint[i].instructions),
+            @"blocks": @(fingerprint[i].blocks)
+        }];
+    }
+
+    NSString *familyDirectory = [directory stringByAppendingPathComponent:family];
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:familyDirectory withIntermediateDirectories:YES
+                                                    attributes:nil error:error]) {
+        return NO;
+    }
+
+    NSMutableDictionary *plist = [@{@"format": @(SRK_CORPUS_FORMAT), @"family": family, @"sample": sample,
+                                    @"functions": functions} mutableCopy];
+    if (hashes) plist[@"hashes"] = hashes;
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:plist format:NSPropertyListBinaryFormat_v1_0
+                                                             options:0 error:error];
+    NSString *key = SRKCorpusSampleKey(file, hashes);
+    NSString *path = [familyDirectory stringByAppendingPathComponent:[key stringByAppendingPathExtension:@"plist"]];
+    return data && [data writeToFile:path options:NSDataWritingAtomic error:error];
+}
+
+NSString *SRKFunctionCorpusFamily(NSString *directory, NSDictionary *hashes) {
+    NSString *sha256 = [hashes[@"file"] isKindOfClass:[NSDictionary class]] ? hashes[@"file"][@"sha256"] : nil;
+    if (![sha256 isKindOfClass:[NSString class]] || sha256.length == 0) return SRK_UNLABELLED_FAMILY;
+
+    NSFileManager *manager = [NSFileManager defaultManager];
+    NSString *name = [sha256 stringByAppendingPathExtension:@"plist"];
+    for (NSString *family in [manager contentsOfDirectoryAtPath:directory error:nil]) {
+        if ([family isEqualToString:SRK_UNLABELLED_FAMILY]) continue;
+        NSString *path = [[directory stringByAppendingPathComponent:family] stringByAppendingPathComponent:name];
+        if ([manager fileExistsAtPath:path]) return family;
+    }
+    return SRK_UNLABELLED_FAMILY;
+}
+
+static uint64_t SRKBandKey(const SRKFunctionFingerprint *fingerprint, NSUInteger band) {
+    const NSUInteger rows = SRK_MINHASH_SIZE / SRK_LSH_BANDS;
+    uint64_t key = SRKMix64(band + 1);
+    for (NSUInteger r = 0; r < rows; r++) {
+        key = SRKMix64(key ^ fingerprint->minhash[band * rows + r]);
+    }
+    return key;
+}
+
+static int SRKCompareBandEntries(const void *a, const void *b) {
+    uint64_t left = ((const SRKBandEntry *)a)->key;
+    uint64_t right = ((const SRKBandEntry *)b)->key;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+NSDictionary *SRKLoadFunctionCorpus(NSString *directory) {
+    NSMutableData *fingerprintData = [NSMutableData data];
+    NSMutableArray<NSDictionary *> *labels = [NSMutableArray array];
+    NSUInteger samples = 0;
+
+    NSDirectoryEnumerator<NSString *> *enumerator = [[NSFileManager defaultManager] enumeratorAtPath:directory];
+    for (NSString *relativePath in enumerator) {
+        if (![relativePath.pathExtension isEqualToString:@"plist"]) continue;
+
+        NSData *data = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:relativePath]];
+        NSDictionary *plist = data ? [NSPropertyListSerialization propertyListWithData:data options:0 format:NULL error:nil] : nil;
+        if (![plist isKindOfClass:[NSDictionary class]] || [plist[@"format"] integerValue] != SRK_CORPUS_FORMAT) continue;
+
+        // Moving a sample to another folder relabels it
+        NSString *folder = relativePath.stringByDeletingLastPathComponent.lastPathComponent;
+        NSString *family = folder.length > 0 ? folder : (plist[@"family"] ?: @"unknown");
+        NSString *sample = plist[@"sample"] ?: relativePath.lastPathComponent.stringByDeletingPathExtension;
+        // Not yet labelled: attributing to it would match a sample against its own earlier runs
+        if ([family isEqualToString:SRK_UNLABELLED_FAMILY]) continue;
+
+        NSUInteger added = 0;
+        for (NSDictionary *function in plist[@"functions"]) {
+            NSData *minhash = function[@"minhash"];
+            if (![minhash isKindOfClass:[NSData class]] || minhash.length != SRK_MINHASH_SIZE * sizeof(uint32_t)) continue;
+
+            SRKFunctionFingerprint fingerprint;
+            memset(&fingerprint, 0, sizeof(SRKFunctionFingerprint));
+            memcpy(fingerprint.minhash, minhash.bytes, minhash.length);
+            fingerprint.cfgHash = [function[@"cfg"] unsignedLongLongValue];
+            fingerprint.instructions = [function[@"instructions"] unsignedIntValue];
+            fingerprint.blocks = [function[@"blocks"] unsignedIntValue];
+            [fingerprintData appendBytes:&fingerprint length:sizeof(SRKFunctionFingerprint)];
+            [labels addObject:@{@"family": family, @"sample": sample, @"function": function[@"name"] ?: @"?"}];
+            added++;
+        }
+        if (added > 0) samples++;
+    }
+
+    NSUInteger count = labels.count;
+    if (count == 0) return nil;
+
+    NSMutableData *bandData = [NSMutableData dataWithLength:count * SRK_LSH_BANDS * sizeof(SRKBandEntry)];
+    SRKBandEntry *bands = bandData.mutableBytes;
+    const SRKFunctionFingerprint *fingerprints = fingerprintData.bytes;
+    for (NSUInteger f = 0; f < count; f++) {
+        for (NSUInteger band = 0; band < SRK_LSH_BANDS; band++) {
+            SRKBandEntry *entry = &bands[f * SRK_LSH_BANDS + band];
+            entry->key = SRKBandKey(&fingerprints[f], band);
+            entry->function = (uint32_t)f;
+        }
+    }
+    qsort(bands, count * SRK_LSH_BANDS, sizeof(SRKBandEntry), SRKCompareBandEntries);
+
+    return @{
+        @"fingerprints": fingerprintData,
+        @"labels": labels,
+        @"bands": bandData,
+        @"samples": @(samples)
+    };
+}
+
+#pragma mark - Matching
+
+/// First band entry whose key is not below the given key
+static NSUInteger SRKLowerBandBound(const SRKBandEntry *bands, NSUInteger count, uint64_t key) {
+    NSUInteger low = 0;
+    NSUInteger high = count;
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        if (bands[middle].key < key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low;
+}
+
+NSArray<NSDictionary *> *SRKMatchFunctionFingerprints(NSDictionary *corpus, NSDictionary *index,
+                                                      NSData *fingerprintData, double threshold) {
+    NSUInteger count = 0;
+    const Address *entries = SRKProcedureEntries(index, &count);
+    if (fingerprintData.length < count * sizeof(SRKFunctionFingerprint)) return @[];
+
+    NSArray<NSDictionary *> *labels = corpus[@"labels"];
+    NSData *bandData = corpus[@"bands"];
+    const SRKFunctionFingerprint *known = [corpus[@"fingerprints"] bytes];
+    const SRKBandEntry *bands = bandData.bytes;
+    NSUInteger bandCount = bandData.length / sizeof(SRKBandEntry);
+    if (labels.count == 0 || bandCount == 0) return @[];
+
+    uint32_t *bestFunction = malloc(MAX(count, 1) * sizeof(uint32_t));
+    double *bestSimilarity = calloc(MAX(count, 1), sizeof(double));
+    BOOL *cfgMatch = calloc(MAX(count, 1), sizeof(BOOL));
+    if (!bestFunction || !bestSimilarity || !cfgMatch) {
+        free(bestFunction);
+        free(bestSimilarity);
+        free(cfgMatch);
+        return @[];
+    }
+    memset(bestFunction, 0xFF, MAX(count, 1) * sizeof(uint32_t));
+
+    const SRKFunctionFingerprint *fingerprints = fingerprintData.bytes;
+    NSUInteger chunks = (count + SRK_FINGERPRINT_CHUNK - 1) / SRK_FINGERPRINT_CHUNK;
+    dispatch_apply(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+        uint32_t candidates[SRK_MAX_CANDIDATES];
+        NSUInteger last = MIN(count, (chunk + 1) * SRK_FINGERPRINT_CHUNK);
+        for (NSUInteger i = chunk * SRK_FINGERPRINT_CHUNK; i < last; i++) {
+            const SRKFunctionFingerprint *fingerprint = &fingerprints[i];
+            if (fingerprint->instructions == 0) continue;
+
+            // Any shared band makes a candidate, then the full signatures decide
+            NSUInteger candidateCount = 0;
+            for (NSUInteger band = 0; band < SRK_LSH_BANDS && candidateCount < SRK_MAX_CANDIDATES; band++) {
+                uint64_t key = SRKBandKey(fingerprint, band);
+                for (NSUInteger b = SRKLowerBandBound(bands, bandCount, key);
+                     b < bandCount && bands[b].key == key && candidateCount < SRK_MAX_CANDIDATES; b++) {
+                    candidates[candidateCount++] = bands[b].function;
+                }
+            }
+            if (candidateCount == 0) continue;
+            qsort(candidates, candidateCount, sizeof(uint32_t), SRKCompareUInt32);
+
+            for (NSUInteger c = 0; c < candidateCount; c++) {
+                if (c > 0 && candidates[c] == candidates[c - 1]) continue;
+
+                const SRKFunctionFingerprint *candidate = &known[candidates[c]];
+                double similarity = SRKFingerprintSimilarity(fingerprint, candidate);
+                BOOL sameShape = fingerprint->cfgHash != 0 && fingerprint->cfgHash == candidate->cfgHash;
+                if (similarity > bestSimilarity[i] || (similarity == bestSimilarity[i] && sameShape && !cfgMatch[i])) {
+                    bestSimilarity[i] = similarity;
+                    bestFunction[i] = candidates[c];
+                    cfgMatch[i] = sameShape;
+                }
+            }
+        }
+    });
+
+    NSMutableArray<NSDictionary *> *matches = [NSMutableArray array];
+    for (NSUInteger i = 0; i < count; i++) {
+        if (bestFunction[i] == UINT32_MAX || bestSimilarity[i] < threshold) continue;
+
+        NSDictionary *label = labels[bestFunction[i]];
+        [matches addObject:@{
+            @"address": @(entries[i]),
+            @"family": label[@"family"],
+            @"sample": label[@"sample"],
+            @"function": label[@"function"],
+            @"similarity": @(bestSimilarity[i]),
+            @"cfg_match": @(cfgMatch[i])
+        }];
+    }
+
+    free(bestFunction);
+    free(bestSimilarity);
+    free(cfgMatch);
+
+    [matches sortUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+        return [b[@"similarity"] compare:a[@"similarity"]];
+    }];
+    return matches;
+}
+
+NSArray<NSDictionary *> *SRKFamiliesForFunctionMatches(NSArray<NSDictionary *> *matches) {
+    NSMutableDictionary<NSString *, NSMutableArray<NSDictionary *> *> *grouped = [NSMutableDictionary dictionary];
+    for (NSDictionary *match in matches) {
+        NSString *family = match[@"family"];
+        if (!grouped[family]) grouped[family] = [NSMutableArray array];
+        [grouped[family] addObject:match];
+    }
+
+    NSMutableArray<NSDictionary *> *families = [NSMutableArray array];
+    for (NSString *family in grouped) {
+        double total = 0;
+        NSMutableSet<NSString *> *samples = [NSMutableSet set];
+        for (NSDictionary *match in grouped[family]) {
+            total += [match[@"similarity"] doubleValue];
+            [samples addObject:match[@"sample"]];
+        }
+        [families addObject:@{
+            @"family": family,
+            @"procedures": @(grouped[family].count),
+            @"similarity": @(total / grouped[family].count),
+            @"samples": [samples.allObjects sortedArrayUsingSelector:@selector(compare:)]
+        }];
+    }
+
+    [families sortUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+        NSComparisonResult order = [b[@"procedures"] compare:a[@"procedures"]];
+        return order != NSOrderedSame ? order : [b[@"similarity"] compare:a[@"similarity"]];
+    }];
+    return families;
+}
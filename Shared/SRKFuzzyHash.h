@@ -0,0 +1,71 @@
+/*
+ SRKFuzzyHash.h
+ Whole-sample similarity hashes for HopperSRK analyzers
+
+ Streaming fuzzy hashes computed while the bytes are read once:
+ - TLSH-style locality sensitive hash: Pearson-hashed byte triplets over
+   a 5-byte window counted into 128 buckets, encoded by quartile
+ - Context-triggered piecewise hash (ssdeep-style): a rolling hash picks
+   the chunk boundaries, one base64 character per chunk, several block
+   sizes in flight until the final one is known
+
+ Hashes are taken for the whole file, every segment and every __cstring
+ section. The corpus samples written by SRKWriteFunctionCorpusSample() keep
+ theirs, and SRKLoadSampleHashIndex() indexes them (TLSH body bands and
+ CTPH 7-grams) so that a new sample is compared only with likely neighbours.
+ The digests are not byte compatible with the reference TLSH and ssdeep
+ tools: they are only compared with each other.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Fewer bytes do not give a TLSH-style digest
+#define SRK_TLSH_MIN_LENGTH 50
+/// TLSH-style distance at or below which two samples are near duplicates
+#define SRK_TLSH_NEAR_DUPLICATE 40
+/// CTPH score (0..100) at or above which two samples are near duplicates
+#define SRK_CTPH_NEAR_DUPLICATE 80
+
+#pragma mark - Digests
+
+/// TLSH-style digest as 70 hex characters, nil when the data is too short or too uniform
+NSString * _Nullable SRKTLSHDigest(const uint8_t *bytes, NSUInteger length);
+
+/// "blocksize:digest:digest" context-triggered piecewise hash
+NSString *SRKCTPHDigest(const uint8_t *bytes, NSUInteger length);
+
+/// Distance between two TLSH-style digests, 0 for identical; NSNotFound when either is malformed
+NSUInteger SRKTLSHDistance(NSString *a, NSString *b);
+
+/// Similarity score between two CTPH digests, 0..100
+NSUInteger SRKCTPHScore(NSString *a, NSString *b);
+
+#pragma mark - Samples
+
+/**
+ * Hashes of the sample, from one read of every byte:
+ * @{@"file": @{@"tlsh"?, @"ctph", @"size", @"sha256"}, @"segments": @{name: hashes},
+ *   @"cstrings": @{segment,section: hashes}}
+ * The file hashes come from the file on disk when it is readable, from the
+ * mapped segments otherwise.
+ */
+NSDictionary *SRKComputeSampleHashes(NSObject<HPDisassembledFile> *file);
+
+/// Nearest neighbour index over the sample hashes of the corpus, nil when no sample has any
+NSDictionary * _Nullable SRKLoadSampleHashIndex(NSString *corpusDirectory);
+
+/**
+ * Corpus samples closest to the hashes, nearest first, the sample's own entry
+ * (same SHA-256, or same name and digests) left out:
+ * @{@"family", @"sample", @"tlsh_distance"?, @"ctph_score", @"cstring_distance"?, @"near_duplicate",
+ *   @"labelled": NO for samples still in SRK_UNLABELLED_FAMILY}
+ */
+NSArray<NSDictionary *> *SRKNearestSamples(NSDictionary *sampleIndex, NSDictionary *hashes, NSString * _Nullable sample,
+                                           NSUInteger maximumCount);
+
+NS_ASSUME_NONNULL_END
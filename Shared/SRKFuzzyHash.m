@@ -0,0 +1,670 @@
+/*
+ SRKFuzzyHash.m
+ Whole-sample similarity hashes for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import <CommonCrypto/CommonDigest.h>
+#import "SRKFuzzyHash.h"
+#import "SRKFunctionSimilarity.h"
+
+// TLSH-style digest: checksum, length code, quartile ratios, 32 body bytes
+#define SRK_TLSH_BUCKETS 128
+#define SRK_TLSH_DIGEST_SIZE 35
+#define SRK_TLSH_BODY_OFFSET 3
+
+// Context-triggered piecewise hash, with the spamsum constants
+#define SRK_CTPH_BLOCKS 31
+#define SRK_CTPH_LENGTH 64
+#define SRK_CTPH_WINDOW 7
+#define SRK_CTPH_MIN_BLOCK 3
+#define SRK_CTPH_INIT 0x28021967U
+#define SRK_CTPH_PRIME 0x01000193U
+
+// Bytes read from the file on disk at a time
+#define SRK_FUZZY_READ_SIZE (1 << 20)
+
+#pragma mark - TLSH-style Hash
+
+typedef struct {
+    uint32_t buckets[256];
+    uint8_t window[5];
+    uint8_t checksum;
+    uint64_t length;
+} SRKTLSHState;
+
+/// Fixed byte permutation for the Pearson hash
+static const uint8_t *SRKPearsonTable(void) {
+    static uint8_t table[256];
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (NSUInteger i = 0; i < 256; i++) table[i] = (uint8_t)i;
+        uint32_t seed = 0x9E3779B9U;
+        for (NSUInteger i = 255; i > 0; i--) {
+            seed ^= seed << 13;
+            seed ^= seed >> 17;
+            seed ^= seed << 5;
+            NSUInteger j = seed % (i + 1);
+            uint8_t swap = table[i];
+            table[i] = table[j];
+            table[j] = swap;
+        }
+    });
+    return table;
+}
+
+static inline uint8_t SRKPearson(const uint8_t *table, uint8_t salt, uint8_t a, uint8_t b, uint8_t c) {
+    uint8_t h = table[salt];
+    h = table[h ^ a];
+    h = table[h ^ b];
+    return table[h ^ c];
+}
+
+static void SRKTLSHUpdate(SRKTLSHState *state, const uint8_t *bytes, NSUInteger length) {
+    const uint8_t *table = SRKPearsonTable();
+    uint8_t *w = state->window;
+
+    for (NSUInteger i = 0; i < length; i++) {
+        w[4] = w[3];
+        w[3] = w[2];
+        w[2] = w[1];
+        w[1] = w[0];
+        w[0] = bytes[i];
+        if (++state->length < 5) continue;
+
+        // The six triplets of the 5-byte window that include the newest byte
+        state->checksum = SRKPearson(table, 0, w[0], w[1], state->checksum);
+        state->buckets[SRKPearson(table, 2, w[0], w[1], w[2])]++;
+        state->buckets[SRKPearson(table, 3, w[0], w[1], w[3])]++;
+        state->buckets[SRKPearson(table, 5, w[0], w[2], w[3])]++;
+        state->buckets[SRKPearson(table, 7, w[0], w[2], w[4])]++;
+        state->buckets[SRKPearson(table, 11, w[0], w[1], w[4])]++;
+        state->buckets[SRKPearson(table, 13, w[0], w[3], w[4])]++;
+    }
+}
+
+static uint8_t SRKTLSHLengthCode(uint64_t length) {
+    double code;
+    if (length <= 656) {
+        code = floor(log((double)length) / log(1.5));
+    } else if (length <= 3199) {
+        code = floor(log((double)length) / log(1.3) - 8.72777);
+    } else {
+        code = floor(log((double)length) / log(1.1) - 62.5472);
+    }
+    return (uint8_t)((uint64_t)MAX(code, 0.0) % 256);
+}
+
+static int SRKCompareBucketCounts(const void *a, const void *b) {
+    uint32_t left = *(const uint32_t *)a;
+    uint32_t right = *(const uint32_t *)b;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+static NSString *SRKTLSHFinal(const SRKTLSHState *state) {
+    if (state->length < SRK_TLSH_MIN_LENGTH) return nil;
+
+    uint32_t sorted[SRK_TLSH_BUCKETS];
+    memcpy(sorted, state->buckets, sizeof(sorted));
+    qsort(sorted, SRK_TLSH_BUCKETS, sizeof(uint32_t), SRKCompareBucketCounts);
+    uint32_t q1 = sorted[SRK_TLSH_BUCKETS / 4 - 1];
+    uint32_t q2 = sorted[SRK_TLSH_BUCKETS / 2 - 1];
+    uint32_t q3 = sorted[SRK_TLSH_BUCKETS * 3 / 4 - 1];
+    if (q3 == 0) return nil;
+
+    uint8_t digest[SRK_TLSH_DIGEST_SIZE];
+    memset(digest, 0, sizeof(digest));
+    digest[0] = state->checksum;
+    digest[1] = SRKTLSHLengthCode(state->length);
+    digest[2] = (uint8_t)(((uint64_t)q1 * 100 / q3) % 16) << 4 | (uint8_t)(((uint64_t)q2 * 100 / q3) % 16);
+
+    for (NSUInteger b = 0; b < SRK_TLSH_BUCKETS; b++) {
+        uint32_t count = state->buckets[b];
+        uint8_t code = count <= q1 ? 0 : (count <= q2 ? 1 : (count <= q3 ? 2 : 3));
+        digest[SRK_TLSH_BODY_OFFSET + b / 4] |= code << ((b % 4) * 2);
+    }
+
+    NSMutableString *hex = [NSMutableString stringWithCapacity:SRK_TLSH_DIGEST_SIZE * 2];
+    for (NSUInteger i = 0; i < SRK_TLSH_DIGEST_SIZE; i++) {
+        [hex appendFormat:@"%02X", digest[i]];
+    }
+    return hex;
+}
+
+static BOOL SRKParseTLSH(NSString *string, uint8_t *digest) {
+    if (string.length != SRK_TLSH_DIGEST_SIZE * 2) return NO;
+    const char *hex = string.UTF8String;
+    for (NSUInteger i = 0; i < SRK_TLSH_DIGEST_SIZE; i++) {
+        unsigned int value = 0;
+        if (sscanf(hex + i * 2, "%2x", &value) != 1) return NO;
+        digest[i] = (uint8_t)value;
+    }
+    return YES;
+}
+
+static NSUInteger SRKCircularDifference(NSUInteger a, NSUInteger b, NSUInteger range) {
+    NSUInteger difference = a > b ? a - b : b - a;
+    return MIN(difference, range - difference);
+}
+
+static NSUInteger SRKTLSHDigestDistance(const uint8_t *a, const uint8_t *b) {
+    NSUInteger distance = a[0] != b[0] ? 1 : 0;
+
+    NSUInteger lengthDifference = SRKCircularDifference(a[1], b[1], 256);
+    distance += lengthDifference <= 1 ? lengthDifference : lengthDifference * 12;
+
+    NSUInteger q1Difference = SRKCircularDifference(a[2] >> 4, b[2] >> 4, 16);
+    NSUInteger q2Difference = SRKCircularDifference(a[2] & 0xF, b[2] & 0xF, 16);
+    distance += q1Difference <= 1 ? q1Difference : (q1Difference - 1) * 12;
+    distance += q2Difference <= 1 ? q2Difference : (q2Difference - 1) * 12;
+
+    for (NSUInteger i = SRK_TLSH_BODY_OFFSET; i < SRK_TLSH_DIGEST_SIZE; i++) {
+        for (NSUInteger shift = 0; shift < 8; shift += 2) {
+            NSInteger difference = labs((NSInteger)((a[i] >> shift) & 3) - (NSInteger)((b[i] >> shift) & 3));
+            distance += difference == 3 ? 6 : (NSUInteger)difference;
+        }
+    }
+    return distance;
+}
+
+NSUInteger SRKTLSHDistance(NSString *a, NSString *b) {
+    uint8_t left[SRK_TLSH_DIGEST_SIZE];
+    uint8_t right[SRK_TLSH_DIGEST_SIZE];
+    if (!SRKParseTLSH(a, left) || !SRKParseTLSH(b, right)) return NSNotFound;
+    return SRKTLSHDigestDistance(left, right);
+}
+
+#pragma mark - Context-Triggered Piecewise Hash
+
+static const char SRKBase64Alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+typedef struct {
+    uint32_t h;
+    uint32_t length;
+    char digest[SRK_CTPH_LENGTH];
+} SRKCTPHBlock;
+
+typedef struct {
+    uint8_t window[SRK_CTPH_WINDOW];
+    uint32_t h1;
+    uint32_t h2;
+    uint32_t h3;
+    uint32_t n;
+    /// Block sizes 3 << start ..< 3 << end are still in flight
+    uint32_t start;
+    uint32_t end;
+    uint64_t total;
+    SRKCTPHBlock blocks[SRK_CTPH_BLOCKS];
+} SRKCTPHState;
+
+static void SRKCTPHInit(SRKCTPHState *state) {
+    memset(state, 0, sizeof(SRKCTPHState));
+    state->end = 1;
+    state->blocks[0].h = SRK_CTPH_INIT;
+}
+
+static void SRKCTPHUpdate(SRKCTPHState *state, const uint8_t *bytes, NSUInteger length) {
+    for (NSUInteger i = 0; i < length; i++) {
+        uint8_t c = bytes[i];
+
+        // Rolling hash over the last SRK_CTPH_WINDOW bytes
+        state->h2 = state->h2 - state->h1 + SRK_CTPH_WINDOW * (uint32_t)c;
+        state->h1 = state->h1 + c - state->window[state->n % SRK_CTPH_WINDOW];
+        state->window[state->n % SRK_CTPH_WINDOW] = c;
+        state->n++;
+        state->h3 = (state->h3 << 5) ^ c;
+        uint32_t roll = state->h1 + state->h2 + state->h3;
+
+        for (uint32_t b = state->start; b < state->end; b++) {
+            state->blocks[b].h = (state->blocks[b].h * SRK_CTPH_PRIME) ^ c;
+        }
+        state->total++;
+
+        if (roll % SRK_CTPH_MIN_BLOCK != SRK_CTPH_MIN_BLOCK - 1) continue;
+
+        // A trigger for a block size is also one for every smaller block size
+        for (uint32_t b = state->start; b < state->end; b++) {
+            uint32_t blockSize = (uint32_t)SRK_CTPH_MIN_BLOCK << b;
+            if (roll % blockSize != blockSize - 1) break;
+
+            SRKCTPHBlock *block = &state->blocks[b];
+            if (block->length == 0 && b == state->end - 1 && state->end < SRK_CTPH_BLOCKS) {
+                // The next block size has never triggered, so its hash equals this one so far
+                state->blocks[state->end].h = block->h;
+                state->blocks[state->end].length = 0;
+                state->end++;
+            }
+            if (block->length < SRK_CTPH_LENGTH - 1) {
+                block->digest[block->length++] = SRKBase64Alphabet[block->h % 64];
+                block->h = SRK_CTPH_INIT;
+            }
+        }
+
+        // A full digest whose double is long enough will never be the chosen block size
+        while (state->end - state->start >= 2 &&
+               ((uint64_t)SRK_CTPH_MIN_BLOCK << state->start) * SRK_CTPH_LENGTH < state->total &&
+               state->blocks[state->start + 1].length >= SRK_CTPH_LENGTH / 2) {
+            state->start++;
+        }
+    }
+}
+
+static NSString *SRKCTPHBlockDigest(const SRKCTPHBlock *block, NSUInteger maximumLength) {
+    NSMutableString *digest = [[NSMutableString alloc] initWithBytes:block->digest
+                                                              length:MIN(block->length, maximumLength - 1)
+                                                            encoding:NSASCIIStringEncoding];
+    if (block->h != SRK_CTPH_INIT) {
+        [digest appendFormat:@"%c", SRKBase64Alphabet[block->h % 64]];
+    }
+    return digest;
+}
+
+static NSString *SRKCTPHFinal(const SRKCTPHState *state) {
+    uint32_t b = state->start;
+    while (((uint64_t)SRK_CTPH_MIN_BLOCK << b) * SRK_CTPH_LENGTH < state->total && b + 1 < state->end) b++;
+    while (b > state->start && state->blocks[b].length < SRK_CTPH_LENGTH / 2) b--;
+
+    NSString *first = SRKCTPHBlockDigest(&state->blocks[b], SRK_CTPH_LENGTH);
+    NSString *second = b + 1 < state->end ? SRKCTPHBlockDigest(&state->blocks[b + 1], SRK_CTPH_LENGTH / 2) : @"";
+    return [NSString stringWithFormat:@"%u:%@:%@", (uint32_t)SRK_CTPH_MIN_BLOCK << b, first, second];
+}
+
+/// Runs of more than three identical characters say little and are cut to three
+static NSString *SRKCollapseRuns(NSString *digest) {
+    NSMutableString *collapsed = [NSMutableString stringWithCapacity:digest.length];
+    for (NSUInteger i = 0; i < digest.length; i++) {
+        unichar c = [digest characterAtIndex:i];
+        if (i >= 3 && c == [digest characterAtIndex:i - 1] && c == [digest characterAtIndex:i - 2] &&
+            c == [digest characterAtIndex:i - 3]) {
+            continue;
+        }
+        [collapsed appendFormat:@"%C", c];
+    }
+    return collapsed;
+}
+
+static BOOL SRKShareWindow(NSString *a, NSString *b) {
+    if (a.length < SRK_CTPH_WINDOW || b.length < SRK_CTPH_WINDOW) return NO;
+
+    NSMutableSet<NSString *> *windows = [NSMutableSet set];
+    for (NSUInteger i = 0; i + SRK_CTPH_WINDOW <= a.length; i++) {
+        [windows addObject:[a substringWithRange:NSMakeRange(i, SRK_CTPH_WINDOW)]];
+    }
+    for (NSUInteger i = 0; i + SRK_CTPH_WINDOW <= b.length; i++) {
+        if ([windows containsObject:[b substringWithRange:NSMakeRange(i, SRK_CTPH_WINDOW)]]) return YES;
+    }
+    return NO;
+}
+
+/// Edit distance with insertions and deletions costing 1 and substitutions 2
+static NSUInteger SRKEditDistance(NSString *a, NSString *b) {
+    NSUInteger rows = a.length;
+    NSUInteger columns = b.length;
+    NSUInteger previous[SRK_CTPH_LENGTH + 1];
+    NSUInteger current[SRK_CTPH_LENGTH + 1];
+    if (rows > SRK_CTPH_LENGTH || columns > SRK_CTPH_LENGTH) return rows + columns;
+
+    for (NSUInteger j = 0; j <= columns; j++) previous[j] = j;
+    for (NSUInteger i = 1; i <= rows; i++) {
+        current[0] = i;
+        unichar c = [a characterAtIndex:i - 1];
+        for (NSUInteger j = 1; j <= columns; j++) {
+            NSUInteger substitution = previous[j - 1] + (c == [b characterAtIndex:j - 1] ? 0 : 2);
+            current[j] = MIN(MIN(previous[j] + 1, current[j - 1] + 1), substitution);
+        }
+        memcpy(previous, current, sizeof(NSUInteger) * (columns + 1));
+    }
+    return previous[columns];
+}
+
+static NSUInteger SRKScoreDigests(NSString *a, NSString *b) {
+    if (!SRKShareWindow(a, b)) return 0;
+
+    NSUInteger scaled = SRKEditDistance(a, b) * SRK_CTPH_LENGTH / (a.length + b.length);
+    scaled = 100 * scaled / SRK_CTPH_LENGTH;
+    return scaled >= 100 ? 0 : 100 - scaled;
+}
+
+NSUInteger SRKCTPHScore(NSString *a, NSString *b) {
+    NSArray<NSString *> *left = [a componentsSeparatedByString:@":"];
+    NSArray<NSString *> *right = [b componentsSeparatedByString:@":"];
+    if (left.count != 3 || right.count != 3) return 0;
+
+    unsigned long long leftSize = strtoull(left[0].UTF8String, NULL, 10);
+    unsigned long long rightSize = strtoull(right[0].UTF8String, NULL, 10);
+    NSString *left1 = SRKCollapseRuns(left[1]);
+    NSString *left2 = SRKCollapseRuns(left[2]);
+    NSString *right1 = SRKCollapseRuns(right[1]);
+    NSString *right2 = SRKCollapseRuns(right[2]);
+
+    if (leftSize == rightSize) {
+        if ([left1 isEqualToString:right1] && left1.length > 0) return 100;
+        return MAX(SRKScoreDigests(left1, right1), SRKScoreDigests(left2, right2));
+    }
+    if (leftSize == rightSize * 2) return SRKScoreDigests(left1, right2);
+    if (rightSize == leftSize * 2) return SRKScoreDigests(left2, right1);
+    return 0;
+}
+
+#pragma mark - Digests
+
+NSString *SRKTLSHDigest(const uint8_t *bytes, NSUInteger length) {
+    SRKTLSHState state;
+    memset(&state, 0, sizeof(SRKTLSHState));
+    SRKTLSHUpdate(&state, bytes, length);
+    return SRKTLSHFinal(&state);
+}
+
+NSString *SRKCTPHDigest(const uint8_t *bytes, NSUInteger length) {
+    SRKCTPHState *state = malloc(sizeof(SRKCTPHState));
+    if (!state) return @"3::";
+    SRKCTPHInit(state);
+    SRKCTPHUpdate(state, bytes, length);
+    NSString *digest = SRKCTPHFinal(state);
+    free(state);
+    return digest;
+}
+
+#pragma mark - Samples
+
+typedef struct {
+    SRKTLSHState tlsh;
+    SRKCTPHState ctph;
+} SRKFuzzyState;
+
+static SRKFuzzyState *SRKFuzzyStateCreate(void) {
+    SRKFuzzyState *state = calloc(1, sizeof(SRKFuzzyState));
+    if (state) SRKCTPHInit(&state->ctph);
+    return state;
+}
+
+static void SRKFuzzyStateUpdate(SRKFuzzyState *state, const uint8_t *bytes, NSUInteger length) {
+    if (!state || length == 0) return;
+    SRKTLSHUpdate(&state->tlsh, bytes, length);
+    SRKCTPHUpdate(&state->ctph, bytes, length);
+}
+
+/// Hashes of the state, which is freed
+static NSDictionary *SRKFuzzyStateFinish(SRKFuzzyState *state) {
+    if (!state) return @{};
+
+    NSMutableDictionary *hashes = [NSMutableDictionary dictionary];
+    NSString *tlsh = SRKTLSHFinal(&state->tlsh);
+    if (tlsh) hashes[@"tlsh"] = tlsh;
+    hashes[@"ctph"] = SRKCTPHFinal(&state->ctph);
+    hashes[@"size"] = @(state->tlsh.length);
+    free(state);
+    return hashes;
+}
+
+/// Feeds the whole-file fuzzy hashes and SHA-256 alike
+static void SRKFileHashUpdate(SRKFuzzyState *state, CC_SHA256_CTX *digest, const uint8_t *bytes, NSUInteger length) {
+    SRKFuzzyStateUpdate(state, bytes, length);
+    if (length > 0) CC_SHA256_Update(digest, bytes, (CC_LONG)length);
+}
+
+NSDictionary *SRKComputeSampleHashes(NSObject<HPDisassembledFile> *file) {
+    SRKFuzzyState *fileState = SRKFuzzyStateCreate();
+    CC_SHA256_CTX fileDigest;
+    CC_SHA256_Init(&fileDigest);
+
+    // The file on disk covers headers and signatures the segments do not map
+    BOOL fileFromDisk = NO;
+    NSString *path = file.originalFilePath;
+    NSFileHandle *handle = path ? [NSFileHandle fileHandleForReadingAtPath:path] : nil;
+    if (handle) {
+        fileFromDisk = YES;
+        for (;;) {
+            @autoreleasepool {
+                NSData *chunk = [handle readDataOfLength:SRK_FUZZY_READ_SIZE];
+                if (chunk.length == 0) break;
+                SRKFileHashUpdate(fileState, &fileDigest, chunk.bytes, chunk.length);
+            }
+        }
+        [handle closeFile];
+    }
+
+    NSMutableDictionary<NSString *, NSDictionary *> *segmentHashes = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSString *, NSDictionary *> *cstringHashes = [NSMutableDictionary dictionary];
+
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length == 0) continue;
+        const uint8_t *bytes = data.bytes;
+
+        NSMutableArray<NSObject<HPSection> *> *cstrings = [NSMutableArray array];
+        for (NSObject<HPSection> *section in [segment sections]) {
+            if ([section.sectionName isEqualToString:@"__cstring"] && section.startAddress >= segment.startAddress &&
+                section.startAddress < segment.startAddress + data.length) {
+                [cstrings addObject:section];
+            }
+        }
+        [cstrings sortUsingComparator:^NSComparisonResult(NSObject<HPSection> *a, NSObject<HPSection> *b) {
+            return a.startAddress < b.startAddress ? NSOrderedAscending :
+                   (a.startAddress > b.startAddress ? NSOrderedDescending : NSOrderedSame);
+        }];
+
+        // One pass over the segment: every run feeds the segment, the file and its __cstring section
+        SRKFuzzyState *segmentState = SRKFuzzyStateCreate();
+        NSUInteger offset = 0;
+        for (NSObject<HPSection> *section in cstrings) {
+            NSUInteger start = MAX(offset, (NSUInteger)(section.startAddress - segment.startAddress));
+            NSUInteger end = MIN(data.length, (NSUInteger)(section.endAddress - segment.startAddress));
+            if (end <= start) continue;
+
+            SRKFuzzyStateUpdate(segmentState, bytes + offset, start - offset);
+            if (!fileFromDisk) SRKFileHashUpdate(fileState, &fileDigest, bytes + offset, start - offset);
+
+            SRKFuzzyState *sectionState = SRKFuzzyStateCreate();
+            SRKFuzzyStateUpdate(segmentState, bytes + start, end - start);
+            SRKFuzzyStateUpdate(sectionState, bytes + start, end - start);
+            if (!fileFromDisk) SRKFileHashUpdate(fileState, &fileDigest, bytes + start, end - start);
+            NSString *key = [NSString stringWithFormat:@"%@,%@", segment.segmentName, section.sectionName];
+            cstringHashes[key] = SRKFuzzyStateFinish(sectionState);
+            offset = end;
+        }
+        SRKFuzzyStateUpdate(segmentState, bytes + offset, data.length - offset);
+        if (!fileFromDisk) SRKFileHashUpdate(fileState, &fileDigest, bytes + offset, data.length - offset);
+
+        segmentHashes[segment.segmentName ?: [NSString stringWithFormat:@"0x%llx", segment.startAddress]] =
+            SRKFuzzyStateFinish(segmentState);
+    }
+
+    uint8_t digest[CC_SHA256_DIGEST_LENGTH];
+    CC_SHA256_Final(digest, &fileDigest);
+    NSMutableString *sha256 = [NSMutableString stringWithCapacity:CC_SHA256_DIGEST_LENGTH * 2];
+    for (NSUInteger i = 0; i < CC_SHA256_DIGEST_LENGTH; i++) [sha256 appendFormat:@"%02x", digest[i]];
+
+    NSMutableDictionary *fileHashes = [SRKFuzzyStateFinish(fileState) mutableCopy];
+    fileHashes[@"sha256"] = sha256;
+
+    return @{
+        @"file": fileHashes,
+        @"segments": segmentHashes,
+        @"cstrings": cstringHashes
+    };
+}
+
+#pragma mark - Nearest Neighbours
+
+typedef struct {
+    uint64_t key;
+    uint32_t sample;
+    uint32_t reserved;
+} SRKSampleKey;
+
+static inline uint64_t SRKFuzzyMix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+/// TLSH body bands and CTPH 7-grams (tagged with their block size) of the file hashes
+static NSData *SRKSampleKeys(NSDictionary *fileHashes) {
+    NSMutableData *keys = [NSMutableData data];
+
+    uint8_t digest[SRK_TLSH_DIGEST_SIZE];
+    if ([fileHashes[@"tlsh"] isKindOfClass:[NSString class]] && SRKParseTLSH(fileHashes[@"tlsh"], digest)) {
+        for (NSUInteger band = 0; band < 8; band++) {
+            uint32_t bytes;
+            memcpy(&bytes, digest + SRK_TLSH_BODY_OFFSET + band * 4, 4);
+            uint64_t key = SRKFuzzyMix(SRKFuzzyMix(0x544C5348ULL + band) ^ bytes);
+            [keys appendBytes:&key length:sizeof(uint64_t)];
+        }
+    }
+
+    NSArray<NSString *> *parts = [fileHashes[@"ctph"] isKindOfClass:[NSString class]] ?
+                                 [fileHashes[@"ctph"] componentsSeparatedByString:@":"] : @[];
+    if (parts.count == 3) {
+        unsigned long long blockSize = strtoull(parts[0].UTF8String, NULL, 10);
+        for (NSUInteger p = 1; p <= 2; p++) {
+            const char *digestCharacters = SRKCollapseRuns(parts[p]).UTF8String;
+            size_t length = strlen(digestCharacters);
+            uint64_t size = blockSize << (p - 1);
+            for (size_t i = 0; i + SRK_CTPH_WINDOW <= length; i++) {
+                uint64_t key = SRKFuzzyMix(size);
+                for (size_t k = 0; k < SRK_CTPH_WINDOW; k++) key = SRKFuzzyMix(key ^ (uint8_t)digestCharacters[i + k]);
+                [keys appendBytes:&key length:sizeof(uint64_t)];
+            }
+        }
+    }
+    return keys;
+}
+
+static int SRKCompareSampleKeys(const void *a, const void *b) {
+    uint64_t left = ((const SRKSampleKey *)a)->key;
+    uint64_t right = ((const SRKSampleKey *)b)->key;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+NSDictionary *SRKLoadSampleHashIndex(NSString *corpusDirectory) {
+    NSMutableArray<NSDictionary *> *samples = [NSMutableArray array];
+    NSMutableData *keyData = [NSMutableData data];
+
+    NSDirectoryEnumerator<NSString *> *enumerator = [[NSFileManager defaultManager] enumeratorAtPath:corpusDirectory];
+    for (NSString *relativePath in enumerator) {
+        if (![relativePath.pathExtension isEqualToString:@"plist"]) continue;
+
+        NSData *data = [NSData dataWithContentsOfFile:[corpusDirectory stringByAppendingPathComponent:relativePath]];
+        NSDictionary *plist = data ? [NSPropertyListSerialization propertyListWithData:data options:0 format:NULL error:nil] : nil;
+        if (![plist isKindOfClass:[NSDictionary class]] || ![plist[@"hashes"] isKindOfClass:[NSDictionary class]]) continue;
+
+        // Labelled the same way as SRKLoadFunctionCorpus(): by the folder the sample sits in
+        NSString *folder = relativePath.stringByDeletingLastPathComponent.lastPathComponent;
+        NSString *family = folder.length > 0 ? folder : (plist[@"family"] ?: @"unknown");
+        NSString *sample = plist[@"sample"] ?: relativePath.lastPathComponent.stringByDeletingPathExtension;
+
+        uint32_t sampleIndex = (uint32_t)samples.count;
+        [samples addObject:@{@"family": family, @"sample": sample, @"hashes": plist[@"hashes"]}];
+
+        NSData *keys = SRKSampleKeys(plist[@"hashes"][@"file"]);
+        const uint64_t *values = keys.bytes;
+        for (NSUInteger k = 0; k < keys.length / sizeof(uint64_t); k++) {
+            SRKSampleKey entry = {values[k], sampleIndex, 0};
+            [keyData appendBytes:&entry length:sizeof(SRKSampleKey)];
+        }
+    }
+
+    if (samples.count == 0) return nil;
+    qsort(keyData.mutableBytes, keyData.length / sizeof(SRKSampleKey), sizeof(SRKSampleKey), SRKCompareSampleKeys);
+    return @{@"samples": samples, @"keys": keyData};
+}
+
+static NSUInteger SRKCStringDistance(NSDictionary *a, NSDictionary *b) {
+    NSUInteger best = NSNotFound;
+    for (NSString *section in a) {
+        NSString *left = a[section][@"tlsh"];
+        NSString *right = [b[section] isKindOfClass:[NSDictionary class]] ? b[section][@"tlsh"] : nil;
+        if (![left isKindOfClass:[NSString class]] || ![right isKindOfClass:[NSString class]]) continue;
+        best = MIN(best, SRKTLSHDistance(left, right));
+    }
+    return best;
+}
+
+/// The sample's own corpus entry: same SHA-256, or for entries without one the same name and digests
+static BOOL SRKIsSameSample(NSDictionary *candidateFile, NSString *candidateName, NSDictionary *queryFile,
+                            NSString *queryName) {
+    NSString *sha256 = queryFile[@"sha256"];
+    if ([candidateFile[@"sha256"] isKindOfClass:[NSString class]] && sha256) {
+        return [candidateFile[@"sha256"] isEqualToString:sha256];
+    }
+    if (!queryName || ![candidateName isEqualToString:queryName]) return NO;
+
+    id tlsh = queryFile[@"tlsh"];
+    BOOL sameTLSH = tlsh ? [tlsh isEqual:candidateFile[@"tlsh"]] : candidateFile[@"tlsh"] == nil;
+    return sameTLSH && [queryFile[@"ctph"] isEqual:candidateFile[@"ctph"]];
+}
+
+NSArray<NSDictionary *> *SRKNearestSamples(NSDictionary *sampleIndex, NSDictionary *hashes, NSString *sample,
+                                           NSUInteger maximumCount) {
+    NSArray<NSDictionary *> *samples = sampleIndex[@"samples"];
+    NSData *keyData = sampleIndex[@"keys"];
+    const SRKSampleKey *keys = keyData.bytes;
+    NSUInteger keyCount = keyData.length / sizeof(SRKSampleKey);
+
+    // Only samples sharing a TLSH band or a CTPH 7-gram are scored
+    NSMutableIndexSet *candidates = [NSMutableIndexSet indexSet];
+    NSData *queryKeys = SRKSampleKeys(hashes[@"file"]);
+    const uint64_t *query = queryKeys.bytes;
+    for (NSUInteger q = 0; q < queryKeys.length / sizeof(uint64_t); q++) {
+        NSUInteger low = 0;
+        NSUInteger high = keyCount;
+        while (low < high) {
+            NSUInteger middle = low + (high - low) / 2;
+            if (keys[middle].key < query[q]) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        for (NSUInteger k = low; k < keyCount && keys[k].key == query[q]; k++) {
+            [candidates addIndex:keys[k].sample];
+        }
+    }
+
+    NSMutableArray<NSDictionary *> *neighbours = [NSMutableArray array];
+    NSString *tlsh = hashes[@"file"][@"tlsh"];
+    NSString *ctph = hashes[@"file"][@"ctph"];
+    [candidates enumerateIndexesUsingBlock:^(NSUInteger s, BOOL *stop) {
+        NSDictionary *candidate = samples[s];
+        NSDictionary *candidateFile = candidate[@"hashes"][@"file"];
+        if (SRKIsSameSample(candidateFile, candidate[@"sample"], hashes[@"file"], sample)) return;
+
+        NSUInteger distance = (tlsh && [candidateFile[@"tlsh"] isKindOfClass:[NSString class]]) ?
+                              SRKTLSHDistance(tlsh, candidateFile[@"tlsh"]) : NSNotFound;
+        NSUInteger score = (ctph && [candidateFile[@"ctph"] isKindOfClass:[NSString class]]) ?
+                           SRKCTPHScore(ctph, candidateFile[@"ctph"]) : 0;
+        NSUInteger cstringDistance = SRKCStringDistance(hashes[@"cstrings"], candidate[@"hashes"][@"cstrings"]);
+
+        NSMutableDictionary *neighbour = [@{
+            @"family": candidate[@"family"],
+            @"sample": candidate[@"sample"],
+            @"ctph_score": @(score),
+            @"labelled": @(![candidate[@"family"] isEqualToString:SRK_UNLABELLED_FAMILY]),
+            @"near_duplicate": @((distance != NSNotFound && distance <= SRK_TLSH_NEAR_DUPLICATE) ||
+                                 score >= SRK_CTPH_NEAR_DUPLICATE)
+        } mutableCopy];
+        if (distance != NSNotFound) neighbour[@"tlsh_distance"] = @(distance);
+        if (cstringDistance != NSNotFound) neighbour[@"cstring_distance"] = @(cstringDistance);
+        [neighbours addObject:neighbour];
+    }];
+
+    [neighbours sortUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+        if ([a[@"near_duplicate"] boolValue] != [b[@"near_duplicate"] boolValue]) {
+            return [a[@"near_duplicate"] boolValue] ? NSOrderedAscending : NSOrderedDescending;
+        }
+        NSUInteger left = a[@"tlsh_distance"] ? [a[@"tlsh_distance"] unsignedIntegerValue] : NSNotFound;
+        NSUInteger right = b[@"tlsh_distance"] ? [b[@"tlsh_distance"] unsignedIntegerValue] : NSNotFound;
+        if (left != right) return left < right ? NSOrderedAscending : NSOrderedDescending;
+        return [b[@"ctph_score"] compare:a[@"ctph_score"]];
+    }];
+
+    return maximumCount > 0 && neighbours.count > maximumCount ?
+           [neighbours subarrayWithRange:NSMakeRange(0, maximumCount)] : neighbours;
+}
@@ -0,0 +1,59 @@
+/*
+ SRKIOCSet.h
+ Exact IOC set lookup for HopperSRK analyzers
+
+ Exact indicators (file paths, mutex and semaphore names, user agents,
+ bundle identifiers, MD5/SHA-1/SHA-256 file hashes) come from plain text
+ files in the IOC directory, one per line, the file name being the source
+ tag of a hit. They are compiled once into a memory-mapped set:
+ - a 64-bit hash per IOC (hex file hashes lowercased first)
+ - a hash-and-displace perfect hash: each IOC hashes to a bucket whose
+   16-bit displacement sends it to its own slot, with 1% spare slots
+ - per slot, a 32-bit fingerprint of the IOC hash and its source, so a
+   probe is two hashes and one compare, and a false hit needs a 2^-32
+   fingerprint collision
+ Strings extracted from the binary are hashed in batches straight from the
+ mapped segment bytes; only the hits become NSStrings.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Shortest extracted string probed against the set
+#define SRK_IOC_MIN_STRING 4
+
+/// ~/Library/Application Support/HopperSRK/IOCs
+NSString *SRKIOCDirectory(void);
+
+/// Compiles the *.txt IOC files of the directory into its mapped set; count receives the IOCs
+BOOL SRKCompileIOCSet(NSString *directory, NSUInteger * _Nullable count, NSError **error);
+
+/// Maps the compiled set of the directory, nil when there is none
+NSDictionary * _Nullable SRKOpenIOCSet(NSString *directory);
+
+#pragma mark - Probing
+
+/// Hash of an IOC as the set stores it (hex digests compared lowercase)
+uint64_t SRKIOCHash(const char *bytes, size_t length);
+
+/// SRKIOCHash() of every string, spread over the cores
+void SRKIOCHashBatch(const char * _Nonnull const * _Nonnull strings, const size_t *lengths, NSUInteger count,
+                     uint64_t *hashes);
+
+/// Source index of the IOC with the hash, -1 when the set does not hold it
+NSInteger SRKIOCSetSource(NSDictionary *set, uint64_t hash);
+
+/// Source tag of a source index
+NSString *SRKIOCSourceName(NSDictionary *set, NSInteger source);
+
+/// Strings of the string and constant sections held by the set: @[@{@"address", @"value", @"source"}]
+NSArray<NSDictionary *> *SRKMatchStringIOCs(NSObject<HPDisassembledFile> *file, NSDictionary *set);
+
+/// MD5, SHA-1 and SHA-256 of the file on disk held by the set: @[@{@"algorithm", @"value", @"source"}]
+NSArray<NSDictionary *> *SRKMatchFileHashIOCs(NSObject<HPDisassembledFile> *file, NSDictionary *set);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,446 @@
+/*
+ SRKIOCSet.m
+ Exact IOC set lookup for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import <CommonCrypto/CommonDigest.h>
+#import "SRKIOCSet.h"
+
+#define SRK_IOC_MAGIC "SRKIOC1"
+// Average IOCs per displacement bucket
+#define SRK_IOC_BUCKET_SIZE 4
+// Seeds tried before giving up on a perfect hash
+#define SRK_IOC_MAX_SEEDS 16
+// Longest IOC; longer lines and strings are not probed
+#define SRK_IOC_MAX_LENGTH 4096
+// Strings hashed per dispatch_apply iteration
+#define SRK_IOC_BATCH 1024
+
+static NSString *const SRKIOCSetFile = @"iocs.bin";
+
+typedef struct {
+    char magic[8];
+    uint64_t seed;
+    uint32_t count;
+    uint32_t slotCount;
+    uint32_t bucketCount;
+    uint32_t sourceBytes;
+    uint64_t displacementsOffset;
+    uint64_t slotsOffset;
+    uint64_t sourcesOffset;
+} SRKIOCHeader;
+
+typedef struct {
+    /// Never 0, which marks an empty slot
+    uint32_t fingerprint;
+    uint16_t source;
+    uint16_t reserved;
+} SRKIOCSlot;
+
+#pragma mark - Hashing
+
+static inline uint64_t SRKIOCMix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+static inline uint64_t SRKIOCRotate(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+/// Eight bytes per round, multiply-rotate like the xxHash family
+static uint64_t SRKIOCRawHash(const uint8_t *bytes, size_t length) {
+    const uint64_t prime1 = 0x9E3779B185EBCA87ULL;
+    const uint64_t prime2 = 0xC2B2AE3D27D4EB4FULL;
+    uint64_t hash = 0x27D4EB2F165667C5ULL ^ (length * prime1);
+
+    size_t i = 0;
+    for (; i + 8 <= length; i += 8) {
+        uint64_t word;
+        memcpy(&word, bytes + i, 8);
+        hash ^= SRKIOCRotate(word * prime2, 31) * prime1;
+        hash = SRKIOCRotate(hash, 27) * prime1 + 0x85EBCA77C2B2AE63ULL;
+    }
+    uint64_t tail = 0;
+    for (size_t shift = 0; i < length; i++, shift += 8) {
+        tail |= (uint64_t)bytes[i] << shift;
+    }
+    hash ^= SRKIOCRotate(tail * prime2, 31) * prime1;
+    return SRKIOCMix(hash);
+}
+
+uint64_t SRKIOCHash(const char *bytes, size_t length) {
+    // MD5, SHA-1 and SHA-256 digests match whatever case the intel used
+    if (length == 32 || length == 40 || length == 64) {
+        char lower[64];
+        BOOL hex = YES;
+        for (size_t i = 0; i < length && hex; i++) {
+            hex = isxdigit((unsigned char)bytes[i]) != 0;
+            lower[i] = (char)tolower((unsigned char)bytes[i]);
+        }
+        if (hex) return SRKIOCRawHash((const uint8_t *)lower, length);
+    }
+    return SRKIOCRawHash((const uint8_t *)bytes, length);
+}
+
+void SRKIOCHashBatch(const char *const *strings, const size_t *lengths, NSUInteger count, uint64_t *hashes) {
+    size_t chunks = (count + SRK_IOC_BATCH - 1) / SRK_IOC_BATCH;
+    dispatch_apply(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+        NSUInteger end = MIN(count, (chunk + 1) * SRK_IOC_BATCH);
+        for (NSUInteger i = chunk * SRK_IOC_BATCH; i < end; i++) {
+            hashes[i] = SRKIOCHash(strings[i], lengths[i]);
+        }
+    });
+}
+
+static inline uint32_t SRKIOCFingerprint(uint64_t hash) {
+    uint32_t fingerprint = (uint32_t)(hash >> 32);
+    return fingerprint ? fingerprint : 1;
+}
+
+static inline uint32_t SRKIOCBucket(uint64_t hash, uint64_t seed, uint32_t bucketCount) {
+    return (uint32_t)(SRKIOCMix(hash ^ seed) % bucketCount);
+}
+
+static inline uint32_t SRKIOCPosition(uint64_t hash, uint64_t displacementKey, uint32_t slotCount) {
+    return (uint32_t)(SRKIOCMix(hash ^ displacementKey) % slotCount);
+}
+
+static inline uint64_t SRKIOCDisplacementKey(uint64_t seed, uint32_t displacement) {
+    return SRKIOCMix(seed + displacement + 1);
+}
+
+#pragma mark - Compiling
+
+NSString *SRKIOCDirectory(void) {
+    NSString *support = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES).firstObject;
+    if (!support) support = [NSHomeDirectory() stringByAppendingPathComponent:@"Library/Application Support"];
+    return [support stringByAppendingPathComponent:@"HopperSRK/IOCs"];
+}
+
+typedef struct {
+    uint64_t hash;
+    uint32_t bucket;
+    uint16_t source;
+    uint16_t reserved;
+} SRKIOCKey;
+
+static int SRKCompareIOCHashes(const void *a, const void *b) {
+    const SRKIOCKey *left = a;
+    const SRKIOCKey *right = b;
+    if (left->hash != right->hash) return left->hash < right->hash ? -1 : 1;
+    return left->source < right->source ? -1 : (left->source > right->source ? 1 : 0);
+}
+
+static int SRKCompareIOCBuckets(const void *a, const void *b) {
+    uint32_t left = ((const SRKIOCKey *)a)->bucket;
+    uint32_t right = ((const SRKIOCKey *)b)->bucket;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+typedef struct {
+    uint32_t bucket;
+    uint32_t first;
+    uint32_t size;
+} SRKIOCBucketRun;
+
+static int SRKCompareBucketRuns(const void *a, const void *b) {
+    const SRKIOCBucketRun *left = a;
+    const SRKIOCBucketRun *right = b;
+    if (left->size != right->size) return left->size > right->size ? -1 : 1;
+    return left->bucket < right->bucket ? -1 : (left->bucket > right->bucket ? 1 : 0);
+}
+
+/// Displacements and slots for the keys with the seed, NO when some bucket finds no displacement
+static BOOL SRKPlaceIOCs(SRKIOCKey *keys, uint32_t count, uint64_t seed, uint32_t bucketCount, uint32_t slotCount,
+                         uint16_t *displacements, SRKIOCSlot *slots) {
+    for (uint32_t i = 0; i < count; i++) keys[i].bucket = SRKIOCBucket(keys[i].hash, seed, bucketCount);
+    qsort(keys, count, sizeof(SRKIOCKey), SRKCompareIOCBuckets);
+
+    NSMutableData *runData = [NSMutableData data];
+    for (uint32_t i = 0; i < count;) {
+        uint32_t j = i + 1;
+        while (j < count && keys[j].bucket == keys[i].bucket) j++;
+        SRKIOCBucketRun run = {keys[i].bucket, i, j - i};
+        [runData appendBytes:&run length:sizeof(SRKIOCBucketRun)];
+        i = j;
+    }
+    SRKIOCBucketRun *runs = runData.mutableBytes;
+    NSUInteger runCount = runData.length / sizeof(SRKIOCBucketRun);
+    qsort(runs, runCount, sizeof(SRKIOCBucketRun), SRKCompareBucketRuns);
+
+    memset(displacements, 0, bucketCount * sizeof(uint16_t));
+    memset(slots, 0, slotCount * sizeof(SRKIOCSlot));
+
+    // Largest buckets first, while most slots are still free
+    uint32_t positions[64];
+    for (NSUInteger r = 0; r < runCount; r++) {
+        if (runs[r].size > 64) return NO;
+
+        BOOL placed = NO;
+        for (uint32_t displacement = 0; displacement <= UINT16_MAX && !placed; displacement++) {
+            uint64_t displacementKey = SRKIOCDisplacementKey(seed, displacement);
+            placed = YES;
+            for (uint32_t k = 0; k < runs[r].size && placed; k++) {
+                positions[k] = SRKIOCPosition(keys[runs[r].first + k].hash, displacementKey, slotCount);
+                if (slots[positions[k]].fingerprint != 0) placed = NO;
+                for (uint32_t earlier = 0; earlier < k && placed; earlier++) {
+                    if (positions[earlier] == positions[k]) placed = NO;
+                }
+            }
+            if (!placed) continue;
+
+            displacements[runs[r].bucket] = (uint16_t)displacement;
+            for (uint32_t k = 0; k < runs[r].size; k++) {
+                const SRKIOCKey *key = &keys[runs[r].first + k];
+                slots[positions[k]] = (SRKIOCSlot){SRKIOCFingerprint(key->hash), key->source, 0};
+            }
+        }
+        if (!placed) return NO;
+    }
+    return YES;
+}
+
+static void SRKAppendAligned(NSMutableData *file, NSData *data, uint64_t *offset) {
+    *offset = file.length;
+    [file appendData:data];
+    [file increaseLengthBy:(8 - file.length % 8) % 8];
+}
+
+BOOL SRKCompileIOCSet(NSString *directory, NSUInteger *count, NSError **error) {
+    NSArray<NSString *> *names = [[[NSFileManager defaultManager] contentsOfDirectoryAtPath:directory error:error]
+                                  sortedArrayUsingSelector:@selector(compare:)];
+    if (!names) return NO;
+
+    NSMutableArray<NSString *> *sources = [NSMutableArray array];
+    NSMutableData *keyData = [NSMutableData data];
+    for (NSString *name in names) {
+        if (![name.pathExtension isEqualToString:@"txt"] || sources.count >= UINT16_MAX) continue;
+
+        NSData *data = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:name]
+                                              options:NSDataReadingMappedIfSafe error:nil];
+        if (!data) continue;
+        uint16_t source = (uint16_t)sources.count;
+        [sources addObject:name.stringByDeletingPathExtension];
+
+        const char *end = (const char *)data.bytes + data.length;
+        for (const char *line = data.bytes; line < end;) {
+            const char *newline = memchr(line, '\n', (size_t)(end - line));
+            const char *lineEnd = newline ?: end;
+            const char *start = line;
+            line = lineEnd + 1;
+
+            // Whole lines are IOCs (paths and user agents hold spaces); only a leading # is a comment
+            while (start < lineEnd && isspace((unsigned char)*start)) start++;
+            while (lineEnd > start && isspace((unsigned char)lineEnd[-1])) lineEnd--;
+            size_t length = (size_t)(lineEnd - start);
+            if (length == 0 || length > SRK_IOC_MAX_LENGTH || *start == '#') continue;
+
+            SRKIOCKey key = {SRKIOCHash(start, length), 0, source, 0};
+            [keyData appendBytes:&key length:sizeof(SRKIOCKey)];
+        }
+    }
+
+    // One slot per distinct IOC; the first file listing it tags it
+    SRKIOCKey *keys = keyData.mutableBytes;
+    NSUInteger total = keyData.length / sizeof(SRKIOCKey);
+    qsort(keys, total, sizeof(SRKIOCKey), SRKCompareIOCHashes);
+    uint32_t unique = 0;
+    for (NSUInteger i = 0; i < total; i++) {
+        if (unique > 0 && keys[unique - 1].hash == keys[i].hash) continue;
+        keys[unique++] = keys[i];
+    }
+
+    uint32_t bucketCount = unique / SRK_IOC_BUCKET_SIZE + 1;
+    uint32_t slotCount = unique + unique / 100 + 1;
+    NSMutableData *displacements = [NSMutableData dataWithLength:bucketCount * sizeof(uint16_t)];
+    NSMutableData *slots = [NSMutableData dataWithLength:slotCount * sizeof(SRKIOCSlot)];
+
+    uint64_t seed = 0;
+    BOOL placed = NO;
+    for (uint64_t attempt = 0; attempt < SRK_IOC_MAX_SEEDS && !placed; attempt++) {
+        seed = SRKIOCMix(0x53524B494F43ULL + attempt);
+        placed = SRKPlaceIOCs(keys, unique, seed, bucketCount, slotCount, displacements.mutableBytes, slots.mutableBytes);
+    }
+    if (!placed) {
+        if (error) *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileWriteUnknownError
+                                            userInfo:@{NSLocalizedDescriptionKey: @"No perfect hash found for the IOC set"}];
+        return NO;
+    }
+
+    NSData *sourceBytes = [[sources componentsJoinedByString:@"\n"] dataUsingEncoding:NSUTF8StringEncoding];
+    SRKIOCHeader header;
+    memset(&header, 0, sizeof(SRKIOCHeader));
+    memcpy(header.magic, SRK_IOC_MAGIC, sizeof(header.magic));
+    header.seed = seed;
+    header.count = unique;
+    header.slotCount = slotCount;
+    header.bucketCount = bucketCount;
+    header.sourceBytes = (uint32_t)sourceBytes.length;
+
+    NSMutableData *file = [NSMutableData dataWithLength:sizeof(SRKIOCHeader)];
+    SRKAppendAligned(file, displacements, &header.displacementsOffset);
+    SRKAppendAligned(file, slots, &header.slotsOffset);
+    SRKAppendAligned(file, sourceBytes, &header.sourcesOffset);
+    [file replaceBytesInRange:NSMakeRange(0, sizeof(SRKIOCHeader)) withBytes:&header];
+
+    if (count) *count = unique;
+    return [file writeToFile:[directory stringByAppendingPathComponent:SRKIOCSetFile] options:NSDataWritingAtomic error:error];
+}
+
+#pragma mark - Probing
+
+NSDictionary *SRKOpenIOCSet(NSString *directory) {
+    NSData *data = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:SRKIOCSetFile]
+                                          options:NSDataReadingMappedAlways error:nil];
+    if (data.length < sizeof(SRKIOCHeader)) return nil;
+
+    const SRKIOCHeader *header = data.bytes;
+    if (memcmp(header->magic, SRK_IOC_MAGIC, sizeof(header->magic)) != 0 || header->slotCount == 0 ||
+        header->bucketCount == 0 ||
+        header->displacementsOffset + (uint64_t)header->bucketCount * sizeof(uint16_t) > data.length ||
+        header->slotsOffset + (uint64_t)header->slotCount * sizeof(SRKIOCSlot) > data.length ||
+        header->sourcesOffset + header->sourceBytes > data.length) {
+        return nil;
+    }
+
+    NSString *sourceText = [[NSString alloc] initWithBytes:(const char *)data.bytes + header->sourcesOffset
+                                                    length:header->sourceBytes encoding:NSUTF8StringEncoding];
+    return @{
+        @"data": data,
+        @"count": @(header->count),
+        @"sources": sourceText.length > 0 ? [sourceText componentsSeparatedByString:@"\n"] : @[]
+    };
+}
+
+/// Probe with the header and its tables looked up once per batch
+static NSInteger SRKIOCProbe(const SRKIOCHeader *header, uint64_t hash) {
+    const uint16_t *displacements = (const uint16_t *)((const uint8_t *)header + header->displacementsOffset);
+    const SRKIOCSlot *slots = (const SRKIOCSlot *)((const uint8_t *)header + header->slotsOffset);
+
+    uint16_t displacement = displacements[SRKIOCBucket(hash, header->seed, header->bucketCount)];
+    const SRKIOCSlot *slot = &slots[SRKIOCPosition(hash, SRKIOCDisplacementKey(header->seed, displacement), header->slotCount)];
+    return slot->fingerprint == SRKIOCFingerprint(hash) ? slot->source : -1;
+}
+
+NSInteger SRKIOCSetSource(NSDictionary *set, uint64_t hash) {
+    NSData *data = set[@"data"];
+    return data.length >= sizeof(SRKIOCHeader) ? SRKIOCProbe(data.bytes, hash) : -1;
+}
+
+NSString *SRKIOCSourceName(NSDictionary *set, NSInteger source) {
+    NSArray<NSString *> *sources = set[@"sources"];
+    return source >= 0 && (NSUInteger)source < sources.count ? sources[source] : @"unknown";
+}
+
+NSArray<NSDictionary *> *SRKMatchStringIOCs(NSObject<HPDisassembledFile> *file, NSDictionary *set) {
+    NSData *setData = set[@"data"];
+    if (setData.length < sizeof(SRKIOCHeader)) return @[];
+    const SRKIOCHeader *header = setData.bytes;
+
+    // Strings are taken in place from the mapped segments, which stay alive until the probe is done
+    NSMutableArray<NSData *> *segmentData = [NSMutableArray array];
+    NSMutableData *stringData = [NSMutableData data];
+    NSMutableData *lengthData = [NSMutableData data];
+    NSMutableData *addressData = [NSMutableData data];
+
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length == 0) continue;
+        [segmentData addObject:data];
+        const char *bytes = data.bytes;
+
+        for (NSObject<HPSection> *section in [segment sections]) {
+            if (![section.sectionName containsString:@"string"] && ![section.sectionName isEqualToString:@"__const"]) continue;
+            if (section.startAddress < segment.startAddress) continue;
+
+            NSUInteger start = (NSUInteger)(section.startAddress - segment.startAddress);
+            NSUInteger end = MIN(data.length, (NSUInteger)(section.endAddress - segment.startAddress));
+            for (NSUInteger i = start; i < end;) {
+                NSUInteger j = i;
+                while (j < end && ((bytes[j] >= 32 && bytes[j] < 127) || bytes[j] == '\t')) j++;
+
+                // NUL-terminated printable runs only
+                size_t length = j - i;
+                if (j < end && bytes[j] == 0 && length >= SRK_IOC_MIN_STRING && length <= SRK_IOC_MAX_LENGTH) {
+                    const char *string = bytes + i;
+                    Address address = segment.startAddress + i;
+                    [stringData appendBytes:&string length:sizeof(const char *)];
+                    [lengthData appendBytes:&length length:sizeof(size_t)];
+                    [addressData appendBytes:&address length:sizeof(Address)];
+                }
+                i = j + 1;
+            }
+        }
+    }
+
+    NSUInteger count = lengthData.length / sizeof(size_t);
+    const char *const *strings = stringData.bytes;
+    const size_t *lengths = lengthData.bytes;
+    const Address *addresses = addressData.bytes;
+    NSMutableData *hashData = [NSMutableData dataWithLength:count * sizeof(uint64_t)];
+    SRKIOCHashBatch(strings, lengths, count, hashData.mutableBytes);
+    const uint64_t *hashes = hashData.bytes;
+
+    NSMutableArray<NSDictionary *> *matches = [NSMutableArray array];
+    for (NSUInteger i = 0; i < count; i++) {
+        NSInteger source = SRKIOCProbe(header, hashes[i]);
+        if (source < 0) continue;
+
+        NSString *value = [[NSString alloc] initWithBytes:strings[i] length:lengths[i] encoding:NSUTF8StringEncoding];
+        [matches addObject:@{
+            @"address": @(addresses[i]),
+            @"value": value ?: @"?",
+            @"source": SRKIOCSourceName(set, source)
+        }];
+    }
+    return matches;
+}
+
+static NSString *SRKHexDigest(const uint8_t *digest, NSUInteger length) {
+    NSMutableString *hex = [NSMutableString stringWithCapacity:length * 2];
+    for (NSUInteger i = 0; i < length; i++) {
+        [hex appendFormat:@"%02x", digest[i]];
+    }
+    return hex;
+}
+
+NSArray<NSDictionary *> *SRKMatchFileHashIOCs(NSObject<HPDisassembledFile> *file, NSDictionary *set) {
+    NSString *path = file.originalFilePath;
+    NSData *data = path ? [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil] : nil;
+    if (!data) return @[];
+
+    uint8_t md5[CC_MD5_DIGEST_LENGTH];
+    uint8_t sha1[CC_SHA1_DIGEST_LENGTH];
+    uint8_t sha256[CC_SHA256_DIGEST_LENGTH];
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    CC_MD5(data.bytes, (CC_LONG)data.length, md5);
+    CC_SHA1(data.bytes, (CC_LONG)data.length, sha1);
+#pragma clang diagnostic pop
+    CC_SHA256(data.bytes, (CC_LONG)data.length, sha256);
+
+    NSDictionary<NSString *, NSString *> *digests = @{
+        @"MD5": SRKHexDigest(md5, sizeof(md5)),
+        @"SHA-1": SRKHexDigest(sha1, sizeof(sha1)),
+        @"SHA-256": SRKHexDigest(sha256, sizeof(sha256))
+    };
+
+    NSMutableArray<NSDictionary *> *matches = [NSMutableArray array];
+    for (NSString *algorithm in [digests.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        const char *hex = digests[algorithm].UTF8String;
+        NSInteger source = SRKIOCSetSource(set, SRKIOCHash(hex, strlen(hex)));
+        if (source >= 0) {
+            [matches addObject:@{@"algorithm": algorithm, @"value": digests[algorithm], @"source": SRKIOCSourceName(set, source)}];
+        }
+    }
+    return matches;
+}
@@ -0,0 +1,41 @@
+/*
+ SRKIOKit.h
+ IOKit user client recovery for HopperSRK analyzers
+
+ Recovers, per call site, the service class names passed to the IOKit
+ matching functions, the user client types passed to IOServiceOpen and the
+ external method selectors and input sizes passed to IOConnectCall*Method,
+ then groups the selectors by the user client they are sent to.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Builds the user client matrix of a file:
+ * - @"services": @{@"address", @"procedure", @"function", @"class"} per matching call
+ * - @"opens":    @{@"address", @"procedure", @"type"?} per IOServiceOpen call
+ * - @"calls":    @{@"address", @"procedure", @"function", @"selector"?, @"scalar_inputs"?,
+ *                  @"struct_input_size"?, @"class"} per external method call
+ * - @"matrix":   service class -> sorted selector numbers (NSNull for unresolved selectors)
+ *
+ * Sizes a call does not take are NSNull. The async calls pass some of theirs
+ * on the stack; those are read from the outgoing argument stores.
+ *
+ * Calls are attributed to the classes matched in the same procedure, then in
+ * its direct callers, then to the only class matched by the binary; "?" otherwise.
+ */
+NSDictionary *SRKIOKitUserClients(NSObject<HPDisassembledFile> *file, NSDictionary *index);
+
+/// "IOFooUserClient → 0, 3, 7" lines for the matrix, sorted by class name
+NSArray<NSString *> *SRKIOKitMatrixLines(NSDictionary *userClients);
+
+/// Appends the "IOKit User Clients" report section: matrix lines under headline, then the first external method calls
+void SRKIOKitAppendReport(NSMutableString *report, NSDictionary *userClients, NSString *headline);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,248 @@
+/*
+ SRKIOKit.m
+ IOKit user client recovery for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKIOKit.h"
+#import "SRKStackFrame.h"
+
+#define SRK_IOKIT_MAX_ARGUMENTS 9
+
+static NSDictionary<NSString *, NSNumber *> *SRKIOKitMatchingArguments(void) {
+    // Argument holding the class / name string
+    return @{
+        @"IOServiceMatching": @0,
+        @"IOServiceNameMatching": @0,
+        @"IOBSDNameMatching": @2
+    };
+}
+
+static NSDictionary<NSString *, NSArray<NSNumber *> *> *SRKIOKitMethodArguments(void) {
+    // Arguments holding the selector, the scalar input count and the struct input size (-1: none)
+    return @{
+        @"IOConnectCallMethod": @[@1, @3, @5],
+        @"IOConnectCallScalarMethod": @[@1, @3, @-1],
+        @"IOConnectCallStructMethod": @[@1, @-1, @3],
+        @"IOConnectCallAsyncMethod": @[@1, @6, @8],
+        @"IOConnectCallAsyncScalarMethod": @[@1, @6, @-1],
+        @"IOConnectCallAsyncStructMethod": @[@1, @-1, @6]
+    };
+}
+
+static NSNumber *SRKIOKitArgumentValue(NSDictionary *callSite, NSDictionary<NSNumber *, NSNumber *> *stackArguments,
+                                       NSNumber *argumentIndex) {
+    if (argumentIndex.integerValue < 0) return nil;
+    return SRKCallSiteValueArgument(callSite, argumentIndex.unsignedIntegerValue) ?: stackArguments[argumentIndex];
+}
+
+/// Method arguments passed on the stack (the async calls), read from the outgoing argument stores:
+/// call address -> @{argument index: value}
+static NSDictionary<NSNumber *, NSDictionary<NSNumber *, NSNumber *> *> *SRKIOKitStackArguments(
+    NSObject<HPDisassembledFile> *file, NSDictionary *index, NSDictionary<NSString *, NSArray<NSNumber *> *> *methodArguments) {
+    NSMutableDictionary<NSNumber *, NSDictionary<NSNumber *, NSNumber *> *> *result = [NSMutableDictionary dictionary];
+
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+    if (lifter.arch == SRKArchitectureUnknown) return result;
+    lifter.slotNames = index[@"dynamic_slots"];
+    SRKArchitecture arch = lifter.arch;
+
+    NSMutableArray<NSString *> *functions = [NSMutableArray array];
+    for (NSString *function in methodArguments) {
+        for (NSNumber *argumentIndex in methodArguments[function]) {
+            if (argumentIndex.integerValue >= 0 &&
+                SRKArgumentRegister(arch, argumentIndex.unsignedIntegerValue) == NSNotFound) {
+                [functions addObject:function];
+                break;
+            }
+        }
+    }
+    NSDictionary<NSNumber *, NSString *> *sites = SRKCallSiteAddresses(file, index, functions);
+
+    NSMutableSet<NSNumber *> *walked = [NSMutableSet set];
+    for (NSNumber *site in [sites.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, index, site.unsignedLongLongValue);
+        if (!procedure || [walked containsObject:@([procedure entryPoint])]) continue;
+        [walked addObject:@([procedure entryPoint])];
+
+        NSMutableDictionary<NSNumber *, NSValue *> *stack = [NSMutableDictionary dictionary];
+        SRKLiftProcedureWithStack(&lifter, procedure, stack, ^(SRKLifter *callLifter, Address callAddress, NSString *callee,
+                                                               SRKRegisterState *state, BOOL *stop) {
+            NSArray<NSNumber *> *arguments = methodArguments[sites[@(callAddress)] ?: @""];
+            if (!arguments) return;
+
+            NSMutableDictionary<NSNumber *, NSNumber *> *values = [NSMutableDictionary dictionary];
+            for (NSUInteger i = 0; i < arguments.count; i++) {
+                NSInteger argumentIndex = arguments[i].integerValue;
+                if (argumentIndex < 0 || SRKArgumentRegister(arch, argumentIndex) != NSNotFound) continue;
+
+                // Selector and scalar count are uint32_t, the struct size a size_t
+                SRKRegisterValue value;
+                if (SRKStackArgumentValue(callLifter, state, stack, argumentIndex, i == 2 ? 8 : 4, &value)) {
+                    values[@(argumentIndex)] = @(value.value);
+                }
+            }
+            if (values.count > 0) result[@(callAddress)] = values;
+        });
+    }
+
+    return result;
+}
+
+NSDictionary *SRKIOKitUserClients(NSObject<HPDisassembledFile> *file, NSDictionary *index) {
+    NSDictionary<NSString *, NSNumber *> *matchingArguments = SRKIOKitMatchingArguments();
+    NSDictionary<NSString *, NSArray<NSNumber *> *> *methodArguments = SRKIOKitMethodArguments();
+
+    NSMutableArray<NSString *> *functions = [NSMutableArray arrayWithArray:matchingArguments.allKeys];
+    [functions addObjectsFromArray:methodArguments.allKeys];
+    [functions addObject:@"IOServiceOpen"];
+
+    NSMutableArray *services = [NSMutableArray array];
+    NSMutableArray *opens = [NSMutableArray array];
+    NSMutableArray<NSMutableDictionary *> *calls = [NSMutableArray array];
+    NSMutableDictionary<NSNumber *, NSMutableOrderedSet<NSString *> *> *classesByProcedure = [NSMutableDictionary dictionary];
+    NSMutableOrderedSet<NSString *> *allClasses = [NSMutableOrderedSet orderedSet];
+    NSDictionary<NSNumber *, NSDictionary<NSNumber *, NSNumber *> *> *stackArguments =
+        SRKIOKitStackArguments(file, index, methodArguments);
+
+    for (NSDictionary *callSite in SRKCallSitesForFunctions(file, index, functions, SRK_IOKIT_MAX_ARGUMENTS)) {
+        NSString *function = callSite[@"function"];
+        NSNumber *procedure = callSite[@"procedure"];
+
+        if (matchingArguments[function]) {
+            NSString *className = SRKCallSiteStringArgument(callSite, matchingArguments[function].unsignedIntegerValue);
+            if (!className) continue;
+
+            [services addObject:@{@"address": callSite[@"address"], @"procedure": procedure,
+                                  @"function": function, @"class": className}];
+
+            NSMutableOrderedSet<NSString *> *classes = classesByProcedure[procedure];
+            if (!classes) {
+                classes = [NSMutableOrderedSet orderedSet];
+                classesByProcedure[procedure] = classes;
+            }
+            [classes addObject:className];
+            [allClasses addObject:className];
+        } else if ([function isEqualToString:@"IOServiceOpen"]) {
+            NSMutableDictionary *open = [NSMutableDictionary dictionaryWithDictionary:@{
+                @"address": callSite[@"address"], @"procedure": procedure
+            }];
+            NSNumber *type = SRKCallSiteValueArgument(callSite, 2);
+            if (type) open[@"type"] = @((uint32_t)type.unsignedLongLongValue);
+            [opens addObject:open];
+        } else {
+            NSArray<NSNumber *> *arguments = methodArguments[function];
+            NSMutableDictionary *call = [NSMutableDictionary dictionaryWithDictionary:@{
+                @"address": callSite[@"address"], @"procedure": procedure, @"function": function
+            }];
+
+            NSDictionary<NSNumber *, NSNumber *> *callStackArguments = stackArguments[callSite[@"address"]];
+            NSNumber *selector = SRKIOKitArgumentValue(callSite, callStackArguments, arguments[0]);
+            NSNumber *scalarInputs = SRKIOKitArgumentValue(callSite, callStackArguments, arguments[1]);
+            NSNumber *structInputSize = SRKIOKitArgumentValue(callSite, callStackArguments, arguments[2]);
+            if (selector) call[@"selector"] = @((uint32_t)selector.unsignedLongLongValue);
+            if (scalarInputs) call[@"scalar_inputs"] = @((uint32_t)scalarInputs.unsignedLongLongValue);
+            if (structInputSize) call[@"struct_input_size"] = structInputSize;
+            // Distinguishes "not passed" from "passed but not recovered" in the report
+            if (arguments[1].integerValue < 0) call[@"scalar_inputs"] = [NSNull null];
+            if (arguments[2].integerValue < 0) call[@"struct_input_size"] = [NSNull null];
+
+            [calls addObject:call];
+        }
+    }
+
+    // Attribute each external method call to the user client it most likely targets
+    NSMutableDictionary<NSString *, NSMutableOrderedSet *> *matrix = [NSMutableDictionary dictionary];
+    for (NSMutableDictionary *call in calls) {
+        NSNumber *procedureEntry = call[@"procedure"];
+        NSMutableOrderedSet<NSString *> *classes = [NSMutableOrderedSet orderedSet];
+        [classes unionOrderedSet:classesByProcedure[procedureEntry] ?: [NSOrderedSet orderedSet]];
+
+        if (classes.count == 0) {
+            NSObject<HPProcedure> *procedure = [file procedureAt:procedureEntry.unsignedLongLongValue];
+            for (NSObject<HPProcedure> *caller in [procedure allCallerProcedures]) {
+                NSOrderedSet<NSString *> *callerClasses = classesByProcedure[@([caller entryPoint])];
+                if (callerClasses) [classes unionOrderedSet:callerClasses];
+            }
+        }
+        if (classes.count == 0 && allClasses.count == 1) {
+            [classes unionOrderedSet:allClasses];
+        }
+        if (classes.count == 0) {
+            [classes addObject:@"?"];
+        }
+
+        call[@"class"] = [classes.array componentsJoinedByString:@"|"];
+        for (NSString *className in classes) {
+            NSMutableOrderedSet *selectors = matrix[className];
+            if (!selectors) {
+                selectors = [NSMutableOrderedSet orderedSet];
+                matrix[className] = selectors;
+            }
+            [selectors addObject:call[@"selector"] ?: [NSNull null]];
+        }
+    }
+
+    NSMutableDictionary<NSString *, NSArray *> *sortedMatrix = [NSMutableDictionary dictionary];
+    for (NSString *className in matrix) {
+        NSArray *selectors = [matrix[className].array sortedArrayUsingComparator:^NSComparisonResult(id a, id b) {
+            if (a == b) return NSOrderedSame;
+            if (a == [NSNull null]) return NSOrderedDescending;
+            if (b == [NSNull null]) return NSOrderedAscending;
+            return [a compare:b];
+        }];
+        sortedMatrix[className] = selectors;
+    }
+
+    return @{
+        @"services": services,
+        @"opens": opens,
+        @"calls": calls,
+        @"matrix": sortedMatrix
+    };
+}
+
+NSArray<NSString *> *SRKIOKitMatrixLines(NSDictionary *userClients) {
+    NSDictionary<NSString *, NSArray *> *matrix = userClients[@"matrix"];
+    NSMutableArray<NSString *> *lines = [NSMutableArray array];
+
+    for (NSString *className in [matrix.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        NSMutableArray<NSString *> *selectors = [NSMutableArray array];
+        for (id selector in matrix[className]) {
+            [selectors addObject:selector == [NSNull null] ? @"?" : [selector stringValue]];
+        }
+        [lines addObject:[NSString stringWithFormat:@"%@ → %@", className, [selectors componentsJoinedByString:@", "]]];
+    }
+
+    return lines;
+}
+
+void SRKIOKitAppendReport(NSMutableString *report, NSDictionary *userClients, NSString *headline) {
+    NSArray<NSString *> *matrixLines = SRKIOKitMatrixLines(userClients);
+    NSArray<NSDictionary *> *externalCalls = userClients[@"calls"];
+
+    [report appendFormat:@"IOKit User Clients: %lu\n", (unsigned long)matrixLines.count];
+    if (matrixLines.count == 0) return;
+
+    [report appendFormat:@"  %@\n", headline];
+    for (NSString *line in matrixLines) {
+        [report appendFormat:@"  • %@\n", line];
+    }
+    for (NSDictionary *call in [externalCalls subarrayWithRange:NSMakeRange(0, MIN(5, externalCalls.count))]) {
+        id scalarInputs = call[@"scalar_inputs"];
+        id structInputSize = call[@"struct_input_size"];
+        [report appendFormat:@"  • 0x%llx: %@ selector %@ (scalars: %@, struct: %@)\n",
+         [call[@"address"] unsignedLongLongValue], call[@"function"], call[@"selector"] ?: @"?",
+         scalarInputs == [NSNull null] ? @"-" : scalarInputs ?: @"?",
+         structInputSize == [NSNull null] ? @"-" : structInputSize ?: @"?"];
+    }
+    if (externalCalls.count > 5) {
+        [report appendFormat:@"  ... and %lu more\n", (unsigned long)(externalCalls.count - 5)];
+    }
+    [report appendString:@"\n"];
+}
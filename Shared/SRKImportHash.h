@@ -0,0 +1,82 @@
+/*
+ SRKImportHash.h
+ Import-set hashing and import similarity index for HopperSRK analyzers
+
+ The sorted import set of a Mach-O plus its dylib list is a cheap family
+ signal that survives recompilation. The imports are read from the load
+ commands and the undefined symbols of the symbol table (two-level
+ namespace ordinals name the dylib of each symbol), and summarized as:
+ - symhash: MD5 of the sorted undefined symbol names joined by ","
+ - a MinHash sketch of the (dylib, symbol) pairs and the dylibs, whose
+   matching slots estimate the Jaccard similarity of two import sets
+
+ The import index is a flat file of fixed-size records, one per corpus
+ sample, mapped and scanned in parallel, so a query over a million samples
+ touches SRK_IMPORT_RECORD_SIZE bytes each and no per-sample objects. It is
+ compiled from the "imports" hashes kept in the function corpus plists,
+ whose folder names label the families.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Slots of the import MinHash sketch
+#define SRK_IMPORT_MINHASH_SIZE 32
+/// Bytes per sample in the import index
+#define SRK_IMPORT_RECORD_SIZE 160
+
+/**
+ * Imports of the image:
+ * @{@"dylibs": install names in load order, @"imports": sorted unique "dylib:symbol",
+ *   @"symbols": sorted unique undefined symbol names, @"source": @"load commands" or @"hopper"}
+ * The file on disk is parsed (the slice matching the analyzed architecture
+ * of a fat file); when it cannot be read, the names Hopper gives the stub and
+ * pointer sections stand in, without dylibs.
+ */
+NSDictionary *SRKCollectImports(NSObject<HPDisassembledFile> *file);
+
+/**
+ * Property list import signature, as kept in the corpus:
+ * @{@"symhash", @"minhash": NSData, @"imports": count, @"dylibs": install names}
+ */
+NSDictionary *SRKComputeImportSignature(NSObject<HPDisassembledFile> *file);
+
+/// Estimated Jaccard similarity of two import signatures
+double SRKImportSimilarity(NSDictionary *a, NSDictionary *b);
+
+#pragma mark - Index
+
+/// ~/Library/Application Support/HopperSRK/ImportIndex
+NSString *SRKImportIndexDirectory(void);
+
+/// YES when the index directory holds an index
+BOOL SRKImportIndexExists(NSString *directory);
+
+/// Appends one sample to the index, creating it when needed; a sample already indexed with the same symhash is kept once
+BOOL SRKAppendImportIndex(NSString *directory, NSString *family, NSString *sample,
+                          NSDictionary *signature, NSError **error);
+
+/**
+ * Rewrites the index from the import signatures of every corpus sample,
+ * labelled by the folder it sits in, one record per symhash and sample name.
+ * count receives the samples indexed.
+ */
+BOOL SRKRebuildImportIndex(NSString *directory, NSString *corpusDirectory, NSUInteger * _Nullable count,
+                           NSError **error);
+
+/**
+ * Indexed samples most similar to the signature, most similar first, the
+ * records of the sample itself (same symhash and name) left out:
+ * @{@"family", @"sample", @"similarity", @"symhash_match"}
+ */
+NSArray<NSDictionary *> *SRKNearestImportSamples(NSString *directory, NSDictionary *signature, NSString * _Nullable sample,
+                                                 NSUInteger maximumCount);
+
+/// Best similarity per labelled family of the neighbours: @[@{@"family", @"similarity", @"samples"}], best first
+NSArray<NSDictionary *> *SRKImportFamilies(NSArray<NSDictionary *> *neighbours);
+
+NS_ASSUME_NONNULL_END
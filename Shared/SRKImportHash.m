@@ -0,0 +1,549 @@
+/*
+ SRKImportHash.m
+ Import-set hashing and import similarity index for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import <CommonCrypto/CommonDigest.h>
+#import <mach-o/fat.h>
+#import <mach-o/loader.h>
+#import <mach-o/nlist.h>
+#import "SRKImportHash.h"
+#import "SRKFunctionSimilarity.h"
+#import "SRKLifter.h"
+
+// Records scored per dispatch_apply iteration
+#define SRK_IMPORT_SCAN_CHUNK 4096
+// Longest "family\tsample\n" label read back from the labels file
+#define SRK_IMPORT_LABEL_MAX 512
+
+typedef struct {
+    uint32_t minhash[SRK_IMPORT_MINHASH_SIZE];
+    uint8_t symhash[CC_MD5_DIGEST_LENGTH];
+    uint32_t imports;
+    uint32_t dylibs;
+    /// Offset of the "family\tsample\n" line in the labels file
+    uint64_t labelOffset;
+} SRKImportRecord;
+
+_Static_assert(sizeof(SRKImportRecord) == SRK_IMPORT_RECORD_SIZE, "import index record size");
+
+static NSString *const SRKImportRecordsFile = @"records.bin";
+static NSString *const SRKImportLabelsFile = @"labels.txt";
+
+#pragma mark - Mach-O Imports
+
+/// Slice of a fat file for the architecture, or the whole data when it is thin
+static NSRange SRKMachOSlice(NSData *data, SRKArchitecture arch) {
+    const uint8_t *bytes = data.bytes;
+    if (data.length < sizeof(struct fat_header)) return NSMakeRange(0, data.length);
+
+    uint32_t magic = OSSwapBigToHostInt32(*(const uint32_t *)bytes);
+    if (magic != FAT_MAGIC && magic != FAT_MAGIC_64) return NSMakeRange(0, data.length);
+
+    cpu_type_t wanted = arch == SRKArchitectureX86_64 ? CPU_TYPE_X86_64 : CPU_TYPE_ARM64;
+    uint32_t count = OSSwapBigToHostInt32(((const struct fat_header *)bytes)->nfat_arch);
+    size_t entrySize = magic == FAT_MAGIC_64 ? sizeof(struct fat_arch_64) : sizeof(struct fat_arch);
+    NSRange first = NSMakeRange(NSNotFound, 0);
+
+    for (uint32_t i = 0; i < count; i++) {
+        size_t position = sizeof(struct fat_header) + i * entrySize;
+        if (position + entrySize > data.length) break;
+
+        cpu_type_t cpu;
+        uint64_t offset;
+        uint64_t size;
+        if (magic == FAT_MAGIC_64) {
+            const struct fat_arch_64 *entry = (const struct fat_arch_64 *)(bytes + position);
+            cpu = (cpu_type_t)OSSwapBigToHostInt32((uint32_t)entry->cputype);
+            offset = OSSwapBigToHostInt64(entry->offset);
+            size = OSSwapBigToHostInt64(entry->size);
+        } else {
+            const struct fat_arch *entry = (const struct fat_arch *)(bytes + position);
+            cpu = (cpu_type_t)OSSwapBigToHostInt32((uint32_t)entry->cputype);
+            offset = OSSwapBigToHostInt32(entry->offset);
+            size = OSSwapBigToHostInt32(entry->size);
+        }
+        if (offset > data.length || size > data.length - offset) continue;
+
+        NSRange slice = NSMakeRange((NSUInteger)offset, (NSUInteger)size);
+        if (cpu == wanted) return slice;
+        if (first.location == NSNotFound) first = slice;
+    }
+    return first.location == NSNotFound ? NSMakeRange(0, 0) : first;
+}
+
+/// Short dylib name for the import tokens: the framework or library file name
+static NSString *SRKDylibShortName(NSString *installName) {
+    NSString *name = installName.lastPathComponent;
+    return name.length > 0 ? name : installName;
+}
+
+/// Dylibs and undefined symbols with their two-level namespace dylib, nil when the slice is not a Mach-O
+static NSDictionary *SRKParseMachOImports(const uint8_t *slice, NSUInteger length) {
+    if (length < sizeof(struct mach_header)) return nil;
+
+    uint32_t magic = *(const uint32_t *)slice;
+    if (magic != MH_MAGIC && magic != MH_MAGIC_64) return nil;
+    BOOL is64 = magic == MH_MAGIC_64;
+    size_t headerSize = is64 ? sizeof(struct mach_header_64) : sizeof(struct mach_header);
+    size_t nlistSize = is64 ? sizeof(struct nlist_64) : sizeof(struct nlist);
+    const struct mach_header *header = (const struct mach_header *)slice;
+
+    NSMutableArray<NSString *> *dylibs = [NSMutableArray array];
+    const struct symtab_command *symtab = NULL;
+    const struct dysymtab_command *dysymtab = NULL;
+
+    size_t position = headerSize;
+    for (uint32_t i = 0; i < header->ncmds; i++) {
+        if (position + sizeof(struct load_command) > length) break;
+        const struct load_command *command = (const struct load_command *)(slice + position);
+        if (command->cmdsize < sizeof(struct load_command) || position + command->cmdsize > length) break;
+
+        switch (command->cmd) {
+            case LC_LOAD_DYLIB:
+            case LC_LOAD_WEAK_DYLIB:
+            case LC_REEXPORT_DYLIB:
+            case LC_LAZY_LOAD_DYLIB:
+            case LC_LOAD_UPWARD_DYLIB: {
+                // Ordinals count every dylib command, so unreadable names keep their slot
+                const struct dylib_command *dylib = (const struct dylib_command *)command;
+                uint32_t offset = command->cmdsize >= sizeof(struct dylib_command) ? dylib->dylib.name.offset : 0;
+                NSString *name = nil;
+                if (offset >= sizeof(struct dylib_command) && offset < command->cmdsize) {
+                    name = [[NSString alloc] initWithBytes:(const char *)command + offset
+                                                    length:strnlen((const char *)command + offset, command->cmdsize - offset)
+                                                  encoding:NSUTF8StringEncoding];
+                }
+                [dylibs addObject:name ?: @"?"];
+                break;
+            }
+            case LC_SYMTAB:
+                if (command->cmdsize >= sizeof(struct symtab_command)) symtab = (const struct symtab_command *)command;
+                break;
+            case LC_DYSYMTAB:
+                if (command->cmdsize >= sizeof(struct dysymtab_command)) dysymtab = (const struct dysymtab_command *)command;
+                break;
+            default:
+                break;
+        }
+        position += command->cmdsize;
+    }
+
+    NSMutableSet<NSString *> *symbols = [NSMutableSet set];
+    NSMutableSet<NSString *> *imports = [NSMutableSet set];
+    if (symtab && symtab->symoff <= length && (uint64_t)symtab->nsyms * nlistSize <= length - symtab->symoff &&
+        symtab->stroff <= length && symtab->strsize <= length - symtab->stroff) {
+        uint32_t first = 0;
+        uint32_t last = symtab->nsyms;
+        if (dysymtab && dysymtab->nundefsym > 0 && (uint64_t)dysymtab->iundefsym + dysymtab->nundefsym <= symtab->nsyms) {
+            first = dysymtab->iundefsym;
+            last = dysymtab->iundefsym + dysymtab->nundefsym;
+        }
+
+        const char *strings = (const char *)slice + symtab->stroff;
+        for (uint32_t s = first; s < last; s++) {
+            const uint8_t *entry = slice + symtab->symoff + (size_t)s * nlistSize;
+            uint32_t stringIndex;
+            uint8_t type;
+            uint16_t description;
+            if (is64) {
+                const struct nlist_64 *symbol = (const struct nlist_64 *)entry;
+                stringIndex = symbol->n_un.n_strx;
+                type = symbol->n_type;
+                description = symbol->n_desc;
+            } else {
+                const struct nlist *symbol = (const struct nlist *)entry;
+                stringIndex = symbol->n_un.n_strx;
+                type = symbol->n_type;
+                description = (uint16_t)symbol->n_desc;
+            }
+            if ((type & N_STAB) || (type & N_TYPE) != N_UNDF || !(type & N_EXT)) continue;
+            if (stringIndex == 0 || stringIndex >= symtab->strsize) continue;
+
+            NSString *name = [[NSString alloc] initWithBytes:strings + stringIndex
+                                                      length:strnlen(strings + stringIndex, symtab->strsize - stringIndex)
+                                                    encoding:NSUTF8StringEncoding];
+            if (name.length == 0) continue;
+
+            uint8_t ordinal = GET_LIBRARY_ORDINAL(description);
+            NSString *dylib = ordinal >= 1 && ordinal <= dylibs.count ? SRKDylibShortName(dylibs[ordinal - 1]) : @"?";
+            [symbols addObject:name];
+            [imports addObject:[NSString stringWithFormat:@"%@:%@", dylib, name]];
+        }
+    }
+
+    return @{
+        @"dylibs": dylibs,
+        @"imports": [imports.allObjects sortedArrayUsingSelector:@selector(compare:)],
+        @"symbols": [symbols.allObjects sortedArrayUsingSelector:@selector(compare:)],
+        @"source": @"load commands"
+    };
+}
+
+/// Imports as Hopper names the stub and pointer sections, for files that are not on disk anymore
+static NSDictionary *SRKHopperImports(NSObject<HPDisassembledFile> *file) {
+    static NSSet<NSString *> *importSections;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        importSections = [NSSet setWithArray:@[@"__stubs", @"__auth_stubs", @"__got", @"__auth_got",
+                                               @"__la_symbol_ptr", @"__nl_symbol_ptr"]];
+    });
+
+    NSMutableSet<NSString *> *symbols = [NSMutableSet set];
+    for (NSNumber *address in [file allNamedAddresses]) {
+        NSString *section = [file sectionForVirtualAddress:address.unsignedLongLongValue].sectionName;
+        if (!section || ![importSections containsObject:section]) continue;
+
+        NSString *name = [file nameForVirtualAddress:address.unsignedLongLongValue];
+        if (name.length == 0) continue;
+        [symbols addObject:[@"_" stringByAppendingString:SRKNormalizedSymbolName(name)]];
+    }
+
+    NSArray<NSString *> *sorted = [symbols.allObjects sortedArrayUsingSelector:@selector(compare:)];
+    NSMutableArray<NSString *> *imports = [NSMutableArray arrayWithCapacity:sorted.count];
+    for (NSString *symbol in sorted) {
+        [imports addObject:[@"?:" stringByAppendingString:symbol]];
+    }
+    return @{@"dylibs": @[], @"imports": imports, @"symbols": sorted, @"source": @"hopper"};
+}
+
+NSDictionary *SRKCollectImports(NSObject<HPDisassembledFile> *file) {
+    NSString *path = file.originalFilePath;
+    NSData *data = path ? [NSData dataWithContentsOfFile:path options:NSDataReadingMappedIfSafe error:nil] : nil;
+    if (data) {
+        NSRange slice = SRKMachOSlice(data, SRKArchitectureForFile(file));
+        NSDictionary *imports = slice.length > 0 ?
+                                SRKParseMachOImports((const uint8_t *)data.bytes + slice.location, slice.length) : nil;
+        if (imports) return imports;
+    }
+    return SRKHopperImports(file);
+}
+
+#pragma mark - Signatures
+
+static inline uint64_t SRKImportMix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+static uint64_t SRKImportTokenHash(NSString *token) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char *c = token.UTF8String; c && *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+static void SRKAddMinHashToken(uint32_t *minhash, NSString *token) {
+    uint64_t hash = SRKImportTokenHash(token);
+    for (NSUInteger i = 0; i < SRK_IMPORT_MINHASH_SIZE; i++) {
+        uint32_t value = (uint32_t)SRKImportMix(hash + (i + 1) * 0x9E3779B97F4A7C15ULL);
+        if (value < minhash[i]) minhash[i] = value;
+    }
+}
+
+NSDictionary *SRKComputeImportSignature(NSObject<HPDisassembledFile> *file) {
+    NSDictionary *imports = SRKCollectImports(file);
+    NSArray<NSString *> *symbols = imports[@"symbols"];
+    NSArray<NSString *> *dylibs = imports[@"dylibs"];
+
+    NSData *joined = [[symbols componentsJoinedByString:@","] dataUsingEncoding:NSUTF8StringEncoding];
+    uint8_t digest[CC_MD5_DIGEST_LENGTH];
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wdeprecated-declarations"
+    CC_MD5(joined.bytes, (CC_LONG)joined.length, digest);
+#pragma clang diagnostic pop
+    NSMutableString *symhash = [NSMutableString stringWithCapacity:CC_MD5_DIGEST_LENGTH * 2];
+    for (NSUInteger i = 0; i < CC_MD5_DIGEST_LENGTH; i++) {
+        [symhash appendFormat:@"%02x", digest[i]];
+    }
+
+    uint32_t minhash[SRK_IMPORT_MINHASH_SIZE];
+    memset(minhash, 0xFF, sizeof(minhash));
+    for (NSString *import in imports[@"imports"]) {
+        SRKAddMinHashToken(minhash, import);
+    }
+    for (NSString *dylib in dylibs) {
+        SRKAddMinHashToken(minhash, [@"@dylib:" stringByAppendingString:dylib]);
+    }
+
+    return @{
+        @"symhash": symhash,
+        @"minhash": [NSData dataWithBytes:minhash length:sizeof(minhash)],
+        @"imports": @([imports[@"imports"] count]),
+        @"dylibs": dylibs
+    };
+}
+
+static BOOL SRKImportRecordForSignature(NSDictionary *signature, SRKImportRecord *record) {
+    memset(record, 0, sizeof(SRKImportRecord));
+    NSData *minhash = signature[@"minhash"];
+    NSString *symhash = signature[@"symhash"];
+    if (![minhash isKindOfClass:[NSData class]] || minhash.length != sizeof(record->minhash)) return NO;
+    if (![symhash isKindOfClass:[NSString class]] || symhash.length != CC_MD5_DIGEST_LENGTH * 2) return NO;
+
+    memcpy(record->minhash, minhash.bytes, sizeof(record->minhash));
+    const char *hex = symhash.UTF8String;
+    for (NSUInteger i = 0; i < CC_MD5_DIGEST_LENGTH; i++) {
+        unsigned int value = 0;
+        if (sscanf(hex + i * 2, "%2x", &value) != 1) return NO;
+        record->symhash[i] = (uint8_t)value;
+    }
+    record->imports = [signature[@"imports"] unsignedIntValue];
+    record->dylibs = (uint32_t)[signature[@"dylibs"] count];
+    return YES;
+}
+
+static double SRKRecordSimilarity(const SRKImportRecord *a, const SRKImportRecord *b) {
+    NSUInteger matches = 0;
+    for (NSUInteger i = 0; i < SRK_IMPORT_MINHASH_SIZE; i++) {
+        if (a->minhash[i] == b->minhash[i]) matches++;
+    }
+    return (double)matches / SRK_IMPORT_MINHASH_SIZE;
+}
+
+double SRKImportSimilarity(NSDictionary *a, NSDictionary *b) {
+    SRKImportRecord left;
+    SRKImportRecord right;
+    if (!SRKImportRecordForSignature(a, &left) || !SRKImportRecordForSignature(b, &right)) return 0.0;
+    if (memcmp(left.symhash, right.symhash, CC_MD5_DIGEST_LENGTH) == 0) return 1.0;
+    return SRKRecordSimilarity(&left, &right);
+}
+
+#pragma mark - Index
+
+NSString *SRKImportIndexDirectory(void) {
+    NSString *support = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES).firstObject;
+    if (!support) support = [NSHomeDirectory() stringByAppendingPathComponent:@"Library/Application Support"];
+    return [support stringByAppendingPathComponent:@"HopperSRK/ImportIndex"];
+}
+
+BOOL SRKImportIndexExists(NSString *directory) {
+    return [[NSFileManager defaultManager] fileExistsAtPath:[directory stringByAppendingPathComponent:SRKImportRecordsFile]];
+}
+
+/// Tabs and newlines would break the label line
+static NSString *SRKImportLabelField(NSString *field) {
+    NSCharacterSet *separators = [NSCharacterSet characterSetWithCharactersInString:@"\t\n"];
+    return [[field componentsSeparatedByCharactersInSet:separators] componentsJoinedByString:@" "];
+}
+
+static NSData *SRKImportLabel(NSString *family, NSString *sample) {
+    return [[NSString stringWithFormat:@"%@\t%@\n", SRKImportLabelField(family), SRKImportLabelField(sample)]
+            dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+static NSArray<NSString *> *SRKReadImportLabel(NSFileHandle *labels, uint64_t offset) {
+    [labels seekToFileOffset:offset];
+    NSData *data = [labels readDataOfLength:SRK_IMPORT_LABEL_MAX];
+    NSString *text = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    NSString *line = [text componentsSeparatedByString:@"\n"].firstObject;
+    NSArray<NSString *> *fields = [line componentsSeparatedByString:@"\t"];
+    return fields.count == 2 ? fields : @[@"unknown", line ?: @"?"];
+}
+
+/// Indexes of the records holding this sample: same symhash and same sample name
+static NSIndexSet *SRKImportRecordsOfSample(const SRKImportRecord *records, NSUInteger count, NSFileHandle *labels,
+                                            const SRKImportRecord *query, NSString *sample) {
+    NSMutableIndexSet *matches = [NSMutableIndexSet indexSet];
+    NSString *field = SRKImportLabelField(sample);
+    for (NSUInteger r = 0; labels && r < count; r++) {
+        if (memcmp(records[r].symhash, query->symhash, CC_MD5_DIGEST_LENGTH) != 0) continue;
+        if ([SRKReadImportLabel(labels, records[r].labelOffset)[1] isEqualToString:field]) [matches addIndex:r];
+    }
+    return matches;
+}
+
+static NSFileHandle *SRKOpenForAppending(NSString *path, NSError **error) {
+    NSFileManager *manager = [NSFileManager defaultManager];
+    if (![manager fileExistsAtPath:path] && ![manager createFileAtPath:path contents:nil attributes:nil]) {
+        if (error) *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileWriteUnknownError
+                                            userInfo:@{NSFilePathErrorKey: path}];
+        return nil;
+    }
+    NSFileHandle *handle = [NSFileHandle fileHandleForWritingAtPath:path];
+    if (!handle && error) {
+        *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileWriteNoPermissionError
+                                 userInfo:@{NSFilePathErrorKey: path}];
+    }
+    return handle;
+}
+
+BOOL SRKAppendImportIndex(NSString *directory, NSString *family, NSString *sample,
+                          NSDictionary *signature, NSError **error) {
+    SRKImportRecord record;
+    if (!SRKImportRecordForSignature(signature, &record)) {
+        if (error) *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSPropertyListReadCorruptError userInfo:nil];
+        return NO;
+    }
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES
+                                                    attributes:nil error:error]) {
+        return NO;
+    }
+
+    NSString *labelsPath = [directory stringByAppendingPathComponent:SRKImportLabelsFile];
+    NSString *recordsPath = [directory stringByAppendingPathComponent:SRKImportRecordsFile];
+
+    // Adding a sample again keeps its one record
+    NSData *existing = [NSData dataWithContentsOfFile:recordsPath options:NSDataReadingMappedIfSafe error:nil];
+    NSFileHandle *existingLabels = existing.length > 0 ? [NSFileHandle fileHandleForReadingAtPath:labelsPath] : nil;
+    NSUInteger duplicates = SRKImportRecordsOfSample(existing.bytes, existing.length / sizeof(SRKImportRecord),
+                                                     existingLabels, &record, sample).count;
+    [existingLabels closeFile];
+    if (duplicates > 0) return YES;
+
+    NSFileHandle *labels = SRKOpenForAppending(labelsPath, error);
+    NSFileHandle *records = labels ? SRKOpenForAppending(recordsPath, error) : nil;
+    if (!labels || !records) return NO;
+
+    // Label first, so a record never points past the end of the labels file
+    record.labelOffset = [labels seekToEndOfFile];
+    [labels writeData:SRKImportLabel(family, sample)];
+    [labels closeFile];
+
+    // A record left partial by an interrupted append is overwritten
+    unsigned long long end = [records seekToEndOfFile];
+    [records seekToFileOffset:end - end % sizeof(SRKImportRecord)];
+    [records writeData:[NSData dataWithBytes:&record length:sizeof(SRKImportRecord)]];
+    [records closeFile];
+    return YES;
+}
+
+BOOL SRKRebuildImportIndex(NSString *directory, NSString *corpusDirectory, NSUInteger *count, NSError **error) {
+    NSMutableData *records = [NSMutableData data];
+    NSMutableData *labels = [NSMutableData data];
+    NSMutableSet<NSString *> *indexed = [NSMutableSet set];
+
+    NSDirectoryEnumerator<NSString *> *enumerator = [[NSFileManager defaultManager] enumeratorAtPath:corpusDirectory];
+    for (NSString *relativePath in enumerator) {
+        if (![relativePath.pathExtension isEqualToString:@"plist"]) continue;
+
+        @autoreleasepool {
+            NSData *data = [NSData dataWithContentsOfFile:[corpusDirectory stringByAppendingPathComponent:relativePath]];
+            NSDictionary *plist = data ? [NSPropertyListSerialization propertyListWithData:data options:0 format:NULL error:nil] : nil;
+            if (![plist isKindOfClass:[NSDictionary class]] || ![plist[@"hashes"] isKindOfClass:[NSDictionary class]]) continue;
+
+            SRKImportRecord record;
+            if (![plist[@"hashes"][@"imports"] isKindOfClass:[NSDictionary class]] ||
+                !SRKImportRecordForSignature(plist[@"hashes"][@"imports"], &record)) {
+                continue;
+            }
+
+            // Labelled the same way as SRKLoadFunctionCorpus(): by the folder the sample sits in
+            NSString *folder = relativePath.stringByDeletingLastPathComponent.lastPathComponent;
+            NSString *family = folder.length > 0 ? folder : (plist[@"family"] ?: @"unknown");
+            NSString *sample = plist[@"sample"] ?: relativePath.lastPathComponent.stringByDeletingPathExtension;
+
+            // One record per (symhash, sample), however many copies of the sample the corpus holds
+            NSString *key = [NSString stringWithFormat:@"%@\t%@", plist[@"hashes"][@"imports"][@"symhash"], sample];
+            if ([indexed containsObject:key]) continue;
+            [indexed addObject:key];
+
+            record.labelOffset = labels.length;
+            [labels appendData:SRKImportLabel(family, sample)];
+            [records appendBytes:&record length:sizeof(SRKImportRecord)];
+        }
+    }
+
+    if (count) *count = records.length / sizeof(SRKImportRecord);
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES
+                                                    attributes:nil error:error]) {
+        return NO;
+    }
+    return [labels writeToFile:[directory stringByAppendingPathComponent:SRKImportLabelsFile]
+                       options:NSDataWritingAtomic error:error] &&
+           [records writeToFile:[directory stringByAppendingPathComponent:SRKImportRecordsFile]
+                        options:NSDataWritingAtomic error:error];
+}
+
+NSArray<NSDictionary *> *SRKNearestImportSamples(NSString *directory, NSDictionary *signature, NSString *sample,
+                                                 NSUInteger maximumCount) {
+    SRKImportRecord query;
+    if (maximumCount == 0 || !SRKImportRecordForSignature(signature, &query) || query.imports == 0) return @[];
+
+    NSData *data = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:SRKImportRecordsFile]
+                                          options:NSDataReadingMappedIfSafe error:nil];
+    const SRKImportRecord *records = data.bytes;
+    NSUInteger count = data.length / sizeof(SRKImportRecord);
+    if (count == 0) return @[];
+
+    // Score every record over the mapped file, then keep the best few
+    float *scores = malloc(count * sizeof(float));
+    if (!scores) return @[];
+    size_t chunks = (count + SRK_IMPORT_SCAN_CHUNK - 1) / SRK_IMPORT_SCAN_CHUNK;
+    dispatch_apply(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+        NSUInteger end = MIN(count, (chunk + 1) * SRK_IMPORT_SCAN_CHUNK);
+        for (NSUInteger r = chunk * SRK_IMPORT_SCAN_CHUNK; r < end; r++) {
+            scores[r] = memcmp(records[r].symhash, query.symhash, CC_MD5_DIGEST_LENGTH) == 0 ?
+                        1.0f : (float)SRKRecordSimilarity(&records[r], &query);
+        }
+    });
+
+    NSFileHandle *labels = [NSFileHandle fileHandleForReadingAtPath:[directory stringByAppendingPathComponent:SRKImportLabelsFile]];
+    if (sample) {
+        [SRKImportRecordsOfSample(records, count, labels, &query, sample) enumerateIndexesUsingBlock:^(NSUInteger r, BOOL *stop) {
+            scores[r] = 0.0f;
+        }];
+    }
+
+    NSUInteger keep = MIN(maximumCount, count);
+    NSUInteger *best = calloc(keep, sizeof(NSUInteger));
+    NSUInteger kept = 0;
+    for (NSUInteger r = 0; best && r < count; r++) {
+        if (scores[r] <= 0.0f || (kept == keep && scores[r] <= scores[best[kept - 1]])) continue;
+
+        NSUInteger slot = kept < keep ? kept++ : keep - 1;
+        while (slot > 0 && scores[best[slot - 1]] < scores[r]) {
+            best[slot] = best[slot - 1];
+            slot--;
+        }
+        best[slot] = r;
+    }
+
+    NSMutableArray<NSDictionary *> *neighbours = [NSMutableArray arrayWithCapacity:kept];
+    for (NSUInteger k = 0; k < kept; k++) {
+        const SRKImportRecord *record = &records[best[k]];
+        NSArray<NSString *> *label = labels ? SRKReadImportLabel(labels, record->labelOffset) : @[@"unknown", @"?"];
+        [neighbours addObject:@{
+            @"family": label[0],
+            @"sample": label[1],
+            @"similarity": @(scores[best[k]]),
+            @"symhash_match": @(memcmp(record->symhash, query.symhash, CC_MD5_DIGEST_LENGTH) == 0)
+        }];
+    }
+    [labels closeFile];
+
+    free(best);
+    free(scores);
+    return neighbours;
+}
+
+NSArray<NSDictionary *> *SRKImportFamilies(NSArray<NSDictionary *> *neighbours) {
+    NSMutableDictionary<NSString *, NSMutableDictionary *> *families = [NSMutableDictionary dictionary];
+    for (NSDictionary *neighbour in neighbours) {
+        // Unlabelled samples are no family to rank
+        if ([neighbour[@"family"] isEqualToString:SRK_UNLABELLED_FAMILY]) continue;
+
+        NSMutableDictionary *family = families[neighbour[@"family"]];
+        if (!family) {
+            family = [@{@"family": neighbour[@"family"], @"similarity": neighbour[@"similarity"], @"samples": @0} mutableCopy];
+            families[neighbour[@"family"]] = family;
+        }
+        if ([neighbour[@"similarity"] doubleValue] > [family[@"similarity"] doubleValue]) {
+            family[@"similarity"] = neighbour[@"similarity"];
+        }
+        family[@"samples"] = @([family[@"samples"] unsignedIntegerValue] + 1);
+    }
+
+    return [families.allValues sortedArrayUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+        return [b[@"similarity"] compare:a[@"similarity"]];
+    }];
+}
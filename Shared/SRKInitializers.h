@@ -0,0 +1,47 @@
+/*
+ SRKInitializers.h
+ Early execution roots for HopperSRK analyzers
+
+ Lists the code dyld and the Objective-C runtime run before main: +load
+ methods of the classes and categories in __objc_nlclslist / __objc_nlcatlist,
+ the __mod_init_func pointers and __init_offsets entries, and C++ static
+ initializers recognized by name. These roots seed call graph reachability,
+ giving how much of the binary can run before main.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Early execution roots in the order they run, deduplicated by address:
+ * @{@"address", @"kind", @"source", @"name"?} where kind is +load,
+ * category +load, mod_init_func, init_offsets or c++ initializer, and
+ * source is the list entry (or procedure) the root was found through.
+ */
+NSArray<NSDictionary *> *SRKFindEarlyExecutionRoots(NSObject<HPDisassembledFile> *file, NSDictionary *index);
+
+/**
+ * Procedure entry points reachable from the roots through the call graph, in
+ * breadth-first order (roots first). maximumCount caps the walk, 0 for none.
+ */
+NSArray<NSNumber *> *SRKEarlyReachableProcedures(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                                 NSArray<NSDictionary *> *roots, NSUInteger maximumCount);
+
+/// One "kind  name" description per root, for the analyzer reports
+NSString *SRKDescribeEarlyExecutionRoot(NSDictionary *root);
+
+/// @{@"roots": SRKFindEarlyExecutionRoots, @"reachable": count of procedures reachable from them}
+NSDictionary *SRKEarlyExecutionSummary(NSObject<HPDisassembledFile> *file, NSDictionary *index);
+
+/**
+ * Appends the "[phase] EARLY EXECUTION (BEFORE MAIN)" report section of a
+ * summary and returns its lines for the analyzer's log.
+ */
+NSArray<NSString *> *SRKAppendEarlyExecutionReport(NSMutableString *report, NSDictionary *summary, NSUInteger phase);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,258 @@
+/*
+ SRKInitializers.m
+ Early execution roots for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKInitializers.h"
+
+// method_list_t.entsizeAndFlags
+#define SRK_METHOD_LIST_RELATIVE        0x80000000U
+#define SRK_METHOD_LIST_DIRECT_SELECTOR 0x40000000U
+#define SRK_METHOD_LIST_ENTSIZE_MASK    0x0000FFFCU
+#define SRK_METHOD_LIST_MAX_COUNT       4096
+
+static NSArray<NSObject<HPSection> *> *SRKSectionsNamed(NSObject<HPDisassembledFile> *file, NSString *name) {
+    NSMutableArray<NSObject<HPSection> *> *sections = [NSMutableArray array];
+    for (NSObject<HPSegment> *segment in file.segments) {
+        for (NSObject<HPSection> *section in segment.sections) {
+            if ([section.sectionName isEqualToString:name]) {
+                [sections addObject:section];
+            }
+        }
+    }
+    return sections;
+}
+
+static NSString *SRKInitializerName(NSObject<HPDisassembledFile> *file, Address address) {
+    NSString *name = [file nameForVirtualAddress:address];
+    return name.length > 0 ? name : nil;
+}
+
+#pragma mark - Objective-C +load
+
+/// Implementation of the "load" method of a method_list_t, 0 when it has none
+static Address SRKLoadMethodImplementation(NSObject<HPDisassembledFile> *file, Address methodList) {
+    if (methodList == 0) return 0;
+
+    uint32_t entsizeAndFlags = [file readUInt32AtVirtualAddress:methodList];
+    uint32_t count = [file readUInt32AtVirtualAddress:methodList + 4];
+    uint32_t entsize = entsizeAndFlags & SRK_METHOD_LIST_ENTSIZE_MASK;
+    BOOL relative = (entsizeAndFlags & SRK_METHOD_LIST_RELATIVE) != 0;
+    if (count == 0 || count > SRK_METHOD_LIST_MAX_COUNT || entsize < (relative ? 12 : 24)) return 0;
+
+    for (uint32_t i = 0; i < count; i++) {
+        Address method = methodList + 8 + (Address)i * entsize;
+        Address selector;
+        Address implementation;
+
+        if (relative) {
+            // { int32 name; int32 types; int32 imp } relative to each field
+            Address nameField = method + (int64_t)[file readInt32AtVirtualAddress:method];
+            selector = (entsizeAndFlags & SRK_METHOD_LIST_DIRECT_SELECTOR) ? nameField : SRKReadPointer(file, nameField);
+            implementation = method + 8 + (int64_t)[file readInt32AtVirtualAddress:method + 8];
+        } else {
+            // { SEL name; const char *types; IMP imp }
+            selector = SRKReadPointer(file, method);
+            implementation = SRKReadPointer(file, method + 16);
+        }
+
+        if (selector != 0 && [SRKReadCString(file, selector, 8) isEqualToString:@"load"]) {
+            return implementation;
+        }
+    }
+    return 0;
+}
+
+static void SRKAddClassLoadMethods(NSObject<HPDisassembledFile> *file, NSMutableArray<NSDictionary *> *roots) {
+    for (NSObject<HPSection> *section in SRKSectionsNamed(file, @"__objc_nlclslist")) {
+        for (Address slot = section.startAddress; slot + 8 <= section.endAddress; slot += 8) {
+            Address classAddress = SRKReadPointer(file, slot);
+            Address metaclass = SRKReadPointer(file, classAddress);
+            if (metaclass == 0) continue;
+
+            // metaclass.data -> class_ro_t.baseMethods holds the class methods
+            Address classRO = SRKReadPointer(file, metaclass + 32) & ~(Address)7;
+            Address implementation = SRKLoadMethodImplementation(file, classRO ? SRKReadPointer(file, classRO + 32) : 0);
+            if (implementation == 0) continue;
+
+            NSString *className = SRKObjCClassNameAtAddress(file, classAddress) ?: @"?";
+            [roots addObject:@{
+                @"address": @(implementation),
+                @"kind": @"+load",
+                @"source": @(slot),
+                @"name": [NSString stringWithFormat:@"+[%@ load]", className]
+            }];
+        }
+    }
+}
+
+static void SRKAddCategoryLoadMethods(NSObject<HPDisassembledFile> *file, NSMutableArray<NSDictionary *> *roots) {
+    for (NSObject<HPSection> *section in SRKSectionsNamed(file, @"__objc_nlcatlist")) {
+        for (Address slot = section.startAddress; slot + 8 <= section.endAddress; slot += 8) {
+            // category_t { name; cls; instanceMethods; classMethods; ... }
+            Address category = SRKReadPointer(file, slot);
+            if (category == 0) continue;
+
+            Address implementation = SRKLoadMethodImplementation(file, SRKReadPointer(file, category + 24));
+            if (implementation == 0) continue;
+
+            Address classAddress = SRKReadPointer(file, category + 8);
+            NSString *className = (classAddress ? SRKObjCClassNameAtAddress(file, classAddress) : nil) ?: @"?";
+            NSString *categoryName = SRKReadCString(file, SRKReadPointer(file, category), 256) ?: @"?";
+            [roots addObject:@{
+                @"address": @(implementation),
+                @"kind": @"category +load",
+                @"source": @(slot),
+                @"name": [NSString stringWithFormat:@"+[%@(%@) load]", className, categoryName]
+            }];
+        }
+    }
+}
+
+#pragma mark - Static Initializers
+
+static void SRKAddModInitFunctions(NSObject<HPDisassembledFile> *file, NSMutableArray<NSDictionary *> *roots) {
+    for (NSObject<HPSection> *section in SRKSectionsNamed(file, @"__mod_init_func")) {
+        for (Address slot = section.startAddress; slot + 8 <= section.endAddress; slot += 8) {
+            Address function = SRKReadPointer(file, slot);
+            if (function == 0 || ![file hasCodeAt:function]) continue;
+
+            NSMutableDictionary *root = [@{@"address": @(function), @"kind": @"mod_init_func", @"source": @(slot)} mutableCopy];
+            NSString *name = SRKInitializerName(file, function);
+            if (name) root[@"name"] = name;
+            [roots addObject:root];
+        }
+    }
+}
+
+static void SRKAddInitOffsets(NSObject<HPDisassembledFile> *file, NSMutableArray<NSDictionary *> *roots) {
+    NSObject<HPSegment> *text = [file segmentNamed:@"__TEXT"];
+    Address imageBase = text ? text.startAddress : [file fileBaseAddress];
+
+    for (NSObject<HPSection> *section in SRKSectionsNamed(file, @"__init_offsets")) {
+        for (Address slot = section.startAddress; slot + 4 <= section.endAddress; slot += 4) {
+            // uint32_t offsets from the mach header
+            Address function = imageBase + [file readUInt32AtVirtualAddress:slot];
+            if (![file hasCodeAt:function]) continue;
+
+            NSMutableDictionary *root = [@{@"address": @(function), @"kind": @"init_offsets", @"source": @(slot)} mutableCopy];
+            NSString *name = SRKInitializerName(file, function);
+            if (name) root[@"name"] = name;
+            [roots addObject:root];
+        }
+    }
+}
+
+static BOOL SRKIsCXXInitializerName(NSString *name) {
+    return [name containsString:@"_GLOBAL__sub_I_"] || [name containsString:@"_GLOBAL__I_"] ||
+           [name containsString:@"__cxx_global_var_init"];
+}
+
+static void SRKAddCXXInitializers(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                  NSMutableArray<NSDictionary *> *roots) {
+    NSUInteger count = 0;
+    const Address *entries = SRKProcedureEntries(index, &count);
+
+    for (NSUInteger i = 0; i < count; i++) {
+        NSString *name = SRKInitializerName(file, entries[i]);
+        if (name && SRKIsCXXInitializerName(name)) {
+            [roots addObject:@{@"address": @(entries[i]), @"kind": @"c++ initializer", @"source": @(entries[i]), @"name": name}];
+        }
+    }
+}
+
+#pragma mark - Roots
+
+NSArray<NSDictionary *> *SRKFindEarlyExecutionRoots(NSObject<HPDisassembledFile> *file, NSDictionary *index) {
+    // libobjc runs +load from dyld's image notification, before the image's own initializers
+    NSMutableArray<NSDictionary *> *candidates = [NSMutableArray array];
+    SRKAddClassLoadMethods(file, candidates);
+    SRKAddCategoryLoadMethods(file, candidates);
+    SRKAddModInitFunctions(file, candidates);
+    SRKAddInitOffsets(file, candidates);
+    SRKAddCXXInitializers(file, index, candidates);
+
+    NSMutableArray<NSDictionary *> *roots = [NSMutableArray array];
+    NSMutableSet<NSNumber *> *seen = [NSMutableSet set];
+    for (NSDictionary *root in candidates) {
+        if ([seen containsObject:root[@"address"]]) continue;
+        [seen addObject:root[@"address"]];
+        [roots addObject:root];
+    }
+    return roots;
+}
+
+NSArray<NSNumber *> *SRKEarlyReachableProcedures(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                                 NSArray<NSDictionary *> *roots, NSUInteger maximumCount) {
+    NSMutableArray<NSNumber *> *order = [NSMutableArray array];
+    NSMutableSet<NSNumber *> *visited = [NSMutableSet set];
+    NSMutableArray<NSObject<HPProcedure> *> *queue = [NSMutableArray array];
+
+    for (NSDictionary *root in roots) {
+        NSObject<HPProcedure> *procedure = [file procedureAt:[root[@"address"] unsignedLongLongValue]];
+        if (!procedure) procedure = SRKProcedureContaining(file, index, [root[@"address"] unsignedLongLongValue]);
+        if (!procedure || [visited containsObject:@(procedure.entryPoint)]) continue;
+
+        [visited addObject:@(procedure.entryPoint)];
+        [queue addObject:procedure];
+    }
+
+    for (NSUInteger head = 0; head < queue.count; head++) {
+        NSObject<HPProcedure> *procedure = queue[head];
+        [order addObject:@(procedure.entryPoint)];
+        if (maximumCount > 0 && order.count >= maximumCount) break;
+
+        for (NSObject<HPProcedure> *callee in procedure.allCalleeProcedures) {
+            NSNumber *entry = @(callee.entryPoint);
+            if ([visited containsObject:entry]) continue;
+            [visited addObject:entry];
+            [queue addObject:callee];
+        }
+    }
+
+    return order;
+}
+
+NSString *SRKDescribeEarlyExecutionRoot(NSDictionary *root) {
+    return [NSString stringWithFormat:@"[%@] %@", root[@"kind"], root[@"name"] ?: @"(unnamed)"];
+}
+
+NSDictionary *SRKEarlyExecutionSummary(NSObject<HPDisassembledFile> *file, NSDictionary *index) {
+    NSArray<NSDictionary *> *roots = SRKFindEarlyExecutionRoots(file, index);
+    return @{
+        @"roots": roots,
+        @"reachable": @(SRKEarlyReachableProcedures(file, index, roots, 0).count)
+    };
+}
+
+NSArray<NSString *> *SRKAppendEarlyExecutionReport(NSMutableString *report, NSDictionary *summary, NSUInteger phase) {
+    NSArray<NSDictionary *> *roots = summary[@"roots"];
+    NSMutableArray<NSString *> *lines = [NSMutableArray array];
+
+    [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n"];
+    [report appendFormat:@"[%lu] EARLY EXECUTION (BEFORE MAIN)\n", (unsigned long)phase];
+    [report appendString:@"━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━━\n\n"];
+
+    if (roots.count == 0) {
+        [report appendString:@"✓ No initializers or +load methods run before main\n\n"];
+        [lines addObject:@"✓ No initializers or +load methods"];
+        return lines;
+    }
+
+    NSString *headline = [NSString stringWithFormat:@"Initializers / +load Methods: %lu (%lu procedures reachable)",
+                          (unsigned long)roots.count, [summary[@"reachable"] unsignedLongValue]];
+    [report appendFormat:@"%@\n\n", headline];
+    [lines addObject:headline];
+    for (NSDictionary *root in roots) {
+        NSString *line = [NSString stringWithFormat:@"  [0x%llx] %@", [root[@"address"] unsignedLongLongValue],
+                          SRKDescribeEarlyExecutionRoot(root)];
+        [report appendFormat:@"%@\n", line];
+        [lines addObject:line];
+    }
+    [report appendString:@"\n"];
+    return lines;
+}
@@ -0,0 +1,44 @@
+/*
+ SRKKeychainQueries.h
+ SecItem query dictionary reconstruction for HopperSRK analyzers
+
+ Lifts the procedures calling SecItemCopyMatching, SecItemAdd,
+ SecItemUpdate and SecItemDelete and follows the dictionaries handed to
+ them back to where they were built:
+ - CFDictionaryCreate and +dictionaryWithObjects:forKeys:count: /
+   -initWithObjects:forKeys:count:, reading the key and value arrays from
+   __const or from the stack slots the procedure stored them into
+ - mutable dictionaries filled with CFDictionaryAddValue/SetValue and
+   -setObject:forKey:, including copies and ARC retain/autorelease hops
+ Keys and values are named after the symbols they were loaded from
+ (kSecClass, kSecClassGenericPassword, kCFBooleanTrue...) or the string
+ literals they point to, so the report shows which items a sample reads,
+ writes or deletes. Dictionaries built in another procedure stay unknown.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Most entries read from one key/value array pair
+#define SRK_KEYCHAIN_MAX_ENTRIES 32
+
+/**
+ * One entry per SecItem call site:
+ * @{@"address", @"function", @"procedure",
+ *   @"query": @[@[key, value], ...] or NSNull when it was built elsewhere,
+ *   @"attributes": the same for SecItemUpdate's second dictionary,
+ *   @"class": kSecClass value when known,
+ *   @"returns_secret": YES for SecItemCopyMatching with kSecReturnData}
+ * Unrecovered keys and values are "?".
+ */
+NSArray<NSDictionary *> *SRKKeychainQueries(NSObject<HPDisassembledFile> *file, NSDictionary *index);
+
+/// "{kSecClass: kSecClassGenericPassword, kSecAttrService: \"com.example\"}"
+NSString *SRKKeychainQueryDescription(id _Nullable query);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,284 @@
+/*
+ SRKKeychainQueries.m
+ SecItem query dictionary reconstruction for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKKeychainQueries.h"
+#import "SRKStackFrame.h"
+
+// Synthetic return values standing for the dictionaries built in the procedure
+#define SRK_KEYCHAIN_DICTIONARY_TAG 0x00007ffd00000000ULL
+
+static NSDictionary<NSString *, NSArray<NSNumber *> *> *SRKKeychainCallArguments(void) {
+    // Arguments holding a dictionary
+    return @{
+        @"SecItemCopyMatching": @[@0],
+        @"SecItemAdd": @[@0],
+        @"SecItemUpdate": @[@0, @1],
+        @"SecItemDelete": @[@0]
+    };
+}
+
+static NSSet<NSString *> *SRKKeychainPassThroughFunctions(void) {
+    // Return their first argument: ARC and CF ownership hops between creation and use
+    return [NSSet setWithArray:@[
+        @"objc_retain", @"objc_autorelease", @"objc_retainAutorelease",
+        @"objc_retainAutoreleasedReturnValue", @"objc_unsafeClaimAutoreleasedReturnValue",
+        @"objc_claimAutoreleasedReturnValue", @"objc_retainAutoreleaseReturnValue",
+        @"CFRetain", @"CFAutorelease", @"CFBridgingRelease", @"CFBridgingRetain"
+    ]];
+}
+
+#pragma mark - Values
+
+typedef struct {
+    __unsafe_unretained NSObject<HPDisassembledFile> *file;
+    __unsafe_unretained NSMutableDictionary<NSNumber *, NSValue *> *stack;
+    __unsafe_unretained NSMutableArray<NSMutableArray *> *dictionaries;
+} SRKKeychainFrame;
+
+static NSMutableArray *SRKKeychainDictionaryForValue(SRKKeychainFrame *frame, SRKRegisterValue value) {
+    if (!value.known || value.value < SRK_KEYCHAIN_DICTIONARY_TAG) return nil;
+    uint64_t index = value.value - SRK_KEYCHAIN_DICTIONARY_TAG;
+    return index < frame->dictionaries.count ? frame->dictionaries[(NSUInteger)index] : nil;
+}
+
+static SRKRegisterValue SRKKeychainNewDictionary(SRKKeychainFrame *frame, NSArray * _Nullable pairs) {
+    SRKRegisterValue value;
+    memset(&value, 0, sizeof(SRKRegisterValue));
+    value.known = YES;
+    value.value = SRK_KEYCHAIN_DICTIONARY_TAG + frame->dictionaries.count;
+    [frame->dictionaries addObject:pairs ? [pairs mutableCopy] : [NSMutableArray array]];
+    return value;
+}
+
+static NSString *SRKKeychainSymbolAt(NSObject<HPDisassembledFile> *file, Address address) {
+    if (address == 0 || address == BAD_ADDRESS) return nil;
+    NSString *name = [file nameForVirtualAddress:address];
+    if (name.length == 0) return nil;
+    // @YES / @NO are emitted as __kCFBooleanTrue / __kCFBooleanFalse
+    name = SRKNormalizedSymbolName(name);
+    while ([name hasPrefix:@"_"]) name = [name substringFromIndex:1];
+    return name;
+}
+
+/// kSec* / kCF* constant name, string literal, small integer or nested dictionary; nil when unknown
+static NSString *SRKKeychainDescribeValue(SRKKeychainFrame *frame, SRKRegisterValue value) {
+    if (!value.known && value.slot == 0) return nil;
+
+    NSMutableArray *nested = SRKKeychainDictionaryForValue(frame, value);
+    if (nested) return SRKKeychainQueryDescription(nested);
+
+    NSString *slotName = SRKKeychainSymbolAt(frame->file, value.slot);
+    NSString *valueName = value.known ? SRKKeychainSymbolAt(frame->file, value.value) : nil;
+    for (NSString *name in @[slotName ?: @"", valueName ?: @""]) {
+        if ([name hasPrefix:@"kSec"] || [name hasPrefix:@"kCF"] || [name hasPrefix:@"kLA"]) return name;
+    }
+
+    NSString *string = SRKStringForValue(frame->file, value);
+    if (string) return [NSString stringWithFormat:@"\"%@\"", string];
+
+    if (value.known && value.value < 0x10000) return [NSString stringWithFormat:@"%llu", value.value];
+    return slotName.length > 0 ? slotName : valueName;
+}
+
+/// Element of a key or value array, from the stack slots stored so far or from the binary
+static BOOL SRKKeychainArrayElement(SRKKeychainFrame *frame, Address base, NSUInteger index, SRKRegisterValue *element) {
+    Address address = base + index * 8;
+    if (SRKStackValue(frame->stack, address, element)) return YES;
+    if (SRKIsStackAddress(address) || [frame->file segmentForVirtualAddress:address] == nil) return NO;
+
+    memset(element, 0, sizeof(SRKRegisterValue));
+    element->known = YES;
+    element->value = SRKReadPointer(frame->file, address);
+    element->slot = address;
+    return YES;
+}
+
+static NSArray *SRKKeychainPairsFromArrays(SRKKeychainFrame *frame, SRKRegisterValue keys, SRKRegisterValue values,
+                                           SRKRegisterValue count) {
+    NSMutableArray *pairs = [NSMutableArray array];
+    if (!keys.known || !values.known || !count.known) return pairs;
+
+    NSUInteger entries = (NSUInteger)MIN(count.value, (uint64_t)SRK_KEYCHAIN_MAX_ENTRIES);
+    for (NSUInteger i = 0; i < entries; i++) {
+        SRKRegisterValue key;
+        SRKRegisterValue value;
+        NSString *keyName = SRKKeychainArrayElement(frame, keys.value, i, &key) ? SRKKeychainDescribeValue(frame, key) : nil;
+        NSString *valueName = SRKKeychainArrayElement(frame, values.value, i, &value) ? SRKKeychainDescribeValue(frame, value) : nil;
+        [pairs addObject:@[keyName ?: @"?", valueName ?: @"?"]];
+    }
+    return pairs;
+}
+
+static void SRKKeychainSetPair(SRKKeychainFrame *frame, NSMutableArray *dictionary, SRKRegisterValue key, SRKRegisterValue value) {
+    NSString *keyName = SRKKeychainDescribeValue(frame, key) ?: @"?";
+    NSString *valueName = SRKKeychainDescribeValue(frame, value) ?: @"?";
+
+    for (NSUInteger i = 0; i < dictionary.count; i++) {
+        if (![keyName isEqualToString:@"?"] && [dictionary[i][0] isEqualToString:keyName]) {
+            dictionary[i] = @[keyName, valueName];
+            return;
+        }
+    }
+    if (dictionary.count < SRK_KEYCHAIN_MAX_ENTRIES) [dictionary addObject:@[keyName, valueName]];
+}
+
+#pragma mark - Dictionary Construction
+
+/// Models the dictionary calls, setting state->result when the call returns a dictionary
+static void SRKKeychainApplyCall(SRKKeychainFrame *frame, SRKArchitecture arch, NSString *callee, SRKRegisterState *state) {
+    SRKRegisterValue (^argument)(NSUInteger) = ^SRKRegisterValue(NSUInteger index) {
+        return SRKArgumentValue(state, arch, index);
+    };
+
+    if ([SRKKeychainPassThroughFunctions() containsObject:callee]) {
+        if (SRKKeychainDictionaryForValue(frame, argument(0))) state->result = argument(0);
+        return;
+    }
+
+    if ([callee isEqualToString:@"CFDictionaryCreate"]) {
+        state->result = SRKKeychainNewDictionary(frame, SRKKeychainPairsFromArrays(frame, argument(1), argument(2), argument(3)));
+    } else if ([callee isEqualToString:@"CFDictionaryCreateMutable"]) {
+        state->result = SRKKeychainNewDictionary(frame, nil);
+    } else if ([callee isEqualToString:@"CFDictionaryCreateMutableCopy"] || [callee isEqualToString:@"CFDictionaryCreateCopy"]) {
+        NSUInteger source = [callee isEqualToString:@"CFDictionaryCreateCopy"] ? 1 : 2;
+        state->result = SRKKeychainNewDictionary(frame, SRKKeychainDictionaryForValue(frame, argument(source)));
+    } else if ([callee isEqualToString:@"CFDictionaryAddValue"] || [callee isEqualToString:@"CFDictionarySetValue"] ||
+               [callee isEqualToString:@"CFDictionaryReplaceValue"]) {
+        NSMutableArray *dictionary = SRKKeychainDictionaryForValue(frame, argument(0));
+        if (dictionary) SRKKeychainSetPair(frame, dictionary, argument(1), argument(2));
+    } else if ([callee isEqualToString:@"objc_alloc_init"] || [callee isEqualToString:@"objc_opt_new"]) {
+        NSString *className = argument(0).objcClass ? SRKObjCClassNameAtAddress(frame->file, argument(0).objcClass) : nil;
+        if ([className hasSuffix:@"Dictionary"]) state->result = SRKKeychainNewDictionary(frame, nil);
+    } else if ([callee hasPrefix:@"objc_msgSend"]) {
+        NSString *selector = [callee hasPrefix:@"objc_msgSend$"] ? [callee substringFromIndex:@"objc_msgSend$".length]
+                                                                 : SRKStringForValue(frame->file, argument(1));
+        if (!selector) return;
+
+        NSMutableArray *receiver = SRKKeychainDictionaryForValue(frame, argument(0));
+        if ([selector isEqualToString:@"dictionaryWithObjects:forKeys:count:"] ||
+            [selector isEqualToString:@"initWithObjects:forKeys:count:"]) {
+            state->result = SRKKeychainNewDictionary(frame, SRKKeychainPairsFromArrays(frame, argument(3), argument(2), argument(4)));
+        } else if ([selector isEqualToString:@"dictionaryWithDictionary:"] || [selector isEqualToString:@"initWithDictionary:"]) {
+            state->result = SRKKeychainNewDictionary(frame, SRKKeychainDictionaryForValue(frame, argument(2)));
+        } else if (receiver && ([selector isEqualToString:@"mutableCopy"] || [selector isEqualToString:@"copy"])) {
+            state->result = SRKKeychainNewDictionary(frame, receiver);
+        } else if (receiver && ([selector isEqualToString:@"setObject:forKey:"] || [selector isEqualToString:@"setValue:forKey:"] ||
+                                [selector isEqualToString:@"setObject:forKeyedSubscript:"])) {
+            SRKKeychainSetPair(frame, receiver, argument(3), argument(2));
+        } else if (receiver && [selector isEqualToString:@"addEntriesFromDictionary:"]) {
+            NSMutableArray *source = SRKKeychainDictionaryForValue(frame, argument(2));
+            for (NSArray *pair in source) {
+                if (receiver.count < SRK_KEYCHAIN_MAX_ENTRIES) [receiver addObject:pair];
+            }
+        } else if ([selector isEqualToString:@"dictionary"] || [selector isEqualToString:@"new"]) {
+            NSString *className = argument(0).objcClass ? SRKObjCClassNameAtAddress(frame->file, argument(0).objcClass) : nil;
+            if ([className hasSuffix:@"Dictionary"]) state->result = SRKKeychainNewDictionary(frame, nil);
+        }
+    }
+}
+
+#pragma mark - Procedure Walk
+
+static void SRKKeychainWalkProcedure(SRKKeychainFrame *frame, SRKLifter *lifter, NSObject<HPProcedure> *procedure,
+                                     NSDictionary<NSString *, NSArray<NSNumber *> *> *callArguments,
+                                     NSMutableArray<NSDictionary *> *queries) {
+    SRKArchitecture arch = lifter->arch;
+    Address entry = [procedure entryPoint];
+
+    SRKCallHandler handler = ^(SRKLifter *callLifter, Address callAddress, NSString *callee,
+                               SRKRegisterState *callState, BOOL *stop) {
+        if (!callee) return;
+
+        NSArray<NSNumber *> *dictionaryArguments = callArguments[callee];
+        if (!dictionaryArguments) {
+            SRKKeychainApplyCall(frame, arch, callee, callState);
+            return;
+        }
+
+        NSMutableDictionary *query = [NSMutableDictionary dictionaryWithDictionary:@{
+            @"address": @(callAddress), @"function": callee, @"procedure": @(entry)
+        }];
+        NSArray *pairs = SRKKeychainDictionaryForValue(frame, SRKArgumentValue(callState, arch, [dictionaryArguments[0] unsignedIntegerValue]));
+        query[@"query"] = pairs ? [pairs copy] : [NSNull null];
+        if (dictionaryArguments.count > 1) {
+            NSArray *attributes = SRKKeychainDictionaryForValue(frame, SRKArgumentValue(callState, arch, [dictionaryArguments[1] unsignedIntegerValue]));
+            query[@"attributes"] = attributes ? [attributes copy] : [NSNull null];
+        }
+
+        BOOL returnsData = NO;
+        for (NSArray *pair in pairs) {
+            if ([pair[0] isEqualToString:@"kSecClass"]) query[@"class"] = pair[1];
+            if ([pair[0] isEqualToString:@"kSecReturnData"] && ![pair[1] isEqualToString:@"kCFBooleanFalse"]) returnsData = YES;
+        }
+        query[@"returns_secret"] = @(returnsData && [callee isEqualToString:@"SecItemCopyMatching"]);
+        [queries addObject:query];
+    };
+
+    SRKLiftProcedureWithStack(lifter, procedure, frame->stack, handler);
+}
+
+#pragma mark - Public API
+
+NSArray<NSDictionary *> *SRKKeychainQueries(NSObject<HPDisassembledFile> *file, NSDictionary *index) {
+    NSDictionary<NSString *, NSArray<NSNumber *> *> *callArguments = SRKKeychainCallArguments();
+    NSDictionary<NSNumber *, NSString *> *sites = SRKCallSiteAddresses(file, index, callArguments.allKeys);
+    NSMutableArray<NSDictionary *> *queries = [NSMutableArray array];
+    if (sites.count == 0) return queries;
+
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+    if (lifter.arch == SRKArchitectureUnknown) return queries;
+    lifter.slotNames = index[@"dynamic_slots"];
+
+    // Each procedure is walked once, however many SecItem calls it makes
+    NSMutableSet<NSNumber *> *walked = [NSMutableSet set];
+    NSMutableSet<NSNumber *> *found = [NSMutableSet set];
+    for (NSNumber *site in [sites.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, index, site.unsignedLongLongValue);
+        if (!procedure || [walked containsObject:@([procedure entryPoint])]) continue;
+        [walked addObject:@([procedure entryPoint])];
+
+        NSMutableDictionary<NSNumber *, NSValue *> *stack = [NSMutableDictionary dictionary];
+        NSMutableArray<NSMutableArray *> *dictionaries = [NSMutableArray array];
+        SRKKeychainFrame frame = {file, stack, dictionaries};
+        NSMutableArray<NSDictionary *> *procedureQueries = [NSMutableArray array];
+        SRKKeychainWalkProcedure(&frame, &lifter, procedure, callArguments, procedureQueries);
+
+        for (NSDictionary *query in procedureQueries) {
+            if ([found containsObject:query[@"address"]]) continue;
+            [found addObject:query[@"address"]];
+            [queries addObject:query];
+        }
+    }
+
+    // Call sites the walk did not reach still show up, with an unknown query
+    for (NSNumber *site in sites) {
+        if ([found containsObject:site]) continue;
+        NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, index, site.unsignedLongLongValue);
+        [queries addObject:@{
+            @"address": site, @"function": sites[site],
+            @"procedure": @(procedure ? [procedure entryPoint] : site.unsignedLongLongValue),
+            @"query": [NSNull null], @"returns_secret": @NO
+        }];
+    }
+
+    [queries sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"address" ascending:YES]]];
+    return queries;
+}
+
+NSString *SRKKeychainQueryDescription(id query) {
+    if (![query isKindOfClass:[NSArray class]]) return @"{?}";
+
+    NSMutableArray<NSString *> *entries = [NSMutableArray array];
+    for (NSArray *pair in query) {
+        [entries addObject:[NSString stringWithFormat:@"%@: %@", pair[0], pair[1]]];
+    }
+    return [NSString stringWithFormat:@"{%@}", [entries componentsJoinedByString:@", "]];
+}
@@ -0,0 +1,65 @@
+/*
+ SRKLibraryCode.h
+ Statically linked library identification for HopperSRK analyzers
+
+ Marks the procedures of statically linked libraries (OpenSSL, curl, zlib,
+ the Swift runtime...) so that analyzers can leave them out of their
+ results. Three sources are combined:
+ - FLIRT-style signatures: the first SRK_SIGNATURE_PREFIX bytes of the
+   procedure with relocated bits masked out (branch and adrp immediates,
+   page offsets, rel32 and RIP-relative displacements), plus a CRC16 over
+   the fixed bytes that follow, loaded from the signature directory
+ - Symbol names left in unstripped binaries (exact names for zlib, whose
+   short names would otherwise match unrelated code)
+ - Procedures referencing distinctive library strings (OpenSSL source
+   paths and version, the zlib copyright, the libcurl version) at least
+   twice, or once next to a procedure already labelled the same way;
+   error messages are never used, implants print them too
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Bytes of the masked procedure prefix
+#define SRK_SIGNATURE_PREFIX 32
+/// Procedures shorter than this are too generic to sign
+#define SRK_SIGNATURE_MIN_LENGTH 16
+
+/**
+ * Library procedures of the image:
+ * @{@"ranges": NSData of AddressRange sorted by location, @"procedures",
+ *   @"libraries": @{library name: procedure count}, @"signatures": signatures loaded}
+ */
+NSDictionary *SRKIdentifyLibraryCode(NSObject<HPDisassembledFile> *file, NSDictionary *index);
+
+/// YES when the address is inside a library procedure
+BOOL SRKIsLibraryAddress(NSDictionary *libraryCode, Address address);
+
+/**
+ * YES when every reference to the address (or to the CFString records
+ * pointing at it) comes from library code; unreferenced data returns NO
+ */
+BOOL SRKIsLibraryOnlyReference(NSObject<HPDisassembledFile> *file, NSDictionary *libraryCode, Address address);
+
+/// "OpenSSL: 1204, zlib: 37", most procedures first
+NSString *SRKDescribeLibraryCode(NSDictionary *libraryCode);
+
+#pragma mark - Signatures
+
+/// ~/Library/Application Support/HopperSRK/Signatures
+NSString *SRKLibrarySignatureDirectory(void);
+
+/**
+ * Writes the signatures of every named procedure of the image to
+ * <directory>/<library>.plist, for a build of the library with symbols.
+ * count receives the number of signatures written.
+ */
+BOOL SRKWriteLibrarySignatures(NSString *directory, NSString *library, NSObject<HPDisassembledFile> *file,
+                               NSDictionary *index, NSUInteger *count, NSError **error);
+
+NS_ASSUME_NONNULL_END
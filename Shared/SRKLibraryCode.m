@@ -0,0 +1,660 @@
+/*
+ SRKLibraryCode.m
+ Statically linked library identification for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKLibraryCode.h"
+
+// Masked prefix plus the longest CRC run
+#define SRK_SIGNATURE_SPAN (SRK_SIGNATURE_PREFIX + 255)
+#define SRK_SIGNATURE_FORMAT 1
+// Procedures signed per dispatch_apply iteration
+#define SRK_LIBRARY_CHUNK 256
+// Offset of the characters pointer in a __cfstring record
+#define SRK_CFSTRING_CHARACTERS 16
+// Library string references that label a procedure with no labelled neighbour
+#define SRK_LIBRARY_STRING_ANCHORS 2
+
+typedef struct {
+    uint64_t key;
+    uint16_t crc;
+    uint8_t crcLength;
+    uint8_t valid;
+} SRKProcedureSignature;
+
+typedef struct {
+    uint64_t key;
+    uint32_t length;
+    uint32_t library;
+    uint16_t crc;
+    uint8_t crcLength;
+    uint8_t reserved;
+} SRKLibrarySignature;
+
+static inline uint64_t SRKSignatureMix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+#pragma mark - Relocation Masks
+
+/// Clears the bits of ARM64 instructions that depend on where the code was linked
+static void SRKARM64RelocationMask(const uint8_t *bytes, NSUInteger length, uint8_t *mask) {
+    memset(mask, 0xFF, length);
+    uint32_t pageRegisters = 0;
+
+    for (NSUInteger offset = 0; offset + 4 <= length; offset += 4) {
+        uint32_t instruction = (uint32_t)bytes[offset] | (uint32_t)bytes[offset + 1] << 8 |
+                               (uint32_t)bytes[offset + 2] << 16 | (uint32_t)bytes[offset + 3] << 24;
+        uint32_t rn = (instruction >> 5) & 31;
+        uint32_t keep = 0xFFFFFFFF;
+
+        if ((instruction & 0x7C000000) == 0x14000000) {
+            // b / bl imm26
+            keep = 0xFC000000;
+        } else if ((instruction & 0x1F000000) == 0x10000000) {
+            // adr / adrp immlo:immhi
+            keep = 0x9F00001F;
+            if (instruction & 0x80000000) pageRegisters |= 1U << (instruction & 31);
+        } else if ((instruction & 0x3B000000) == 0x18000000) {
+            // ldr literal imm19
+            keep = 0xFF00001F;
+        } else if ((instruction & 0x7F800000) == 0x11000000 && (pageRegisters & (1U << rn))) {
+            // add xd, xpage, #pageoff
+            keep = ~0x003FFC00U;
+        } else if ((instruction & 0x3B000000) == 0x39000000 && (pageRegisters & (1U << rn))) {
+            // ldr / str [xpage, #pageoff]
+            keep = ~0x003FFC00U;
+        }
+
+        mask[offset] = keep & 0xFF;
+        mask[offset + 1] = (keep >> 8) & 0xFF;
+        mask[offset + 2] = (keep >> 16) & 0xFF;
+        mask[offset + 3] = (keep >> 24) & 0xFF;
+    }
+}
+
+/// Wildcards the last occurrence of a 32-bit displacement inside one instruction
+static void SRKMaskDisplacement(const uint8_t *instruction, NSUInteger length, int32_t displacement, uint8_t *mask) {
+    for (NSInteger k = (NSInteger)length - 4; k >= 1; k--) {
+        if (memcmp(instruction + k, &displacement, 4) == 0) {
+            memset(mask + k, 0, 4);
+            return;
+        }
+    }
+}
+
+/// Wildcards rel32 branch targets and RIP-relative displacements, decoding with the CPU plugin
+static void SRKX86RelocationMask(SRKLifter *lifter, Address address, const uint8_t *bytes, NSUInteger length,
+                                 uint8_t *mask) {
+    memset(mask, 0xFF, length);
+
+    for (NSUInteger offset = 0; offset < length;) {
+        NSUInteger instructionLength = SRKLifterDecode(lifter, address + offset);
+        if (instructionLength == 0 || offset + instructionLength > length) break;
+        const DisasmStruct *disasm = &lifter->disasm;
+        Address next = address + offset + instructionLength;
+
+        for (NSUInteger i = 0; i < DISASM_MAX_OPERANDS; i++) {
+            const DisasmOperand *operand = &disasm->operand[i];
+            if (operand->type == 0 || (operand->type & DISASM_OPERAND_NO_OPERAND)) break;
+
+            if ((operand->type & DISASM_OPERAND_MEMORY_TYPE) &&
+                (DISASM_GET_REGISTER_INDEX_MASK(operand->memory.baseRegistersMask) & (1ULL << DISASM_REG_INDEX_RIP))) {
+                SRKMaskDisplacement(bytes + offset, instructionLength, (int32_t)operand->memory.displacement, mask + offset);
+            } else if ((operand->type & DISASM_OPERAND_CONSTANT_TYPE) && operand->isBranchDestination &&
+                       instructionLength >= 5) {
+                SRKMaskDisplacement(bytes + offset, instructionLength, (int32_t)(operand->immediateValue - next),
+                                    mask + offset);
+            }
+        }
+        offset += instructionLength;
+    }
+}
+
+#pragma mark - Signatures
+
+/// CRC-16/X.25, as used by FLIRT pattern files
+static uint16_t SRKSignatureCRC16(const uint8_t *bytes, NSUInteger length) {
+    uint16_t crc = 0xFFFF;
+    for (NSUInteger i = 0; i < length; i++) {
+        uint8_t data = bytes[i];
+        for (int bit = 0; bit < 8; bit++, data >>= 1) {
+            crc = ((crc ^ data) & 1) ? (crc >> 1) ^ 0x8408 : crc >> 1;
+        }
+    }
+    return (uint16_t)~crc;
+}
+
+static uint64_t SRKSignatureKey(const uint8_t *pattern, const uint8_t *mask, NSUInteger prefixLength) {
+    uint64_t key = SRKSignatureMix(prefixLength);
+    for (NSUInteger i = 0; i < prefixLength; i++) {
+        key = SRKSignatureMix(key ^ ((uint64_t)mask[i] << 8 | (pattern[i] & mask[i])));
+    }
+    return key;
+}
+
+static SRKProcedureSignature SRKSignProcedure(const uint8_t *bytes, const uint8_t *mask, NSUInteger available) {
+    SRKProcedureSignature signature;
+    memset(&signature, 0, sizeof(SRKProcedureSignature));
+    if (available < SRK_SIGNATURE_MIN_LENGTH) return signature;
+
+    NSUInteger prefixLength = MIN((NSUInteger)SRK_SIGNATURE_PREFIX, available);
+    signature.key = SRKSignatureKey(bytes, mask, prefixLength);
+
+    // The CRC covers the fixed bytes after the prefix, up to the first relocation
+    NSUInteger crcLength = 0;
+    while (prefixLength + crcLength < available && crcLength < 255 && mask[prefixLength + crcLength] == 0xFF) {
+        crcLength++;
+    }
+    signature.crcLength = (uint8_t)crcLength;
+    signature.crc = SRKSignatureCRC16(bytes + prefixLength, crcLength);
+    signature.valid = 1;
+    return signature;
+}
+
+/// Mapped bytes of the segments holding procedures, as @{@"start", @"data"}
+static NSArray<NSDictionary *> *SRKCodeSegments(NSObject<HPDisassembledFile> *file) {
+    NSMutableArray<NSDictionary *> *segments = [NSMutableArray array];
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length == 0 || [segment procedureCount] == 0) continue;
+        [segments addObject:@{@"start": @(segment.startAddress), @"data": data}];
+    }
+    return segments;
+}
+
+/// Bytes at the entry point, bounded by the next procedure and the end of the segment
+static const uint8_t *SRKProcedureBytes(NSArray<NSDictionary *> *segments, const Address *entries, NSUInteger count,
+                                        NSUInteger i, NSUInteger *available) {
+    *available = 0;
+    for (NSDictionary *segment in segments) {
+        Address start = [segment[@"start"] unsignedLongLongValue];
+        NSData *data = segment[@"data"];
+        if (entries[i] < start || entries[i] >= start + data.length) continue;
+
+        Address end = start + data.length;
+        if (i + 1 < count && entries[i + 1] < end) end = entries[i + 1];
+        *available = (NSUInteger)MIN((Address)SRK_SIGNATURE_SPAN, end - entries[i]);
+        return (const uint8_t *)data.bytes + (entries[i] - start);
+    }
+    return NULL;
+}
+
+/// Size of the procedure from its entry point to the end of its last basic block
+static uint32_t SRKProcedureExtent(NSObject<HPDisassembledFile> *file, Address entry) {
+    NSObject<HPProcedure> *procedure = [file procedureAt:entry];
+    Address end = entry;
+    NSUInteger blockCount = procedure.basicBlockCount;
+    for (NSUInteger b = 0; b < blockCount; b++) {
+        NSObject<HPBasicBlock> *block = [procedure basicBlockAtIndex:b];
+        if (block.to > end) end = block.to;
+    }
+    return (uint32_t)MIN(end - entry, (Address)UINT32_MAX);
+}
+
+static BOOL SRKIsStubAddress(NSObject<HPDisassembledFile> *file, Address address) {
+    return SRKSectionNameContains(file, address, @"stub");
+}
+
+NSString *SRKLibrarySignatureDirectory(void) {
+    NSString *support = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES).firstObject;
+    if (!support) support = [NSHomeDirectory() stringByAppendingPathComponent:@"Library/Application Support"];
+    return [support stringByAppendingPathComponent:@"HopperSRK/Signatures"];
+}
+
+BOOL SRKWriteLibrarySignatures(NSString *directory, NSString *library, NSObject<HPDisassembledFile> *file,
+                               NSDictionary *index, NSUInteger *count, NSError **error) {
+    NSUInteger entryCount = 0;
+    const Address *entries = SRKProcedureEntries(index, &entryCount);
+    SRKArchitecture arch = [index[@"arch"] unsignedIntegerValue];
+    NSArray<NSDictionary *> *segments = SRKCodeSegments(file);
+
+    NSObject<CPUContext> *cpu = arch == SRKArchitectureX86_64 ? [file buildCPUContext] : nil;
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+    uint8_t mask[SRK_SIGNATURE_SPAN];
+
+    NSMutableArray<NSDictionary *> *signatures = [NSMutableArray array];
+    for (NSUInteger i = 0; i < entryCount; i++) {
+        NSString *name = [file nameForVirtualAddress:entries[i]];
+        if (name.length == 0 || [name hasPrefix:@"sub_"] || [name hasPrefix:@"j_"] || SRKIsStubAddress(file, entries[i])) {
+            continue;
+        }
+
+        NSUInteger available = 0;
+        const uint8_t *bytes = SRKProcedureBytes(segments, entries, entryCount, i, &available);
+        if (!bytes || available < SRK_SIGNATURE_MIN_LENGTH) continue;
+
+        if (arch == SRKArchitectureX86_64) {
+            SRKX86RelocationMask(&lifter, entries[i], bytes, available, mask);
+        } else {
+            SRKARM64RelocationMask(bytes, available, mask);
+        }
+
+        SRKProcedureSignature signature = SRKSignProcedure(bytes, mask, available);
+        NSUInteger prefixLength = MIN((NSUInteger)SRK_SIGNATURE_PREFIX, available);
+        [signatures addObject:@{
+            @"name": name,
+            @"pattern": [NSData dataWithBytes:bytes length:prefixLength],
+            @"mask": [NSData dataWithBytes:mask length:prefixLength],
+            @"crc_length": @(signature.crcLength),
+            @"crc": @(signature.crc),
+            @"length": @(SRKProcedureExtent(file, entries[i]))
+        }];
+    }
+
+    if (count) *count = signatures.count;
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES
+                                                    attributes:nil error:error]) {
+        return NO;
+    }
+
+    NSDictionary *plist = @{@"format": @(SRK_SIGNATURE_FORMAT), @"library": library, @"signatures": signatures};
+    NSData *data = [NSPropertyListSerialization dataWithPropertyList:plist format:NSPropertyListBinaryFormat_v1_0
+                                                             options:0 error:error];
+    NSString *path = [directory stringByAppendingPathComponent:[library stringByAppendingPathExtension:@"plist"]];
+    return data && [data writeToFile:path options:NSDataWritingAtomic error:error];
+}
+
+static int SRKCompareLibrarySignatures(const void *a, const void *b) {
+    uint64_t left = ((const SRKLibrarySignature *)a)->key;
+    uint64_t right = ((const SRKLibrarySignature *)b)->key;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+/// Signatures of every file in the directory sorted by key, libraries receives their names
+static NSData *SRKLoadLibrarySignatures(NSString *directory, NSMutableArray<NSString *> *libraries) {
+    NSMutableData *signatureData = [NSMutableData data];
+
+    for (NSString *fileName in [[NSFileManager defaultManager] contentsOfDirectoryAtPath:directory error:nil]) {
+        if (![fileName.pathExtension isEqualToString:@"plist"]) continue;
+
+        NSData *data = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:fileName]];
+        NSDictionary *plist = data ? [NSPropertyListSerialization propertyListWithData:data options:0 format:NULL error:nil] : nil;
+        if (![plist isKindOfClass:[NSDictionary class]] || [plist[@"format"] integerValue] != SRK_SIGNATURE_FORMAT) continue;
+
+        uint32_t library = (uint32_t)libraries.count;
+        [libraries addObject:plist[@"library"] ?: fileName.stringByDeletingPathExtension];
+
+        for (NSDictionary *entry in plist[@"signatures"]) {
+            NSData *pattern = entry[@"pattern"];
+            NSData *mask = entry[@"mask"];
+            if (![pattern isKindOfClass:[NSData class]] || ![mask isKindOfClass:[NSData class]] ||
+                pattern.length != mask.length || pattern.length == 0 || pattern.length > SRK_SIGNATURE_PREFIX) {
+                continue;
+            }
+
+            SRKLibrarySignature signature;
+            memset(&signature, 0, sizeof(SRKLibrarySignature));
+            signature.key = SRKSignatureKey(pattern.bytes, mask.bytes, pattern.length);
+            signature.crc = [entry[@"crc"] unsignedShortValue];
+            signature.crcLength = [entry[@"crc_length"] unsignedCharValue];
+            signature.length = [entry[@"length"] unsignedIntValue];
+            signature.library = library;
+            [signatureData appendBytes:&signature length:sizeof(SRKLibrarySignature)];
+        }
+    }
+
+    qsort(signatureData.mutableBytes, signatureData.length / sizeof(SRKLibrarySignature),
+          sizeof(SRKLibrarySignature), SRKCompareLibrarySignatures);
+    return signatureData;
+}
+
+#pragma mark - Names and Strings
+
+static NSDictionary<NSString *, NSArray<NSString *> *> *SRKLibraryNamePrefixes(void) {
+    static NSDictionary<NSString *, NSArray<NSString *> *> *prefixes;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        prefixes = @{
+            @"OpenSSL": @[@"SSL_", @"SSL3_", @"TLS_", @"DTLS_", @"EVP_", @"BIO_", @"CRYPTO_", @"OPENSSL_", @"ossl_",
+                          @"X509_", @"X509V3_", @"RSA_", @"DSA_", @"DH_", @"EC_", @"ECDSA_", @"ECDH_", @"BN_",
+                          @"ASN1_", @"PEM_", @"ERR_", @"HMAC_", @"RAND_", @"OBJ_", @"PKCS7_", @"PKCS12_",
+                          @"i2d_", @"d2i_"],
+            @"curl": @[@"curl_", @"Curl_"],
+            @"zlib": @[@"_tr_"],
+            @"Swift runtime": @[@"swift_", @"$ss", @"$sS"]
+        };
+    });
+    return prefixes;
+}
+
+/// Library symbols too short or generic to match by prefix: "inflate" must not take "inflateBuffer" along
+static NSDictionary<NSString *, NSString *> *SRKLibraryExactNames(void) {
+    static NSDictionary<NSString *, NSString *> *names;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        NSArray<NSString *> *zlib = @[
+            @"inflate", @"inflateInit_", @"inflateInit2_", @"inflateEnd", @"inflateReset", @"inflateReset2",
+            @"inflateSetDictionary", @"inflateSync", @"inflate_fast", @"inflate_table",
+            @"deflate", @"deflateInit_", @"deflateInit2_", @"deflateEnd", @"deflateReset", @"deflateParams",
+            @"deflateBound", @"deflateSetDictionary",
+            @"adler32", @"adler32_z", @"adler32_combine", @"crc32", @"crc32_z", @"crc32_combine", @"get_crc_table",
+            @"compress", @"compress2", @"compressBound", @"uncompress", @"uncompress2",
+            @"zError", @"zlibVersion", @"zcalloc", @"zcfree",
+            @"gzopen", @"gzdopen", @"gzread", @"gzwrite", @"gzclose"
+        ];
+        NSMutableDictionary<NSString *, NSString *> *table = [NSMutableDictionary dictionary];
+        for (NSString *name in zlib) table[name] = @"zlib";
+        names = table;
+    });
+    return names;
+}
+
+static NSString *SRKLibraryForName(NSString *name) {
+    NSString *exact = SRKLibraryExactNames()[name];
+    if (exact) return exact;
+
+    NSDictionary<NSString *, NSArray<NSString *> *> *prefixes = SRKLibraryNamePrefixes();
+    for (NSString *library in prefixes) {
+        for (NSString *prefix in prefixes[library]) {
+            if ([name hasPrefix:prefix]) return library;
+        }
+    }
+    return nil;
+}
+
+/// Library whose version, copyright or source path string this is, or nil; error messages are too generic to count
+static const char *SRKLibraryForString(const char *string) {
+    static const char *openSSLDirectories[] = {"crypto/", "ssl/", "providers/", "engines/", NULL};
+
+    size_t length = strlen(string);
+    for (const char **directory = openSSLDirectories; *directory; directory++) {
+        if (strncmp(string, *directory, strlen(*directory)) == 0 && length > 2 && strcmp(string + length - 2, ".c") == 0) {
+            return "OpenSSL";
+        }
+    }
+    if (strncmp(string, "OpenSSL ", 8) == 0 && length > 8 && isdigit((unsigned char)string[8])) return "OpenSSL";
+    // " deflate 1.2.13 Copyright 1995-2022 Jean-loup Gailly and Mark Adler "
+    if ((strncmp(string, " deflate ", 9) == 0 || strncmp(string, " inflate ", 9) == 0) &&
+        strstr(string, " Copyright ") && strstr(string, "Mark Adler")) {
+        return "zlib";
+    }
+    if (strncmp(string, "libcurl/", 8) == 0 && length > 8 && isdigit((unsigned char)string[8])) return "curl";
+    return NULL;
+}
+
+/// Last procedure id whose entry point is at or below the address
+static NSUInteger SRKOwningProcedure(const Address *entries, NSUInteger count, Address address) {
+    NSUInteger low = 0;
+    NSUInteger high = count;
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        if (entries[middle] <= address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low == 0 ? NSNotFound : low - 1;
+}
+
+/**
+ * Labels the procedures referencing library strings. One reference is not
+ * enough: a procedure needs SRK_LIBRARY_STRING_ANCHORS of them, or a
+ * neighbour the signatures or names already put in the same library.
+ */
+static void SRKAssignStringAnchors(NSObject<HPDisassembledFile> *file, const Address *entries, NSUInteger count,
+                                   NSMutableArray<NSString *> *libraries, int32_t *libraryOf) {
+    int32_t *anchorLibrary = malloc(MAX(count, 1) * sizeof(int32_t));
+    uint32_t *anchors = calloc(MAX(count, 1), sizeof(uint32_t));
+    if (!anchorLibrary || !anchors) {
+        free(anchorLibrary);
+        free(anchors);
+        return;
+    }
+    memset(anchorLibrary, 0xFF, MAX(count, 1) * sizeof(int32_t));
+
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length == 0) continue;
+        const char *bytes = data.bytes;
+
+        for (NSObject<HPSection> *section in [segment sections]) {
+            if (!section.pureCStringSection && ![section.sectionName containsString:@"cstring"]) continue;
+            if (section.startAddress < segment.startAddress) continue;
+
+            uint64_t end = MIN((uint64_t)data.length, section.endAddress - segment.startAddress);
+            for (uint64_t offset = section.startAddress - segment.startAddress; offset < end;) {
+                const char *terminator = memchr(bytes + offset, 0, (size_t)(end - offset));
+                if (!terminator) break;
+                uint64_t next = (uint64_t)(terminator - bytes) + 1;
+
+                const char *library = SRKLibraryForString(bytes + offset);
+                if (library) {
+                    NSString *name = @(library);
+                    NSUInteger libraryIndex = [libraries indexOfObject:name];
+                    if (libraryIndex == NSNotFound) {
+                        libraryIndex = libraries.count;
+                        [libraries addObject:name];
+                    }
+
+                    for (NSNumber *reference in [segment referencesToAddress:segment.startAddress + offset]) {
+                        NSUInteger owner = SRKOwningProcedure(entries, count, reference.unsignedLongLongValue);
+                        if (owner == NSNotFound || libraryOf[owner] >= 0) continue;
+                        if (anchorLibrary[owner] < 0) anchorLibrary[owner] = (int32_t)libraryIndex;
+                        if (anchorLibrary[owner] == (int32_t)libraryIndex) anchors[owner]++;
+                    }
+                }
+                offset = next;
+            }
+        }
+    }
+
+    // Neighbours are judged on the signature and name labels only, so anchors never vouch for each other
+    NSMutableIndexSet *anchored = [NSMutableIndexSet indexSet];
+    for (NSUInteger i = 0; i < count; i++) {
+        int32_t library = anchorLibrary[i];
+        if (library < 0) continue;
+        BOOL corroborated = (i > 0 && libraryOf[i - 1] == library) || (i + 1 < count && libraryOf[i + 1] == library);
+        if (anchors[i] >= SRK_LIBRARY_STRING_ANCHORS || corroborated) [anchored addIndex:i];
+    }
+    [anchored enumerateIndexesUsingBlock:^(NSUInteger i, BOOL *stop) {
+        libraryOf[i] = anchorLibrary[i];
+    }];
+
+    free(anchorLibrary);
+    free(anchors);
+}
+
+#pragma mark - Identification
+
+static int SRKCompareAddressRanges(const void *a, const void *b) {
+    Address left = ((const AddressRange *)a)->from;
+    Address right = ((const AddressRange *)b)->from;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+NSDictionary *SRKIdentifyLibraryCode(NSObject<HPDisassembledFile> *file, NSDictionary *index) {
+    NSUInteger count = 0;
+    const Address *entries = SRKProcedureEntries(index, &count);
+    SRKArchitecture arch = [index[@"arch"] unsignedIntegerValue];
+
+    int32_t *libraryOf = malloc(MAX(count, 1) * sizeof(int32_t));
+    uint32_t *expectedLength = calloc(MAX(count, 1), sizeof(uint32_t));
+    if (!libraryOf || !expectedLength) {
+        free(libraryOf);
+        free(expectedLength);
+        return @{@"ranges": [NSData data], @"procedures": @0, @"libraries": @{}, @"signatures": @0};
+    }
+    memset(libraryOf, 0xFF, MAX(count, 1) * sizeof(int32_t));
+
+    NSMutableArray<NSString *> *libraries = [NSMutableArray array];
+    NSData *signatureData = SRKLoadLibrarySignatures(SRKLibrarySignatureDirectory(), libraries);
+    NSUInteger signatureCount = signatureData.length / sizeof(SRKLibrarySignature);
+
+    // Stub entries are the image calling out, never library code
+    uint8_t *isStub = calloc(MAX(count, 1), sizeof(uint8_t));
+    for (NSUInteger i = 0; isStub && i < count; i++) {
+        isStub[i] = SRKIsStubAddress(file, entries[i]);
+    }
+
+    if (signatureCount > 0 && isStub) {
+        NSArray<NSDictionary *> *segments = SRKCodeSegments(file);
+        const uint8_t **procedureBytes = calloc(count, sizeof(uint8_t *));
+        NSUInteger *available = calloc(count, sizeof(NSUInteger));
+        uint8_t *masks = arch == SRKArchitectureX86_64 ? malloc(count * SRK_SIGNATURE_SPAN) : NULL;
+
+        if (procedureBytes && available && (arch != SRKArchitectureX86_64 || masks)) {
+            for (NSUInteger i = 0; i < count; i++) {
+                if (!isStub[i]) procedureBytes[i] = SRKProcedureBytes(segments, entries, count, i, &available[i]);
+            }
+
+            // x86 instruction boundaries come from the CPU plugin, which stays on this thread
+            if (masks) {
+                NSObject<CPUContext> *cpu = [file buildCPUContext];
+                SRKLifter lifter;
+                SRKLifterInit(&lifter, file, cpu);
+                for (NSUInteger i = 0; i < count; i++) {
+                    if (procedureBytes[i] && available[i] >= SRK_SIGNATURE_MIN_LENGTH) {
+                        SRKX86RelocationMask(&lifter, entries[i], procedureBytes[i], available[i],
+                                             masks + i * SRK_SIGNATURE_SPAN);
+                    }
+                }
+            }
+
+            const SRKLibrarySignature *signatures = signatureData.bytes;
+            NSUInteger chunks = (count + SRK_LIBRARY_CHUNK - 1) / SRK_LIBRARY_CHUNK;
+            dispatch_apply(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+                uint8_t localMask[SRK_SIGNATURE_SPAN];
+                NSUInteger last = MIN(count, (chunk + 1) * SRK_LIBRARY_CHUNK);
+                for (NSUInteger i = chunk * SRK_LIBRARY_CHUNK; i < last; i++) {
+                    if (!procedureBytes[i] || available[i] < SRK_SIGNATURE_MIN_LENGTH) continue;
+
+                    const uint8_t *mask = masks ? masks + i * SRK_SIGNATURE_SPAN : localMask;
+                    if (!masks) SRKARM64RelocationMask(procedureBytes[i], available[i], localMask);
+                    SRKProcedureSignature signature = SRKSignProcedure(procedureBytes[i], mask, available[i]);
+                    if (!signature.valid) continue;
+
+                    NSUInteger low = 0;
+                    NSUInteger high = signatureCount;
+                    while (low < high) {
+                        NSUInteger middle = low + (high - low) / 2;
+                        if (signatures[middle].key < signature.key) {
+                            low = middle + 1;
+                        } else {
+                            high = middle;
+                        }
+                    }
+                    for (NSUInteger s = low; s < signatureCount && signatures[s].key == signature.key; s++) {
+                        if (signatures[s].crcLength == signature.crcLength && signatures[s].crc == signature.crc) {
+                            libraryOf[i] = (int32_t)signatures[s].library;
+                            expectedLength[i] = signatures[s].length;
+                            break;
+                        }
+                    }
+                }
+            });
+        }
+
+        free(procedureBytes);
+        free(available);
+        free(masks);
+    }
+
+    // Signature hits are confirmed against the procedure size, then names and strings fill the gaps
+    for (NSUInteger i = 0; i < count; i++) {
+        if (libraryOf[i] >= 0 && expectedLength[i] != 0 && SRKProcedureExtent(file, entries[i]) != expectedLength[i]) {
+            libraryOf[i] = -1;
+        }
+        if (libraryOf[i] >= 0 || (isStub && isStub[i])) continue;
+
+        NSString *name = [file nameForVirtualAddress:entries[i]];
+        NSString *library = name ? SRKLibraryForName(SRKNormalizedSymbolName(name)) : nil;
+        if (library) {
+            NSUInteger libraryIndex = [libraries indexOfObject:library];
+            if (libraryIndex == NSNotFound) {
+                libraryIndex = libraries.count;
+                [libraries addObject:library];
+            }
+            libraryOf[i] = (int32_t)libraryIndex;
+        }
+    }
+    SRKAssignStringAnchors(file, entries, count, libraries, libraryOf);
+
+    NSMutableData *rangeData = [NSMutableData data];
+    NSMutableDictionary<NSString *, NSNumber *> *procedureCounts = [NSMutableDictionary dictionary];
+    for (NSUInteger i = 0; i < count; i++) {
+        if (libraryOf[i] < 0 || (isStub && isStub[i])) continue;
+
+        AddressRange range = {entries[i], MAX(SRKProcedureExtent(file, entries[i]), 1U)};
+        [rangeData appendBytes:&range length:sizeof(AddressRange)];
+        NSString *library = libraries[libraryOf[i]];
+        procedureCounts[library] = @([procedureCounts[library] unsignedIntegerValue] + 1);
+    }
+    qsort(rangeData.mutableBytes, rangeData.length / sizeof(AddressRange), sizeof(AddressRange), SRKCompareAddressRanges);
+
+    free(libraryOf);
+    free(expectedLength);
+    free(isStub);
+
+    return @{
+        @"ranges": rangeData,
+        @"procedures": @(rangeData.length / sizeof(AddressRange)),
+        @"libraries": procedureCounts,
+        @"signatures": @(signatureCount)
+    };
+}
+
+BOOL SRKIsLibraryAddress(NSDictionary *libraryCode, Address address) {
+    NSData *rangeData = libraryCode[@"ranges"];
+    const AddressRange *ranges = rangeData.bytes;
+    NSUInteger count = rangeData.length / sizeof(AddressRange);
+
+    NSUInteger low = 0;
+    NSUInteger high = count;
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        if (ranges[middle].from <= address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low > 0 && address < ranges[low - 1].from + ranges[low - 1].len;
+}
+
+static BOOL SRKReferencesAreLibraryCode(NSObject<HPDisassembledFile> *file, NSDictionary *libraryCode,
+                                        Address address, BOOL followCFStrings) {
+    NSObject<HPSegment> *segment = [file segmentForVirtualAddress:address];
+    NSArray<NSNumber *> *references = [segment referencesToAddress:address];
+    if (references.count == 0) return NO;
+
+    for (NSNumber *reference in references) {
+        Address from = reference.unsignedLongLongValue;
+        if (followCFStrings && SRKSectionNameContains(file, from, @"cfstring")) {
+            // The code references the CFString record holding the characters pointer
+            if (!SRKReferencesAreLibraryCode(file, libraryCode, from - SRK_CFSTRING_CHARACTERS, NO)) return NO;
+        } else if (!SRKIsLibraryAddress(libraryCode, from)) {
+            return NO;
+        }
+    }
+    return YES;
+}
+
+BOOL SRKIsLibraryOnlyReference(NSObject<HPDisassembledFile> *file, NSDictionary *libraryCode, Address address) {
+    if ([libraryCode[@"procedures"] unsignedIntegerValue] == 0) return NO;
+    return SRKReferencesAreLibraryCode(file, libraryCode, address, YES);
+}
+
+NSString *SRKDescribeLibraryCode(NSDictionary *libraryCode) {
+    NSDictionary<NSString *, NSNumber *> *counts = libraryCode[@"libraries"];
+    NSArray<NSString *> *libraries = [counts keysSortedByValueUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) {
+        return [b compare:a];
+    }];
+
+    NSMutableArray<NSString *> *parts = [NSMutableArray array];
+    for (NSString *library in libraries) {
+        [parts addObject:[NSString stringWithFormat:@"%@: %@", library, counts[library]]];
+    }
+    return parts.count > 0 ? [parts componentsJoinedByString:@", "] : @"none";
+}
@@ -0,0 +1,133 @@
+/*
+ SRKLifter.h
+ Shared register-tracking lifter for HopperSRK analyzers
+
+ Walks instructions decoded by Hopper's CPU plugin and keeps a small
+ constant-propagation state for the general purpose registers, so that
+ analyzers can recover the arguments passed at a call site:
+ - adrp/add/ldr (ARM64) and lea/mov (x86_64) address materialization
+ - Loads through selrefs, classrefs, GOT slots and __const pointers
+ - Chained-fixup pointer decoding
+ - Call site notification with the callee symbol name
+
+ The API is plain C so that every plugin bundle can compile it in
+ without registering duplicate Objective-C classes inside Hopper.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+#define SRK_MAX_REGISTERS 32
+
+typedef NS_ENUM(NSUInteger, SRKArchitecture) {
+    SRKArchitectureUnknown = 0,
+    SRKArchitectureARM64,
+    SRKArchitectureX86_64
+};
+
+/**
+ * Value tracked for one register
+ *
+ * slot is the memory location the value was loaded from (selref, classref,
+ * GOT entry...), objcClass the classref or class address the value is known
+ * to be an instance or class object of.
+ */
+typedef struct {
+    BOOL known;
+    uint64_t value;
+    Address slot;
+    Address objcClass;
+} SRKRegisterValue;
+
+typedef struct {
+    SRKRegisterValue regs[SRK_MAX_REGISTERS];
+    /// Set by a call handler to describe the callee's return value
+    SRKRegisterValue result;
+} SRKRegisterState;
+
+/**
+ * Decoding context. The file and CPU context are not retained: the caller
+ * owns them for the lifetime of the lifter.
+ */
+typedef struct {
+    __unsafe_unretained NSObject<HPDisassembledFile> *file;
+    __unsafe_unretained NSObject<CPUContext> *cpu;
+    SRKArchitecture arch;
+    const uint8_t *bytes;
+    Address bytesStart;
+    Address bytesEnd;
+    /// Optional slot address -> symbol name for imports resolved at run time (dlsym results)
+    __unsafe_unretained NSDictionary<NSNumber *, NSString *> * _Nullable slotNames;
+    DisasmStruct disasm;
+} SRKLifter;
+
+/**
+ * Invoked before each call (or tail call to a named function) is applied.
+ * callee is the normalized symbol name of the destination, when known.
+ */
+typedef void (^SRKCallHandler)(SRKLifter *lifter, Address callAddress, NSString * _Nullable callee,
+                               SRKRegisterState *state, BOOL *stop);
+
+#pragma mark - Architecture
+
+SRKArchitecture SRKArchitectureForFile(NSObject<HPDisassembledFile> *file);
+NSUInteger SRKArgumentRegister(SRKArchitecture arch, NSUInteger argumentIndex);
+NSUInteger SRKReturnRegister(SRKArchitecture arch);
+
+#pragma mark - Lifting
+
+void SRKLifterInit(SRKLifter *lifter, NSObject<HPDisassembledFile> *file, NSObject<CPUContext> *cpu);
+void SRKRegisterStateReset(SRKRegisterState *state);
+
+/// Decodes one instruction into lifter->disasm, returns its length or 0
+NSUInteger SRKLifterDecode(SRKLifter *lifter, Address address);
+
+/// Applies the instruction currently held in lifter->disasm to the state
+void SRKLifterExecute(SRKLifter *lifter, SRKRegisterState *state, SRKCallHandler _Nullable handler, BOOL *stop);
+
+/// Lifts [from, to), returns NO if the handler requested a stop
+BOOL SRKLiftRange(SRKLifter *lifter, Address from, Address to, SRKRegisterState *state, SRKCallHandler _Nullable handler);
+
+/// Lifts every basic block of a procedure, carrying state across fall-through edges
+BOOL SRKLiftProcedure(SRKLifter *lifter, NSObject<HPProcedure> *procedure, SRKCallHandler _Nullable handler);
+
+SRKRegisterValue SRKArgumentValue(const SRKRegisterState *state, SRKArchitecture arch, NSUInteger argumentIndex);
+
+/// Destination of the store instruction held in lifter->disasm, if it can be computed
+BOOL SRKLifterStoreAddress(SRKLifter *lifter, const SRKRegisterState *state, Address *address);
+
+/// Value written by that store instruction (its first register or constant source operand)
+BOOL SRKLifterStoredValue(SRKLifter *lifter, const SRKRegisterState *state, SRKRegisterValue *value);
+
+/// Source address and destination register of the load instruction held in lifter->disasm
+BOOL SRKLifterLoadAddress(SRKLifter *lifter, const SRKRegisterState *state, Address *address, NSUInteger *destination);
+
+/// Value of a register or constant operand of the instruction held in lifter->disasm
+BOOL SRKLifterOperandValue(SRKLifter *lifter, const SRKRegisterState *state, NSUInteger operandIndex,
+                           SRKRegisterValue *value);
+
+#pragma mark - Memory Helpers
+
+/// Decodes a raw pointer that may still hold a chained-fixup rebase encoding
+Address SRKDecodePointer(NSObject<HPDisassembledFile> *file, uint64_t raw);
+Address SRKReadPointer(NSObject<HPDisassembledFile> *file, Address address);
+
+/// Reads a NUL terminated UTF-8 string straight from the mapped segment data
+NSString * _Nullable SRKReadCString(NSObject<HPDisassembledFile> *file, Address address, NSUInteger maxLength);
+
+/// Resolves a tracked value to a string: C string, CFString or selref; __objc_stubs code is not resolved
+NSString * _Nullable SRKStringForValue(NSObject<HPDisassembledFile> *file, SRKRegisterValue value);
+
+/// Name of the Objective-C class referenced by a classref slot or class_t address
+NSString * _Nullable SRKObjCClassNameAtAddress(NSObject<HPDisassembledFile> *file, Address address);
+
+/// Strips stub/GOT prefixes and the leading underscore Hopper adds to imported symbols
+NSString *SRKNormalizedSymbolName(NSString *name);
+
+BOOL SRKSectionNameContains(NSObject<HPDisassembledFile> *file, Address address, NSString *fragment);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,858 @@
+/*
+ SRKLifter.m
+ Shared register-tracking lifter for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKLifter.h"
+
+static const NSUInteger SRKX86ArgumentRegisters[] = {
+    DISASM_REG_INDEX_RDI, DISASM_REG_INDEX_RSI, DISASM_REG_INDEX_RDX,
+    DISASM_REG_INDEX_RCX, DISASM_REG_INDEX_R8, DISASM_REG_INDEX_R9
+};
+
+static const NSUInteger SRKX86CallerSavedRegisters[] = {
+    DISASM_REG_INDEX_RAX, DISASM_REG_INDEX_RCX, DISASM_REG_INDEX_RDX,
+    DISASM_REG_INDEX_RSI, DISASM_REG_INDEX_RDI, DISASM_REG_INDEX_R8,
+    DISASM_REG_INDEX_R9, DISASM_REG_INDEX_R10, DISASM_REG_INDEX_R11
+};
+
+// Mnemonics whose first operand is only read
+static const char *SRKARM64NonWritingPrefixes[] = {
+    "st", "cmp", "cmn", "tst", "ccmp", "ccmn", "fcmp", "prfm", "nop", "dmb",
+    "dsb", "isb", "hint", "msr", "sys", "svc", "brk", "hlt", "pac", "aut", NULL
+};
+
+static const char *SRKX86NonWritingPrefixes[] = {
+    "cmp", "test", "push", "bt", "ucomis", "comis", "nop", "int", "syscall",
+    "ud2", "hlt", "cld", "std", "clc", "stc", "prefetch", "lfence", "mfence", "sfence", NULL
+};
+
+#pragma mark - Architecture
+
+SRKArchitecture SRKArchitectureForFile(NSObject<HPDisassembledFile> *file) {
+    NSString *family = file.cpuFamily.lowercaseString ?: @"";
+    NSString *subFamily = file.cpuSubFamily.lowercaseString ?: @"";
+
+    if (![file is64Bits]) {
+        return SRKArchitectureUnknown;
+    }
+
+    if ([family containsString:@"intel"] || [family containsString:@"x86"]) {
+        return SRKArchitectureX86_64;
+    }
+
+    if ([family containsString:@"arm"] || [family containsString:@"aarch64"] ||
+        [subFamily containsString:@"aarch64"] || [subFamily containsString:@"arm64"]) {
+        return SRKArchitectureARM64;
+    }
+
+    return SRKArchitectureUnknown;
+}
+
+NSUInteger SRKArgumentRegister(SRKArchitecture arch, NSUInteger argumentIndex) {
+    if (arch == SRKArchitectureX86_64) {
+        return argumentIndex < 6 ? SRKX86ArgumentRegisters[argumentIndex] : NSNotFound;
+    }
+    return argumentIndex < 8 ? argumentIndex : NSNotFound;
+}
+
+NSUInteger SRKReturnRegister(SRKArchitecture arch) {
+    return arch == SRKArchitectureX86_64 ? DISASM_REG_INDEX_RAX : 0;
+}
+
+#pragma mark - Operand Helpers
+
+static BOOL SRKOperandUsed(const DisasmOperand *operand) {
+    return operand->type != 0 && !(operand->type & DISASM_OPERAND_NO_OPERAND);
+}
+
+static NSInteger SRKRegisterIndexFromMask(uint64_t mask) {
+    uint64_t indexMask = DISASM_GET_REGISTER_INDEX_MASK(mask);
+    if (indexMask == 0) {
+        return -1;
+    }
+    NSInteger index = __builtin_ctzll(indexMask);
+    return index < SRK_MAX_REGISTERS ? index : -1;
+}
+
+static NSInteger SRKOperandRegister(const DisasmOperand *operand) {
+    if (!SRKOperandUsed(operand)) return -1;
+    if (!(operand->type & DISASM_OPERAND_REGISTER_TYPE)) return -1;
+    if (!(operand->type & DISASM_OPERAND_GENERAL_REG)) return -1;
+    return SRKRegisterIndexFromMask(operand->type);
+}
+
+static BOOL SRKOperandIsConstant(const DisasmOperand *operand) {
+    return SRKOperandUsed(operand) &&
+           (operand->type & DISASM_OPERAND_CONSTANT_TYPE) &&
+           !(operand->type & DISASM_OPERAND_FLOAT_CONSTANT);
+}
+
+static uint64_t SRKShiftedImmediate(const DisasmOperand *operand) {
+    uint64_t immediate = (uint64_t)operand->immediateValue;
+    if (operand->shiftMode == DISASM_SHIFT_LSL && operand->shiftAmount > 0 && operand->shiftAmount < 64) {
+        immediate <<= operand->shiftAmount;
+    }
+    return immediate;
+}
+
+static uint64_t SRKTruncate(uint64_t value, uint32_t bits) {
+    if (bits == 0 || bits >= 64) return value;
+    return value & ((1ULL << bits) - 1);
+}
+
+static BOOL SRKEffectiveAddress(SRKLifter *lifter, const SRKRegisterState *state,
+                                const DisasmOperand *operand, Address *address) {
+    if (!SRKOperandUsed(operand) || !(operand->type & DISASM_OPERAND_MEMORY_TYPE)) {
+        return NO;
+    }
+
+    uint64_t baseMask = DISASM_GET_REGISTER_INDEX_MASK(operand->memory.baseRegistersMask);
+    uint64_t indexMask = DISASM_GET_REGISTER_INDEX_MASK(operand->memory.indexRegistersMask);
+
+    if (indexMask == 0) {
+        if (baseMask == 0 && operand->memory.displacement != 0) {
+            *address = (Address)operand->memory.displacement;
+            return YES;
+        }
+
+        NSInteger base = SRKRegisterIndexFromMask(baseMask);
+        if (lifter->arch == SRKArchitectureX86_64 && base == DISASM_REG_INDEX_RIP) {
+            *address = lifter->disasm.instruction.pcRegisterValue + operand->memory.displacement;
+            return YES;
+        }
+        if (base >= 0 && state->regs[base].known) {
+            *address = state->regs[base].value + operand->memory.displacement;
+            return YES;
+        }
+    }
+
+    // Fall back on the address Hopper itself resolved for this instruction
+    Address resolved = lifter->disasm.instruction.addressValue;
+    if (resolved != 0 && [lifter->file segmentForVirtualAddress:resolved] != nil) {
+        *address = resolved;
+        return YES;
+    }
+
+    return NO;
+}
+
+static uint64_t SRKReadSized(NSObject<HPDisassembledFile> *file, Address address, uint32_t bits, BOOL signExtend) {
+    switch (bits) {
+        case 8:
+            return signExtend ? (uint64_t)(int64_t)[file readInt8AtVirtualAddress:address]
+                              : [file readUInt8AtVirtualAddress:address];
+        case 16:
+            return signExtend ? (uint64_t)(int64_t)[file readInt16AtVirtualAddress:address]
+                              : [file readUInt16AtVirtualAddress:address];
+        case 32:
+            return signExtend ? (uint64_t)(int64_t)[file readInt32AtVirtualAddress:address]
+                              : [file readUInt32AtVirtualAddress:address];
+        default:
+            return [file readUInt64AtVirtualAddress:address];
+    }
+}
+
+static BOOL SRKHasPrefixInList(const char *mnemonic, const char **prefixes) {
+    for (NSUInteger i = 0; prefixes[i] != NULL; i++) {
+        if (strncmp(mnemonic, prefixes[i], strlen(prefixes[i])) == 0) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+static void SRKClearRegister(SRKRegisterState *state, NSInteger reg) {
+    if (reg >= 0 && reg < SRK_MAX_REGISTERS) {
+        memset(&state->regs[reg], 0, sizeof(SRKRegisterValue));
+    }
+}
+
+static void SRKSetConstant(SRKRegisterState *state, NSInteger reg, uint64_t value) {
+    if (reg < 0 || reg >= SRK_MAX_REGISTERS) return;
+    SRKClearRegister(state, reg);
+    state->regs[reg].known = YES;
+    state->regs[reg].value = value;
+}
+
+static void SRKClobberWrittenRegisters(SRKLifter *lifter, SRKRegisterState *state) {
+    DisasmStruct *disasm = &lifter->disasm;
+    const char *mnemonic = disasm->instruction.mnemonic;
+    const char **nonWriting = lifter->arch == SRKArchitectureX86_64 ? SRKX86NonWritingPrefixes
+                                                                     : SRKARM64NonWritingPrefixes;
+    BOOL firstIsDestination = !SRKHasPrefixInList(mnemonic, nonWriting);
+
+    for (NSUInteger i = 0; i < DISASM_MAX_OPERANDS; i++) {
+        DisasmOperand *operand = &disasm->operand[i];
+        NSInteger reg = SRKOperandRegister(operand);
+        if (reg < 0) continue;
+        if ((operand->accessMode & DISASM_ACCESS_WRITE) || (i == 0 && firstIsDestination)) {
+            SRKClearRegister(state, reg);
+        }
+    }
+
+    // Pair loads and exchanges also write their second operand
+    if ((lifter->arch == SRKArchitectureARM64 && (strncmp(mnemonic, "ldp", 3) == 0 || strncmp(mnemonic, "ldnp", 4) == 0 ||
+                                                  strncmp(mnemonic, "ldxp", 4) == 0 || strncmp(mnemonic, "ldaxp", 5) == 0)) ||
+        (lifter->arch == SRKArchitectureX86_64 && (strncmp(mnemonic, "xchg", 4) == 0 || strncmp(mnemonic, "xadd", 4) == 0))) {
+        SRKClearRegister(state, SRKOperandRegister(&disasm->operand[1]));
+    }
+
+    uint32_t implicitMask = disasm->implicitlyWrittenRegisters[DISASM_OPERAND_GENERAL_REG_INDEX];
+    while (implicitMask != 0) {
+        NSInteger reg = __builtin_ctz(implicitMask);
+        SRKClearRegister(state, reg);
+        implicitMask &= implicitMask - 1;
+    }
+}
+
+static void SRKClobberCallerSavedRegisters(SRKRegisterState *state, SRKArchitecture arch) {
+    if (arch == SRKArchitectureX86_64) {
+        for (NSUInteger i = 0; i < sizeof(SRKX86CallerSavedRegisters) / sizeof(SRKX86CallerSavedRegisters[0]); i++) {
+            SRKClearRegister(state, SRKX86CallerSavedRegisters[i]);
+        }
+    } else {
+        for (NSInteger reg = 0; reg <= 18; reg++) {
+            SRKClearRegister(state, reg);
+        }
+        SRKClearRegister(state, 30);
+    }
+}
+
+#pragma mark - Lifting
+
+void SRKLifterInit(SRKLifter *lifter, NSObject<HPDisassembledFile> *file, NSObject<CPUContext> *cpu) {
+    memset(lifter, 0, sizeof(SRKLifter));
+    lifter->file = file;
+    lifter->cpu = cpu;
+    lifter->arch = SRKArchitectureForFile(file);
+}
+
+void SRKRegisterStateReset(SRKRegisterState *state) {
+    memset(state, 0, sizeof(SRKRegisterState));
+}
+
+static BOOL SRKLifterMapBytes(SRKLifter *lifter, Address address) {
+    if (lifter->bytes != NULL && address >= lifter->bytesStart && address < lifter->bytesEnd) {
+        return YES;
+    }
+
+    NSObject<HPSegment> *segment = [lifter->file segmentForVirtualAddress:address];
+    NSData *data = segment.mappedData;
+    if (data.length == 0) {
+        lifter->bytes = NULL;
+        return NO;
+    }
+
+    lifter->bytes = data.bytes;
+    lifter->bytesStart = segment.startAddress;
+    lifter->bytesEnd = segment.startAddress + data.length;
+
+    return address >= lifter->bytesStart && address < lifter->bytesEnd;
+}
+
+NSUInteger SRKLifterDecode(SRKLifter *lifter, Address address) {
+    if (!SRKLifterMapBytes(lifter, address) || lifter->bytesEnd - address < 4) {
+        return 0;
+    }
+
+    DisasmStruct *disasm = &lifter->disasm;
+    [lifter->cpu initDisasmStructure:disasm withSyntaxIndex:lifter->file.userRequestedSyntaxIndex];
+    disasm->bytes = lifter->bytes + (address - lifter->bytesStart);
+    disasm->virtualAddr = address;
+
+    int length = [lifter->cpu disassembleSingleInstruction:disasm
+                                        usingProcessorMode:[lifter->file cpuModeAtVirtualAddress:address]];
+    if (length == DISASM_UNKNOWN_OPCODE || length <= 0) {
+        return 0;
+    }
+
+    return (NSUInteger)length;
+}
+
+static BOOL SRKIsImportTarget(SRKLifter *lifter, Address target, Address slot) {
+    if (slot != 0) return YES;
+    if (target == 0 || target == BAD_ADDRESS) return NO;
+
+    NSObject<HPSection> *section = [lifter->file sectionForVirtualAddress:target];
+    if (!section) return YES;
+
+    NSString *sectionName = section.sectionName;
+    return [sectionName containsString:@"stub"] || [sectionName containsString:@"got"] ||
+           [sectionName containsString:@"symbol_ptr"];
+}
+
+static void SRKLifterExecuteCall(SRKLifter *lifter, SRKRegisterState *state, SRKCallHandler handler, BOOL *stop) {
+    DisasmStruct *disasm = &lifter->disasm;
+    DisasmOperand *operand = &disasm->operand[0];
+    Address target = BAD_ADDRESS;
+    Address slot = 0;
+
+    if (SRKOperandIsConstant(operand)) {
+        target = (Address)operand->immediateValue;
+    } else if (operand->type & DISASM_OPERAND_MEMORY_TYPE) {
+        if (SRKEffectiveAddress(lifter, state, operand, &slot)) {
+            target = SRKReadPointer(lifter->file, slot);
+        }
+    } else {
+        NSInteger reg = SRKOperandRegister(operand);
+        if (reg >= 0) {
+            if (state->regs[reg].known) target = state->regs[reg].value;
+            slot = state->regs[reg].slot;
+        }
+    }
+
+    if ((target == BAD_ADDRESS || target == 0) && disasm->instruction.addressValue != 0) {
+        target = disasm->instruction.addressValue;
+    }
+
+    BOOL isCall = disasm->instruction.branchType == DISASM_BRANCH_CALL;
+    if (!isCall && !SRKIsImportTarget(lifter, target, slot)) {
+        // Plain jump inside the procedure
+        return;
+    }
+
+    // Slots filled at run time (dlsym results) carry an already normalized name
+    NSString *callee = slot != 0 ? lifter->slotNames[@(slot)] : nil;
+    if (!callee) {
+        if (target != BAD_ADDRESS && target != 0) {
+            callee = [lifter->file nameForVirtualAddress:target];
+        }
+        if (callee.length == 0 && slot != 0) {
+            callee = [lifter->file nameForVirtualAddress:slot];
+        }
+        callee = callee.length > 0 ? SRKNormalizedSymbolName(callee) : nil;
+    }
+
+    memset(&state->result, 0, sizeof(SRKRegisterValue));
+    if (handler) {
+        handler(lifter, disasm->virtualAddr, callee, state, stop);
+    }
+
+    SRKRegisterValue result = state->result;
+    SRKClobberCallerSavedRegisters(state, lifter->arch);
+    if (result.known || result.objcClass != 0) {
+        state->regs[SRKReturnRegister(lifter->arch)] = result;
+    }
+    memset(&state->result, 0, sizeof(SRKRegisterValue));
+}
+
+static void SRKExecuteLoad(SRKLifter *lifter, SRKRegisterState *state, NSInteger dstReg,
+                           const DisasmOperand *source, uint32_t bits, BOOL signExtend) {
+    Address address = 0;
+
+    if (SRKOperandIsConstant(source)) {
+        // ARM64 literal pool load
+        address = (Address)source->immediateValue;
+    } else if (!SRKEffectiveAddress(lifter, state, source, &address)) {
+        SRKClearRegister(state, dstReg);
+        return;
+    }
+
+    if (address == 0 || [lifter->file segmentForVirtualAddress:address] == nil) {
+        SRKClearRegister(state, dstReg);
+        return;
+    }
+
+    uint64_t value = SRKReadSized(lifter->file, address, bits, signExtend);
+    if (bits >= 64) {
+        Address decoded = SRKDecodePointer(lifter->file, value);
+        if (decoded != 0) value = decoded;
+    }
+
+    SRKSetConstant(state, dstReg, value);
+    state->regs[dstReg].slot = address;
+
+    if (SRKSectionNameContains(lifter->file, address, @"classrefs") ||
+        SRKSectionNameContains(lifter->file, address, @"superrefs")) {
+        state->regs[dstReg].objcClass = address;
+    }
+}
+
+static BOOL SRKExecuteARM64(SRKLifter *lifter, SRKRegisterState *state) {
+    DisasmStruct *disasm = &lifter->disasm;
+    const char *mnemonic = disasm->instruction.mnemonic;
+    DisasmOperand *dst = &disasm->operand[0];
+    DisasmOperand *src = &disasm->operand[1];
+    DisasmOperand *extra = &disasm->operand[2];
+    NSInteger dstReg = SRKOperandRegister(dst);
+    NSInteger srcReg = SRKOperandRegister(src);
+
+    if (dstReg < 0) {
+        // Stores, compares and branches don't define a register we track
+        return strncmp(mnemonic, "st", 2) == 0;
+    }
+
+    if (strcmp(mnemonic, "adrp") == 0 || strcmp(mnemonic, "adr") == 0) {
+        if (!SRKOperandIsConstant(src)) return NO;
+        SRKSetConstant(state, dstReg, (uint64_t)src->immediateValue);
+        return YES;
+    }
+
+    if (strcmp(mnemonic, "add") == 0 || strcmp(mnemonic, "sub") == 0) {
+        if (srcReg < 0 || !state->regs[srcReg].known || !SRKOperandIsConstant(extra)) return NO;
+        uint64_t immediate = SRKShiftedImmediate(extra);
+        uint64_t base = state->regs[srcReg].value;
+        SRKSetConstant(state, dstReg, SRKTruncate(mnemonic[0] == 'a' ? base + immediate : base - immediate, dst->size));
+        return YES;
+    }
+
+    if (strcmp(mnemonic, "mov") == 0) {
+        if (srcReg >= 0) {
+            SRKRegisterValue copy = state->regs[srcReg];
+            state->regs[dstReg] = copy;
+            if (copy.known) state->regs[dstReg].value = SRKTruncate(copy.value, dst->size);
+            return YES;
+        }
+        if (SRKOperandIsConstant(src)) {
+            SRKSetConstant(state, dstReg, SRKTruncate(SRKShiftedImmediate(src), dst->size));
+            return YES;
+        }
+        return NO;
+    }
+
+    if (strcmp(mnemonic, "movz") == 0 || strcmp(mnemonic, "movn") == 0) {
+        if (!SRKOperandIsConstant(src)) return NO;
+        uint64_t immediate = SRKShiftedImmediate(src);
+        SRKSetConstant(state, dstReg, SRKTruncate(mnemonic[3] == 'n' ? ~immediate : immediate, dst->size));
+        return YES;
+    }
+
+    if (strcmp(mnemonic, "movk") == 0) {
+        if (!state->regs[dstReg].known || !SRKOperandIsConstant(src)) return NO;
+        int32_t shift = src->shiftMode == DISASM_SHIFT_LSL ? src->shiftAmount : 0;
+        if (shift < 0 || shift > 48) return NO;
+        uint64_t mask = 0xFFFFULL << shift;
+        uint64_t value = (state->regs[dstReg].value & ~mask) | (((uint64_t)src->immediateValue & 0xFFFF) << shift);
+        SRKSetConstant(state, dstReg, SRKTruncate(value, dst->size));
+        return YES;
+    }
+
+    if ((strncmp(mnemonic, "ldr", 3) == 0 || strncmp(mnemonic, "ldur", 4) == 0) &&
+        strncmp(mnemonic, "ldrex", 5) != 0) {
+        const char *suffix = mnemonic + (mnemonic[2] == 'u' ? 4 : 3);
+        BOOL signExtend = suffix[0] == 's';
+        if (signExtend) suffix++;
+        uint32_t bits = dst->size ?: 64;
+        if (suffix[0] == 'b') bits = 8;
+        else if (suffix[0] == 'h') bits = 16;
+        else if (suffix[0] == 'w') bits = 32;
+        SRKExecuteLoad(lifter, state, dstReg, src, bits, signExtend);
+        return YES;
+    }
+
+    return NO;
+}
+
+static BOOL SRKExecuteX86(SRKLifter *lifter, SRKRegisterState *state) {
+    DisasmStruct *disasm = &lifter->disasm;
+    const char *mnemonic = disasm->instruction.mnemonic;
+    DisasmOperand *dst = &disasm->operand[0];
+    DisasmOperand *src = &disasm->operand[1];
+    NSInteger dstReg = SRKOperandRegister(dst);
+    NSInteger srcReg = SRKOperandRegister(src);
+
+    if (dstReg < 0) {
+        // Memory destinations leave the register file untouched
+        return (dst->type & DISASM_OPERAND_MEMORY_TYPE) &&
+               (strcmp(mnemonic, "mov") == 0 || strncmp(mnemonic, "movs", 4) == 0 ||
+                strncmp(mnemonic, "movap", 5) == 0 || strncmp(mnemonic, "movup", 5) == 0);
+    }
+
+    if (strcmp(mnemonic, "lea") == 0) {
+        Address address = 0;
+        if (!SRKEffectiveAddress(lifter, state, src, &address)) return NO;
+        SRKSetConstant(state, dstReg, address);
+        return YES;
+    }
+
+    if (strcmp(mnemonic, "mov") == 0 || strcmp(mnemonic, "movabs") == 0) {
+        if (srcReg >= 0) {
+            SRKRegisterValue copy = state->regs[srcReg];
+            state->regs[dstReg] = copy;
+            if (copy.known) state->regs[dstReg].value = SRKTruncate(copy.value, dst->size);
+            return YES;
+        }
+        if (SRKOperandIsConstant(src)) {
+            SRKSetConstant(state, dstReg, SRKTruncate((uint64_t)src->immediateValue, dst->size));
+            return YES;
+        }
+        if (src->type & DISASM_OPERAND_MEMORY_TYPE) {
+            SRKExecuteLoad(lifter, state, dstReg, src, src->size ?: dst->size, NO);
+            return YES;
+        }
+        return NO;
+    }
+
+    if (strcmp(mnemonic, "xor") == 0 && srcReg == dstReg) {
+        SRKSetConstant(state, dstReg, 0);
+        return YES;
+    }
+
+    if ((strcmp(mnemonic, "add") == 0 || strcmp(mnemonic, "sub") == 0) &&
+        state->regs[dstReg].known && SRKOperandIsConstant(src)) {
+        uint64_t base = state->regs[dstReg].value;
+        uint64_t immediate = (uint64_t)src->immediateValue;
+        SRKSetConstant(state, dstReg, SRKTruncate(mnemonic[0] == 'a' ? base + immediate : base - immediate, dst->size));
+        return YES;
+    }
+
+    return NO;
+}
+
+void SRKLifterExecute(SRKLifter *lifter, SRKRegisterState *state, SRKCallHandler handler, BOOL *stop) {
+    DisasmBranchType branchType = lifter->disasm.instruction.branchType;
+
+    if (branchType == DISASM_BRANCH_CALL || branchType == DISASM_BRANCH_JMP) {
+        SRKLifterExecuteCall(lifter, state, handler, stop);
+        return;
+    }
+    if (branchType != DISASM_BRANCH_NONE) {
+        return;
+    }
+
+    BOOL handled = NO;
+    if (lifter->arch == SRKArchitectureARM64) {
+        handled = SRKExecuteARM64(lifter, state);
+    } else if (lifter->arch == SRKArchitectureX86_64) {
+        handled = SRKExecuteX86(lifter, state);
+    }
+
+    if (!handled) {
+        SRKClobberWrittenRegisters(lifter, state);
+    }
+}
+
+BOOL SRKLiftRange(SRKLifter *lifter, Address from, Address to, SRKRegisterState *state, SRKCallHandler handler) {
+    Address address = from;
+    BOOL stop = NO;
+
+    while (address < to) {
+        NSUInteger length = SRKLifterDecode(lifter, address);
+        if (length == 0) break;
+
+        SRKLifterExecute(lifter, state, handler, &stop);
+        if (stop) return NO;
+
+        address += length;
+    }
+
+    return YES;
+}
+
+BOOL SRKLiftProcedure(SRKLifter *lifter, NSObject<HPProcedure> *procedure, SRKCallHandler handler) {
+    SRKRegisterState state;
+    SRKRegisterStateReset(&state);
+
+    Address previousStart = BAD_ADDRESS;
+    Address previousEnd = BAD_ADDRESS;
+    NSUInteger count = procedure.basicBlockCount;
+
+    for (NSUInteger i = 0; i < count; i++) {
+        NSObject<HPBasicBlock> *block = [procedure basicBlockAtIndex:i];
+        if (!block) continue;
+
+        // Only keep the state when the block is reached by falling through from the previous one
+        NSArray<NSObject<HPBasicBlock> *> *predecessors = block.predecessors;
+        BOOL fallsThrough = (block.from == previousEnd && predecessors.count == 1 &&
+                             predecessors.firstObject.from == previousStart);
+        if (!fallsThrough) {
+            SRKRegisterStateReset(&state);
+        }
+
+        if (!SRKLiftRange(lifter, block.from, block.to, &state, handler)) {
+            return NO;
+        }
+
+        previousStart = block.from;
+        previousEnd = block.to;
+    }
+
+    return YES;
+}
+
+SRKRegisterValue SRKArgumentValue(const SRKRegisterState *state, SRKArchitecture arch, NSUInteger argumentIndex) {
+    SRKRegisterValue value;
+    memset(&value, 0, sizeof(SRKRegisterValue));
+
+    NSUInteger reg = SRKArgumentRegister(arch, argumentIndex);
+    if (reg != NSNotFound && reg < SRK_MAX_REGISTERS) {
+        value = state->regs[reg];
+    }
+    return value;
+}
+
+BOOL SRKLifterStoreAddress(SRKLifter *lifter, const SRKRegisterState *state, Address *address) {
+    DisasmStruct *disasm = &lifter->disasm;
+    const char *mnemonic = disasm->instruction.mnemonic;
+
+    if (lifter->arch == SRKArchitectureARM64) {
+        if (strncmp(mnemonic, "st", 2) != 0) return NO;
+    } else if (lifter->arch == SRKArchitectureX86_64) {
+        if (!(disasm->operand[0].type & DISASM_OPERAND_MEMORY_TYPE) || strncmp(mnemonic, "mov", 3) != 0) return NO;
+    } else {
+        return NO;
+    }
+
+    for (NSUInteger i = 0; i < DISASM_MAX_OPERANDS; i++) {
+        DisasmOperand *operand = &disasm->operand[i];
+        if (SRKOperandUsed(operand) && (operand->type & DISASM_OPERAND_MEMORY_TYPE)) {
+            return SRKEffectiveAddress(lifter, state, operand, address);
+        }
+    }
+    return NO;
+}
+
+BOOL SRKLifterLoadAddress(SRKLifter *lifter, const SRKRegisterState *state, Address *address, NSUInteger *destination) {
+    DisasmStruct *disasm = &lifter->disasm;
+    const char *mnemonic = disasm->instruction.mnemonic;
+
+    if (lifter->arch == SRKArchitectureARM64) {
+        if ((strncmp(mnemonic, "ldr", 3) != 0 && strncmp(mnemonic, "ldur", 4) != 0) ||
+            strncmp(mnemonic, "ldrex", 5) == 0) return NO;
+    } else if (lifter->arch == SRKArchitectureX86_64) {
+        if (strcmp(mnemonic, "mov") != 0) return NO;
+    } else {
+        return NO;
+    }
+
+    NSInteger reg = SRKOperandRegister(&disasm->operand[0]);
+    if (reg < 0 || !(disasm->operand[1].type & DISASM_OPERAND_MEMORY_TYPE)) return NO;
+    if (!SRKEffectiveAddress(lifter, state, &disasm->operand[1], address)) return NO;
+
+    *destination = (NSUInteger)reg;
+    return YES;
+}
+
+BOOL SRKLifterStoredValue(SRKLifter *lifter, const SRKRegisterState *state, SRKRegisterValue *value) {
+    for (NSUInteger i = 0; i < DISASM_MAX_OPERANDS; i++) {
+        DisasmOperand *operand = &lifter->disasm.operand[i];
+        if (!SRKOperandUsed(operand) || (operand->type & DISASM_OPERAND_MEMORY_TYPE)) continue;
+
+        NSInteger reg = SRKOperandRegister(operand);
+        if (reg >= 0) {
+            *value = state->regs[reg];
+            return YES;
+        }
+        if (SRKOperandIsConstant(operand)) {
+            memset(value, 0, sizeof(SRKRegisterValue));
+            value->known = YES;
+            value->value = (uint64_t)operand->immediateValue;
+            return YES;
+        }
+    }
+    return NO;
+}
+
+BOOL SRKLifterOperandValue(SRKLifter *lifter, const SRKRegisterState *state, NSUInteger operandIndex,
+                           SRKRegisterValue *value) {
+    if (operandIndex >= DISASM_MAX_OPERANDS) return NO;
+
+    DisasmOperand *operand = &lifter->disasm.operand[operandIndex];
+    NSInteger reg = SRKOperandRegister(operand);
+    if (reg >= 0) {
+        *value = state->regs[reg];
+        return YES;
+    }
+    if (SRKOperandIsConstant(operand)) {
+        memset(value, 0, sizeof(SRKRegisterValue));
+        value->known = YES;
+        value->value = SRKShiftedImmediate(operand);
+        return YES;
+    }
+    return NO;
+}
+
+#pragma mark - Memory Helpers
+
+static Address SRKImageBase(NSObject<HPDisassembledFile> *file) {
+    NSObject<HPSegment> *text = [file segmentNamed:@"__TEXT"];
+    return text ? text.startAddress : [file fileBaseAddress];
+}
+
+Address SRKDecodePointer(NSObject<HPDisassembledFile> *file, uint64_t raw) {
+    if (raw == 0) return 0;
+    if ([file segmentForVirtualAddress:raw] != nil) return raw;
+
+    Address imageBase = SRKImageBase(file);
+    BOOL highBit = (raw >> 63) & 1;
+
+    if (highBit) {
+        // DYLD_CHAINED_PTR_ARM64E auth rebase carries diversity bits, a plain bind doesn't
+        BOOL arm64eBind = (raw >> 62) & 1;
+        if (arm64eBind || (raw & 0x0007FFFF00000000ULL) == 0) return 0;
+        Address candidate = imageBase + (raw & 0xFFFFFFFFULL);
+        return [file segmentForVirtualAddress:candidate] ? candidate : 0;
+    }
+
+    uint64_t target = raw & 0xFFFFFFFFFULL;
+    uint64_t high8 = (raw >> 36) & 0xFF;
+    Address candidates[] = {
+        (high8 << 56) | target,             // DYLD_CHAINED_PTR_64 rebase
+        imageBase + target,                 // DYLD_CHAINED_PTR_64_OFFSET rebase
+        raw & 0x7FFFFFFFFFFULL,             // DYLD_CHAINED_PTR_ARM64E rebase
+        imageBase + (raw & 0x3FFFFFFFULL)   // DYLD_CHAINED_PTR_64_KERNEL_CACHE rebase
+    };
+
+    for (NSUInteger i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++) {
+        if (candidates[i] != 0 && [file segmentForVirtualAddress:candidates[i]] != nil) {
+            return candidates[i];
+        }
+    }
+
+    return 0;
+}
+
+Address SRKReadPointer(NSObject<HPDisassembledFile> *file, Address address) {
+    if (address == 0 || [file segmentForVirtualAddress:address] == nil) return 0;
+    return SRKDecodePointer(file, [file readUInt64AtVirtualAddress:address]);
+}
+
+static NSData *SRKReadBytes(NSObject<HPDisassembledFile> *file, Address address, NSUInteger length) {
+    NSObject<HPSegment> *segment = [file segmentForVirtualAddress:address];
+    NSData *data = segment.mappedData;
+    if (!data || address < segment.startAddress) return nil;
+
+    uint64_t offset = address - segment.startAddress;
+    if (offset >= data.length) return nil;
+
+    NSUInteger available = (NSUInteger)MIN((uint64_t)length, data.length - offset);
+    return [data subdataWithRange:NSMakeRange((NSUInteger)offset, available)];
+}
+
+NSString *SRKReadCString(NSObject<HPDisassembledFile> *file, Address address, NSUInteger maxLength) {
+    NSObject<HPSegment> *segment = [file segmentForVirtualAddress:address];
+    NSData *data = segment.mappedData;
+    if (!data || address < segment.startAddress) return nil;
+
+    uint64_t offset = address - segment.startAddress;
+    if (offset >= data.length) return nil;
+
+    const uint8_t *bytes = (const uint8_t *)data.bytes + offset;
+    NSUInteger available = (NSUInteger)MIN((uint64_t)maxLength, data.length - offset);
+    const uint8_t *terminator = memchr(bytes, 0, available);
+    if (!terminator || terminator == bytes) return nil;
+
+    NSUInteger length = (NSUInteger)(terminator - bytes);
+    for (NSUInteger i = 0; i < length; i++) {
+        if (bytes[i] < 32 && bytes[i] != '\t' && bytes[i] != '\n' && bytes[i] != '\r') {
+            return nil;
+        }
+    }
+
+    return [[NSString alloc] initWithBytes:bytes length:length encoding:NSUTF8StringEncoding];
+}
+
+static NSString *SRKReadCFString(NSObject<HPDisassembledFile> *file, Address address) {
+    // struct __NSConstantString { isa; flags; const char *str; long length; }
+    uint64_t flags = [file readUInt64AtVirtualAddress:address + 8];
+    Address characters = SRKReadPointer(file, address + 16);
+    uint64_t length = [file readUInt64AtVirtualAddress:address + 24];
+    if (characters == 0) return nil;
+
+    if ((flags & 0xFF) == 0xD0) {
+        // UTF-16 constant string
+        if (length == 0 || length > 4096) return nil;
+        NSData *data = SRKReadBytes(file, characters, (NSUInteger)length * 2);
+        if (data.length != length * 2) return nil;
+        return [[NSString alloc] initWithData:data encoding:NSUTF16LittleEndianStringEncoding];
+    }
+
+    return SRKReadCString(file, characters, 4096);
+}
+
+NSString *SRKStringForValue(NSObject<HPDisassembledFile> *file, SRKRegisterValue value) {
+    if (!value.known) return nil;
+
+    Address address = SRKDecodePointer(file, value.value);
+    if (address == 0) return nil;
+
+    NSObject<HPSection> *section = [file sectionForVirtualAddress:address];
+    if (!section || section.pureCodeSection) return nil;
+
+    NSString *sectionName = section.sectionName ?: @"";
+    if ([sectionName isEqualToString:@"__cfstring"]) {
+        return SRKReadCFString(file, address);
+    }
+    if ([sectionName isEqualToString:@"__objc_selrefs"]) {
+        Address selector = SRKReadPointer(file, address);
+        return selector ? SRKReadCString(file, selector, 1024) : nil;
+    }
+
+    return SRKReadCString(file, address, 4096);
+}
+
+static NSString *SRKObjCClassNameFromSymbol(NSString *symbol) {
+    static NSArray<NSString *> *prefixes;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        prefixes = @[
+            @"_OBJC_CLASS_$_", @"OBJC_CLASS_$_", @"_OBJC_METACLASS_$_", @"OBJC_METACLASS_$_",
+            @"objc_cls_ref_", @"_objc_cls_ref_", @"objc_class_"
+        ];
+    });
+
+    for (NSString *prefix in prefixes) {
+        if ([symbol hasPrefix:prefix] && symbol.length > prefix.length) {
+            return [symbol substringFromIndex:prefix.length];
+        }
+    }
+    return nil;
+}
+
+NSString *SRKObjCClassNameAtAddress(NSObject<HPDisassembledFile> *file, Address address) {
+    if (address == 0) return nil;
+
+    NSString *name = SRKObjCClassNameFromSymbol([file nameForVirtualAddress:address]);
+    if (name) return name;
+
+    Address classAddress = address;
+    if (SRKSectionNameContains(file, address, @"classrefs") || SRKSectionNameContains(file, address, @"superrefs")) {
+        classAddress = SRKReadPointer(file, address);
+        if (classAddress == 0) return nil;
+
+        name = SRKObjCClassNameFromSymbol([file nameForVirtualAddress:classAddress]);
+        if (name) return name;
+    }
+
+    // class_t.data -> class_ro_t.name
+    Address classRO = SRKReadPointer(file, classAddress + 32) & ~(Address)7;
+    if (classRO == 0) return nil;
+
+    Address namePointer = SRKReadPointer(file, classRO + 24);
+    return namePointer ? SRKReadCString(file, namePointer, 256) : nil;
+}
+
+NSString *SRKNormalizedSymbolName(NSString *name) {
+    static NSArray<NSString *> *prefixes;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        prefixes = @[
+            @"imp___stubs_", @"imp___auth_stubs_", @"imp___got_", @"imp___auth_got_",
+            @"imp___la_symbol_ptr_", @"imp___nl_symbol_ptr_", @"j_"
+        ];
+    });
+
+    NSString *normalized = name;
+    for (NSString *prefix in prefixes) {
+        if ([normalized hasPrefix:prefix]) {
+            normalized = [normalized substringFromIndex:prefix.length];
+            break;
+        }
+    }
+
+    if ([normalized hasPrefix:@"_"]) {
+        normalized = [normalized substringFromIndex:1];
+    }
+
+    return normalized;
+}
+
+BOOL SRKSectionNameContains(NSObject<HPDisassembledFile> *file, Address address, NSString *fragment) {
+    NSObject<HPSection> *section = [file sectionForVirtualAddress:address];
+    return section.sectionName != nil && [section.sectionName containsString:fragment];
+}
@@ -0,0 +1,42 @@
+/*
+ SRKObjCMessages.h
+ Objective-C message send resolution for HopperSRK analyzers
+
+ Pairs every objc_msgSend / objc_msgSend$selector stub call with the
+ selector loaded from __objc_selrefs and, when the receiver came from a
+ classref (directly or through alloc/new/init/shared* results), with the
+ receiver class. Only procedures that reference a message send function
+ are lifted.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * Builds the message send index of a file:
+ * - @"sends":        every resolved send, sorted by address
+ * - @"by_procedure": procedure entry point -> sends
+ * - @"by_selector":  selector -> sends
+ * - @"by_class":     receiver class -> sends
+ *
+ * Each send is @{@"address", @"procedure", @"selector", @"function"} plus
+ * @"class" when the receiver class is known.
+ */
+NSDictionary *SRKBuildObjCMessageIndex(NSObject<HPDisassembledFile> *file, NSDictionary *imageIndex);
+
+NSArray<NSDictionary *> *SRKObjCSendsForSelector(NSDictionary *messageIndex, NSString *selector);
+NSArray<NSDictionary *> *SRKObjCSendsForClass(NSDictionary *messageIndex, NSString *className);
+NSArray<NSDictionary *> *SRKObjCSendsInProcedure(NSDictionary *messageIndex, Address procedure);
+
+/// Classes defined in the image that inherit from one of the named classes, directly or not
+NSSet<NSString *> *SRKObjCImageSubclasses(NSObject<HPDisassembledFile> *file, NSSet<NSString *> *classNames);
+
+/// "[NSTask launch]", or "[? launch]" when the receiver class is unknown
+NSString *SRKObjCSendDescription(NSDictionary *send);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,229 @@
+/*
+ SRKObjCMessages.m
+ Objective-C message send resolution for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKObjCMessages.h"
+
+// Superclass links followed from a class of the image
+#define SRK_OBJC_MAX_CLASS_DEPTH 16
+
+static NSDictionary<NSString *, NSString *> *SRKRuntimeSelectors(void) {
+    static NSDictionary<NSString *, NSString *> *selectors;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        // Runtime entry points the compiler emits instead of a plain message send
+        selectors = @{
+            @"objc_alloc": @"alloc",
+            @"objc_alloc_init": @"init",
+            @"objc_allocWithZone": @"allocWithZone:",
+            @"objc_opt_new": @"new",
+            @"objc_opt_class": @"class",
+            @"objc_opt_self": @"self",
+            @"objc_opt_isKindOfClass": @"isKindOfClass:",
+            @"objc_opt_respondsToSelector": @"respondsToSelector:"
+        };
+    });
+    return selectors;
+}
+
+static NSSet<NSString *> *SRKPassthroughFunctions(void) {
+    static NSSet<NSString *> *functions;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        // ARC helpers returning their first argument
+        functions = [NSSet setWithArray:@[
+            @"objc_retain", @"objc_autorelease", @"objc_retainAutorelease",
+            @"objc_retainAutoreleasedReturnValue", @"objc_claimAutoreleasedReturnValue",
+            @"objc_unsafeClaimAutoreleasedReturnValue", @"objc_retainAutoreleaseReturnValue",
+            @"objc_autoreleaseReturnValue"
+        ]];
+    });
+    return functions;
+}
+
+static BOOL SRKSelectorReturnsReceiverClass(NSString *selector) {
+    static NSArray<NSString *> *prefixes;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        prefixes = @[@"alloc", @"init", @"new", @"shared", @"default", @"standard", @"current",
+                     @"class", @"self", @"retain", @"autorelease"];
+    });
+
+    for (NSString *prefix in prefixes) {
+        if ([selector hasPrefix:prefix]) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+static void SRKAppendSend(NSMutableDictionary *table, id key, NSDictionary *send) {
+    NSMutableArray *sends = table[key];
+    if (!sends) {
+        sends = [NSMutableArray array];
+        table[key] = sends;
+    }
+    [sends addObject:send];
+}
+
+#pragma mark - Message Index
+
+NSDictionary *SRKBuildObjCMessageIndex(NSObject<HPDisassembledFile> *file, NSDictionary *imageIndex) {
+    NSMutableArray<NSDictionary *> *sends = [NSMutableArray array];
+    NSMutableDictionary<NSNumber *, NSMutableArray *> *byProcedure = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSString *, NSMutableArray *> *bySelector = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSString *, NSMutableArray *> *byClass = [NSMutableDictionary dictionary];
+
+    NSDictionary *messageIndex = @{@"sends": sends, @"by_procedure": byProcedure,
+                                 @"by_selector": bySelector, @"by_class": byClass};
+
+    NSMutableArray<NSString *> *functions = [NSMutableArray arrayWithArray:@[
+        @"objc_msgSend", @"objc_msgSend_stret", @"objc_msgSendSuper2", @"objc_msgSendSuper2_stret"
+    ]];
+    [functions addObjectsFromArray:SRKRuntimeSelectors().allKeys];
+    for (NSString *symbol in [imageIndex[@"symbols"] allKeys]) {
+        if ([symbol hasPrefix:@"objc_msgSend$"]) {
+            [functions addObject:symbol];
+        }
+    }
+
+    // Only procedures that actually send messages are lifted
+    NSDictionary<NSNumber *, NSString *> *sites = SRKCallSiteAddresses(file, imageIndex, functions);
+    NSMutableSet<NSNumber *> *procedureEntries = [NSMutableSet set];
+    for (NSNumber *site in sites) {
+        NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, imageIndex, site.unsignedLongLongValue);
+        if (procedure) {
+            [procedureEntries addObject:@([procedure entryPoint])];
+        }
+    }
+    if (procedureEntries.count == 0) return messageIndex;
+
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+    if (lifter.arch == SRKArchitectureUnknown) return messageIndex;
+
+    NSDictionary<NSString *, NSString *> *runtimeSelectors = SRKRuntimeSelectors();
+    NSSet<NSString *> *passthrough = SRKPassthroughFunctions();
+    NSMutableDictionary<NSNumber *, NSString *> *classNames = [NSMutableDictionary dictionary];
+    NSArray<NSNumber *> *entries = [procedureEntries.allObjects sortedArrayUsingSelector:@selector(compare:)];
+
+    for (NSNumber *entry in entries) {
+        NSObject<HPProcedure> *procedure = [file procedureAt:entry.unsignedLongLongValue];
+        if (!procedure) continue;
+
+        SRKLiftProcedure(&lifter, procedure, ^(SRKLifter *callLifter, Address callAddress, NSString *callee,
+                                               SRKRegisterState *state, BOOL *stop) {
+            if (!callee) return;
+
+            if ([passthrough containsObject:callee]) {
+                state->result = SRKArgumentValue(state, callLifter->arch, 0);
+                return;
+            }
+
+            NSUInteger receiverArgument = 0;
+            NSString *selector = nil;
+
+            if ([callee hasPrefix:@"objc_msgSend$"]) {
+                selector = [callee substringFromIndex:@"objc_msgSend$".length];
+            } else if ([callee hasPrefix:@"objc_msgSend"]) {
+                if ([callee hasSuffix:@"_stret"]) {
+                    receiverArgument = 1;
+                }
+                selector = SRKStringForValue(file, SRKArgumentValue(state, callLifter->arch, receiverArgument + 1));
+            } else {
+                selector = runtimeSelectors[callee];
+            }
+            if (selector.length == 0) return;
+
+            SRKRegisterValue receiver = SRKArgumentValue(state, callLifter->arch, receiverArgument);
+            NSString *className = nil;
+            if (receiver.objcClass != 0) {
+                NSNumber *classKey = @(receiver.objcClass);
+                className = classNames[classKey];
+                if (!className) {
+                    className = SRKObjCClassNameAtAddress(file, receiver.objcClass) ?: @"";
+                    classNames[classKey] = className;
+                }
+                if (className.length == 0) className = nil;
+
+                if (SRKSelectorReturnsReceiverClass(selector)) {
+                    state->result.objcClass = receiver.objcClass;
+                }
+            }
+
+            NSMutableDictionary *send = [NSMutableDictionary dictionaryWithDictionary:@{
+                @"address": @(callAddress),
+                @"procedure": entry,
+                @"selector": selector,
+                @"function": callee
+            }];
+            if (className) {
+                send[@"class"] = className;
+            }
+
+            [sends addObject:send];
+            SRKAppendSend(byProcedure, entry, send);
+            SRKAppendSend(bySelector, selector, send);
+            if (className) {
+                SRKAppendSend(byClass, className, send);
+            }
+        });
+    }
+
+    [sends sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"address" ascending:YES]]];
+    return messageIndex;
+}
+
+#pragma mark - Queries
+
+NSArray<NSDictionary *> *SRKObjCSendsForSelector(NSDictionary *messageIndex, NSString *selector) {
+    return messageIndex[@"by_selector"][selector] ?: @[];
+}
+
+NSArray<NSDictionary *> *SRKObjCSendsForClass(NSDictionary *messageIndex, NSString *className) {
+    return messageIndex[@"by_class"][className] ?: @[];
+}
+
+NSArray<NSDictionary *> *SRKObjCSendsInProcedure(NSDictionary *messageIndex, Address procedure) {
+    return messageIndex[@"by_procedure"][@(procedure)] ?: @[];
+}
+
+NSString *SRKObjCSendDescription(NSDictionary *send) {
+    return [NSString stringWithFormat:@"[%@ %@]", send[@"class"] ?: @"?", send[@"selector"]];
+}
+
+NSSet<NSString *> *SRKObjCImageSubclasses(NSObject<HPDisassembledFile> *file, NSSet<NSString *> *classNames) {
+    NSMutableSet<NSString *> *subclasses = [NSMutableSet set];
+
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        for (NSObject<HPSection> *section in [segment sections]) {
+            if (![section.sectionName containsString:@"classlist"]) continue;
+
+            for (Address entry = section.startAddress; entry + 8 <= section.endAddress; entry += 8) {
+                Address classAddress = SRKReadPointer(file, entry);
+                NSString *name = SRKObjCClassNameAtAddress(file, classAddress);
+                if (!name || [classNames containsObject:name]) continue;
+
+                // class_t.superclass, up to a class of the set or a root
+                Address superclass = classAddress;
+                for (NSUInteger depth = 0; depth < SRK_OBJC_MAX_CLASS_DEPTH; depth++) {
+                    superclass = SRKReadPointer(file, superclass + 8);
+                    NSString *superName = SRKObjCClassNameAtAddress(file, superclass);
+                    if (!superName) break;
+                    if ([classNames containsObject:superName]) {
+                        [subclasses addObject:name];
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+    return subclasses;
+}
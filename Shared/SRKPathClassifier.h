@@ -0,0 +1,49 @@
+/*
+ SRKPathClassifier.h
+ Sensitive macOS path classification for HopperSRK analyzers
+
+ Sensitive locations (launch agents and daemons, TCC databases, keychains,
+ browser profiles, sudoers, cron, periodic, emond, ...) are listed in a data
+ file, one "<category> <severity> <path>" line each. SensitivePaths.txt is
+ copied into the plugin bundle and can be extended by a file of the same
+ name in the HopperSRK support directory. The locations are loaded into a
+ trie over lowercased path components, so a path string is classified in a
+ single walk over its components:
+ - "~" roots cover ~/, $HOME, /Users/<name> and /var/root
+ - /private/etc, /private/var, /private/tmp and the /System/Volumes/Data
+   firmlink prefix fold into their short forms
+ - "*" in a listed path matches any one component (browser profile names)
+ - a listed location covers everything below it; the deepest match wins
+ - relative paths of two or more components are tried as home-relative,
+   since binaries usually append them to NSHomeDirectory()
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// File name of the sensitive location list, bundled and in the support directory
+#define SRK_SENSITIVE_PATHS_FILE @"SensitivePaths.txt"
+
+/// ~/Library/Application Support/HopperSRK/SensitivePaths.txt
+NSString *SRKPathClassifierUserFile(void);
+
+/// The list bundled with the plugin followed by the user's list, those that exist
+NSArray<NSString *> *SRKDefaultPathClassifierFiles(NSBundle *bundle);
+
+/// Loads the lists in order, a later line overriding the same location: @{@"root", @"home", @"count"}
+NSDictionary *SRKLoadPathClassifier(NSArray<NSString *> *files);
+
+/**
+ * Classifies a path string:
+ * @{@"category", @"severity", @"location": listed path that matched}
+ * or nil when it is under no listed location
+ */
+NSDictionary * _Nullable SRKClassifyPath(NSDictionary *classifier, NSString *path);
+
+/// critical 4, high 3, medium 2, low 1, anything else 0
+NSInteger SRKPathSeverityRank(NSString * _Nullable severity);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,206 @@
+/*
+ SRKPathClassifier.m
+ Sensitive macOS path classification for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKPathClassifier.h"
+
+// Trie node key holding the location listed at the node; never a path component
+static NSString *const SRKPathEntryKey = @"";
+static NSString *const SRKPathWildcard = @"*";
+
+#pragma mark - Path Components
+
+/**
+ * Lowercased components of a path with "." and ".." resolved and the
+ * home, /private and firmlink prefixes folded. home receives whether the
+ * components are relative to a home directory. Returns nil for strings
+ * that are no path; relative paths are only accepted when allowRelative.
+ */
+static NSArray<NSString *> *SRKPathComponentsOf(NSString *path, BOOL allowRelative, BOOL *home) {
+    NSString *trimmed = [path stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    if ([trimmed hasPrefix:@"file://"]) trimmed = [trimmed substringFromIndex:7];
+    if (trimmed.length == 0) return nil;
+
+    BOOL isHome = NO;
+    BOOL isRelative = NO;
+    if ([trimmed hasPrefix:@"${HOME}"]) {
+        isHome = YES;
+        trimmed = [trimmed substringFromIndex:7];
+    } else if ([trimmed hasPrefix:@"$HOME"]) {
+        isHome = YES;
+        trimmed = [trimmed substringFromIndex:5];
+    } else if ([trimmed hasPrefix:@"~"]) {
+        // ~user/... is some other user's home, just as good
+        isHome = YES;
+        NSRange slash = [trimmed rangeOfString:@"/"];
+        trimmed = slash.location == NSNotFound ? @"" : [trimmed substringFromIndex:slash.location];
+    } else if (![trimmed hasPrefix:@"/"]) {
+        if (!allowRelative) return nil;
+        isHome = YES;
+        isRelative = YES;
+    }
+
+    NSMutableArray<NSString *> *components = [NSMutableArray array];
+    for (NSString *component in [trimmed componentsSeparatedByString:@"/"]) {
+        if (component.length == 0 || [component isEqualToString:@"."]) continue;
+        if ([component isEqualToString:@".."]) {
+            if (components.count > 0) [components removeLastObject];
+            continue;
+        }
+        [components addObject:component.lowercaseString];
+    }
+
+    if (isRelative) {
+        // "%@/Library/LaunchAgents/%@.plist" is formatted with the home directory
+        if (components.count > 0 && [components[0] containsString:@"%"]) [components removeObjectAtIndex:0];
+        // A single word is no evidence of a path
+        if (components.count < 2) return nil;
+    } else if (!isHome) {
+        if (components.count > 3 && [components[0] isEqualToString:@"system"] &&
+            [components[1] isEqualToString:@"volumes"] && [components[2] isEqualToString:@"data"]) {
+            [components removeObjectsInRange:NSMakeRange(0, 3)];
+        }
+        if (components.count > 1 && [components[0] isEqualToString:@"private"] &&
+            ([components[1] isEqualToString:@"etc"] || [components[1] isEqualToString:@"var"] ||
+             [components[1] isEqualToString:@"tmp"])) {
+            [components removeObjectAtIndex:0];
+        }
+        if (components.count >= 2 && [components[0] isEqualToString:@"users"] &&
+            ![components[1] isEqualToString:@"shared"] && ![components[1] containsString:@"*"]) {
+            isHome = YES;
+            [components removeObjectsInRange:NSMakeRange(0, 2)];
+        } else if (components.count >= 2 && [components[0] isEqualToString:@"var"] &&
+                   [components[1] isEqualToString:@"root"]) {
+            isHome = YES;
+            [components removeObjectsInRange:NSMakeRange(0, 2)];
+        }
+    }
+
+    if (home) *home = isHome;
+    return components;
+}
+
+#pragma mark - Loading
+
+NSString *SRKPathClassifierUserFile(void) {
+    NSString *support = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES).firstObject;
+    if (!support) support = [NSHomeDirectory() stringByAppendingPathComponent:@"Library/Application Support"];
+    return [[support stringByAppendingPathComponent:@"HopperSRK"] stringByAppendingPathComponent:SRK_SENSITIVE_PATHS_FILE];
+}
+
+NSArray<NSString *> *SRKDefaultPathClassifierFiles(NSBundle *bundle) {
+    NSMutableArray<NSString *> *files = [NSMutableArray array];
+    NSString *bundled = [bundle pathForResource:SRK_SENSITIVE_PATHS_FILE.stringByDeletingPathExtension
+                                         ofType:SRK_SENSITIVE_PATHS_FILE.pathExtension];
+    if (bundled) [files addObject:bundled];
+
+    NSString *user = SRKPathClassifierUserFile();
+    if ([[NSFileManager defaultManager] fileExistsAtPath:user]) [files addObject:user];
+    return files;
+}
+
+NSInteger SRKPathSeverityRank(NSString *severity) {
+    if ([severity isEqualToString:@"critical"]) return 4;
+    if ([severity isEqualToString:@"high"]) return 3;
+    if ([severity isEqualToString:@"medium"]) return 2;
+    if ([severity isEqualToString:@"low"]) return 1;
+    return 0;
+}
+
+NSDictionary *SRKLoadPathClassifier(NSArray<NSString *> *files) {
+    NSMutableDictionary *root = [NSMutableDictionary dictionary];
+    NSMutableDictionary *home = [NSMutableDictionary dictionary];
+    NSCharacterSet *whitespace = [NSCharacterSet whitespaceCharacterSet];
+    __block NSUInteger count = 0;
+
+    for (NSString *file in files) {
+        NSString *contents = [NSString stringWithContentsOfFile:file encoding:NSUTF8StringEncoding error:nil];
+        if (!contents) continue;
+
+        [contents enumerateLinesUsingBlock:^(NSString *line, BOOL *stop) {
+            NSString *trimmed = [line stringByTrimmingCharactersInSet:whitespace];
+            if (trimmed.length == 0 || [trimmed hasPrefix:@"#"]) return;
+
+            // <category> <severity> <path, which may hold spaces>
+            NSScanner *scanner = [NSScanner scannerWithString:trimmed];
+            scanner.charactersToBeSkipped = whitespace;
+            NSString *category = nil;
+            NSString *severity = nil;
+            if (![scanner scanUpToCharactersFromSet:whitespace intoString:&category] ||
+                ![scanner scanUpToCharactersFromSet:whitespace intoString:&severity] || scanner.isAtEnd) return;
+            severity = severity.lowercaseString;
+            if (SRKPathSeverityRank(severity) == 0) return;
+
+            NSString *location = [[trimmed substringFromIndex:scanner.scanLocation] stringByTrimmingCharactersInSet:whitespace];
+            BOOL isHome = NO;
+            NSArray<NSString *> *components = SRKPathComponentsOf(location, NO, &isHome);
+            if (!components || (components.count == 0 && !isHome)) return;
+
+            NSMutableDictionary *node = isHome ? home : root;
+            for (NSString *component in components) {
+                NSMutableDictionary *child = node[component];
+                if (!child) {
+                    child = [NSMutableDictionary dictionary];
+                    node[component] = child;
+                }
+                node = child;
+            }
+            if (!node[SRKPathEntryKey]) count++;
+            node[SRKPathEntryKey] = @{@"category": category, @"severity": severity, @"location": location};
+        }];
+    }
+
+    return @{@"root": root, @"home": home, @"count": @(count)};
+}
+
+#pragma mark - Classification
+
+/// Deepest listed location under the node matching components from index on; depth receives its component count
+static NSDictionary *SRKMatchPathNode(NSDictionary *node, NSArray<NSString *> *components, NSUInteger index,
+                                      NSUInteger *depth) {
+    NSDictionary *best = node[SRKPathEntryKey];
+    NSUInteger bestDepth = index;
+    if (index == components.count) {
+        *depth = bestDepth;
+        return best;
+    }
+
+    // An exact component beats a wildcard at the same depth
+    NSDictionary *exact = node[components[index]];
+    if (exact) {
+        NSUInteger exactDepth = 0;
+        NSDictionary *match = SRKMatchPathNode(exact, components, index + 1, &exactDepth);
+        if (match && (!best || exactDepth > bestDepth)) {
+            best = match;
+            bestDepth = exactDepth;
+        }
+    }
+    NSDictionary *wildcard = node[SRKPathWildcard];
+    if (wildcard && wildcard != exact) {
+        NSUInteger wildcardDepth = 0;
+        NSDictionary *match = SRKMatchPathNode(wildcard, components, index + 1, &wildcardDepth);
+        if (match && (!best || wildcardDepth > bestDepth)) {
+            best = match;
+            bestDepth = wildcardDepth;
+        }
+    }
+
+    *depth = bestDepth;
+    return best;
+}
+
+NSDictionary *SRKClassifyPath(NSDictionary *classifier, NSString *path) {
+    if ([classifier[@"count"] unsignedIntegerValue] == 0) return nil;
+
+    BOOL isHome = NO;
+    NSArray<NSString *> *components = SRKPathComponentsOf(path, YES, &isHome);
+    if (!components) return nil;
+
+    NSUInteger depth = 0;
+    return SRKMatchPathNode(isHome ? classifier[@"home"] : classifier[@"root"], components, 0, &depth);
+}
@@ -0,0 +1,39 @@
+/*
+ SRKPointerTables.h
+ Code pointer table recovery for HopperSRK analyzers
+
+ Scans the data sections for arrays of procedure pointers (dispatch tables,
+ sysent-like syscall tables) and finds the instructions storing into them.
+ Slots are decoded in plain C against the sorted procedure entry points of
+ the image index, so the scan stays linear in the size of the data.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Shortest run of procedure pointers reported as a table
+#define SRK_POINTER_TABLE_MIN_ENTRIES 4
+
+/**
+ * Arrays of procedure pointers found in the data sections, sorted by address:
+ * @{@"address", @"section", @"stride", @"count", @"targets", @"sysent", @"name"?}
+ * targets holds the decoded entry points, stride is in bytes, and sysent is
+ * set when the records also carry plausible sy_narg / sy_arg_bytes fields.
+ */
+NSArray<NSDictionary *> *SRKFindPointerTables(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                              NSUInteger minimumEntries);
+
+/**
+ * Store instructions whose destination lies inside one of the tables:
+ * @{@"address", @"procedure", @"table", @"entry"} sorted by address, where
+ * table is the table address and entry the index of the overwritten record.
+ */
+NSArray<NSDictionary *> *SRKFindPointerTableWrites(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                                   NSArray<NSDictionary *> *tables);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,379 @@
+/*
+ SRKPointerTables.m
+ Code pointer table recovery for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKPointerTables.h"
+
+// Widest record searched for, in pointer slots (the legacy 40-byte sysent)
+#define SRK_POINTER_TABLE_MAX_STRIDE    5
+#define SRK_SYSENT_MIN_ENTRIES          64
+#define SRK_SYSENT_MAX_ARGUMENTS        16
+#define SRK_SYSENT_MAX_ARGUMENT_BYTES   128
+
+typedef struct {
+    Address imageBase;
+    Address low;
+    Address high;
+    const Address *entries;
+    NSUInteger count;
+} SRKCodePointerDecoder;
+
+typedef struct {
+    NSUInteger stride;
+    NSInteger nargOffset;
+    NSInteger argBytesOffset;
+} SRKSysentLayout;
+
+// Field offsets relative to sy_call
+static const SRKSysentLayout SRKSysentLayouts[] = {
+    {24, 20, 22},   // sy_call, sy_arg_munge32, sy_return_type, sy_narg, sy_arg_bytes
+    {40, -8, 28}    // sy_narg, sy_resv, sy_flags, sy_call, munge32, munge64, sy_return_type, sy_arg_bytes
+};
+
+#pragma mark - Decoding
+
+static BOOL SRKSkipPointerTableSection(NSObject<HPSection> *section) {
+    if (section.pureCodeSection || section.zeroFillSection || section.pureCStringSection) return YES;
+
+    // Import slots, Objective-C metadata and initializer lists are parsed elsewhere
+    NSString *name = section.sectionName ?: @"";
+    for (NSString *fragment in @[@"objc", @"got", @"symbol_ptr", @"auth_ptr", @"mod_init", @"mod_term",
+                                 @"init_offsets", @"interpose", @"cfstring", @"stub"]) {
+        if ([name containsString:fragment]) return YES;
+    }
+    return NO;
+}
+
+static Address SRKDecodeCodePointer(const SRKCodePointerDecoder *decoder, uint64_t raw) {
+    if (raw == 0) return 0;
+
+    // Same rebase encodings as SRKDecodePointer, but only procedure entries are accepted
+    Address candidates[5];
+    NSUInteger candidateCount = 0;
+    candidates[candidateCount++] = raw;
+
+    if ((raw >> 63) & 1) {
+        if ((raw >> 62) & 1) return 0;
+        candidates[candidateCount++] = decoder->imageBase + (raw & 0xFFFFFFFFULL);
+    } else {
+        uint64_t target = raw & 0xFFFFFFFFFULL;
+        candidates[candidateCount++] = (((raw >> 36) & 0xFF) << 56) | target;
+        candidates[candidateCount++] = decoder->imageBase + target;
+        candidates[candidateCount++] = raw & 0x7FFFFFFFFFFULL;
+        candidates[candidateCount++] = decoder->imageBase + (raw & 0x3FFFFFFFULL);
+    }
+
+    for (NSUInteger i = 0; i < candidateCount; i++) {
+        // Bounds test first: most data words never reach the binary search
+        Address candidate = candidates[i];
+        if (candidate < decoder->low || candidate > decoder->high) continue;
+        if (SRKIsProcedureEntry(decoder->entries, decoder->count, candidate)) {
+            return candidate;
+        }
+    }
+
+    return 0;
+}
+
+static BOOL SRKLooksLikeSysent(const uint8_t *bytes, NSUInteger length, NSUInteger firstOffset,
+                               NSUInteger stride, NSUInteger count) {
+    if (count < SRK_SYSENT_MIN_ENTRIES) return NO;
+
+    for (NSUInteger l = 0; l < sizeof(SRKSysentLayouts) / sizeof(SRKSysentLayouts[0]); l++) {
+        const SRKSysentLayout *layout = &SRKSysentLayouts[l];
+        if (layout->stride != stride) continue;
+
+        NSUInteger plausible = 0;
+        for (NSUInteger i = 0; i < count; i++) {
+            NSInteger record = (NSInteger)(firstOffset + i * stride);
+            NSInteger nargOffset = record + layout->nargOffset;
+            NSInteger argBytesOffset = record + layout->argBytesOffset;
+            if (nargOffset < 0 || argBytesOffset < 0 || (NSUInteger)argBytesOffset + 2 > length) continue;
+
+            int16_t narg;
+            uint16_t argBytes;
+            memcpy(&narg, bytes + nargOffset, sizeof(narg));
+            memcpy(&argBytes, bytes + argBytesOffset, sizeof(argBytes));
+            if (narg >= 0 && narg <= SRK_SYSENT_MAX_ARGUMENTS && argBytes <= SRK_SYSENT_MAX_ARGUMENT_BYTES) {
+                plausible++;
+            }
+        }
+
+        // Allow a few reserved / padded records
+        if (plausible * 10 >= count * 9) return YES;
+    }
+
+    return NO;
+}
+
+#pragma mark - Table Scan
+
+static NSArray<NSDictionary *> *SRKScanPointerSection(const SRKCodePointerDecoder *decoder, NSDictionary *section,
+                                                      NSUInteger minimumEntries) {
+    NSData *data = section[@"data"];
+    const uint8_t *bytes = data.bytes;
+    NSUInteger offset = [section[@"offset"] unsignedIntegerValue];
+    NSUInteger length = [section[@"length"] unsignedIntegerValue];
+    Address start = [section[@"start"] unsignedLongLongValue];
+
+    NSUInteger slotCount = length / sizeof(uint64_t);
+    if (slotCount < minimumEntries) return @[];
+
+    Address *targets = calloc(slotCount, sizeof(Address));
+    BOOL *claimed = calloc(slotCount, sizeof(BOOL));
+    if (!targets || !claimed) {
+        free(targets);
+        free(claimed);
+        return @[];
+    }
+
+    for (NSUInteger slot = 0; slot < slotCount; slot++) {
+        uint64_t raw;
+        memcpy(&raw, bytes + offset + slot * sizeof(uint64_t), sizeof(raw));
+        targets[slot] = SRKDecodeCodePointer(decoder, raw);
+    }
+
+    NSMutableArray<NSDictionary *> *tables = [NSMutableArray array];
+
+    // Dense tables first, so a wider stride never splits a table already found
+    for (NSUInteger stride = 1; stride <= SRK_POINTER_TABLE_MAX_STRIDE; stride++) {
+        NSMutableArray<NSValue *> *runs = [NSMutableArray array];
+
+        for (NSUInteger phase = 0; phase < stride; phase++) {
+            NSUInteger runStart = 0;
+            NSUInteger runLength = 0;
+
+            for (NSUInteger slot = phase; slot < slotCount; slot += stride) {
+                BOOL member = targets[slot] != 0 && !claimed[slot];
+                if (member) {
+                    if (runLength == 0) runStart = slot;
+                    runLength++;
+                }
+                if (!member || slot + stride >= slotCount) {
+                    if (runLength >= minimumEntries) {
+                        [runs addObject:[NSValue valueWithRange:NSMakeRange(runStart, runLength)]];
+                    }
+                    runLength = 0;
+                }
+            }
+        }
+
+        // Records holding several pointers (sy_call + mungers) match in several phases: keep the first
+        [runs sortUsingComparator:^NSComparisonResult(NSValue *a, NSValue *b) {
+            NSUInteger left = a.rangeValue.location;
+            NSUInteger right = b.rangeValue.location;
+            return left < right ? NSOrderedAscending : (left > right ? NSOrderedDescending : NSOrderedSame);
+        }];
+
+        for (NSValue *run in runs) {
+            NSRange range = run.rangeValue;
+            NSUInteger spanEnd = MIN(slotCount, range.location + range.length * stride);
+
+            BOOL overlaps = NO;
+            for (NSUInteger slot = range.location; slot < spanEnd && !overlaps; slot++) {
+                overlaps = claimed[slot];
+            }
+            if (overlaps) continue;
+
+            for (NSUInteger slot = range.location; slot < spanEnd; slot++) {
+                claimed[slot] = YES;
+            }
+
+            NSMutableArray<NSNumber *> *entryTargets = [NSMutableArray arrayWithCapacity:range.length];
+            for (NSUInteger i = 0; i < range.length; i++) {
+                [entryTargets addObject:@(targets[range.location + i * stride])];
+            }
+
+            NSUInteger strideBytes = stride * sizeof(uint64_t);
+            BOOL sysent = SRKLooksLikeSysent(bytes + offset, length, range.location * sizeof(uint64_t),
+                                             strideBytes, range.length);
+
+            [tables addObject:@{
+                @"address": @(start + range.location * sizeof(uint64_t)),
+                @"section": section[@"name"],
+                @"stride": @(strideBytes),
+                @"count": @(range.length),
+                @"targets": entryTargets,
+                @"sysent": @(sysent)
+            }];
+        }
+    }
+
+    free(targets);
+    free(claimed);
+    return tables;
+}
+
+NSArray<NSDictionary *> *SRKFindPointerTables(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                              NSUInteger minimumEntries) {
+    SRKCodePointerDecoder decoder;
+    decoder.entries = SRKProcedureEntries(index, &decoder.count);
+    if (decoder.count == 0) return @[];
+
+    NSObject<HPSegment> *text = [file segmentNamed:@"__TEXT"];
+    decoder.imageBase = text ? text.startAddress : [file fileBaseAddress];
+    decoder.low = decoder.entries[0];
+    decoder.high = decoder.entries[decoder.count - 1];
+
+    // Snapshot the candidate sections so they can be scanned off the main thread
+    NSMutableArray<NSDictionary *> *sections = [NSMutableArray array];
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length == 0) continue;
+
+        for (NSObject<HPSection> *section in [segment sections]) {
+            if (SRKSkipPointerTableSection(section)) continue;
+
+            // Slots are pointer aligned relative to the segment
+            Address start = (section.startAddress + 7) & ~7ULL;
+            if (start < segment.startAddress || start >= section.endAddress) continue;
+
+            NSUInteger offset = (NSUInteger)(start - segment.startAddress);
+            if (offset >= data.length) continue;
+            NSUInteger length = MIN((NSUInteger)(section.endAddress - start), data.length - offset);
+
+            [sections addObject:@{
+                @"name": section.sectionName ?: @"",
+                @"start": @(start),
+                @"offset": @(offset),
+                @"length": @(length),
+                @"data": data
+            }];
+        }
+    }
+
+    NSMutableArray *perSection = [NSMutableArray arrayWithCapacity:sections.count];
+    for (NSUInteger i = 0; i < sections.count; i++) {
+        [perSection addObject:@[]];
+    }
+
+    dispatch_apply(sections.count, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t i) {
+        NSArray *tables = SRKScanPointerSection(&decoder, sections[i], minimumEntries);
+        @synchronized (perSection) {
+            perSection[i] = tables;
+        }
+    });
+
+    NSMutableArray<NSDictionary *> *tables = [NSMutableArray array];
+    for (NSArray *sectionTables in perSection) {
+        for (NSDictionary *table in sectionTables) {
+            NSString *name = [file nameForVirtualAddress:[table[@"address"] unsignedLongLongValue]];
+            if (name.length > 0) {
+                NSMutableDictionary *named = [table mutableCopy];
+                named[@"name"] = name;
+                table = named;
+            }
+            [tables addObject:table];
+        }
+    }
+
+    [tables sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"address" ascending:YES]]];
+    return tables;
+}
+
+#pragma mark - Write Sites
+
+NSArray<NSDictionary *> *SRKFindPointerTableWrites(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                                   NSArray<NSDictionary *> *tables) {
+    if (tables.count == 0) return @[];
+
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+    if (lifter.arch == SRKArchitectureUnknown) return @[];
+
+    NSUInteger tableCount = tables.count;
+    Address *starts = calloc(tableCount, sizeof(Address));
+    Address *ends = calloc(tableCount, sizeof(Address));
+    if (!starts || !ends) {
+        free(starts);
+        free(ends);
+        return @[];
+    }
+
+    // Code referencing the table or any of its records
+    NSArray<NSObject<HPSegment> *> *segments = [file segments];
+    NSMutableOrderedSet<NSNumber *> *references = [NSMutableOrderedSet orderedSet];
+    for (NSUInteger t = 0; t < tableCount; t++) {
+        NSDictionary *table = tables[t];
+        NSUInteger stride = [table[@"stride"] unsignedIntegerValue];
+        NSUInteger count = [table[@"count"] unsignedIntegerValue];
+        starts[t] = [table[@"address"] unsignedLongLongValue];
+        ends[t] = starts[t] + stride * count;
+
+        for (NSUInteger i = 0; i < count; i++) {
+            for (NSObject<HPSegment> *segment in segments) {
+                for (NSNumber *reference in [segment referencesToAddress:starts[t] + i * stride]) {
+                    if ([file hasCodeAt:reference.unsignedLongLongValue]) {
+                        [references addObject:reference];
+                    }
+                }
+            }
+        }
+    }
+
+    NSMutableArray<NSDictionary *> *writes = [NSMutableArray array];
+    NSMutableSet<NSNumber *> *liftedBlocks = [NSMutableSet set];
+    NSMutableSet<NSNumber *> *reported = [NSMutableSet set];
+
+    for (NSNumber *reference in references) {
+        Address site = reference.unsignedLongLongValue;
+        NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, index, site);
+        NSObject<HPBasicBlock> *block = [procedure basicBlockContainingInstructionAt:site];
+        Address from = block ? block.from : site;
+        Address to = block ? block.to : site + 1;
+
+        if ([liftedBlocks containsObject:@(from)]) continue;
+        [liftedBlocks addObject:@(from)];
+
+        SRKRegisterState state;
+        SRKRegisterStateReset(&state);
+        BOOL stop = NO;
+
+        for (Address address = from; address < to && !stop; ) {
+            NSUInteger length = SRKLifterDecode(&lifter, address);
+            if (length == 0) break;
+
+            Address destination;
+            if (SRKLifterStoreAddress(&lifter, &state, &destination)) {
+                // Last table starting at or below the destination
+                NSUInteger low = 0;
+                NSUInteger high = tableCount;
+                while (low < high) {
+                    NSUInteger middle = low + (high - low) / 2;
+                    if (starts[middle] <= destination) {
+                        low = middle + 1;
+                    } else {
+                        high = middle;
+                    }
+                }
+
+                if (low > 0 && destination < ends[low - 1] && ![reported containsObject:@(address)]) {
+                    NSDictionary *table = tables[low - 1];
+                    NSUInteger stride = [table[@"stride"] unsignedIntegerValue];
+                    [reported addObject:@(address)];
+                    [writes addObject:@{
+                        @"address": @(address),
+                        @"procedure": @(procedure ? [procedure entryPoint] : address),
+                        @"table": table[@"address"],
+                        @"entry": @((destination - starts[low - 1]) / stride)
+                    }];
+                }
+            }
+
+            SRKLifterExecute(&lifter, &state, nil, &stop);
+            address += length;
+        }
+    }
+
+    free(starts);
+    free(ends);
+
+    [writes sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"address" ascending:YES]]];
+    return writes;
+}
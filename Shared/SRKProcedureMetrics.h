@@ -0,0 +1,68 @@
+/*
+ SRKProcedureMetrics.h
+ Per-procedure metrics table for HopperSRK analyzers
+
+ One sweep over the procedures of the image index: the basic blocks,
+ successor edges and callees are copied out of Hopper once, then every
+ metric is computed in parallel into columns indexed by procedure id (the
+ position of the entry point in SRKProcedureEntries()). Later passes read
+ the columns and the flattened control-flow graph instead of walking the
+ Objective-C basic block objects again.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// One basic block of the flattened control-flow graph
+typedef struct {
+    Address from;
+    Address to;
+    /// Successors are edges[firstEdge ..< firstEdge + edgeCount], as block indexes within the procedure
+    uint32_t firstEdge;
+    uint32_t edgeCount;
+} SRKProcedureBlock;
+
+/**
+ * Builds the metrics table; analyzers build it once per run and pass it on.
+ * Every uint32_t column holds one value per procedure id:
+ * - @"instructions", @"blocks", @"edges", @"cyclomatic" (edges - blocks + 2)
+ * - @"fan_in" (call references to the entry point), @"fan_out" (distinct callees)
+ * - @"string_refs": references to C strings and CFStrings from the procedure body
+ * - @"api_process", @"api_network", @"api_file", @"api_crypto", @"api_keychain",
+ *   @"api_ipc", @"api_memory", @"api_debugging": calls to imports of that category
+ * - @"first_block", @"entry_block": where the procedure's blocks start and its entry block
+ */
+NSDictionary *SRKBuildProcedureMetrics(NSObject<HPDisassembledFile> *file, NSDictionary *index);
+
+/// Names of the api_* columns
+NSArray<NSString *> *SRKProcedureAPICategories(void);
+
+/// Column of the table, count receives the number of procedures; NULL for an unknown column
+const uint32_t * _Nullable SRKProcedureMetricColumn(NSDictionary *metrics, NSString *column, NSUInteger *count);
+
+/**
+ * Procedures calling imports of the given api_* columns, most calls first, at
+ * most maximumCount, procedures of libraryCode left out:
+ * @{@"procedure", @"calls": total over the columns, @"apis": @{column: count},
+ *   @"fan_in", @"string_refs"}
+ */
+NSArray<NSDictionary *> *SRKProceduresByAPICalls(NSDictionary *metrics, NSDictionary *index, NSArray<NSString *> *columns,
+                                                 NSDictionary * _Nullable libraryCode, NSUInteger maximumCount);
+
+/// Appends the procedures of SRKProceduresByAPICalls() under the headline, one line each
+void SRKAppendProcedureAPIReport(NSMutableString *report, NSObject<HPDisassembledFile> *file,
+                                 NSArray<NSDictionary *> *procedures, NSString *headline);
+
+/// Procedure id of an entry point, NSNotFound when it is not one
+NSUInteger SRKProcedureIdentifier(NSDictionary *index, Address entry);
+
+/// Basic blocks of a procedure and the shared edge array their successors index into
+const SRKProcedureBlock * _Nullable SRKProcedureBlocks(NSDictionary *metrics, NSUInteger procedureId, NSUInteger *count);
+const uint32_t * _Nullable SRKProcedureEdges(NSDictionary *metrics);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,372 @@
+/*
+ SRKProcedureMetrics.m
+ Per-procedure metrics table for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKProcedureMetrics.h"
+#import "SRKLibraryCode.h"
+
+// Procedures measured per dispatch_apply iteration
+#define SRK_METRICS_CHUNK 256
+// Size of a __cfstring record (isa, flags, characters, length)
+#define SRK_CFSTRING_SIZE 32
+
+static NSDictionary<NSString *, NSArray<NSString *> *> *SRKAPICategoryFunctions(void) {
+    static NSDictionary<NSString *, NSArray<NSString *> *> *functions;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        functions = @{
+            @"api_process": @[@"fork", @"vfork", @"execve", @"execv", @"execvp", @"execl", @"execlp", @"posix_spawn",
+                              @"posix_spawnp", @"system", @"popen", @"kill"],
+            @"api_network": @[@"socket", @"connect", @"bind", @"listen", @"accept", @"send", @"sendto", @"recv",
+                              @"recvfrom", @"getaddrinfo", @"gethostbyname", @"CFSocketCreate",
+                              @"CFStreamCreatePairWithSocketToHost", @"nw_connection_create",
+                              @"SCNetworkReachabilityCreateWithName", @"curl_easy_perform"],
+            @"api_file": @[@"open", @"openat", @"fopen", @"unlink", @"rename", @"chmod", @"chown", @"mkdir",
+                           @"rmdir", @"truncate", @"ftruncate", @"copyfile", @"remove", @"symlink"],
+            @"api_crypto": @[@"CCCrypt", @"CCCryptorCreate", @"CCCryptorCreateWithMode", @"CCHmac", @"CC_SHA1",
+                             @"CC_SHA256", @"CC_MD5", @"CCKeyDerivationPBKDF", @"SecKeyCreateRandomKey",
+                             @"SecKeyCreateEncryptedData", @"SecKeyEncrypt", @"SecRandomCopyBytes"],
+            @"api_keychain": @[@"SecItemAdd", @"SecItemCopyMatching", @"SecItemUpdate", @"SecItemDelete",
+                               @"SecKeychainFindGenericPassword", @"SecKeychainFindInternetPassword",
+                               @"SecKeychainItemCopyContent", @"SecKeychainOpen", @"SecKeychainUnlock"],
+            @"api_ipc": @[@"mach_msg", @"bootstrap_look_up", @"bootstrap_check_in", @"xpc_connection_create",
+                          @"xpc_connection_create_mach_service", @"xpc_connection_send_message",
+                          @"xpc_connection_send_message_with_reply_sync", @"CFMessagePortCreateRemote"],
+            @"api_memory": @[@"task_for_pid", @"mach_vm_allocate", @"mach_vm_write", @"mach_vm_protect",
+                             @"vm_allocate", @"vm_write", @"vm_protect", @"mprotect", @"mmap",
+                             @"thread_create_running", @"dlopen", @"dlsym"],
+            @"api_debugging": @[@"ptrace", @"sysctl", @"sysctlbyname", @"task_get_exception_ports",
+                                @"task_set_exception_ports", @"isatty", @"getppid"]
+        };
+    });
+    return functions;
+}
+
+NSArray<NSString *> *SRKProcedureAPICategories(void) {
+    return @[@"api_process", @"api_network", @"api_file", @"api_crypto",
+             @"api_keychain", @"api_ipc", @"api_memory", @"api_debugging"];
+}
+
+static int SRKCompareMetricAddresses(const void *a, const void *b) {
+    Address left = *(const Address *)a;
+    Address right = *(const Address *)b;
+    return left < right ? -1 : (left > right ? 1 : 0);
+}
+
+/// Last procedure id whose entry point is at or below the address
+static NSUInteger SRKPrecedingProcedure(const Address *entries, NSUInteger count, Address address) {
+    NSUInteger low = 0;
+    NSUInteger high = count;
+    while (low < high) {
+        NSUInteger middle = low + (high - low) / 2;
+        if (entries[middle] <= address) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    return low == 0 ? NSNotFound : low - 1;
+}
+
+NSUInteger SRKProcedureIdentifier(NSDictionary *index, Address entry) {
+    NSUInteger count = 0;
+    const Address *entries = SRKProcedureEntries(index, &count);
+    NSUInteger candidate = SRKPrecedingProcedure(entries, count, entry);
+    return (candidate != NSNotFound && entries[candidate] == entry) ? candidate : NSNotFound;
+}
+
+#pragma mark - Sweep
+
+/// Addresses of the instructions referencing C strings and CFStrings
+static NSData *SRKStringReferences(NSObject<HPDisassembledFile> *file) {
+    NSMutableData *references = [NSMutableData data];
+
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length == 0) continue;
+        const uint8_t *bytes = data.bytes;
+
+        for (NSObject<HPSection> *section in [segment sections]) {
+            BOOL cString = section.pureCStringSection || [section.sectionName containsString:@"cstring"];
+            BOOL cfString = [section.sectionName isEqualToString:@"__cfstring"];
+            if (!cString && !cfString) continue;
+            if (section.startAddress < segment.startAddress) continue;
+
+            uint64_t start = section.startAddress - segment.startAddress;
+            uint64_t end = MIN((uint64_t)data.length, section.endAddress - segment.startAddress);
+
+            for (uint64_t offset = start; offset < end;) {
+                uint64_t next = offset + SRK_CFSTRING_SIZE;
+                if (cString) {
+                    const uint8_t *terminator = memchr(bytes + offset, 0, (size_t)(end - offset));
+                    next = terminator ? (uint64_t)(terminator - bytes) + 1 : end;
+                    if (next == offset + 1) {
+                        offset = next;
+                        continue;
+                    }
+                }
+
+                for (NSNumber *reference in [segment referencesToAddress:segment.startAddress + offset]) {
+                    Address from = reference.unsignedLongLongValue;
+                    [references appendBytes:&from length:sizeof(Address)];
+                }
+                offset = next;
+            }
+        }
+    }
+
+    return references;
+}
+
+NSDictionary *SRKBuildProcedureMetrics(NSObject<HPDisassembledFile> *file, NSDictionary *index) {
+    NSUInteger count = 0;
+    const Address *entries = SRKProcedureEntries(index, &count);
+    NSArray<NSString *> *categories = SRKProcedureAPICategories();
+
+    NSMutableDictionary<NSString *, NSMutableData *> *columns = [NSMutableDictionary dictionary];
+    for (NSString *column in [@[@"instructions", @"blocks", @"edges", @"cyclomatic", @"fan_in", @"fan_out",
+                                @"string_refs", @"first_block", @"entry_block"] arrayByAddingObjectsFromArray:categories]) {
+        columns[column] = [NSMutableData dataWithLength:count * sizeof(uint32_t)];
+    }
+
+    uint32_t *instructions = columns[@"instructions"].mutableBytes;
+    uint32_t *blockCounts = columns[@"blocks"].mutableBytes;
+    uint32_t *edgeCounts = columns[@"edges"].mutableBytes;
+    uint32_t *cyclomatic = columns[@"cyclomatic"].mutableBytes;
+    uint32_t *fanIn = columns[@"fan_in"].mutableBytes;
+    uint32_t *fanOut = columns[@"fan_out"].mutableBytes;
+    uint32_t *stringRefs = columns[@"string_refs"].mutableBytes;
+    uint32_t *firstBlock = columns[@"first_block"].mutableBytes;
+    uint32_t *entryBlock = columns[@"entry_block"].mutableBytes;
+
+    uint32_t **apiHits = calloc(MAX(categories.count, 1), sizeof(uint32_t *));
+    uint32_t *firstCallee = calloc(MAX(count, 1), sizeof(uint32_t));
+    uint32_t *calleeCounts = calloc(MAX(count, 1), sizeof(uint32_t));
+    Address *extent = calloc(MAX(count, 1), sizeof(Address));
+    if (!apiHits || !firstCallee || !calleeCounts || !extent) {
+        free(apiHits);
+        free(firstCallee);
+        free(calleeCounts);
+        free(extent);
+        return @{@"columns": @{}, @"count": @0};
+    }
+    for (NSUInteger c = 0; c < categories.count; c++) {
+        apiHits[c] = columns[categories[c]].mutableBytes;
+    }
+
+    // Import address -> category, so the parallel pass only does dictionary reads
+    NSMutableDictionary<NSNumber *, NSNumber *> *importCategories = [NSMutableDictionary dictionary];
+    NSDictionary<NSString *, NSArray<NSString *> *> *categoryFunctions = SRKAPICategoryFunctions();
+    for (NSUInteger c = 0; c < categories.count; c++) {
+        for (NSString *function in categoryFunctions[categories[c]]) {
+            for (NSNumber *address in SRKAddressesForSymbol(index, function)) {
+                importCategories[address] = @(c);
+            }
+        }
+    }
+
+    // x86 instruction lengths vary, so only there do the blocks get decoded
+    SRKArchitecture arch = [index[@"arch"] unsignedIntegerValue];
+    NSObject<CPUContext> *cpu = arch == SRKArchitectureX86_64 ? [file buildCPUContext] : nil;
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+
+    // Hopper objects stay on this thread: copy the graphs and callees out once
+    NSMutableData *blockData = [NSMutableData data];
+    NSMutableData *edgeData = [NSMutableData data];
+    NSMutableData *calleeData = [NSMutableData data];
+    for (NSUInteger i = 0; i < count; i++) {
+        firstBlock[i] = (uint32_t)(blockData.length / sizeof(SRKProcedureBlock));
+        firstCallee[i] = (uint32_t)(calleeData.length / sizeof(Address));
+
+        NSObject<HPProcedure> *procedure = [file procedureAt:entries[i]];
+        if (!procedure) continue;
+
+        NSUInteger blockCount = procedure.basicBlockCount;
+        for (NSUInteger b = 0; b < blockCount; b++) {
+            SRKProcedureBlock block;
+            memset(&block, 0, sizeof(SRKProcedureBlock));
+            block.firstEdge = (uint32_t)(edgeData.length / sizeof(uint32_t));
+
+            NSObject<HPBasicBlock> *basicBlock = [procedure basicBlockAtIndex:b];
+            if (basicBlock) {
+                block.from = basicBlock.from;
+                block.to = basicBlock.to;
+                if (block.from == entries[i]) entryBlock[i] = (uint32_t)b;
+
+                for (NSObject<HPBasicBlock> *successor in basicBlock.successors) {
+                    NSUInteger target = successor.index;
+                    if (target >= blockCount) continue;
+                    uint32_t edge = (uint32_t)target;
+                    [edgeData appendBytes:&edge length:sizeof(uint32_t)];
+                    block.edgeCount++;
+                }
+
+                for (Address address = block.from; cpu && address < block.to;) {
+                    NSUInteger length = SRKLifterDecode(&lifter, address);
+                    if (length == 0) break;
+                    instructions[i]++;
+                    address += length;
+                }
+            }
+            [blockData appendBytes:&block length:sizeof(SRKProcedureBlock)];
+        }
+        blockCounts[i] = (uint32_t)blockCount;
+
+        for (NSObject<HPCallReference> *callee in procedure.allCallees) {
+            Address target = callee.to;
+            [calleeData appendBytes:&target length:sizeof(Address)];
+            calleeCounts[i]++;
+        }
+    }
+
+    NSData *stringReferenceData = SRKStringReferences(file);
+
+    const SRKProcedureBlock *blocks = blockData.bytes;
+    const Address *callees = calleeData.bytes;
+    NSDictionary<NSNumber *, NSNumber *> *categoryLookup = [importCategories copy];
+    NSUInteger chunks = (count + SRK_METRICS_CHUNK - 1) / SRK_METRICS_CHUNK;
+    dispatch_apply(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+        NSUInteger last = MIN(count, (chunk + 1) * SRK_METRICS_CHUNK);
+        for (NSUInteger i = chunk * SRK_METRICS_CHUNK; i < last; i++) {
+            const SRKProcedureBlock *procedureBlocks = blocks + firstBlock[i];
+            for (uint32_t b = 0; b < blockCounts[i]; b++) {
+                edgeCounts[i] += procedureBlocks[b].edgeCount;
+                if (procedureBlocks[b].to > extent[i]) extent[i] = procedureBlocks[b].to;
+                if (arch == SRKArchitectureARM64 && procedureBlocks[b].to > procedureBlocks[b].from) {
+                    instructions[i] += (uint32_t)((procedureBlocks[b].to - procedureBlocks[b].from) / 4);
+                }
+            }
+            if (blockCounts[i] > 0) {
+                int64_t complexity = (int64_t)edgeCounts[i] - (int64_t)blockCounts[i] + 2;
+                cyclomatic[i] = (uint32_t)MAX(complexity, 1);
+            }
+
+            if (calleeCounts[i] == 0) continue;
+            Address *sorted = malloc(calleeCounts[i] * sizeof(Address));
+            if (!sorted) continue;
+            memcpy(sorted, callees + firstCallee[i], calleeCounts[i] * sizeof(Address));
+            qsort(sorted, calleeCounts[i], sizeof(Address), SRKCompareMetricAddresses);
+
+            for (uint32_t c = 0; c < calleeCounts[i]; c++) {
+                if (c == 0 || sorted[c] != sorted[c - 1]) fanOut[i]++;
+                NSNumber *category = categoryLookup[@(sorted[c])];
+                if (category) apiHits[category.unsignedIntegerValue][i]++;
+            }
+            free(sorted);
+        }
+    });
+
+    // Fan-in and string references attribute addresses to other procedures, so they are tallied afterwards
+    NSUInteger calleeTotal = calleeData.length / sizeof(Address);
+    for (NSUInteger c = 0; c < calleeTotal; c++) {
+        NSUInteger target = SRKPrecedingProcedure(entries, count, callees[c]);
+        if (target != NSNotFound && entries[target] == callees[c]) fanIn[target]++;
+    }
+
+    const Address *stringReferences = stringReferenceData.bytes;
+    NSUInteger stringReferenceCount = stringReferenceData.length / sizeof(Address);
+    for (NSUInteger r = 0; r < stringReferenceCount; r++) {
+        NSUInteger owner = SRKPrecedingProcedure(entries, count, stringReferences[r]);
+        if (owner != NSNotFound && stringReferences[r] < extent[owner]) stringRefs[owner]++;
+    }
+
+    free(apiHits);
+    free(firstCallee);
+    free(calleeCounts);
+    free(extent);
+
+    return @{
+        @"columns": [columns copy],
+        @"count": @(count),
+        @"cfg_blocks": blockData,
+        @"cfg_edges": edgeData
+    };
+}
+
+#pragma mark - Rankings
+
+NSArray<NSDictionary *> *SRKProceduresByAPICalls(NSDictionary *metrics, NSDictionary *index, NSArray<NSString *> *columns,
+                                                 NSDictionary *libraryCode, NSUInteger maximumCount) {
+    NSUInteger count = 0;
+    NSUInteger entryCount = 0;
+    const Address *entries = SRKProcedureEntries(index, &entryCount);
+    const uint32_t *fanIn = SRKProcedureMetricColumn(metrics, @"fan_in", &count);
+    const uint32_t *stringRefs = SRKProcedureMetricColumn(metrics, @"string_refs", &count);
+    if (!fanIn || !stringRefs) return @[];
+    count = MIN(count, entryCount);
+
+    NSMutableArray<NSDictionary *> *procedures = [NSMutableArray array];
+    for (NSUInteger i = 0; i < count; i++) {
+        NSMutableDictionary<NSString *, NSNumber *> *apis = [NSMutableDictionary dictionary];
+        NSUInteger calls = 0;
+        for (NSString *column in columns) {
+            NSUInteger columnCount = 0;
+            const uint32_t *hits = SRKProcedureMetricColumn(metrics, column, &columnCount);
+            if (!hits || i >= columnCount || hits[i] == 0) continue;
+            apis[column] = @(hits[i]);
+            calls += hits[i];
+        }
+        if (calls == 0 || (libraryCode && SRKIsLibraryAddress(libraryCode, entries[i]))) continue;
+
+        [procedures addObject:@{@"procedure": @(entries[i]), @"calls": @(calls), @"apis": apis,
+                                @"fan_in": @(fanIn[i]), @"string_refs": @(stringRefs[i])}];
+    }
+
+    [procedures sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"calls" ascending:NO],
+                                       [NSSortDescriptor sortDescriptorWithKey:@"procedure" ascending:YES]]];
+    return [procedures subarrayWithRange:NSMakeRange(0, MIN(procedures.count, maximumCount))];
+}
+
+void SRKAppendProcedureAPIReport(NSMutableString *report, NSObject<HPDisassembledFile> *file,
+                                 NSArray<NSDictionary *> *procedures, NSString *headline) {
+    if (procedures.count == 0) return;
+
+    [report appendFormat:@"%@:\n", headline];
+    for (NSDictionary *procedure in procedures) {
+        Address entry = [procedure[@"procedure"] unsignedLongLongValue];
+        NSString *name = [file nameForVirtualAddress:entry];
+        if (name.length == 0) name = [NSString stringWithFormat:@"sub_%llx", (unsigned long long)entry];
+
+        // "api_network" reads as "network" in the report
+        NSMutableArray<NSString *> *apis = [NSMutableArray array];
+        for (NSString *column in [[procedure[@"apis"] allKeys] sortedArrayUsingSelector:@selector(compare:)]) {
+            [apis addObject:[NSString stringWithFormat:@"%@ %@", procedure[@"apis"][column],
+                             [column stringByReplacingOccurrencesOfString:@"api_" withString:@""]]];
+        }
+        [report appendFormat:@"  [0x%llx] %@: %@ calls (fan-in %@, %@ string references)\n", (unsigned long long)entry, name,
+         [apis componentsJoinedByString:@", "], procedure[@"fan_in"], procedure[@"string_refs"]];
+    }
+    [report appendString:@"\n"];
+}
+
+#pragma mark - Accessors
+
+const uint32_t *SRKProcedureMetricColumn(NSDictionary *metrics, NSString *column, NSUInteger *count) {
+    NSData *data = metrics[@"columns"][column];
+    *count = data ? [metrics[@"count"] unsignedIntegerValue] : 0;
+    return data.bytes;
+}
+
+const SRKProcedureBlock *SRKProcedureBlocks(NSDictionary *metrics, NSUInteger procedureId, NSUInteger *count) {
+    NSUInteger procedures = 0;
+    const uint32_t *firstBlock = SRKProcedureMetricColumn(metrics, @"first_block", &procedures);
+    const uint32_t *blockCounts = SRKProcedureMetricColumn(metrics, @"blocks", &procedures);
+    NSData *blocks = metrics[@"cfg_blocks"];
+
+    *count = 0;
+    if (!firstBlock || !blockCounts || procedureId >= procedures || blockCounts[procedureId] == 0) return NULL;
+
+    *count = blockCounts[procedureId];
+    return (const SRKProcedureBlock *)blocks.bytes + firstBlock[procedureId];
+}
+
+const uint32_t *SRKProcedureEdges(NSDictionary *metrics) {
+    NSData *edges = metrics[@"cfg_edges"];
+    return edges.bytes;
+}
@@ -0,0 +1,77 @@
+/*
+ SRKProtocolClusters.h
+ Corpus-wide C2 protocol shape clustering for HopperSRK analyzers
+
+ Hosts rotate between builds of a family; the shape of its protocol rarely
+ does. The request paths, query keys and User-Agent strings a sample
+ carries are reduced to shape tokens (paths as normalized templates with
+ digit runs and conversions folded, User-Agents as word shingles with
+ version numbers folded) and summarized by a MinHash sketch.
+
+ Samples are clustered incrementally in a flat file of fixed-size records,
+ one per sample, each holding its sketch and cluster id:
+ - the sketch is cut into SRK_PROTOCOL_BANDS LSH bands; only records
+   sharing a band with the new sample are candidates
+ - the new sample joins the cluster of its most similar candidate when
+   their estimated Jaccard similarity reaches SRK_PROTOCOL_JOIN_THRESHOLD,
+   and opens a new cluster otherwise
+ so adding a sample is one scan of the mapped records and one append,
+ without reclustering what came before. Cluster ids are stable: they are
+ never renumbered or merged.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Slots of the protocol shape MinHash sketch
+#define SRK_PROTOCOL_MINHASH_SIZE 32
+/// LSH bands the sketch is cut into, of SRK_PROTOCOL_MINHASH_SIZE / SRK_PROTOCOL_BANDS slots each
+#define SRK_PROTOCOL_BANDS 8
+/// Bytes per sample in the cluster store
+#define SRK_PROTOCOL_RECORD_SIZE 144
+/// Estimated Jaccard similarity for a sample to join an existing cluster
+#define SRK_PROTOCOL_JOIN_THRESHOLD 0.5
+
+/**
+ * Protocol shapes of the image's strings, library-only strings left out:
+ * @{@"paths": normalized request path templates, @"query_keys": lowercased keys,
+ *   @"user_agents": User-Agent strings}, each sorted and unique
+ */
+NSDictionary *SRKCollectProtocolShapes(NSObject<HPDisassembledFile> *file, NSDictionary * _Nullable libraryCode);
+
+/// Property list signature of the shapes: @{@"minhash": NSData, @"tokens": count}
+NSDictionary *SRKComputeProtocolSignature(NSDictionary *shapes);
+
+/// Estimated Jaccard similarity of two protocol signatures
+double SRKProtocolSimilarity(NSDictionary *a, NSDictionary *b);
+
+#pragma mark - Clusters
+
+/// ~/Library/Application Support/HopperSRK/ProtocolClusters
+NSString *SRKProtocolClusterDirectory(void);
+
+/**
+ * Clusters holding LSH candidates of the signature, most similar first:
+ * @{@"cluster": id, @"similarity": best member, @"members": count,
+ *   @"families": @[@{@"family", @"samples"}] most common first, unlabelled members left out}
+ * Records filed under the sample's own name are skipped, so a rerun does not
+ * find the sample's earlier filing.
+ */
+NSArray<NSDictionary *> *SRKNearestProtocolClusters(NSString *directory, NSDictionary *signature,
+                                                     NSString * _Nullable sample, NSUInteger maximumCount);
+
+/**
+ * Files the sample into the cluster of its most similar candidate, or a new
+ * cluster, and appends it to the store; cluster receives the id. A sample
+ * already filed under the same name with the same sketch is not appended
+ * again. The store is locked while the sample is assigned, so concurrent
+ * batch runs never hand out the same new id twice.
+ */
+BOOL SRKAddToProtocolClusters(NSString *directory, NSString *family, NSString *sample, NSDictionary *signature,
+                              uint32_t * _Nullable cluster, NSError **error);
+
+NS_ASSUME_NONNULL_END
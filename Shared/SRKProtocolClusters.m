@@ -0,0 +1,552 @@
+/*
+ SRKProtocolClusters.m
+ Corpus-wide C2 protocol shape clustering for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import <sys/file.h>
+#import "SRKProtocolClusters.h"
+#import "SRKFunctionSimilarity.h"
+#import "SRKLibraryCode.h"
+#import "SRKURLParser.h"
+
+// Longest extracted string looked at
+#define SRK_PROTOCOL_MAX_STRING 1024
+// Longest shaped path segment, query key or User-Agent word
+#define SRK_PROTOCOL_MAX_COMPONENT 128
+// Hex characters from which a path segment or key reads as an identifier
+#define SRK_PROTOCOL_HEX_IDENTIFIER 16
+// Records scored per dispatch_apply iteration
+#define SRK_PROTOCOL_SCAN_CHUNK 4096
+// Members per reported cluster whose labels are read for the family tally
+#define SRK_PROTOCOL_LABEL_SAMPLES 32
+// Longest "family\tsample\n" label read back from the labels file
+#define SRK_PROTOCOL_LABEL_MAX 512
+
+#define SRK_PROTOCOL_BAND_ROWS (SRK_PROTOCOL_MINHASH_SIZE / SRK_PROTOCOL_BANDS)
+
+typedef struct {
+    uint32_t minhash[SRK_PROTOCOL_MINHASH_SIZE];
+    uint32_t cluster;
+    uint32_t tokens;
+    /// Offset of the "family\tsample\n" line in the labels file
+    uint64_t labelOffset;
+} SRKProtocolRecord;
+
+_Static_assert(sizeof(SRKProtocolRecord) == SRK_PROTOCOL_RECORD_SIZE, "protocol cluster record size");
+_Static_assert(SRK_PROTOCOL_MINHASH_SIZE % SRK_PROTOCOL_BANDS == 0, "protocol LSH bands");
+
+static NSString *const SRKProtocolRecordsFile = @"records.bin";
+static NSString *const SRKProtocolLabelsFile = @"labels.txt";
+static NSString *const SRKProtocolLockFile = @"records.lock";
+
+#pragma mark - Shapes
+
+static inline char SRKProtocolLower(char c) {
+    return c >= 'A' && c <= 'Z' ? (char)(c + 32) : c;
+}
+
+static inline BOOL SRKProtocolIsHex(char c) {
+    return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F');
+}
+
+/**
+ * Shape of a path segment, query key or User-Agent word, NUL-terminated in
+ * buffer: lowercased, format conversions as "{}", digit runs as "#", and
+ * long hex identifiers (hashes, UUIDs) as "{h}". Returns its length.
+ */
+static size_t SRKShapeComponent(const char *text, size_t length, char *buffer, size_t capacity) {
+    size_t hex = 0;
+    BOOL identifier = length >= SRK_PROTOCOL_HEX_IDENTIFIER;
+    for (size_t i = 0; i < length && identifier; i++) {
+        if (SRKProtocolIsHex(text[i])) hex++;
+        else if (text[i] != '-') identifier = NO;
+    }
+    if (identifier && hex >= SRK_PROTOCOL_HEX_IDENTIFIER) {
+        return (size_t)snprintf(buffer, capacity, "{h}");
+    }
+
+    size_t written = 0;
+    for (size_t i = 0; i < length && written + 3 < capacity; i++) {
+        char c = text[i];
+        if (c == '%') {
+            size_t specifier = SRKFormatSpecifierLength(text + i, length - i);
+            if (specifier > 0) {
+                buffer[written++] = '{';
+                buffer[written++] = '}';
+                i += specifier - 1;
+                continue;
+            }
+        }
+        if (c >= '0' && c <= '9') {
+            while (i + 1 < length && text[i + 1] >= '0' && text[i + 1] <= '9') i++;
+            buffer[written++] = '#';
+            continue;
+        }
+        buffer[written++] = SRKProtocolLower(c);
+    }
+    buffer[written] = 0;
+    return written;
+}
+
+static BOOL SRKProtocolHasPrefix(const char *text, size_t length, const char *prefix) {
+    size_t prefixLength = strlen(prefix);
+    return length >= prefixLength && strncasecmp(text, prefix, prefixLength) == 0;
+}
+
+/// The User-Agent the string holds, without a "User-Agent:" header name; NULL when it holds none
+static const char *SRKUserAgentStart(const char *text, size_t length) {
+    static const char *const agents[] = {
+        "Mozilla/", "curl/", "Wget/", "python-requests/", "Python-urllib/", "Go-http-client/",
+        "okhttp/", "CFNetwork/", "WinHTTP", "Java/", "libcurl/"
+    };
+
+    if (SRKProtocolHasPrefix(text, length, "User-Agent:")) {
+        const char *start = text + strlen("User-Agent:");
+        while (*start == ' ' || *start == '\t') start++;
+        return *start ? start : NULL;
+    }
+    for (size_t a = 0; a < sizeof(agents) / sizeof(agents[0]); a++) {
+        if (SRKProtocolHasPrefix(text, length, agents[a])) return text;
+    }
+    return NULL;
+}
+
+/// Whether a parsed URL is a request rather than a file path ("%@/Library/%@" parses too)
+static BOOL SRKIsRequestShaped(const char *text, const SRKURLParts *parts) {
+    static const char *const webExtensions[] = {".php", ".asp", ".aspx", ".jsp", ".cgi", ".html", ".json"};
+
+    if (parts->flags & SRKURLHasScheme) {
+        return !SRKProtocolHasPrefix(text + parts->scheme.offset, parts->scheme.length, "file");
+    }
+    if (parts->query.length > 0) return YES;
+    if ((parts->flags & SRKURLHasAuthority) && !(parts->flags & SRKURLTemplatedHost) &&
+        parts->host.length > 0 && text[parts->host.offset] != '%') {
+        return YES;
+    }
+
+    size_t cursor = 0;
+    SRKURLRange segment;
+    SRKURLRange last = {0, 0};
+    while (SRKURLNextPathSegment(parts, text, &cursor, &segment)) {
+        if (segment.length == 3 && strncasecmp(text + segment.offset, "api", 3) == 0) return YES;
+        last = segment;
+    }
+    for (size_t e = 0; e < sizeof(webExtensions) / sizeof(webExtensions[0]); e++) {
+        size_t extension = strlen(webExtensions[e]);
+        if (last.length > extension &&
+            strncasecmp(text + last.offset + last.length - extension, webExtensions[e], extension) == 0) {
+            return YES;
+        }
+    }
+    return NO;
+}
+
+/// Path template and query keys of a request URL
+static void SRKAddRequestShape(const char *text, const SRKURLParts *parts, NSMutableSet<NSString *> *paths,
+                               NSMutableSet<NSString *> *keys) {
+    char component[SRK_PROTOCOL_MAX_COMPONENT];
+    NSMutableString *path = [NSMutableString string];
+
+    size_t cursor = 0;
+    SRKURLRange segment;
+    while (SRKURLNextPathSegment(parts, text, &cursor, &segment)) {
+        SRKShapeComponent(text + segment.offset, segment.length, component, sizeof(component));
+        [path appendFormat:@"/%s", component];
+    }
+    if (path.length > 0) [paths addObject:path];
+
+    cursor = 0;
+    SRKURLRange key;
+    SRKURLRange value;
+    while (SRKURLNextQueryParameter(parts, text, &cursor, &key, &value)) {
+        if (key.length == 0) continue;
+        SRKShapeComponent(text + key.offset, key.length, component, sizeof(component));
+        [keys addObject:@(component)];
+    }
+}
+
+NSDictionary *SRKCollectProtocolShapes(NSObject<HPDisassembledFile> *file, NSDictionary *libraryCode) {
+    NSMutableSet<NSString *> *paths = [NSMutableSet set];
+    NSMutableSet<NSString *> *keys = [NSMutableSet set];
+    NSMutableSet<NSString *> *agents = [NSMutableSet set];
+
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length == 0) continue;
+        const char *bytes = data.bytes;
+
+        for (NSObject<HPSection> *section in [segment sections]) {
+            if (![section.sectionName containsString:@"string"] && ![section.sectionName isEqualToString:@"__const"]) continue;
+            if (section.startAddress < segment.startAddress) continue;
+
+            NSUInteger start = (NSUInteger)(section.startAddress - segment.startAddress);
+            NSUInteger end = MIN(data.length, (NSUInteger)(section.endAddress - segment.startAddress));
+            for (NSUInteger i = start; i < end;) {
+                NSUInteger j = i;
+                while (j < end && bytes[j] >= 32 && bytes[j] < 127) j++;
+
+                // NUL-terminated printable runs; shapes are looked for before any object is made
+                size_t length = j - i;
+                const char *text = bytes + i;
+                Address address = segment.startAddress + i;
+                i = j + 1;
+                if (j >= end || bytes[j] != 0 || length < 4 || length > SRK_PROTOCOL_MAX_STRING) continue;
+
+                const char *agent = SRKUserAgentStart(text, length);
+                SRKURLParts parts;
+                BOOL request = !agent && memchr(text, '/', length) && SRKParseURL(text, length, YES, &parts) &&
+                               SRKIsRequestShaped(text, &parts);
+                if (!agent && !request) continue;
+                if (libraryCode && SRKIsLibraryOnlyReference(file, libraryCode, address)) continue;
+
+                if (agent) {
+                    NSString *userAgent = [[NSString alloc] initWithBytes:agent length:length - (size_t)(agent - text)
+                                                                 encoding:NSUTF8StringEncoding];
+                    if (userAgent) [agents addObject:userAgent];
+                } else {
+                    SRKAddRequestShape(text, &parts, paths, keys);
+                }
+            }
+        }
+    }
+
+    return @{
+        @"paths": [paths.allObjects sortedArrayUsingSelector:@selector(compare:)],
+        @"query_keys": [keys.allObjects sortedArrayUsingSelector:@selector(compare:)],
+        @"user_agents": [agents.allObjects sortedArrayUsingSelector:@selector(compare:)]
+    };
+}
+
+#pragma mark - Signatures
+
+static inline uint64_t SRKProtocolMix(uint64_t value) {
+    value ^= value >> 33;
+    value *= 0xff51afd7ed558ccdULL;
+    value ^= value >> 33;
+    value *= 0xc4ceb9fe1a85ec53ULL;
+    value ^= value >> 33;
+    return value;
+}
+
+static void SRKAddProtocolToken(uint32_t *minhash, NSMutableSet<NSString *> *seen, NSString *token) {
+    if ([seen containsObject:token]) return;
+    [seen addObject:token];
+
+    uint64_t hash = 0xcbf29ce484222325ULL;
+    for (const char *c = token.UTF8String; c && *c; c++) {
+        hash = (hash ^ (uint8_t)*c) * 0x100000001b3ULL;
+    }
+    for (NSUInteger i = 0; i < SRK_PROTOCOL_MINHASH_SIZE; i++) {
+        uint32_t value = (uint32_t)SRKProtocolMix(hash + (i + 1) * 0x9E3779B97F4A7C15ULL);
+        if (value < minhash[i]) minhash[i] = value;
+    }
+}
+
+/// Single words and adjacent pairs, so both shared vocabulary and shared order count
+static void SRKAddShingles(uint32_t *minhash, NSMutableSet<NSString *> *seen, NSString *prefix,
+                           NSArray<NSString *> *words) {
+    for (NSUInteger w = 0; w < words.count; w++) {
+        SRKAddProtocolToken(minhash, seen, [NSString stringWithFormat:@"%@:%@", prefix, words[w]]);
+        if (w + 1 < words.count) {
+            SRKAddProtocolToken(minhash, seen, [NSString stringWithFormat:@"%@2:%@ %@", prefix, words[w], words[w + 1]]);
+        }
+    }
+}
+
+NSDictionary *SRKComputeProtocolSignature(NSDictionary *shapes) {
+    uint32_t minhash[SRK_PROTOCOL_MINHASH_SIZE];
+    memset(minhash, 0xFF, sizeof(minhash));
+    NSMutableSet<NSString *> *seen = [NSMutableSet set];
+
+    for (NSString *path in shapes[@"paths"]) {
+        SRKAddProtocolToken(minhash, seen, [@"path:" stringByAppendingString:path]);
+        NSArray<NSString *> *segments = [[path componentsSeparatedByString:@"/"]
+                                         filteredArrayUsingPredicate:[NSPredicate predicateWithFormat:@"length > 0"]];
+        SRKAddShingles(minhash, seen, @"seg", segments);
+    }
+    for (NSString *key in shapes[@"query_keys"]) {
+        SRKAddProtocolToken(minhash, seen, [@"key:" stringByAppendingString:key]);
+    }
+
+    NSCharacterSet *separators = [NSCharacterSet characterSetWithCharactersInString:@" ;(),"];
+    for (NSString *agent in shapes[@"user_agents"]) {
+        NSMutableArray<NSString *> *words = [NSMutableArray array];
+        for (NSString *word in [agent componentsSeparatedByCharactersInSet:separators]) {
+            const char *text = word.UTF8String;
+            if (!text || !*text) continue;
+            char shaped[SRK_PROTOCOL_MAX_COMPONENT];
+            SRKShapeComponent(text, strlen(text), shaped, sizeof(shaped));
+            [words addObject:@(shaped)];
+        }
+        SRKAddShingles(minhash, seen, @"ua", words);
+    }
+
+    return @{
+        @"minhash": [NSData dataWithBytes:minhash length:sizeof(minhash)],
+        @"tokens": @(seen.count)
+    };
+}
+
+static BOOL SRKProtocolRecordForSignature(NSDictionary *signature, SRKProtocolRecord *record) {
+    memset(record, 0, sizeof(SRKProtocolRecord));
+    NSData *minhash = signature[@"minhash"];
+    if (![minhash isKindOfClass:[NSData class]] || minhash.length != sizeof(record->minhash)) return NO;
+
+    memcpy(record->minhash, minhash.bytes, sizeof(record->minhash));
+    record->tokens = [signature[@"tokens"] unsignedIntValue];
+    return YES;
+}
+
+static double SRKProtocolRecordSimilarity(const SRKProtocolRecord *a, const SRKProtocolRecord *b) {
+    NSUInteger matches = 0;
+    for (NSUInteger i = 0; i < SRK_PROTOCOL_MINHASH_SIZE; i++) {
+        if (a->minhash[i] == b->minhash[i]) matches++;
+    }
+    return (double)matches / SRK_PROTOCOL_MINHASH_SIZE;
+}
+
+double SRKProtocolSimilarity(NSDictionary *a, NSDictionary *b) {
+    SRKProtocolRecord left;
+    SRKProtocolRecord right;
+    if (!SRKProtocolRecordForSignature(a, &left) || !SRKProtocolRecordForSignature(b, &right)) return 0.0;
+    if (left.tokens == 0 || right.tokens == 0) return 0.0;
+    return SRKProtocolRecordSimilarity(&left, &right);
+}
+
+#pragma mark - Store
+
+NSString *SRKProtocolClusterDirectory(void) {
+    NSString *support = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES).firstObject;
+    if (!support) support = [NSHomeDirectory() stringByAppendingPathComponent:@"Library/Application Support"];
+    return [support stringByAppendingPathComponent:@"HopperSRK/ProtocolClusters"];
+}
+
+static BOOL SRKSharesBand(const SRKProtocolRecord *a, const SRKProtocolRecord *b) {
+    for (NSUInteger band = 0; band < SRK_PROTOCOL_BANDS; band++) {
+        NSUInteger first = band * SRK_PROTOCOL_BAND_ROWS;
+        if (memcmp(&a->minhash[first], &b->minhash[first], SRK_PROTOCOL_BAND_ROWS * sizeof(uint32_t)) == 0) return YES;
+    }
+    return NO;
+}
+
+/// Similarity of every record to the query over the mapped file; 0 for records sharing no band with it
+static float *SRKScoreProtocolRecords(const SRKProtocolRecord *records, NSUInteger count, const SRKProtocolRecord *query) {
+    float *scores = malloc(MAX(count, 1) * sizeof(float));
+    if (!scores) return NULL;
+
+    size_t chunks = (count + SRK_PROTOCOL_SCAN_CHUNK - 1) / SRK_PROTOCOL_SCAN_CHUNK;
+    dispatch_apply(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+        NSUInteger end = MIN(count, (chunk + 1) * SRK_PROTOCOL_SCAN_CHUNK);
+        for (NSUInteger r = chunk * SRK_PROTOCOL_SCAN_CHUNK; r < end; r++) {
+            scores[r] = records[r].tokens > 0 && SRKSharesBand(&records[r], query) ?
+                        (float)SRKProtocolRecordSimilarity(&records[r], query) : 0.0f;
+        }
+    });
+    return scores;
+}
+
+// Tabs and newlines would break the label line
+static NSString *SRKProtocolLabelField(NSString *field) {
+    NSCharacterSet *separators = [NSCharacterSet characterSetWithCharactersInString:@"\t\n"];
+    return [[field componentsSeparatedByCharactersInSet:separators] componentsJoinedByString:@" "];
+}
+
+static NSData *SRKProtocolLabel(NSString *family, NSString *sample) {
+    return [[NSString stringWithFormat:@"%@\t%@\n", SRKProtocolLabelField(family), SRKProtocolLabelField(sample)]
+            dataUsingEncoding:NSUTF8StringEncoding];
+}
+
+static NSArray<NSString *> *SRKReadProtocolLabel(NSFileHandle *labels, uint64_t offset) {
+    [labels seekToFileOffset:offset];
+    NSData *data = [labels readDataOfLength:SRK_PROTOCOL_LABEL_MAX];
+    NSString *text = [[NSString alloc] initWithData:data encoding:NSUTF8StringEncoding];
+    NSString *line = [text componentsSeparatedByString:@"\n"].firstObject;
+    NSArray<NSString *> *fields = [line componentsSeparatedByString:@"\t"];
+    return fields.count == 2 ? fields : @[@"unknown", line ?: @"?"];
+}
+
+NSArray<NSDictionary *> *SRKNearestProtocolClusters(NSString *directory, NSDictionary *signature,
+                                                     NSString *sample, NSUInteger maximumCount) {
+    SRKProtocolRecord query;
+    if (maximumCount == 0 || !SRKProtocolRecordForSignature(signature, &query) || query.tokens == 0) return @[];
+
+    NSData *data = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:SRKProtocolRecordsFile]
+                                          options:NSDataReadingMappedIfSafe error:nil];
+    const SRKProtocolRecord *records = data.bytes;
+    NSUInteger count = data.length / sizeof(SRKProtocolRecord);
+    float *scores = count > 0 ? SRKScoreProtocolRecords(records, count, &query) : NULL;
+    if (!scores) return @[];
+
+    // Earlier filings of the sample itself would match it at 100%
+    NSFileHandle *labels = [NSFileHandle fileHandleForReadingAtPath:[directory stringByAppendingPathComponent:SRKProtocolLabelsFile]];
+    NSMutableIndexSet *own = [NSMutableIndexSet indexSet];
+    NSString *field = sample ? SRKProtocolLabelField(sample) : nil;
+    for (NSUInteger r = 0; labels && field && r < count; r++) {
+        if (scores[r] <= 0.0f) continue;
+        if ([SRKReadProtocolLabel(labels, records[r].labelOffset)[1] isEqualToString:field]) [own addIndex:r];
+    }
+
+    // Best candidate per cluster; candidates are few, so objects are fine from here on
+    NSMutableDictionary<NSNumber *, NSNumber *> *best = [NSMutableDictionary dictionary];
+    for (NSUInteger r = 0; r < count; r++) {
+        if (scores[r] <= 0.0f || [own containsIndex:r]) continue;
+        NSNumber *cluster = @(records[r].cluster);
+        if (scores[r] > [best[cluster] floatValue]) best[cluster] = @(scores[r]);
+    }
+    free(scores);
+
+    NSArray<NSNumber *> *ranked = [best keysSortedByValueUsingComparator:^NSComparisonResult(NSNumber *a, NSNumber *b) {
+        return [b compare:a];
+    }];
+    ranked = [ranked subarrayWithRange:NSMakeRange(0, MIN(ranked.count, maximumCount))];
+
+    NSMutableDictionary<NSNumber *, NSNumber *> *members = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSNumber *, NSMutableArray<NSNumber *> *> *labelOffsets = [NSMutableDictionary dictionary];
+    for (NSNumber *cluster in ranked) {
+        members[cluster] = @0;
+        labelOffsets[cluster] = [NSMutableArray array];
+    }
+    for (NSUInteger r = 0; r < count; r++) {
+        NSNumber *cluster = @(records[r].cluster);
+        if (!members[cluster] || [own containsIndex:r]) continue;
+        members[cluster] = @([members[cluster] unsignedIntegerValue] + 1);
+        if (labelOffsets[cluster].count < SRK_PROTOCOL_LABEL_SAMPLES) [labelOffsets[cluster] addObject:@(records[r].labelOffset)];
+    }
+
+    NSMutableArray<NSDictionary *> *clusters = [NSMutableArray arrayWithCapacity:ranked.count];
+    for (NSNumber *cluster in ranked) {
+        // Unlabelled members count towards the cluster size but name no family
+        NSCountedSet<NSString *> *families = [NSCountedSet set];
+        for (NSNumber *offset in labelOffsets[cluster]) {
+            NSString *family = labels ? SRKReadProtocolLabel(labels, offset.unsignedLongLongValue)[0] : @"unknown";
+            if (![family isEqualToString:SRK_UNLABELLED_FAMILY]) [families addObject:family];
+        }
+
+        NSMutableArray<NSDictionary *> *tally = [NSMutableArray array];
+        for (NSString *family in families) {
+            [tally addObject:@{@"family": family, @"samples": @([families countForObject:family])}];
+        }
+        [tally sortUsingComparator:^NSComparisonResult(NSDictionary *a, NSDictionary *b) {
+            return [b[@"samples"] compare:a[@"samples"]];
+        }];
+
+        [clusters addObject:@{
+            @"cluster": cluster,
+            @"similarity": best[cluster],
+            @"members": members[cluster],
+            @"families": tally
+        }];
+    }
+    [labels closeFile];
+    return clusters;
+}
+
+static NSFileHandle *SRKProtocolOpenForAppending(NSString *path, NSError **error) {
+    NSFileManager *manager = [NSFileManager defaultManager];
+    if (![manager fileExistsAtPath:path] && ![manager createFileAtPath:path contents:nil attributes:nil]) {
+        if (error) *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileWriteUnknownError
+                                            userInfo:@{NSFilePathErrorKey: path}];
+        return nil;
+    }
+    NSFileHandle *handle = [NSFileHandle fileHandleForWritingAtPath:path];
+    if (!handle && error) {
+        *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSFileWriteNoPermissionError
+                                 userInfo:@{NSFilePathErrorKey: path}];
+    }
+    return handle;
+}
+
+/// Cluster for the record: the cluster of an identical filing, of the best candidate, or a new one
+static uint32_t SRKAssignProtocolCluster(NSString *directory, const SRKProtocolRecord *record, NSData *label,
+                                         BOOL *alreadyFiled) {
+    *alreadyFiled = NO;
+    NSData *data = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:SRKProtocolRecordsFile]
+                                          options:NSDataReadingMappedIfSafe error:nil];
+    const SRKProtocolRecord *records = data.bytes;
+    NSUInteger count = data.length / sizeof(SRKProtocolRecord);
+    float *scores = count > 0 ? SRKScoreProtocolRecords(records, count, record) : NULL;
+
+    uint32_t highest = 0;
+    NSUInteger best = NSNotFound;
+    NSFileHandle *labels = nil;
+    for (NSUInteger r = 0; r < count; r++) {
+        highest = MAX(highest, records[r].cluster);
+        if (!scores || scores[r] <= 0.0f) continue;
+
+        if (scores[r] >= 1.0f) {
+            // Same sketch: a rerun over a sample that is filed already keeps its cluster
+            if (!labels) labels = [NSFileHandle fileHandleForReadingAtPath:[directory stringByAppendingPathComponent:SRKProtocolLabelsFile]];
+            [labels seekToFileOffset:records[r].labelOffset];
+            if ([[labels readDataOfLength:label.length] isEqualToData:label]) {
+                *alreadyFiled = YES;
+                best = r;
+                break;
+            }
+        }
+        if (best == NSNotFound || scores[r] > scores[best]) best = r;
+    }
+    [labels closeFile];
+
+    BOOL joins = best != NSNotFound && (*alreadyFiled || scores[best] >= SRK_PROTOCOL_JOIN_THRESHOLD);
+    uint32_t cluster = joins ? records[best].cluster : highest + 1;
+    free(scores);
+    return cluster;
+}
+
+BOOL SRKAddToProtocolClusters(NSString *directory, NSString *family, NSString *sample, NSDictionary *signature,
+                              uint32_t *cluster, NSError **error) {
+    SRKProtocolRecord record;
+    if (!SRKProtocolRecordForSignature(signature, &record) || record.tokens == 0) {
+        if (error) *error = [NSError errorWithDomain:NSCocoaErrorDomain code:NSPropertyListReadCorruptError userInfo:nil];
+        return NO;
+    }
+    if (![[NSFileManager defaultManager] createDirectoryAtPath:directory withIntermediateDirectories:YES
+                                                    attributes:nil error:error]) {
+        return NO;
+    }
+
+    // Held from the scan to the append, so two runs never both open cluster highest + 1
+    NSString *lockPath = [directory stringByAppendingPathComponent:SRKProtocolLockFile];
+    int lock = open(lockPath.fileSystemRepresentation, O_RDWR | O_CREAT, 0644);
+    if (lock < 0 || flock(lock, LOCK_EX) != 0) {
+        int code = errno;
+        if (lock >= 0) close(lock);
+        if (error) *error = [NSError errorWithDomain:NSPOSIXErrorDomain code:code userInfo:@{NSFilePathErrorKey: lockPath}];
+        return NO;
+    }
+
+    NSData *label = SRKProtocolLabel(family, sample);
+    BOOL alreadyFiled = NO;
+    BOOL written = YES;
+    @autoreleasepool {
+        // The mapping of the records is let go before they are appended to
+        record.cluster = SRKAssignProtocolCluster(directory, &record, label, &alreadyFiled);
+    }
+
+    if (!alreadyFiled) {
+        NSFileHandle *labels = SRKProtocolOpenForAppending([directory stringByAppendingPathComponent:SRKProtocolLabelsFile], error);
+        NSFileHandle *records = labels ? SRKProtocolOpenForAppending([directory stringByAppendingPathComponent:SRKProtocolRecordsFile], error) : nil;
+        written = labels && records;
+        if (written) {
+            // Label first, so a record never points past the end of the labels file
+            record.labelOffset = [labels seekToEndOfFile];
+            [labels writeData:label];
+
+            // A record left partial by an interrupted append is overwritten
+            unsigned long long end = [records seekToEndOfFile];
+            [records seekToFileOffset:end - end % sizeof(SRKProtocolRecord)];
+            [records writeData:[NSData dataWithBytes:&record length:sizeof(SRKProtocolRecord)]];
+        }
+        [labels closeFile];
+        [records closeFile];
+    }
+
+    flock(lock, LOCK_UN);
+    close(lock);
+    if (written && cluster) *cluster = record.cluster;
+    return written;
+}
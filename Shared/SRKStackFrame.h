@@ -0,0 +1,73 @@
+/*
+ SRKStackFrame.h
+ Stack frame model layered over the SRKLifter register lifter
+
+ SRKLifter only reads memory from the binary, so whatever a procedure
+ spills to its own frame is lost. SRKLiftProcedureWithStack lifts a
+ procedure with sp and fp seeded to a synthetic frame address and records
+ every store landing in that frame, byte-accurate and little-endian, so:
+ - reloads of spilled registers get the stored value back
+ - call handlers can read the arrays and structures the procedure built on
+   its stack (CFDictionaryCreate key arrays, sockaddr_in, addrinfo hints)
+ - call handlers can store what a callee writes through a pointer argument
+ A later store overwrites the bytes of earlier ones it overlaps. Stores of
+ untracked (SIMD) registers clear the bytes they cover.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKLifter.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Synthetic value seeded into the stack pointer; no Mach-O segment lives this high
+#define SRK_STACK_FRAME_BASE 0x00007ffe00000000ULL
+/// Addresses within this distance of SRK_STACK_FRAME_BASE belong to the frame
+#define SRK_STACK_FRAME_SPAN 0x100000ULL
+
+/// Stored value and its width in bytes (1 to 8), boxed in the frame dictionary
+typedef struct {
+    SRKRegisterValue value;
+    uint32_t size;
+} SRKStackSlot;
+
+/// Whether an address falls in the synthetic frame
+BOOL SRKIsStackAddress(Address address);
+
+/**
+ * Lifts a procedure like SRKLiftProcedure, recording the stores into its
+ * frame in stack (slot address -> NSValue of SRKStackSlot). The handler can
+ * read and write stack while it runs.
+ */
+void SRKLiftProcedureWithStack(SRKLifter *lifter, NSObject<HPProcedure> *procedure,
+                               NSMutableDictionary<NSNumber *, NSValue *> *stack, SRKCallHandler _Nullable handler);
+
+/// Records a store of size bytes (1 to 8) at address
+void SRKStackStore(NSMutableDictionary<NSNumber *, NSValue *> *stack, Address address, SRKRegisterValue value, uint32_t size);
+
+/// Clears length bytes at address, for stores whose value is not tracked
+void SRKStackClear(NSMutableDictionary<NSNumber *, NSValue *> *stack, Address address, NSUInteger length);
+
+/// Value stored exactly at address, with its symbol and class information
+BOOL SRKStackValue(NSDictionary<NSNumber *, NSValue *> *stack, Address address, SRKRegisterValue *value);
+
+/**
+ * Copies length bytes (at most 64) starting at address into bytes.
+ * Returns a mask with bit i set when byte i is known; unknown bytes are 0.
+ */
+uint64_t SRKStackReadBytes(NSDictionary<NSNumber *, NSValue *> *stack, Address address, uint8_t *bytes, NSUInteger length);
+
+/**
+ * Outgoing argument argumentIndex at a call, size bytes (1 to 8) wide: its
+ * register, or past the argument registers the bytes stored at sp plus the
+ * argument's slot. Earlier stack arguments are taken to be 8 bytes each,
+ * which always holds on x86_64; Darwin arm64 packs narrower ones, so there
+ * only the first stack argument is exact. NO when the value is not known.
+ */
+BOOL SRKStackArgumentValue(SRKLifter *lifter, const SRKRegisterState *state,
+                           NSDictionary<NSNumber *, NSValue *> *stack, NSUInteger argumentIndex, uint32_t size,
+                           SRKRegisterValue *value);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,259 @@
+/*
+ SRKStackFrame.m
+ Stack frame model layered over the SRKLifter register lifter
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKStackFrame.h"
+
+// ARM64 stack pointer and frame pointer register indexes
+#define SRK_STACK_ARM64_SP 31
+#define SRK_STACK_ARM64_FP 29
+// Widest slot; wider stores are split
+#define SRK_STACK_SLOT_MAX 8
+
+#pragma mark - Slots
+
+BOOL SRKIsStackAddress(Address address) {
+    return address >= SRK_STACK_FRAME_BASE - SRK_STACK_FRAME_SPAN &&
+           address < SRK_STACK_FRAME_BASE + SRK_STACK_FRAME_SPAN;
+}
+
+static uint64_t SRKStackTruncate(uint64_t value, uint32_t size) {
+    return size >= 8 ? value : value & ((1ULL << (size * 8)) - 1);
+}
+
+static void SRKStackPut(NSMutableDictionary<NSNumber *, NSValue *> *stack, Address address, SRKStackSlot slot) {
+    stack[@(address)] = [NSValue valueWithBytes:&slot objCType:@encode(SRKStackSlot)];
+}
+
+static BOOL SRKStackSlotAt(NSDictionary<NSNumber *, NSValue *> *stack, Address address, SRKStackSlot *slot) {
+    NSValue *boxed = stack[@(address)];
+    if (!boxed) return NO;
+    [boxed getValue:slot];
+    return YES;
+}
+
+/// Part of a slot's value starting offset bytes in; a slice no longer names a symbol
+static SRKStackSlot SRKStackSlice(SRKStackSlot slot, uint32_t offset, uint32_t size) {
+    SRKStackSlot slice;
+    memset(&slice, 0, sizeof(SRKStackSlot));
+    slice.size = size;
+    slice.value.known = slot.value.known;
+    if (slot.value.known) slice.value.value = SRKStackTruncate(slot.value.value >> (offset * 8), size);
+    return slice;
+}
+
+void SRKStackClear(NSMutableDictionary<NSNumber *, NSValue *> *stack, Address address, NSUInteger length) {
+    Address end = address + length;
+    Address first = address >= SRK_STACK_SLOT_MAX - 1 ? address - (SRK_STACK_SLOT_MAX - 1) : 0;
+
+    for (Address start = first; start < end; start++) {
+        SRKStackSlot slot;
+        if (!SRKStackSlotAt(stack, start, &slot)) continue;
+        Address slotEnd = start + slot.size;
+        if (slotEnd <= address) continue;
+
+        [stack removeObjectForKey:@(start)];
+        // Keep the bytes on either side of the cleared range
+        if (start < address) SRKStackPut(stack, start, SRKStackSlice(slot, 0, (uint32_t)(address - start)));
+        if (slotEnd > end) SRKStackPut(stack, end, SRKStackSlice(slot, (uint32_t)(end - start), (uint32_t)(slotEnd - end)));
+    }
+}
+
+void SRKStackStore(NSMutableDictionary<NSNumber *, NSValue *> *stack, Address address, SRKRegisterValue value, uint32_t size) {
+    if (size == 0 || size > SRK_STACK_SLOT_MAX) size = SRK_STACK_SLOT_MAX;
+    SRKStackClear(stack, address, size);
+
+    SRKStackSlot slot;
+    slot.value = value;
+    slot.size = size;
+    if (value.known) slot.value.value = SRKStackTruncate(value.value, size);
+    SRKStackPut(stack, address, slot);
+}
+
+BOOL SRKStackValue(NSDictionary<NSNumber *, NSValue *> *stack, Address address, SRKRegisterValue *value) {
+    SRKStackSlot slot;
+    if (!SRKStackSlotAt(stack, address, &slot)) return NO;
+    *value = slot.value;
+    return YES;
+}
+
+uint64_t SRKStackReadBytes(NSDictionary<NSNumber *, NSValue *> *stack, Address address, uint8_t *bytes, NSUInteger length) {
+    if (length > 64) length = 64;
+    memset(bytes, 0, length);
+
+    uint64_t known = 0;
+    Address end = address + length;
+    Address first = address >= SRK_STACK_SLOT_MAX - 1 ? address - (SRK_STACK_SLOT_MAX - 1) : 0;
+    for (Address start = first; start < end; start++) {
+        SRKStackSlot slot;
+        if (!SRKStackSlotAt(stack, start, &slot) || !slot.value.known) continue;
+
+        // Both supported architectures are little-endian
+        for (uint32_t i = 0; i < slot.size; i++) {
+            Address byteAddress = start + i;
+            if (byteAddress < address || byteAddress >= end) continue;
+            bytes[byteAddress - address] = (uint8_t)(slot.value.value >> (i * 8));
+            known |= 1ULL << (byteAddress - address);
+        }
+    }
+    return known;
+}
+
+#pragma mark - Lifting
+
+/// Width in bytes of the value the decoded store or load moves through memory
+static uint32_t SRKStackAccessSize(SRKLifter *lifter) {
+    DisasmStruct *disasm = &lifter->disasm;
+    const char *mnemonic = disasm->instruction.mnemonic;
+    if (lifter->arch == SRKArchitectureARM64) {
+        size_t length = strlen(mnemonic);
+        // strb/sturb/ldrb/ldurb, strh/sturh/ldrh/ldurh; the register operand is a w register either way
+        if (length > 0 && mnemonic[length - 1] == 'b') return 1;
+        if (length > 0 && mnemonic[length - 1] == 'h') return 2;
+    }
+
+    for (NSUInteger i = 0; i < DISASM_MAX_OPERANDS; i++) {
+        const DisasmOperand *operand = &disasm->operand[i];
+        if ((operand->type & DISASM_OPERAND_MEMORY_TYPE) && operand->size >= 8 && operand->size <= 64) {
+            return operand->size / 8;
+        }
+    }
+    // Pair stores carry the pair's width on the memory operand; each register its own
+    const DisasmOperand *reg = &disasm->operand[0];
+    if (!(reg->type & DISASM_OPERAND_MEMORY_TYPE) && reg->size >= 8 && reg->size <= 64) return reg->size / 8;
+    return SRK_STACK_SLOT_MAX;
+}
+
+static void SRKStackRecordStore(SRKLifter *lifter, const SRKRegisterState *state,
+                                NSMutableDictionary<NSNumber *, NSValue *> *stack) {
+    Address address = 0;
+    if (!SRKLifterStoreAddress(lifter, state, &address) || !SRKIsStackAddress(address)) return;
+
+    uint32_t size = SRKStackAccessSize(lifter);
+    const char *mnemonic = lifter->disasm.instruction.mnemonic;
+    BOOL pair = lifter->arch == SRKArchitectureARM64 && (strncmp(mnemonic, "stp", 3) == 0 || strncmp(mnemonic, "stnp", 4) == 0);
+
+    SRKRegisterValue value;
+    if (!SRKLifterStoredValue(lifter, state, &value)) {
+        // A SIMD register or anything else the lifter does not track
+        SRKStackClear(stack, address, pair ? size * 2 : size);
+        return;
+    }
+    SRKStackStore(stack, address, value, size);
+
+    // stp/stnp store their second register right after the first
+    SRKRegisterValue second;
+    if (pair && SRKLifterOperandValue(lifter, state, 1, &second)) {
+        SRKStackStore(stack, address + size, second, size);
+    }
+}
+
+/// Value a load of size bytes at address reads back, when the frame holds it
+static BOOL SRKStackLoad(NSDictionary<NSNumber *, NSValue *> *stack, Address address, uint32_t size, SRKRegisterValue *value) {
+    SRKStackSlot slot;
+    if (SRKStackSlotAt(stack, address, &slot) && slot.size == size) {
+        *value = slot.value;
+        return YES;
+    }
+
+    uint8_t bytes[SRK_STACK_SLOT_MAX];
+    uint64_t mask = size >= 8 ? 0xFF : (1ULL << size) - 1;
+    if ((SRKStackReadBytes(stack, address, bytes, size) & mask) != mask) return NO;
+
+    memset(value, 0, sizeof(SRKRegisterValue));
+    value->known = YES;
+    for (uint32_t i = 0; i < size; i++) value->value |= (uint64_t)bytes[i] << (i * 8);
+    return YES;
+}
+
+BOOL SRKStackArgumentValue(SRKLifter *lifter, const SRKRegisterState *state,
+                           NSDictionary<NSNumber *, NSValue *> *stack, NSUInteger argumentIndex, uint32_t size,
+                           SRKRegisterValue *value) {
+    if (SRKArgumentRegister(lifter->arch, argumentIndex) != NSNotFound) {
+        *value = SRKArgumentValue(state, lifter->arch, argumentIndex);
+        return value->known;
+    }
+
+    NSUInteger registerArguments = lifter->arch == SRKArchitectureX86_64 ? 6 : 8;
+    NSUInteger stackRegister = lifter->arch == SRKArchitectureX86_64 ? DISASM_REG_INDEX_RSP : SRK_STACK_ARM64_SP;
+    SRKRegisterValue sp = state->regs[stackRegister];
+    if (!sp.known || !SRKIsStackAddress(sp.value)) return NO;
+
+    if (size == 0 || size > SRK_STACK_SLOT_MAX) size = SRK_STACK_SLOT_MAX;
+    return SRKStackLoad(stack, sp.value + (argumentIndex - registerArguments) * 8, size, value);
+}
+
+void SRKLiftProcedureWithStack(SRKLifter *lifter, NSObject<HPProcedure> *procedure,
+                               NSMutableDictionary<NSNumber *, NSValue *> *stack, SRKCallHandler handler) {
+    NSUInteger stackRegisters[2];
+    if (lifter->arch == SRKArchitectureARM64) {
+        stackRegisters[0] = SRK_STACK_ARM64_SP;
+        stackRegisters[1] = SRK_STACK_ARM64_FP;
+    } else {
+        stackRegisters[0] = DISASM_REG_INDEX_RSP;
+        stackRegisters[1] = DISASM_REG_INDEX_RBP;
+    }
+
+    // Last known stack and frame pointers, restored whenever the lifter loses them
+    SRKRegisterValue frameValues[2];
+    memset(frameValues, 0, sizeof(frameValues));
+    frameValues[0].known = YES;
+    frameValues[0].value = SRK_STACK_FRAME_BASE;
+    if (lifter->arch == SRKArchitectureX86_64) frameValues[1] = frameValues[0];
+
+    SRKRegisterState state;
+    SRKRegisterStateReset(&state);
+    Address previousStart = BAD_ADDRESS;
+    Address previousEnd = BAD_ADDRESS;
+
+    NSUInteger count = procedure.basicBlockCount;
+    for (NSUInteger i = 0; i < count; i++) {
+        NSObject<HPBasicBlock> *block = [procedure basicBlockAtIndex:i];
+        if (!block) continue;
+
+        // Registers follow SRKLiftProcedure; the frame is kept across blocks
+        NSArray<NSObject<HPBasicBlock> *> *predecessors = block.predecessors;
+        BOOL fallsThrough = (block.from == previousEnd && predecessors.count == 1 &&
+                             predecessors.firstObject.from == previousStart);
+        if (!fallsThrough) SRKRegisterStateReset(&state);
+
+        Address address = block.from;
+        BOOL stop = NO;
+        while (address < block.to && !stop) {
+            for (NSUInteger r = 0; r < 2; r++) {
+                if (!state.regs[stackRegisters[r]].known && frameValues[r].known) state.regs[stackRegisters[r]] = frameValues[r];
+            }
+
+            NSUInteger length = SRKLifterDecode(lifter, address);
+            if (length == 0) break;
+
+            SRKStackRecordStore(lifter, &state, stack);
+
+            Address loadAddress = 0;
+            NSUInteger loadRegister = NSNotFound;
+            BOOL stackLoad = SRKLifterLoadAddress(lifter, &state, &loadAddress, &loadRegister) &&
+                             SRKIsStackAddress(loadAddress) && loadRegister < SRK_MAX_REGISTERS;
+            uint32_t loadSize = stackLoad ? SRKStackAccessSize(lifter) : 0;
+
+            SRKLifterExecute(lifter, &state, handler, &stop);
+
+            // The lifter only reads the binary; reloads of spilled values come from the frame
+            SRKRegisterValue reloaded;
+            if (stackLoad && SRKStackLoad(stack, loadAddress, loadSize, &reloaded)) state.regs[loadRegister] = reloaded;
+
+            for (NSUInteger r = 0; r < 2; r++) {
+                if (state.regs[stackRegisters[r]].known) frameValues[r] = state.regs[stackRegisters[r]];
+            }
+            address += length;
+        }
+        if (stop) return;
+
+        previousStart = block.from;
+        previousEnd = block.to;
+    }
+}
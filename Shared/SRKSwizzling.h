@@ -0,0 +1,32 @@
+/*
+ SRKSwizzling.h
+ Objective-C method swizzling recovery for HopperSRK analyzers
+
+ Follows the Method values returned by class_getInstanceMethod /
+ class_getClassMethod (with classes from classrefs, objc_getClass or
+ NSClassFromString and selectors from selrefs, sel_registerName or
+ NSSelectorFromString) into method_exchangeImplementations,
+ method_setImplementation and class_replaceMethod, so every swizzle call
+ site is reported with the methods it actually swaps.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+/**
+ * One entry per swizzling call site, sorted by address:
+ * @{@"address", @"procedure", @"function", @"method", @"replacement"}
+ * method and replacement are "-[Class selector]" / "+[Class selector]"
+ * descriptions ("+" for methods of a metaclass, from objc_getMetaClass,
+ * object_getClass of a class or a metaclass reference), with "?" for the
+ * parts that could not be recovered; a
+ * replacement implementation is described by its name or address.
+ */
+NSArray<NSDictionary *> *SRKFindMethodSwizzles(NSObject<HPDisassembledFile> *file, NSDictionary *index);
+
+NS_ASSUME_NONNULL_END
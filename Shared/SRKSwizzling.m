@@ -0,0 +1,228 @@
+/*
+ SRKSwizzling.m
+ Objective-C method swizzling recovery for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKSwizzling.h"
+
+// Classes, selectors and Methods produced by runtime calls are tracked as
+// synthetic register values above this base, far from any mapped address
+#define SRK_SWIZZLE_TOKEN_BASE 0x5357000000000000ULL
+
+// class_ro_t.flags bit set on metaclasses
+#define SRK_OBJC_RO_META       0x1
+
+static NSSet<NSString *> *SRKSwizzleFunctions(void) {
+    return [NSSet setWithArray:@[@"method_exchangeImplementations", @"method_setImplementation", @"class_replaceMethod"]];
+}
+
+static NSSet<NSString *> *SRKClassLookupFunctions(void) {
+    return [NSSet setWithArray:@[@"objc_getClass", @"objc_lookUpClass", @"objc_getRequiredClass",
+                                 @"objc_getMetaClass", @"NSClassFromString"]];
+}
+
+static NSSet<NSString *> *SRKSelectorLookupFunctions(void) {
+    return [NSSet setWithArray:@[@"sel_registerName", @"sel_getUid", @"NSSelectorFromString"]];
+}
+
+static NSSet<NSString *> *SRKSwizzlePassthroughFunctions(void) {
+    // Return their first argument as far as class tracking is concerned
+    return [NSSet setWithArray:@[@"objc_opt_class", @"objc_opt_self", @"objc_retain",
+                                 @"objc_retainAutoreleasedReturnValue", @"objc_claimAutoreleasedReturnValue",
+                                 @"objc_unsafeClaimAutoreleasedReturnValue"]];
+}
+
+static SRKRegisterValue SRKSwizzleToken(NSMutableDictionary<NSNumber *, NSDictionary *> *tokens, NSDictionary *meaning) {
+    SRKRegisterValue value;
+    memset(&value, 0, sizeof(SRKRegisterValue));
+    value.known = YES;
+    value.value = SRK_SWIZZLE_TOKEN_BASE + tokens.count;
+    tokens[@(value.value)] = meaning;
+    return value;
+}
+
+static NSDictionary *SRKSwizzleTokenMeaning(NSDictionary<NSNumber *, NSDictionary *> *tokens, SRKRegisterValue value) {
+    return value.known ? tokens[@(value.value)] : nil;
+}
+
+static NSString *SRKSwizzleClassName(NSObject<HPDisassembledFile> *file, NSDictionary *tokens, SRKRegisterValue value) {
+    NSString *className = SRKSwizzleTokenMeaning(tokens, value)[@"class"];
+    if (className) return className;
+
+    if (value.objcClass != 0) {
+        return SRKObjCClassNameAtAddress(file, value.objcClass);
+    }
+    if (value.known && SRKSectionNameContains(file, value.value, @"objc_data")) {
+        return SRKObjCClassNameAtAddress(file, value.value);
+    }
+    return nil;
+}
+
+/// Whether the tracked class is a metaclass, whose methods are class methods
+static BOOL SRKSwizzleIsMetaClass(NSObject<HPDisassembledFile> *file, NSDictionary *tokens, SRKRegisterValue value) {
+    NSDictionary *meaning = SRKSwizzleTokenMeaning(tokens, value);
+    if (meaning) return [meaning[@"meta"] boolValue];
+
+    Address classAddress = value.objcClass;
+    if (classAddress == 0 && value.known && SRKSectionNameContains(file, value.value, @"objc_data")) {
+        classAddress = value.value;
+    }
+    if (classAddress == 0) return NO;
+    if (SRKSectionNameContains(file, classAddress, @"classrefs") || SRKSectionNameContains(file, classAddress, @"superrefs")) {
+        classAddress = SRKReadPointer(file, classAddress);
+        if (classAddress == 0) return NO;
+    }
+
+    if ([[file nameForVirtualAddress:classAddress] containsString:@"OBJC_METACLASS_$_"]) return YES;
+
+    // class_t.data -> class_ro_t.flags
+    Address classRO = SRKReadPointer(file, classAddress + 32) & ~(Address)7;
+    return classRO != 0 && ([file readUInt32AtVirtualAddress:classRO] & SRK_OBJC_RO_META) != 0;
+}
+
+static NSString *SRKSwizzleSelector(NSObject<HPDisassembledFile> *file, NSDictionary *tokens, SRKRegisterValue value) {
+    NSString *selector = SRKSwizzleTokenMeaning(tokens, value)[@"selector"];
+    return selector ?: SRKStringForValue(file, value);
+}
+
+static NSString *SRKSwizzleMethodDescription(BOOL classMethod, NSString *className, NSString *selector) {
+    return [NSString stringWithFormat:@"%@[%@ %@]", classMethod ? @"+" : @"-", className ?: @"?", selector ?: @"?"];
+}
+
+static NSString *SRKSwizzleImplementation(NSObject<HPDisassembledFile> *file, NSDictionary *tokens, SRKRegisterValue value) {
+    NSDictionary *meaning = SRKSwizzleTokenMeaning(tokens, value);
+    if (meaning[@"imp"]) return meaning[@"imp"];
+    if (!value.known) return @"?";
+
+    NSString *name = [file nameForVirtualAddress:value.value];
+    return name.length > 0 ? name : [NSString stringWithFormat:@"0x%llx", value.value];
+}
+
+#pragma mark - Swizzle Recovery
+
+NSArray<NSDictionary *> *SRKFindMethodSwizzles(NSObject<HPDisassembledFile> *file, NSDictionary *index) {
+    NSSet<NSString *> *swizzleFunctions = SRKSwizzleFunctions();
+    NSMutableArray<NSDictionary *> *swizzles = [NSMutableArray array];
+
+    // Only procedures calling a swizzling function are lifted
+    NSDictionary<NSNumber *, NSString *> *sites = SRKCallSiteAddresses(file, index, swizzleFunctions.allObjects);
+    NSMutableSet<NSNumber *> *procedureEntries = [NSMutableSet set];
+    for (NSNumber *site in sites) {
+        NSObject<HPProcedure> *procedure = SRKProcedureContaining(file, index, site.unsignedLongLongValue);
+        if (procedure) {
+            [procedureEntries addObject:@([procedure entryPoint])];
+        }
+    }
+    if (procedureEntries.count == 0) return swizzles;
+
+    NSObject<CPUContext> *cpu = [file buildCPUContext];
+    SRKLifter lifter;
+    SRKLifterInit(&lifter, file, cpu);
+    if (lifter.arch == SRKArchitectureUnknown) return swizzles;
+
+    NSSet<NSString *> *classLookups = SRKClassLookupFunctions();
+    NSSet<NSString *> *selectorLookups = SRKSelectorLookupFunctions();
+    NSSet<NSString *> *passthrough = SRKSwizzlePassthroughFunctions();
+    NSMutableDictionary<NSNumber *, NSDictionary *> *tokens = [NSMutableDictionary dictionary];
+    NSMutableSet<NSNumber *> *reported = [NSMutableSet set];
+
+    for (NSNumber *entry in [procedureEntries.allObjects sortedArrayUsingSelector:@selector(compare:)]) {
+        NSObject<HPProcedure> *procedure = [file procedureAt:entry.unsignedLongLongValue];
+        if (!procedure) continue;
+
+        SRKLiftProcedure(&lifter, procedure, ^(SRKLifter *callLifter, Address callAddress, NSString *callee,
+                                               SRKRegisterState *state, BOOL *stop) {
+            if (!callee) return;
+
+            SRKArchitecture arch = callLifter->arch;
+            SRKRegisterValue first = SRKArgumentValue(state, arch, 0);
+            SRKRegisterValue second = SRKArgumentValue(state, arch, 1);
+
+            if ([passthrough containsObject:callee] ||
+                ([callee hasPrefix:@"objc_msgSend"] &&
+                 ([callee isEqualToString:@"objc_msgSend$class"] ||
+                  [SRKStringForValue(file, second) isEqualToString:@"class"]))) {
+                state->result = first;
+                return;
+            }
+
+            if ([classLookups containsObject:callee]) {
+                NSString *className = SRKStringForValue(file, first);
+                if (className) {
+                    state->result = SRKSwizzleToken(tokens, @{@"class": className,
+                                                              @"meta": @([callee isEqualToString:@"objc_getMetaClass"])});
+                }
+                return;
+            }
+
+            // The class of a class object is its metaclass; of anything else, treat it as the class itself
+            if ([callee isEqualToString:@"object_getClass"]) {
+                NSString *className = SRKSwizzleClassName(file, tokens, first);
+                state->result = className ? SRKSwizzleToken(tokens, @{@"class": className, @"meta": @YES}) : first;
+                return;
+            }
+
+            if ([selectorLookups containsObject:callee]) {
+                NSString *selector = SRKStringForValue(file, first);
+                if (selector) state->result = SRKSwizzleToken(tokens, @{@"selector": selector});
+                return;
+            }
+
+            if ([callee isEqualToString:@"class_getInstanceMethod"] || [callee isEqualToString:@"class_getClassMethod"]) {
+                BOOL classMethod = [callee isEqualToString:@"class_getClassMethod"] ||
+                                   SRKSwizzleIsMetaClass(file, tokens, first);
+                NSString *method = SRKSwizzleMethodDescription(classMethod, SRKSwizzleClassName(file, tokens, first),
+                                                               SRKSwizzleSelector(file, tokens, second));
+                state->result = SRKSwizzleToken(tokens, @{@"method": method});
+                return;
+            }
+
+            if ([callee isEqualToString:@"method_getImplementation"]) {
+                NSString *method = SRKSwizzleTokenMeaning(tokens, first)[@"method"];
+                if (method) state->result = SRKSwizzleToken(tokens, @{@"imp": [@"IMP of " stringByAppendingString:method]});
+                return;
+            }
+
+            if ([callee isEqualToString:@"class_getMethodImplementation"]) {
+                NSString *method = SRKSwizzleMethodDescription(SRKSwizzleIsMetaClass(file, tokens, first),
+                                                               SRKSwizzleClassName(file, tokens, first),
+                                                               SRKSwizzleSelector(file, tokens, second));
+                state->result = SRKSwizzleToken(tokens, @{@"imp": [@"IMP of " stringByAppendingString:method]});
+                return;
+            }
+
+            if (![swizzleFunctions containsObject:callee] || [reported containsObject:@(callAddress)]) return;
+            [reported addObject:@(callAddress)];
+
+            NSString *method;
+            NSString *replacement;
+            if ([callee isEqualToString:@"class_replaceMethod"]) {
+                method = SRKSwizzleMethodDescription(SRKSwizzleIsMetaClass(file, tokens, first),
+                                                     SRKSwizzleClassName(file, tokens, first),
+                                                     SRKSwizzleSelector(file, tokens, second));
+                replacement = SRKSwizzleImplementation(file, tokens, SRKArgumentValue(state, arch, 2));
+            } else if ([callee isEqualToString:@"method_setImplementation"]) {
+                method = SRKSwizzleTokenMeaning(tokens, first)[@"method"] ?: @"?";
+                replacement = SRKSwizzleImplementation(file, tokens, second);
+            } else {
+                method = SRKSwizzleTokenMeaning(tokens, first)[@"method"] ?: @"?";
+                replacement = SRKSwizzleTokenMeaning(tokens, second)[@"method"] ?: @"?";
+            }
+
+            [swizzles addObject:@{
+                @"address": @(callAddress),
+                @"procedure": entry,
+                @"function": callee,
+                @"method": method,
+                @"replacement": replacement
+            }];
+        });
+    }
+
+    [swizzles sortUsingDescriptors:@[[NSSortDescriptor sortDescriptorWithKey:@"address" ascending:YES]]];
+    return swizzles;
+}
@@ -0,0 +1,65 @@
+/*
+ SRKThreatIntel.h
+ Threat-intel domain and IP blocklist matching for HopperSRK analyzers
+
+ Blocklists are plain text files in the threat intel directory (one domain,
+ IP address or CIDR range per line, hosts-file lines accepted, "#" starts a
+ comment); the file name is the source tag reported with a hit. They are
+ compiled once into a single file that is memory mapped at analysis time,
+ so opening millions of entries costs one mmap:
+ - Domains: a trie over the reversed labels (com -> example -> www), nodes
+   in breadth-first order with the children of a node contiguous and sorted,
+   so a lookup is a binary search per label and a listed domain matches all
+   of its subdomains
+ - Addresses: CIDR ranges (IPv4 mapped into IPv6) in prefix tree preorder,
+   each with a link to its enclosing range, so a lookup is a binary search
+   plus a walk up to the most specific range holding the address
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// ~/Library/Application Support/HopperSRK/ThreatIntel
+NSString *SRKThreatIntelDirectory(void);
+
+/**
+ * Compiles the *.txt blocklists of the directory into its mapped file.
+ * counts receives @{@"domains", @"ranges", @"sources"}.
+ */
+BOOL SRKCompileThreatIntel(NSString *directory, NSDictionary * _Nullable * _Nullable counts, NSError **error);
+
+/// Maps the compiled blocklists of the directory, nil when there are none
+NSDictionary * _Nullable SRKOpenThreatIntel(NSString *directory);
+
+#pragma mark - Lookups
+
+/**
+ * Source index of the listed domain that is the domain or one of its parents,
+ * -1 when none is. matchedOffset receives where the listed suffix starts.
+ * The domain is compared case-insensitively; a trailing dot is ignored.
+ */
+NSInteger SRKThreatIntelDomainSource(NSDictionary *intel, const char *domain, size_t length,
+                                     size_t * _Nullable matchedOffset);
+
+/**
+ * Source index of the most specific listed range holding the IPv6 address
+ * (IPv4 as ::ffff:a.b.c.d), -1 when none does. prefixLength receives its
+ * prefix length in IPv6 bits.
+ */
+NSInteger SRKThreatIntelAddressSource(NSDictionary *intel, const uint8_t address[_Nonnull 16],
+                                      uint8_t * _Nullable prefixLength);
+
+/// Source tag of a source index
+NSString *SRKThreatIntelSourceName(NSDictionary *intel, NSInteger source);
+
+/**
+ * Checks an indicator (IP address, domain or URL):
+ * @{@"indicator", @"kind": @"ip"/@"domain", @"source", @"match": listed domain or CIDR}
+ * or nil when nothing lists it
+ */
+NSDictionary * _Nullable SRKThreatIntelMatch(NSDictionary *intel, NSString *indicator);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,548 @@
+/*
+ SRKThreatIntel.m
+ Threat-intel domain and IP blocklist matching for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import <arpa/inet.h>
+#import "SRKThreatIntel.h"
+#import "SRKURLParser.h"
+
+#define SRK_INTEL_MAGIC "SRKTI01"
+// Longest domain name, without the trailing dot
+#define SRK_INTEL_MAX_DOMAIN 253
+// Sorts below every label character, so sorted keys group by label
+#define SRK_INTEL_SEPARATOR '\x01'
+// Range without an enclosing range
+#define SRK_INTEL_NO_PARENT UINT32_MAX
+
+static NSString *const SRKThreatIntelFile = @"threatintel.bin";
+
+typedef struct {
+    char magic[8];
+    uint32_t nodeCount;
+    uint32_t labelBytes;
+    uint32_t rangeCount;
+    uint32_t sourceBytes;
+    uint64_t nodesOffset;
+    uint64_t labelsOffset;
+    uint64_t rangesOffset;
+    uint64_t sourcesOffset;
+} SRKIntelHeader;
+
+typedef struct {
+    uint32_t firstChild;
+    uint32_t childCount;
+    /// Offset of the label in the label blob
+    uint32_t label;
+    uint16_t labelLength;
+    /// Listing source + 1, 0 when the domain itself is not listed
+    uint16_t source;
+} SRKIntelNode;
+
+typedef struct {
+    uint64_t high;
+    uint64_t low;
+    uint32_t parent;
+    uint16_t source;
+    uint8_t prefixLength;
+    uint8_t reserved;
+} SRKIntelRange;
+
+#pragma mark - Addresses
+
+static void SRKAddressHalves(const uint8_t *address, uint64_t *high, uint64_t *low) {
+    *high = 0;
+    *low = 0;
+    for (NSUInteger i = 0; i < 8; i++) {
+        *high = (*high << 8) | address[i];
+        *low = (*low << 8) | address[i + 8];
+    }
+}
+
+static void SRKMaskHalves(uint64_t *high, uint64_t *low, uint8_t prefixLength) {
+    if (prefixLength < 64) {
+        *high &= prefixLength == 0 ? 0 : ~0ULL << (64 - prefixLength);
+        *low = 0;
+    } else if (prefixLength < 128) {
+        *low &= prefixLength == 64 ? 0 : ~0ULL << (128 - prefixLength);
+    }
+}
+
+static BOOL SRKRangeContains(const SRKIntelRange *range, uint64_t high, uint64_t low) {
+    SRKMaskHalves(&high, &low, range->prefixLength);
+    return high == range->high && low == range->low;
+}
+
+/// "a.b.c.d", "a.b.c.d/n", IPv6 and IPv6/n, as an IPv6 address and prefix length
+static BOOL SRKParseAddress(const char *text, uint8_t *address, uint8_t *prefixLength) {
+    char buffer[INET6_ADDRSTRLEN + 8];
+    if (strlen(text) >= sizeof(buffer)) return NO;
+    strcpy(buffer, text);
+
+    long prefix = -1;
+    char *slash = strchr(buffer, '/');
+    if (slash) {
+        char *end = NULL;
+        *slash = '\0';
+        prefix = strtol(slash + 1, &end, 10);
+        if (end == slash + 1 || *end != '\0' || prefix < 0) return NO;
+    }
+
+    struct in_addr v4;
+    if (inet_pton(AF_INET, buffer, &v4) == 1) {
+        if (prefix > 32) return NO;
+        memset(address, 0, 10);
+        address[10] = 0xFF;
+        address[11] = 0xFF;
+        memcpy(address + 12, &v4, 4);
+        *prefixLength = (uint8_t)(96 + (prefix < 0 ? 32 : prefix));
+        return YES;
+    }
+    if (inet_pton(AF_INET6, buffer, address) == 1) {
+        if (prefix > 128) return NO;
+        *prefixLength = (uint8_t)(prefix < 0 ? 128 : prefix);
+        return YES;
+    }
+    return NO;
+}
+
+static NSString *SRKFormatRange(const uint8_t *address, uint8_t prefixLength) {
+    uint8_t network[16];
+    memcpy(network, address, 16);
+    for (NSUInteger bit = prefixLength; bit < 128; bit++) {
+        network[bit / 8] &= (uint8_t)~(0x80 >> (bit % 8));
+    }
+
+    static const uint8_t mappedPrefix[12] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xFF, 0xFF};
+    char text[INET6_ADDRSTRLEN];
+    if (prefixLength >= 96 && memcmp(network, mappedPrefix, 12) == 0) {
+        inet_ntop(AF_INET, network + 12, text, sizeof(text));
+        return [NSString stringWithFormat:@"%s/%u", text, prefixLength - 96];
+    }
+    inet_ntop(AF_INET6, network, text, sizeof(text));
+    return [NSString stringWithFormat:@"%s/%u", text, prefixLength];
+}
+
+#pragma mark - Compiling
+
+NSString *SRKThreatIntelDirectory(void) {
+    NSString *support = NSSearchPathForDirectoriesInDomains(NSApplicationSupportDirectory, NSUserDomainMask, YES).firstObject;
+    if (!support) support = [NSHomeDirectory() stringByAppendingPathComponent:@"Library/Application Support"];
+    return [support stringByAppendingPathComponent:@"HopperSRK/ThreatIntel"];
+}
+
+typedef struct {
+    const char *key;
+    uint32_t length;
+    uint16_t source;
+} SRKIntelKey;
+
+typedef struct {
+    uint32_t lo;
+    uint32_t hi;
+    uint32_t offset;
+    uint32_t node;
+} SRKIntelPending;
+
+static int SRKCompareBytes(const char *a, size_t aLength, const char *b, size_t bLength) {
+    int order = memcmp(a, b, MIN(aLength, bLength));
+    if (order != 0) return order;
+    return aLength < bLength ? -1 : (aLength > bLength ? 1 : 0);
+}
+
+static int SRKCompareIntelKeys(const void *a, const void *b) {
+    const SRKIntelKey *left = a;
+    const SRKIntelKey *right = b;
+    int order = SRKCompareBytes(left->key, left->length, right->key, right->length);
+    return order != 0 ? order : (left->source < right->source ? -1 : (left->source > right->source ? 1 : 0));
+}
+
+static int SRKCompareIntelRanges(const void *a, const void *b) {
+    const SRKIntelRange *left = a;
+    const SRKIntelRange *right = b;
+    if (left->high != right->high) return left->high < right->high ? -1 : 1;
+    if (left->low != right->low) return left->low < right->low ? -1 : 1;
+    if (left->prefixLength != right->prefixLength) return left->prefixLength < right->prefixLength ? -1 : 1;
+    return left->source < right->source ? -1 : (left->source > right->source ? 1 : 0);
+}
+
+/// Appends the reversed-label key of a blocklist domain ("www.example.com" -> "com\1example\1www")
+static BOOL SRKAppendDomainKey(NSMutableData *keys, const char *domain, size_t length) {
+    while (length > 0 && domain[length - 1] == '.') length--;
+    if (length >= 2 && domain[0] == '*' && domain[1] == '.') {
+        domain += 2;
+        length -= 2;
+    }
+    while (length > 0 && domain[0] == '.') {
+        domain++;
+        length--;
+    }
+    if (length == 0 || length > SRK_INTEL_MAX_DOMAIN || !memchr(domain, '.', length)) return NO;
+
+    char key[SRK_INTEL_MAX_DOMAIN];
+    size_t written = 0;
+    size_t end = length;
+    while (end > 0) {
+        size_t start = end;
+        while (start > 0 && domain[start - 1] != '.') start--;
+        if (end - start == 0 || end - start > 63) return NO;
+
+        if (written > 0) key[written++] = SRK_INTEL_SEPARATOR;
+        for (size_t i = start; i < end; i++) {
+            char c = (char)tolower((unsigned char)domain[i]);
+            if (!isalnum((unsigned char)c) && c != '-' && c != '_') return NO;
+            key[written++] = c;
+        }
+        end = start > 0 ? start - 1 : 0;
+    }
+
+    [keys appendBytes:key length:written];
+    return YES;
+}
+
+/// Nodes and labels of the reversed-label trie over the sorted keys
+static void SRKBuildDomainTrie(SRKIntelKey *keys, NSUInteger count, NSMutableData *nodes, NSMutableData *labels) {
+    SRKIntelNode root = {0, 0, 0, 0, 0};
+    [nodes appendBytes:&root length:sizeof(SRKIntelNode)];
+    if (count == 0) return;
+
+    NSMutableDictionary<NSData *, NSNumber *> *labelOffsets = [NSMutableDictionary dictionary];
+    NSMutableData *pending = [NSMutableData data];
+    SRKIntelPending first = {0, (uint32_t)count, 0, 0};
+    [pending appendBytes:&first length:sizeof(SRKIntelPending)];
+
+    // Breadth first, so the children of each node are appended next to each other
+    for (NSUInteger head = 0; head < pending.length / sizeof(SRKIntelPending); head++) {
+        SRKIntelPending current = ((const SRKIntelPending *)pending.bytes)[head];
+
+        // A listed domain sorts before its subdomains, which it already covers
+        if (keys[current.lo].length < current.offset) {
+            ((SRKIntelNode *)nodes.mutableBytes)[current.node].source = keys[current.lo].source + 1;
+            continue;
+        }
+
+        uint32_t firstChild = (uint32_t)(nodes.length / sizeof(SRKIntelNode));
+        uint32_t childCount = 0;
+        for (uint32_t i = current.lo; i < current.hi;) {
+            const char *label = keys[i].key + current.offset;
+            const char *separator = memchr(label, SRK_INTEL_SEPARATOR, keys[i].length - current.offset);
+            uint32_t labelLength = separator ? (uint32_t)(separator - label) : keys[i].length - current.offset;
+            uint32_t next = current.offset + labelLength;
+
+            uint32_t j = i + 1;
+            while (j < current.hi && keys[j].length >= next && memcmp(keys[j].key + current.offset, label, labelLength) == 0 &&
+                   (keys[j].length == next || keys[j].key[next] == SRK_INTEL_SEPARATOR)) {
+                j++;
+            }
+
+            NSData *labelData = [NSData dataWithBytes:label length:labelLength];
+            NSNumber *labelOffset = labelOffsets[labelData];
+            if (!labelOffset) {
+                labelOffset = @(labels.length);
+                labelOffsets[labelData] = labelOffset;
+                [labels appendData:labelData];
+            }
+
+            SRKIntelNode child = {0, 0, labelOffset.unsignedIntValue, (uint16_t)labelLength, 0};
+            SRKIntelPending childPending = {i, j, next + 1, (uint32_t)(nodes.length / sizeof(SRKIntelNode))};
+            [nodes appendBytes:&child length:sizeof(SRKIntelNode)];
+            [pending appendBytes:&childPending length:sizeof(SRKIntelPending)];
+            childCount++;
+            i = j;
+        }
+
+        SRKIntelNode *node = &((SRKIntelNode *)nodes.mutableBytes)[current.node];
+        node->firstChild = firstChild;
+        node->childCount = childCount;
+    }
+}
+
+/// Sorted, deduplicated ranges with their enclosing range linked
+static void SRKLinkRanges(NSMutableData *ranges) {
+    SRKIntelRange *list = ranges.mutableBytes;
+    NSUInteger count = ranges.length / sizeof(SRKIntelRange);
+    qsort(list, count, sizeof(SRKIntelRange), SRKCompareIntelRanges);
+
+    NSUInteger unique = 0;
+    for (NSUInteger i = 0; i < count; i++) {
+        if (unique > 0 && list[unique - 1].high == list[i].high && list[unique - 1].low == list[i].low &&
+            list[unique - 1].prefixLength == list[i].prefixLength) {
+            continue;
+        }
+        list[unique++] = list[i];
+    }
+    ranges.length = unique * sizeof(SRKIntelRange);
+    list = ranges.mutableBytes;
+
+    // CIDR ranges nest or are disjoint, so the enclosing ranges form a stack
+    uint32_t *stack = malloc(MAX(unique, 1) * sizeof(uint32_t));
+    NSUInteger depth = 0;
+    for (NSUInteger i = 0; stack && i < unique; i++) {
+        while (depth > 0 && !SRKRangeContains(&list[stack[depth - 1]], list[i].high, list[i].low)) depth--;
+        list[i].parent = depth > 0 ? stack[depth - 1] : SRK_INTEL_NO_PARENT;
+        stack[depth++] = (uint32_t)i;
+    }
+    free(stack);
+}
+
+static void SRKAppendPadded(NSMutableData *file, NSData *data, uint64_t *offset) {
+    *offset = file.length;
+    [file appendData:data];
+    NSUInteger padding = (8 - file.length % 8) % 8;
+    [file increaseLengthBy:padding];
+}
+
+BOOL SRKCompileThreatIntel(NSString *directory, NSDictionary **counts, NSError **error) {
+    NSArray<NSString *> *names = [[[NSFileManager defaultManager] contentsOfDirectoryAtPath:directory error:error]
+                                  sortedArrayUsingSelector:@selector(compare:)];
+    if (!names) return NO;
+
+    NSMutableArray<NSString *> *sources = [NSMutableArray array];
+    NSMutableData *keyBytes = [NSMutableData data];
+    NSMutableData *keyEntries = [NSMutableData data];
+    NSMutableData *ranges = [NSMutableData data];
+
+    for (NSString *name in names) {
+        if (![name.pathExtension isEqualToString:@"txt"] || sources.count >= UINT16_MAX - 1) continue;
+
+        NSData *data = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:name]
+                                              options:NSDataReadingMappedIfSafe error:nil];
+        if (!data) continue;
+        uint16_t source = (uint16_t)sources.count;
+        [sources addObject:name.stringByDeletingPathExtension];
+
+        const char *bytes = data.bytes;
+        const char *end = bytes + data.length;
+        for (const char *line = bytes; line < end;) {
+            const char *newline = memchr(line, '\n', (size_t)(end - line));
+            const char *lineEnd = newline ?: end;
+            const char *comment = memchr(line, '#', (size_t)(lineEnd - line));
+            const char *contentEnd = comment ?: lineEnd;
+
+            // The last field, so hosts-file lines ("0.0.0.0 example.com") give their domain
+            while (contentEnd > line && isspace((unsigned char)contentEnd[-1])) contentEnd--;
+            const char *field = contentEnd;
+            while (field > line && !isspace((unsigned char)field[-1])) field--;
+            size_t length = (size_t)(contentEnd - field);
+            line = lineEnd + 1;
+            if (length == 0 || length > SRK_INTEL_MAX_DOMAIN) continue;
+
+            char token[SRK_INTEL_MAX_DOMAIN + 1];
+            memcpy(token, field, length);
+            token[length] = '\0';
+
+            uint8_t address[16];
+            uint8_t prefixLength = 0;
+            if (SRKParseAddress(token, address, &prefixLength)) {
+                SRKIntelRange range = {0, 0, SRK_INTEL_NO_PARENT, source, prefixLength, 0};
+                SRKAddressHalves(address, &range.high, &range.low);
+                SRKMaskHalves(&range.high, &range.low, prefixLength);
+                [ranges appendBytes:&range length:sizeof(SRKIntelRange)];
+                continue;
+            }
+
+            NSUInteger offset = keyBytes.length;
+            if (SRKAppendDomainKey(keyBytes, token, length)) {
+                SRKIntelKey key = {(const char *)(uintptr_t)offset, (uint32_t)(keyBytes.length - offset), source};
+                [keyEntries appendBytes:&key length:sizeof(SRKIntelKey)];
+            }
+        }
+    }
+
+    // Key offsets become pointers once the key bytes stop growing
+    SRKIntelKey *keys = keyEntries.mutableBytes;
+    NSUInteger keyCount = keyEntries.length / sizeof(SRKIntelKey);
+    for (NSUInteger i = 0; i < keyCount; i++) {
+        keys[i].key = (const char *)keyBytes.bytes + (uintptr_t)keys[i].key;
+    }
+    qsort(keys, keyCount, sizeof(SRKIntelKey), SRKCompareIntelKeys);
+
+    NSMutableData *nodes = [NSMutableData data];
+    NSMutableData *labels = [NSMutableData data];
+    SRKBuildDomainTrie(keys, keyCount, nodes, labels);
+    SRKLinkRanges(ranges);
+    NSData *sourceBytes = [[sources componentsJoinedByString:@"\n"] dataUsingEncoding:NSUTF8StringEncoding];
+
+    SRKIntelHeader header;
+    memset(&header, 0, sizeof(SRKIntelHeader));
+    memcpy(header.magic, SRK_INTEL_MAGIC, sizeof(header.magic));
+    header.nodeCount = (uint32_t)(nodes.length / sizeof(SRKIntelNode));
+    header.labelBytes = (uint32_t)labels.length;
+    header.rangeCount = (uint32_t)(ranges.length / sizeof(SRKIntelRange));
+    header.sourceBytes = (uint32_t)sourceBytes.length;
+
+    NSMutableData *file = [NSMutableData dataWithLength:sizeof(SRKIntelHeader)];
+    SRKAppendPadded(file, nodes, &header.nodesOffset);
+    SRKAppendPadded(file, labels, &header.labelsOffset);
+    SRKAppendPadded(file, ranges, &header.rangesOffset);
+    SRKAppendPadded(file, sourceBytes, &header.sourcesOffset);
+    [file replaceBytesInRange:NSMakeRange(0, sizeof(SRKIntelHeader)) withBytes:&header];
+
+    if (counts) {
+        NSUInteger listed = 0;
+        const SRKIntelNode *list = nodes.bytes;
+        for (NSUInteger i = 0; i < header.nodeCount; i++) {
+            if (list[i].source) listed++;
+        }
+        *counts = @{@"domains": @(listed), @"ranges": @(header.rangeCount), @"sources": @(sources.count)};
+    }
+    return [file writeToFile:[directory stringByAppendingPathComponent:SRKThreatIntelFile]
+                     options:NSDataWritingAtomic error:error];
+}
+
+#pragma mark - Lookups
+
+NSDictionary *SRKOpenThreatIntel(NSString *directory) {
+    NSData *data = [NSData dataWithContentsOfFile:[directory stringByAppendingPathComponent:SRKThreatIntelFile]
+                                          options:NSDataReadingMappedAlways error:nil];
+    if (data.length < sizeof(SRKIntelHeader)) return nil;
+
+    const SRKIntelHeader *header = data.bytes;
+    if (memcmp(header->magic, SRK_INTEL_MAGIC, sizeof(header->magic)) != 0) return nil;
+    if (header->nodeCount == 0 ||
+        header->nodesOffset + (uint64_t)header->nodeCount * sizeof(SRKIntelNode) > data.length ||
+        header->labelsOffset + header->labelBytes > data.length ||
+        header->rangesOffset + (uint64_t)header->rangeCount * sizeof(SRKIntelRange) > data.length ||
+        header->sourcesOffset + header->sourceBytes > data.length) {
+        return nil;
+    }
+
+    NSString *sourceText = [[NSString alloc] initWithBytes:(const char *)data.bytes + header->sourcesOffset
+                                                    length:header->sourceBytes encoding:NSUTF8StringEncoding];
+    return @{
+        @"data": data,
+        @"sources": sourceText.length > 0 ? [sourceText componentsSeparatedByString:@"\n"] : @[]
+    };
+}
+
+static const SRKIntelHeader *SRKIntelHeaderOf(NSDictionary *intel) {
+    NSData *data = intel[@"data"];
+    return data.length >= sizeof(SRKIntelHeader) ? data.bytes : NULL;
+}
+
+NSInteger SRKThreatIntelDomainSource(NSDictionary *intel, const char *domain, size_t length, size_t *matchedOffset) {
+    const SRKIntelHeader *header = SRKIntelHeaderOf(intel);
+    if (!header) return -1;
+    const SRKIntelNode *nodes = (const SRKIntelNode *)((const uint8_t *)header + header->nodesOffset);
+    const char *labels = (const char *)header + header->labelsOffset;
+
+    while (length > 0 && domain[length - 1] == '.') length--;
+    if (length == 0 || length > SRK_INTEL_MAX_DOMAIN) return -1;
+    char lower[SRK_INTEL_MAX_DOMAIN];
+    for (size_t i = 0; i < length; i++) lower[i] = (char)tolower((unsigned char)domain[i]);
+
+    // Rightmost label first, one binary search among the children per label
+    uint32_t node = 0;
+    size_t end = length;
+    for (;;) {
+        size_t start = end;
+        while (start > 0 && lower[start - 1] != '.') start--;
+        if (start == end) return -1;
+
+        uint32_t low = nodes[node].firstChild;
+        uint32_t high = low + nodes[node].childCount;
+        if (high > header->nodeCount) return -1;
+        uint32_t found = UINT32_MAX;
+        while (low < high) {
+            uint32_t middle = low + (high - low) / 2;
+            int order = SRKCompareBytes(labels + nodes[middle].label, nodes[middle].labelLength, lower + start, end - start);
+            if (order == 0) {
+                found = middle;
+                break;
+            }
+            if (order < 0) {
+                low = middle + 1;
+            } else {
+                high = middle;
+            }
+        }
+        if (found == UINT32_MAX) return -1;
+
+        node = found;
+        if (nodes[node].source) {
+            if (matchedOffset) *matchedOffset = start;
+            return nodes[node].source - 1;
+        }
+        if (start == 0) return -1;
+        end = start - 1;
+    }
+}
+
+NSInteger SRKThreatIntelAddressSource(NSDictionary *intel, const uint8_t address[16], uint8_t *prefixLength) {
+    const SRKIntelHeader *header = SRKIntelHeaderOf(intel);
+    if (!header || header->rangeCount == 0) return -1;
+    const SRKIntelRange *ranges = (const SRKIntelRange *)((const uint8_t *)header + header->rangesOffset);
+
+    uint64_t high;
+    uint64_t low;
+    SRKAddressHalves(address, &high, &low);
+
+    // Last range starting at or below the address; the ranges holding it are that one or its ancestors
+    uint32_t lower = 0;
+    uint32_t upper = header->rangeCount;
+    while (lower < upper) {
+        uint32_t middle = lower + (upper - lower) / 2;
+        if (ranges[middle].high < high || (ranges[middle].high == high && ranges[middle].low <= low)) {
+            lower = middle + 1;
+        } else {
+            upper = middle;
+        }
+    }
+
+    for (uint32_t r = lower > 0 ? lower - 1 : SRK_INTEL_NO_PARENT; r < header->rangeCount; r = ranges[r].parent) {
+        if (SRKRangeContains(&ranges[r], high, low)) {
+            if (prefixLength) *prefixLength = ranges[r].prefixLength;
+            return ranges[r].source;
+        }
+    }
+    return -1;
+}
+
+NSString *SRKThreatIntelSourceName(NSDictionary *intel, NSInteger source) {
+    NSArray<NSString *> *sources = intel[@"sources"];
+    return source >= 0 && (NSUInteger)source < sources.count ? sources[source] : @"unknown";
+}
+
+NSDictionary *SRKThreatIntelMatch(NSDictionary *intel, NSString *indicator) {
+    NSString *value = [indicator stringByTrimmingCharactersInSet:[NSCharacterSet whitespaceAndNewlineCharacterSet]];
+    const char *text = value.UTF8String;
+    if (!text || text[0] == '\0') return nil;
+
+    // URLs are matched by their host; templated hosts ("%@") match nothing
+    char host[SRK_INTEL_MAX_DOMAIN + 1];
+    if (strstr(text, "://")) {
+        SRKURLParts parts;
+        if (!SRKParseURL(text, strlen(text), NO, &parts) || parts.host.length == 0 ||
+            parts.host.length > SRK_INTEL_MAX_DOMAIN || (parts.flags & SRKURLTemplatedHost)) return nil;
+        memcpy(host, text + parts.host.offset, parts.host.length);
+        host[parts.host.length] = '\0';
+        text = host;
+    }
+
+    uint8_t address[16];
+    uint8_t prefixLength = 0;
+    if (!strchr(text, '/') && SRKParseAddress(text, address, &prefixLength)) {
+        NSInteger source = SRKThreatIntelAddressSource(intel, address, &prefixLength);
+        if (source < 0) return nil;
+        return @{
+            @"indicator": indicator,
+            @"kind": @"ip",
+            @"source": SRKThreatIntelSourceName(intel, source),
+            @"match": SRKFormatRange(address, prefixLength)
+        };
+    }
+
+    size_t matchedOffset = 0;
+    NSInteger source = SRKThreatIntelDomainSource(intel, text, strlen(text), &matchedOffset);
+    if (source < 0) return nil;
+    return @{
+        @"indicator": indicator,
+        @"kind": @"domain",
+        @"source": SRKThreatIntelSourceName(intel, source),
+        @"match": [[NSString stringWithUTF8String:text + matchedOffset] lowercaseString]
+    };
+}
@@ -0,0 +1,52 @@
+/*
+ SRKTrampolines.h
+ Inline hook and trampoline detection for HopperSRK analyzers
+
+ Matches absolute-jump trampolines (ldr x16, #8; br x16 / jmp [rip+0] /
+ movabs + jmp reg / push + ret) at procedure entry points and as byte
+ templates in data sections, and finds the procedures that make code
+ writable (vm_protect, mach_vm_protect, mprotect) to install them.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+#import <Hopper/Hopper.h>
+#import "SRKCallSites.h"
+
+NS_ASSUME_NONNULL_BEGIN
+
+typedef struct {
+    /// Bytes covered by the trampoline, literal target included
+    NSUInteger length;
+    /// Absolute target, 0 when it is a placeholder
+    Address target;
+    const char *kind;
+} SRKTrampolineMatch;
+
+/// Matches a trampoline at the start of bytes; pushRet also accepts the noisier push imm32; ret
+BOOL SRKMatchTrampoline(const uint8_t *bytes, NSUInteger available, SRKArchitecture arch,
+                        BOOL pushRet, SRKTrampolineMatch *match);
+
+/// Procedures starting with a trampoline: @{@"address", @"kind", @"target", @"name"?, @"target_name"?}
+NSArray<NSDictionary *> *SRKFindPrologueTrampolines(NSObject<HPDisassembledFile> *file, NSDictionary *index);
+
+/// Trampoline byte templates in data sections: @{@"address", @"section", @"kind", @"target"}
+NSArray<NSDictionary *> *SRKFindTrampolineTemplates(NSObject<HPDisassembledFile> *file);
+
+/**
+ * Procedures changing memory protection to writable code, or of a code address:
+ * @{@"procedure", @"name"?, @"protect", @"patches", @"trampolines"} where protect lists
+ * @{@"address", @"function", @"protection"?, @"target"?, @"size"?, @"trampolines"?} and
+ * patches the copy / vm_write / cache flush call sites of the same procedure as
+ * @{@"address", @"function", @"target"?, @"trampolines"?, @"template"?}.
+ *
+ * Each trampolines array holds the addresses of the given prologue trampolines the call
+ * writes or makes writable; template is the data template a copy reads from. The
+ * installer's own trampolines are those its patches write, else those it unprotects.
+ */
+NSArray<NSDictionary *> *SRKFindHookInstallers(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                               NSArray<NSDictionary *> *trampolines,
+                                               NSArray<NSDictionary *> *templates);
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,400 @@
+/*
+ SRKTrampolines.m
+ Inline hook and trampoline detection for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKTrampolines.h"
+
+// Longest trampoline matched, literal target included
+#define SRK_TRAMPOLINE_MAX_LENGTH   16
+// Procedure entries matched per dispatch_apply iteration
+#define SRK_TRAMPOLINE_CHUNK        1024
+
+#define SRK_VM_PROT_WRITE           0x02
+#define SRK_VM_PROT_EXECUTE         0x04
+#define SRK_VM_PROT_COPY            0x10
+
+// Protection changes of unknown size cover the page holding the target
+#define SRK_PAGE_SIZE_ARM64         0x4000
+#define SRK_PAGE_SIZE_X86_64        0x1000
+
+static uint64_t SRKReadLE64(const uint8_t *bytes) {
+    uint64_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+static uint32_t SRKReadLE32(const uint8_t *bytes) {
+    uint32_t value;
+    memcpy(&value, bytes, sizeof(value));
+    return value;
+}
+
+#pragma mark - Pattern Matching
+
+BOOL SRKMatchTrampoline(const uint8_t *bytes, NSUInteger available, SRKArchitecture arch,
+                        BOOL pushRet, SRKTrampolineMatch *match) {
+    if (arch == SRKArchitectureARM64) {
+        // ldr xN, #8; br xN; .quad target
+        if (available < 16) return NO;
+        uint32_t load = SRKReadLE32(bytes);
+        uint32_t branch = SRKReadLE32(bytes + 4);
+        if ((load & 0xFFFFFFE0) != 0x58000040) return NO;
+        if (branch != (0xD61F0000 | ((load & 0x1F) << 5))) return NO;
+
+        match->length = 16;
+        match->target = SRKReadLE64(bytes + 8);
+        match->kind = "ldr xN, #8; br xN";
+        return YES;
+    }
+
+    if (arch != SRKArchitectureX86_64) return NO;
+
+    // jmp qword [rip+0]; .quad target
+    if (available >= 14 && bytes[0] == 0xFF && bytes[1] == 0x25 && SRKReadLE32(bytes + 2) == 0) {
+        match->length = 14;
+        match->target = SRKReadLE64(bytes + 6);
+        match->kind = "jmp [rip+0]";
+        return YES;
+    }
+
+    // movabs rN, target; jmp rN (rax-rdi, then r8-r15)
+    if (available >= 12 && bytes[0] == 0x48 && (bytes[1] & 0xF8) == 0xB8 &&
+        bytes[10] == 0xFF && bytes[11] == (0xE0 | (bytes[1] & 7))) {
+        match->length = 12;
+        match->target = SRKReadLE64(bytes + 2);
+        match->kind = "movabs reg; jmp reg";
+        return YES;
+    }
+    if (available >= 13 && bytes[0] == 0x49 && (bytes[1] & 0xF8) == 0xB8 &&
+        bytes[10] == 0x41 && bytes[11] == 0xFF && bytes[12] == (0xE0 | (bytes[1] & 7))) {
+        match->length = 13;
+        match->target = SRKReadLE64(bytes + 2);
+        match->kind = "movabs reg; jmp reg";
+        return YES;
+    }
+
+    // push low32; mov dword [rsp+4], high32; ret
+    if (available >= 14 && bytes[0] == 0x68 && bytes[5] == 0xC7 && bytes[6] == 0x44 &&
+        bytes[7] == 0x24 && bytes[8] == 0x04 && bytes[13] == 0xC3) {
+        match->length = 14;
+        match->target = (Address)SRKReadLE32(bytes + 1) | ((Address)SRKReadLE32(bytes + 9) << 32);
+        match->kind = "push; mov [rsp+4]; ret";
+        return YES;
+    }
+
+    if (pushRet && available >= 6 && bytes[0] == 0x68 && bytes[5] == 0xC3) {
+        match->length = 6;
+        match->target = (Address)(int64_t)(int32_t)SRKReadLE32(bytes + 1);
+        match->kind = "push; ret";
+        return YES;
+    }
+
+    return NO;
+}
+
+#pragma mark - Procedure Prologues
+
+NSArray<NSDictionary *> *SRKFindPrologueTrampolines(NSObject<HPDisassembledFile> *file, NSDictionary *index) {
+    SRKArchitecture arch = [index[@"arch"] unsignedIntegerValue];
+    NSUInteger entryCount = 0;
+    const Address *entries = SRKProcedureEntries(index, &entryCount);
+    if (arch == SRKArchitectureUnknown || entryCount == 0) return @[];
+
+    // Snapshot the mapped code and the stub ranges, where absolute jumps are expected
+    NSMutableArray<NSDictionary *> *segments = [NSMutableArray array];
+    NSMutableArray<NSValue *> *stubRanges = [NSMutableArray array];
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length == 0 || [segment procedureCount] == 0) continue;
+        [segments addObject:@{@"start": @(segment.startAddress), @"data": data}];
+
+        for (NSObject<HPSection> *section in [segment sections]) {
+            if ([section.sectionName containsString:@"stub"]) {
+                [stubRanges addObject:[NSValue valueWithRange:NSMakeRange((NSUInteger)section.startAddress,
+                                                                          (NSUInteger)(section.endAddress - section.startAddress))]];
+            }
+        }
+    }
+
+    SRKTrampolineMatch *matches = calloc(entryCount, sizeof(SRKTrampolineMatch));
+    if (!matches) return @[];
+
+    NSUInteger chunks = (entryCount + SRK_TRAMPOLINE_CHUNK - 1) / SRK_TRAMPOLINE_CHUNK;
+    dispatch_apply(chunks, dispatch_get_global_queue(QOS_CLASS_USER_INITIATED, 0), ^(size_t chunk) {
+        NSUInteger first = chunk * SRK_TRAMPOLINE_CHUNK;
+        NSUInteger last = MIN(entryCount, first + SRK_TRAMPOLINE_CHUNK);
+        NSDictionary *segment = nil;
+        Address segmentStart = 0;
+        NSUInteger segmentLength = 0;
+
+        // Entries are sorted, so the segment is only looked up again when leaving it
+        for (NSUInteger i = first; i < last; i++) {
+            Address entry = entries[i];
+            if (!segment || entry < segmentStart || entry >= segmentStart + segmentLength) {
+                segment = nil;
+                for (NSDictionary *candidate in segments) {
+                    Address start = [candidate[@"start"] unsignedLongLongValue];
+                    NSUInteger length = [candidate[@"data"] length];
+                    if (entry >= start && entry < start + length) {
+                        segment = candidate;
+                        segmentStart = start;
+                        segmentLength = length;
+                        break;
+                    }
+                }
+                if (!segment) continue;
+            }
+
+            BOOL inStub = NO;
+            for (NSValue *range in stubRanges) {
+                if (NSLocationInRange((NSUInteger)entry, range.rangeValue)) {
+                    inStub = YES;
+                    break;
+                }
+            }
+            if (inStub) continue;
+
+            const uint8_t *bytes = (const uint8_t *)[segment[@"data"] bytes] + (entry - segmentStart);
+            NSUInteger available = MIN(SRK_TRAMPOLINE_MAX_LENGTH, segmentLength - (NSUInteger)(entry - segmentStart));
+            SRKTrampolineMatch match;
+            if (SRKMatchTrampoline(bytes, available, arch, YES, &match)) {
+                matches[i] = match;
+            }
+        }
+    });
+
+    NSMutableArray<NSDictionary *> *trampolines = [NSMutableArray array];
+    for (NSUInteger i = 0; i < entryCount; i++) {
+        if (matches[i].kind == NULL) continue;
+
+        NSMutableDictionary *trampoline = [NSMutableDictionary dictionaryWithDictionary:@{
+            @"address": @(entries[i]),
+            @"kind": @(matches[i].kind),
+            @"target": @(matches[i].target)
+        }];
+        NSString *name = [file nameForVirtualAddress:entries[i]];
+        if (name) trampoline[@"name"] = name;
+
+        Address target = SRKDecodePointer(file, matches[i].target);
+        NSString *targetName = target ? [file nameForVirtualAddress:target] : nil;
+        if (targetName) trampoline[@"target_name"] = targetName;
+
+        [trampolines addObject:trampoline];
+    }
+
+    free(matches);
+    return trampolines;
+}
+
+#pragma mark - Data Templates
+
+NSArray<NSDictionary *> *SRKFindTrampolineTemplates(NSObject<HPDisassembledFile> *file) {
+    SRKArchitecture arch = SRKArchitectureForFile(file);
+    if (arch == SRKArchitectureUnknown) return @[];
+
+    // memchr on the most selective byte of each pattern, then a full match around the hit
+    uint8_t anchor = arch == SRKArchitectureARM64 ? 0x58 : 0xFF;
+    NSMutableArray<NSDictionary *> *templates = [NSMutableArray array];
+
+    for (NSObject<HPSegment> *segment in [file segments]) {
+        NSData *data = segment.mappedData;
+        if (data.length == 0) continue;
+
+        for (NSObject<HPSection> *section in [segment sections]) {
+            if (section.pureCodeSection || section.containsCode || section.zeroFillSection ||
+                section.pureCStringSection) continue;
+            if (section.startAddress < segment.startAddress) continue;
+
+            NSUInteger offset = (NSUInteger)(section.startAddress - segment.startAddress);
+            if (offset >= data.length) continue;
+            NSUInteger length = MIN((NSUInteger)(section.endAddress - section.startAddress), data.length - offset);
+
+            const uint8_t *base = (const uint8_t *)data.bytes + offset;
+            const uint8_t *cursor = base;
+            const uint8_t *end = base + length;
+            const uint8_t *coveredUntil = base;
+
+            while (cursor < end) {
+                const uint8_t *hit = memchr(cursor, anchor, (size_t)(end - cursor));
+                if (!hit) break;
+                cursor = hit + 1;
+
+                // ARM64: the anchor is the top byte of the ldr word; x86: jmp [rip+0] or the jmp of movabs
+                NSInteger starts[3];
+                NSUInteger startCount = 0;
+                if (arch == SRKArchitectureARM64) {
+                    starts[startCount++] = (hit - base) - 3;
+                } else {
+                    starts[startCount++] = hit - base;
+                    starts[startCount++] = (hit - base) - 10;
+                    starts[startCount++] = (hit - base) - 11;
+                }
+
+                for (NSUInteger i = 0; i < startCount; i++) {
+                    if (starts[i] < 0 || base + starts[i] < coveredUntil) continue;
+                    if (arch == SRKArchitectureARM64 && (starts[i] & 3) != 0) continue;
+
+                    const uint8_t *candidate = base + starts[i];
+                    SRKTrampolineMatch match;
+                    if (!SRKMatchTrampoline(candidate, (NSUInteger)(end - candidate), arch, NO, &match)) continue;
+
+                    [templates addObject:@{
+                        @"address": @(section.startAddress + starts[i]),
+                        @"section": section.sectionName ?: @"",
+                        @"kind": @(match.kind),
+                        @"target": @(match.target)
+                    }];
+                    coveredUntil = candidate + match.length;
+                    cursor = MAX(cursor, coveredUntil);
+                    break;
+                }
+            }
+        }
+    }
+
+    return templates;
+}
+
+#pragma mark - Hook Installers
+
+/// Trampolines, entries or templates, whose first byte lies in [start, end)
+static NSArray<NSNumber *> *SRKTrampolinesInRange(NSArray<NSDictionary *> *trampolines, Address start, Address end) {
+    NSMutableArray<NSNumber *> *addresses = [NSMutableArray array];
+    for (NSDictionary *trampoline in trampolines) {
+        Address address = [trampoline[@"address"] unsignedLongLongValue];
+        if (address >= start && address < end) [addresses addObject:trampoline[@"address"]];
+    }
+    return addresses;
+}
+
+NSArray<NSDictionary *> *SRKFindHookInstallers(NSObject<HPDisassembledFile> *file, NSDictionary *index,
+                                               NSArray<NSDictionary *> *trampolines,
+                                               NSArray<NSDictionary *> *templates) {
+    // Address, protection and size argument of each protection function
+    NSDictionary<NSString *, NSArray<NSNumber *> *> *protectArguments = @{
+        @"vm_protect": @[@1, @4, @2],
+        @"mach_vm_protect": @[@1, @4, @2],
+        @"mprotect": @[@0, @2, @1]
+    };
+    // Destination, source (-1 for none) and length argument of each patch function
+    NSDictionary<NSString *, NSArray<NSNumber *> *> *patchArguments = @{
+        @"memcpy": @[@0, @1, @2],
+        @"__memcpy_chk": @[@0, @1, @2],
+        @"memmove": @[@0, @1, @2],
+        @"vm_write": @[@1, @2, @3],
+        @"mach_vm_write": @[@1, @2, @3],
+        @"sys_icache_invalidate": @[@0, @-1, @1],
+        @"sys_dcache_flush": @[@0, @-1, @1],
+        @"__clear_cache": @[@0, @-1, @-1]
+    };
+
+    SRKArchitecture arch = [index[@"arch"] unsignedIntegerValue];
+    Address pageSize = arch == SRKArchitectureARM64 ? SRK_PAGE_SIZE_ARM64 : SRK_PAGE_SIZE_X86_64;
+
+    NSMutableArray<NSString *> *functions = [NSMutableArray arrayWithArray:protectArguments.allKeys];
+    [functions addObjectsFromArray:patchArguments.allKeys];
+
+    NSMutableDictionary<NSNumber *, NSMutableArray *> *protectByProcedure = [NSMutableDictionary dictionary];
+    NSMutableDictionary<NSNumber *, NSMutableArray *> *patchesByProcedure = [NSMutableDictionary dictionary];
+
+    for (NSDictionary *callSite in SRKCallSitesForFunctions(file, index, functions, 5)) {
+        NSString *function = callSite[@"function"];
+        NSNumber *procedure = callSite[@"procedure"];
+        NSArray<NSNumber *> *arguments = protectArguments[function];
+
+        if (!arguments) {
+            NSArray<NSNumber *> *patchArgs = patchArguments[function];
+            NSMutableDictionary *patch = [NSMutableDictionary dictionaryWithDictionary:@{
+                @"address": callSite[@"address"], @"function": function
+            }];
+            NSNumber *destination = SRKCallSiteValueArgument(callSite, patchArgs[0].unsignedIntegerValue);
+            if (destination) {
+                // Without a known length, a trampoline written at the destination is the longest expected
+                NSNumber *length = patchArgs[2].integerValue >= 0 ?
+                    SRKCallSiteValueArgument(callSite, patchArgs[2].unsignedIntegerValue) : nil;
+                Address start = destination.unsignedLongLongValue;
+                Address size = length.unsignedLongLongValue ?: SRK_TRAMPOLINE_MAX_LENGTH;
+                patch[@"target"] = destination;
+                patch[@"trampolines"] = SRKTrampolinesInRange(trampolines, start, start + size);
+            }
+            NSNumber *source = patchArgs[1].integerValue >= 0 ?
+                SRKCallSiteValueArgument(callSite, patchArgs[1].unsignedIntegerValue) : nil;
+            if (source) {
+                Address start = source.unsignedLongLongValue;
+                NSArray<NSNumber *> *copied = SRKTrampolinesInRange(templates, start, start + SRK_TRAMPOLINE_MAX_LENGTH);
+                if (copied.count > 0) patch[@"template"] = copied.firstObject;
+            }
+
+            NSMutableArray *patches = patchesByProcedure[procedure];
+            if (!patches) {
+                patches = [NSMutableArray array];
+                patchesByProcedure[procedure] = patches;
+            }
+            [patches addObject:patch];
+            continue;
+        }
+
+        NSNumber *target = SRKCallSiteValueArgument(callSite, arguments[0].unsignedIntegerValue);
+        NSNumber *protection = SRKCallSiteValueArgument(callSite, arguments[1].unsignedIntegerValue);
+        NSNumber *size = SRKCallSiteValueArgument(callSite, arguments[2].unsignedIntegerValue);
+        uint64_t prot = protection.unsignedLongLongValue;
+
+        // Writable code, a copy-on-write mapping made writable, or any change over __text
+        BOOL writableCode = protection && (prot & SRK_VM_PROT_WRITE) &&
+                            (prot & (SRK_VM_PROT_EXECUTE | SRK_VM_PROT_COPY));
+        BOOL codeTarget = target && SRKSectionNameContains(file, target.unsignedLongLongValue, @"text") &&
+                          (!protection || (prot & SRK_VM_PROT_WRITE));
+        if (!writableCode && !codeTarget) continue;
+
+        NSMutableDictionary *protect = [NSMutableDictionary dictionaryWithDictionary:@{
+            @"address": callSite[@"address"], @"function": function
+        }];
+        if (protection) protect[@"protection"] = @(prot);
+        if (target) {
+            // The kernel rounds the range out to whole pages
+            Address start = target.unsignedLongLongValue & ~(pageSize - 1);
+            Address end = target.unsignedLongLongValue + (size.unsignedLongLongValue ?: 1);
+            end = (end + pageSize - 1) & ~(pageSize - 1);
+            protect[@"target"] = target;
+            if (size) protect[@"size"] = size;
+            protect[@"trampolines"] = SRKTrampolinesInRange(trampolines, start, end);
+        }
+
+        NSMutableArray *protects = protectByProcedure[procedure];
+        if (!protects) {
+            protects = [NSMutableArray array];
+            protectByProcedure[procedure] = protects;
+        }
+        [protects addObject:protect];
+    }
+
+    NSMutableArray<NSDictionary *> *installers = [NSMutableArray array];
+    for (NSNumber *procedure in [protectByProcedure.allKeys sortedArrayUsingSelector:@selector(compare:)]) {
+        NSArray *protects = protectByProcedure[procedure];
+        NSArray *patches = patchesByProcedure[procedure] ?: @[];
+
+        // Entries patched by this installer: written directly, or else inside the range it made writable
+        NSMutableOrderedSet<NSNumber *> *patched = [NSMutableOrderedSet orderedSet];
+        for (NSDictionary *patch in patches) [patched addObjectsFromArray:patch[@"trampolines"] ?: @[]];
+        if (patched.count == 0) {
+            for (NSDictionary *protect in protects) [patched addObjectsFromArray:protect[@"trampolines"] ?: @[]];
+        }
+
+        NSMutableDictionary *installer = [NSMutableDictionary dictionaryWithDictionary:@{
+            @"procedure": procedure,
+            @"protect": protects,
+            @"patches": patches,
+            @"trampolines": patched.array
+        }];
+        NSString *name = [file nameForVirtualAddress:procedure.unsignedLongLongValue];
+        if (name) installer[@"name"] = name;
+        [installers addObject:installer];
+    }
+
+    return installers;
+}
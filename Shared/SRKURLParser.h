@@ -0,0 +1,103 @@
+/*
+ SRKURLParser.h
+ Allocation-free URL/URI parsing and normalization for HopperSRK analyzers
+
+ Splits a URL held in a byte buffer into scheme, userinfo, host, port,
+ path, query and fragment ranges in one pass, without copying or
+ allocating, so the millions of candidate strings of a large binary can be
+ tried cheaply. URLs embedded in binaries are often format strings, so
+ printf conversions (%s, %@, %d, %02x, %llu...) are recognized and told
+ apart from percent-escapes: "%@://%@:%d/api/%s" is a URL template with a
+ templated host and port.
+
+ Normalization writes into a caller buffer:
+ - scheme and host lowercased, the host's trailing dot dropped
+ - the scheme's default port dropped, an empty path with a host becomes "/"
+ - escapes of unreserved characters decoded, other escapes uppercased
+ - format conversions replaced by {s}, {d}, {x}, {f}, {c} or {p}
+ - the fragment dropped, since it never reaches the server
+ so the same indicator written differently, or templates differing only in
+ the conversions used, compare equal.
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+NS_ASSUME_NONNULL_BEGIN
+
+/// Byte range within the parsed buffer; length 0 when the component is empty or absent
+typedef struct {
+    uint32_t offset;
+    uint32_t length;
+} SRKURLRange;
+
+typedef NS_OPTIONS(uint16_t, SRKURLFlags) {
+    SRKURLHasScheme     = 1 << 0,
+    SRKURLHasAuthority  = 1 << 1,
+    SRKURLHasUserinfo   = 1 << 2,
+    SRKURLHasPort       = 1 << 3,
+    SRKURLHasQuery      = 1 << 4,
+    SRKURLHasFragment   = 1 << 5,
+    SRKURLHostIPv4      = 1 << 6,
+    /// The host range excludes the brackets
+    SRKURLHostIPv6      = 1 << 7,
+    /// Holds printf-style conversions
+    SRKURLIsTemplate    = 1 << 8,
+    /// The scheme or host is itself a conversion
+    SRKURLTemplatedHost = 1 << 9,
+    /// The port is itself a conversion; portNumber is -1
+    SRKURLTemplatedPort = 1 << 10
+};
+
+typedef struct {
+    SRKURLRange scheme;
+    SRKURLRange userinfo;
+    SRKURLRange host;
+    SRKURLRange port;
+    SRKURLRange path;
+    SRKURLRange query;
+    SRKURLRange fragment;
+    /// -1 when there is no port or it is templated
+    int32_t portNumber;
+    uint16_t formatSpecifiers;
+    SRKURLFlags flags;
+} SRKURLParts;
+
+/**
+ * Parses bytes[0, length). Returns NO for strings that are no URL: empty,
+ * holding whitespace or control bytes, or with an invalid port. Without a
+ * "scheme://" or "//" prefix a URL is only accepted when allowSchemeless,
+ * as "host.tld/path", "%@/api/%d" or an absolute path.
+ */
+BOOL SRKParseURL(const char *bytes, size_t length, BOOL allowSchemeless, SRKURLParts *parts);
+
+/**
+ * Length of the printf conversion starting at bytes[0] == '%', or 0 when it
+ * is a percent-escape or no conversion. Two hex digits after '%' are read
+ * as an escape unless a longer conversion (%02x) spans them.
+ */
+size_t SRKFormatSpecifierLength(const char *bytes, size_t length);
+
+/**
+ * Writes the normalized URL NUL-terminated into buffer, truncated to
+ * capacity. Returns the full length, which may exceed capacity - 1.
+ */
+size_t SRKNormalizeURL(const char *bytes, const SRKURLParts *parts, char *buffer, size_t capacity);
+
+/// Next non-empty path segment from *cursor (start at 0); NO when there are no more
+BOOL SRKURLNextPathSegment(const SRKURLParts *parts, const char *bytes, size_t *cursor, SRKURLRange *segment);
+
+/// Next "key=value" query parameter from *cursor (start at 0); value is empty without '='
+BOOL SRKURLNextQueryParameter(const SRKURLParts *parts, const char *bytes, size_t *cursor, SRKURLRange *key,
+                              SRKURLRange *value);
+
+/**
+ * Convenience for Objective-C callers, which allocates:
+ * @{@"scheme", @"host", @"port" (NSNumber), @"path", @"query", @"query_keys",
+ *   @"path_segments", @"normalized", @"template" (BOOL)}
+ * Absent components are left out. nil when the string is no URL.
+ */
+NSDictionary * _Nullable SRKURLComponents(NSString *url, BOOL allowSchemeless);
+
+NS_ASSUME_NONNULL_END
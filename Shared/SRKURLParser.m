@@ -0,0 +1,483 @@
+/*
+ SRKURLParser.m
+ Allocation-free URL/URI parsing and normalization for HopperSRK analyzers
+
+ Copyright (c) 2025 Zeyad Azima. All rights reserved.
+ */
+
+@import Foundation;
+
+#import "SRKURLParser.h"
+
+// Character classes, one table lookup per byte
+#define SRK_URL_ALPHA      0x01
+#define SRK_URL_DIGIT      0x02
+#define SRK_URL_HEX        0x04
+#define SRK_URL_SCHEME     0x08   // after the first letter: ALPHA DIGIT + - .
+#define SRK_URL_UNRESERVED 0x10   // ALPHA DIGIT - . _ ~
+#define SRK_URL_INVALID    0x20   // whitespace, control bytes, DEL
+
+// Normalized URLs SRKURLComponents renders on the stack before spilling to the heap
+#define SRK_URL_STACK_BUFFER 1024
+
+static uint8_t SRKURLClasses[256];
+
+static void SRKURLInitClasses(void) {
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        for (int c = 0; c < 256; c++) {
+            uint8_t classes = 0;
+            BOOL alpha = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+            BOOL digit = c >= '0' && c <= '9';
+            if (alpha) classes |= SRK_URL_ALPHA;
+            if (digit) classes |= SRK_URL_DIGIT;
+            if (digit || (c >= 'a' && c <= 'f') || (c >= 'A' && c <= 'F')) classes |= SRK_URL_HEX;
+            if (alpha || digit || c == '+' || c == '-' || c == '.') classes |= SRK_URL_SCHEME;
+            if (alpha || digit || c == '-' || c == '.' || c == '_' || c == '~') classes |= SRK_URL_UNRESERVED;
+            if (c <= 0x20 || c == 0x7F) classes |= SRK_URL_INVALID;
+            SRKURLClasses[c] = classes;
+        }
+    });
+}
+
+static inline BOOL SRKURLIs(char c, uint8_t classes) {
+    return (SRKURLClasses[(uint8_t)c] & classes) != 0;
+}
+
+static inline char SRKURLLower(char c) {
+    return (c >= 'A' && c <= 'Z') ? (char)(c + ('a' - 'A')) : c;
+}
+
+static inline uint8_t SRKURLHexValue(char c) {
+    if (c >= '0' && c <= '9') return (uint8_t)(c - '0');
+    return (uint8_t)(SRKURLLower(c) - 'a' + 10);
+}
+
+static inline SRKURLRange SRKURLMakeRange(size_t start, size_t end) {
+    SRKURLRange range = {(uint32_t)start, (uint32_t)(end - start)};
+    return range;
+}
+
+#pragma mark - Format Conversions
+
+size_t SRKFormatSpecifierLength(const char *bytes, size_t length) {
+    if (length < 2 || bytes[0] != '%') return 0;
+    if (bytes[1] == '@') return 2;
+
+    size_t i = 1;
+    BOOL zeroPadded = NO;
+    while (i < length && strchr("-+ #0'", bytes[i]) && bytes[i] != '\0') {
+        if (bytes[i] == '0') zeroPadded = YES;
+        i++;
+    }
+    size_t widthStart = i;
+    while (i < length && SRKURLIs(bytes[i], SRK_URL_DIGIT)) i++;
+    // "%2F" is an escape, not a two-column float; widths only count zero-padded ("%08x")
+    if (i > widthStart && !zeroPadded) return 0;
+    if (i < length && bytes[i] == '.') {
+        i++;
+        while (i < length && (SRKURLIs(bytes[i], SRK_URL_DIGIT) || bytes[i] == '*')) i++;
+    }
+    while (i < length && strchr("hlqztjL", bytes[i]) && bytes[i] != '\0') i++;
+    if (i >= length || !strchr("diouxXsScCpfeg", bytes[i]) || bytes[i] == '\0') return 0;
+    size_t specifier = i + 1;
+
+    // "%de" reads as the escape of 0xDE unless the conversion runs past both digits
+    BOOL escape = length >= 3 && SRKURLIs(bytes[1], SRK_URL_HEX) && SRKURLIs(bytes[2], SRK_URL_HEX);
+    return escape && specifier <= 3 ? 0 : specifier;
+}
+
+/// Placeholder letter a conversion normalizes to
+static char SRKFormatPlaceholder(const char *specifier, size_t length) {
+    switch (specifier[length - 1]) {
+        case 'd': case 'i': case 'u': case 'o': return 'd';
+        case 'x': case 'X': return 'x';
+        case 'f': case 'e': case 'g': return 'f';
+        case 'c': case 'C': return 'c';
+        case 'p': return 'p';
+        default: return 's';
+    }
+}
+
+#pragma mark - Parsing
+
+static BOOL SRKURLIsIPv4(const char *bytes, SRKURLRange range) {
+    NSUInteger dots = 0;
+    NSUInteger octet = 0;
+    NSUInteger digits = 0;
+    for (uint32_t i = 0; i < range.length; i++) {
+        char c = bytes[range.offset + i];
+        if (c == '.') {
+            if (digits == 0) return NO;
+            dots++;
+            octet = 0;
+            digits = 0;
+        } else if (SRKURLIs(c, SRK_URL_DIGIT)) {
+            octet = octet * 10 + (NSUInteger)(c - '0');
+            if (++digits > 3 || octet > 255) return NO;
+        } else {
+            return NO;
+        }
+    }
+    return dots == 3 && digits > 0;
+}
+
+/// Splits bytes[start, end) into userinfo, host and port; NO for a malformed port
+static BOOL SRKURLParseAuthority(const char *bytes, size_t start, size_t end, SRKURLParts *parts) {
+    // The last '@' ends the userinfo; "%@" is a conversion, not a separator
+    size_t hostStart = start;
+    for (size_t i = end; i > start; i--) {
+        if (bytes[i - 1] == '@' && !(i >= 2 + start && bytes[i - 2] == '%')) {
+            parts->userinfo = SRKURLMakeRange(start, i - 1);
+            parts->flags |= SRKURLHasUserinfo;
+            hostStart = i;
+            break;
+        }
+    }
+
+    size_t hostEnd = end;
+    size_t portStart = 0;
+    if (hostStart < end && bytes[hostStart] == '[') {
+        const char *close = memchr(bytes + hostStart, ']', end - hostStart);
+        if (!close) return NO;
+        size_t closeIndex = (size_t)(close - bytes);
+        parts->host = SRKURLMakeRange(hostStart + 1, closeIndex);
+        parts->flags |= SRKURLHostIPv6;
+        if (closeIndex + 1 < end) {
+            if (bytes[closeIndex + 1] != ':') return NO;
+            portStart = closeIndex + 2;
+        }
+    } else {
+        for (size_t i = end; i > hostStart; i--) {
+            if (bytes[i - 1] == ':') {
+                hostEnd = i - 1;
+                portStart = i;
+                break;
+            }
+        }
+        parts->host = SRKURLMakeRange(hostStart, hostEnd);
+        if (SRKURLIsIPv4(bytes, parts->host)) parts->flags |= SRKURLHostIPv4;
+    }
+
+    if (parts->host.length > 0 && bytes[parts->host.offset] == '%' &&
+        SRKFormatSpecifierLength(bytes + parts->host.offset, parts->host.length) > 0) {
+        parts->flags |= SRKURLTemplatedHost;
+    }
+
+    if (portStart > 0) {
+        parts->port = SRKURLMakeRange(portStart, end);
+        parts->flags |= SRKURLHasPort;
+        if (parts->port.length == 0) return NO;
+
+        if (bytes[portStart] == '%') {
+            if (SRKFormatSpecifierLength(bytes + portStart, end - portStart) != end - portStart) return NO;
+            parts->flags |= SRKURLTemplatedPort;
+            return YES;
+        }
+        int32_t port = 0;
+        for (size_t i = portStart; i < end; i++) {
+            if (!SRKURLIs(bytes[i], SRK_URL_DIGIT)) return NO;
+            port = port * 10 + (bytes[i] - '0');
+            if (port > UINT16_MAX) return NO;
+        }
+        parts->portNumber = port;
+    }
+    return YES;
+}
+
+/// Whether the text before the first '/' of a schemeless string reads as a host
+static BOOL SRKURLLooksLikeAuthority(const char *bytes, size_t end) {
+    if (end == 0) return NO;
+    if (bytes[0] == '%') return SRKFormatSpecifierLength(bytes, end) > 0;
+    if (end == 9 && strncasecmp(bytes, "localhost", 9) == 0) return YES;
+
+    BOOL dot = NO;
+    for (size_t i = 0; i < end; i++) {
+        char c = bytes[i];
+        if (c == '.') {
+            if (i == 0 || i + 1 == end) return NO;
+            dot = YES;
+        } else if (c == ':') {
+            // host:port
+            return dot || (i > 0 && i + 1 < end);
+        } else if (!SRKURLIs(c, SRK_URL_ALPHA | SRK_URL_DIGIT) && c != '-' && c != '_' && c != '[' && c != ']') {
+            return NO;
+        }
+    }
+    return dot;
+}
+
+BOOL SRKParseURL(const char *bytes, size_t length, BOOL allowSchemeless, SRKURLParts *parts) {
+    SRKURLInitClasses();
+    memset(parts, 0, sizeof(SRKURLParts));
+    parts->portNumber = -1;
+    if (length == 0 || length > UINT32_MAX) return NO;
+
+    // One pass for the bytes a URL never holds and for the format conversions
+    for (size_t i = 0; i < length; i++) {
+        if (SRKURLIs(bytes[i], SRK_URL_INVALID)) return NO;
+        if (bytes[i] == '%') {
+            size_t specifier = SRKFormatSpecifierLength(bytes + i, length - i);
+            if (specifier > 0) {
+                if (parts->formatSpecifiers < UINT16_MAX) parts->formatSpecifiers++;
+                i += specifier - 1;
+            } else if (i + 1 < length && bytes[i + 1] == '%') {
+                i++;
+            }
+        }
+    }
+    if (parts->formatSpecifiers > 0) parts->flags |= SRKURLIsTemplate;
+
+    // scheme://, where the scheme may itself be a conversion ("%@://")
+    size_t position = 0;
+    size_t schemeEnd = 0;
+    if (SRKURLIs(bytes[0], SRK_URL_ALPHA)) {
+        schemeEnd = 1;
+        while (schemeEnd < length && SRKURLIs(bytes[schemeEnd], SRK_URL_SCHEME)) schemeEnd++;
+    } else if (bytes[0] == '%') {
+        schemeEnd = SRKFormatSpecifierLength(bytes, length);
+    }
+    if (schemeEnd > 0 && schemeEnd + 3 <= length && memcmp(bytes + schemeEnd, "://", 3) == 0) {
+        parts->scheme = SRKURLMakeRange(0, schemeEnd);
+        parts->flags |= SRKURLHasScheme | SRKURLHasAuthority;
+        if (bytes[0] == '%') parts->flags |= SRKURLTemplatedHost;
+        position = schemeEnd + 3;
+    } else if (length >= 2 && bytes[0] == '/' && bytes[1] == '/') {
+        parts->flags |= SRKURLHasAuthority;
+        position = 2;
+    } else if (!allowSchemeless) {
+        return NO;
+    }
+
+    size_t authorityEnd = position;
+    while (authorityEnd < length && bytes[authorityEnd] != '/' && bytes[authorityEnd] != '?' && bytes[authorityEnd] != '#') {
+        authorityEnd++;
+    }
+    if (!(parts->flags & SRKURLHasAuthority) && SRKURLLooksLikeAuthority(bytes, authorityEnd)) {
+        parts->flags |= SRKURLHasAuthority;
+    }
+
+    if (parts->flags & SRKURLHasAuthority) {
+        if (!SRKURLParseAuthority(bytes, position, authorityEnd, parts)) return NO;
+        // Only file:/// and friends may leave the host out
+        if (parts->host.length == 0 && !(parts->flags & SRKURLHasScheme)) return NO;
+        position = authorityEnd;
+    } else if (bytes[0] != '/') {
+        return NO;
+    }
+
+    size_t pathEnd = position;
+    while (pathEnd < length && bytes[pathEnd] != '?' && bytes[pathEnd] != '#') pathEnd++;
+    parts->path = SRKURLMakeRange(position, pathEnd);
+    position = pathEnd;
+
+    if (position < length && bytes[position] == '?') {
+        size_t queryEnd = position + 1;
+        while (queryEnd < length && bytes[queryEnd] != '#') queryEnd++;
+        parts->query = SRKURLMakeRange(position + 1, queryEnd);
+        parts->flags |= SRKURLHasQuery;
+        position = queryEnd;
+    }
+    if (position < length && bytes[position] == '#') {
+        parts->fragment = SRKURLMakeRange(position + 1, length);
+        parts->flags |= SRKURLHasFragment;
+    }
+    return YES;
+}
+
+#pragma mark - Normalization
+
+typedef struct {
+    char *buffer;
+    size_t capacity;
+    size_t length;
+} SRKURLWriter;
+
+static inline void SRKURLPut(SRKURLWriter *writer, char c) {
+    if (writer->length + 1 < writer->capacity) writer->buffer[writer->length] = c;
+    writer->length++;
+}
+
+static void SRKURLPutLowercase(SRKURLWriter *writer, const char *bytes, SRKURLRange range) {
+    for (uint32_t i = 0; i < range.length; i++) SRKURLPut(writer, SRKURLLower(bytes[range.offset + i]));
+}
+
+/// Copies a component with escapes and conversions normalized
+static void SRKURLPutNormalized(SRKURLWriter *writer, const char *bytes, SRKURLRange range, BOOL lowercase) {
+    static const char hex[] = "0123456789ABCDEF";
+    const char *text = bytes + range.offset;
+    size_t length = range.length;
+
+    for (size_t i = 0; i < length; i++) {
+        char c = text[i];
+        if (c != '%') {
+            SRKURLPut(writer, lowercase ? SRKURLLower(c) : c);
+            continue;
+        }
+
+        size_t specifier = SRKFormatSpecifierLength(text + i, length - i);
+        if (specifier > 0) {
+            SRKURLPut(writer, '{');
+            SRKURLPut(writer, SRKFormatPlaceholder(text + i, specifier));
+            SRKURLPut(writer, '}');
+            i += specifier - 1;
+        } else if (i + 2 < length && SRKURLIs(text[i + 1], SRK_URL_HEX) && SRKURLIs(text[i + 2], SRK_URL_HEX)) {
+            char decoded = (char)((SRKURLHexValue(text[i + 1]) << 4) | SRKURLHexValue(text[i + 2]));
+            if (SRKURLIs(decoded, SRK_URL_UNRESERVED)) {
+                SRKURLPut(writer, lowercase ? SRKURLLower(decoded) : decoded);
+            } else {
+                SRKURLPut(writer, '%');
+                SRKURLPut(writer, hex[(uint8_t)decoded >> 4]);
+                SRKURLPut(writer, hex[(uint8_t)decoded & 0xF]);
+            }
+            i += 2;
+        } else {
+            // A stray '%' or the "%%" of a format string
+            SRKURLPut(writer, '%');
+            if (i + 1 < length && text[i + 1] == '%') i++;
+        }
+    }
+}
+
+static BOOL SRKURLSchemeIs(const char *bytes, SRKURLRange scheme, const char *name) {
+    return scheme.length == strlen(name) && strncasecmp(bytes + scheme.offset, name, scheme.length) == 0;
+}
+
+static int32_t SRKURLDefaultPort(const char *bytes, SRKURLRange scheme) {
+    if (SRKURLSchemeIs(bytes, scheme, "http") || SRKURLSchemeIs(bytes, scheme, "ws")) return 80;
+    if (SRKURLSchemeIs(bytes, scheme, "https") || SRKURLSchemeIs(bytes, scheme, "wss")) return 443;
+    if (SRKURLSchemeIs(bytes, scheme, "ftp")) return 21;
+    return -1;
+}
+
+size_t SRKNormalizeURL(const char *bytes, const SRKURLParts *parts, char *buffer, size_t capacity) {
+    SRKURLInitClasses();
+    SRKURLWriter writer = {buffer, capacity, 0};
+
+    if (parts->flags & SRKURLHasScheme) {
+        SRKURLPutNormalized(&writer, bytes, parts->scheme, YES);
+        SRKURLPut(&writer, ':');
+        SRKURLPut(&writer, '/');
+        SRKURLPut(&writer, '/');
+    }
+
+    if (parts->flags & SRKURLHasAuthority) {
+        if (parts->flags & SRKURLHasUserinfo) {
+            SRKURLPutNormalized(&writer, bytes, parts->userinfo, NO);
+            SRKURLPut(&writer, '@');
+        }
+
+        SRKURLRange host = parts->host;
+        if (host.length > 1 && bytes[host.offset + host.length - 1] == '.') host.length--;
+        if (parts->flags & SRKURLHostIPv6) {
+            SRKURLPut(&writer, '[');
+            SRKURLPutLowercase(&writer, bytes, host);
+            SRKURLPut(&writer, ']');
+        } else {
+            SRKURLPutNormalized(&writer, bytes, host, YES);
+        }
+
+        // Only a numeric port can be the default one; a templated port is always kept
+        if ((parts->flags & SRKURLHasPort) &&
+            (parts->portNumber < 0 || parts->portNumber != SRKURLDefaultPort(bytes, parts->scheme))) {
+            SRKURLPut(&writer, ':');
+            SRKURLPutNormalized(&writer, bytes, parts->port, NO);
+        }
+        if (parts->path.length == 0) SRKURLPut(&writer, '/');
+    }
+
+    SRKURLPutNormalized(&writer, bytes, parts->path, NO);
+    if (parts->flags & SRKURLHasQuery) {
+        SRKURLPut(&writer, '?');
+        SRKURLPutNormalized(&writer, bytes, parts->query, NO);
+    }
+
+    if (capacity > 0) buffer[MIN(writer.length, capacity - 1)] = '\0';
+    return writer.length;
+}
+
+#pragma mark - Iteration
+
+BOOL SRKURLNextPathSegment(const SRKURLParts *parts, const char *bytes, size_t *cursor, SRKURLRange *segment) {
+    size_t end = (size_t)parts->path.offset + parts->path.length;
+    size_t position = MAX(*cursor, (size_t)parts->path.offset);
+    while (position < end && bytes[position] == '/') position++;
+    if (position >= end) {
+        *cursor = end;
+        return NO;
+    }
+
+    const char *slash = memchr(bytes + position, '/', end - position);
+    size_t segmentEnd = slash ? (size_t)(slash - bytes) : end;
+    *segment = SRKURLMakeRange(position, segmentEnd);
+    *cursor = segmentEnd;
+    return YES;
+}
+
+BOOL SRKURLNextQueryParameter(const SRKURLParts *parts, const char *bytes, size_t *cursor, SRKURLRange *key,
+                              SRKURLRange *value) {
+    size_t end = (size_t)parts->query.offset + parts->query.length;
+    size_t position = MAX(*cursor, (size_t)parts->query.offset);
+    while (position < end && bytes[position] == '&') position++;
+    if (position >= end) {
+        *cursor = end;
+        return NO;
+    }
+
+    const char *ampersand = memchr(bytes + position, '&', end - position);
+    size_t parameterEnd = ampersand ? (size_t)(ampersand - bytes) : end;
+    const char *equals = memchr(bytes + position, '=', parameterEnd - position);
+    size_t keyEnd = equals ? (size_t)(equals - bytes) : parameterEnd;
+
+    *key = SRKURLMakeRange(position, keyEnd);
+    *value = equals ? SRKURLMakeRange(keyEnd + 1, parameterEnd) : SRKURLMakeRange(parameterEnd, parameterEnd);
+    *cursor = parameterEnd;
+    return YES;
+}
+
+#pragma mark - Objective-C Convenience
+
+static NSString *SRKURLString(const char *bytes, SRKURLRange range) {
+    return [[NSString alloc] initWithBytes:bytes + range.offset length:range.length encoding:NSUTF8StringEncoding] ?: @"";
+}
+
+NSDictionary *SRKURLComponents(NSString *url, BOOL allowSchemeless) {
+    const char *bytes = url.UTF8String;
+    if (!bytes) return nil;
+    size_t length = strlen(bytes);
+
+    SRKURLParts parts;
+    if (!SRKParseURL(bytes, length, allowSchemeless, &parts)) return nil;
+
+    NSMutableDictionary *components = [NSMutableDictionary dictionary];
+    if (parts.flags & SRKURLHasScheme) components[@"scheme"] = SRKURLString(bytes, parts.scheme).lowercaseString;
+    if (parts.flags & SRKURLHasAuthority) components[@"host"] = SRKURLString(bytes, parts.host).lowercaseString;
+    if (parts.portNumber >= 0) components[@"port"] = @(parts.portNumber);
+    components[@"path"] = SRKURLString(bytes, parts.path);
+    if (parts.flags & SRKURLHasQuery) components[@"query"] = SRKURLString(bytes, parts.query);
+
+    NSMutableArray<NSString *> *segments = [NSMutableArray array];
+    SRKURLRange segment;
+    size_t cursor = 0;
+    while (SRKURLNextPathSegment(&parts, bytes, &cursor, &segment)) [segments addObject:SRKURLString(bytes, segment)];
+    components[@"path_segments"] = segments;
+
+    NSMutableArray<NSString *> *keys = [NSMutableArray array];
+    SRKURLRange key;
+    SRKURLRange value;
+    cursor = 0;
+    while (SRKURLNextQueryParameter(&parts, bytes, &cursor, &key, &value)) [keys addObject:SRKURLString(bytes, key)];
+    components[@"query_keys"] = keys;
+
+    char stackBuffer[SRK_URL_STACK_BUFFER];
+    size_t normalizedLength = SRKNormalizeURL(bytes, &parts, stackBuffer, sizeof(stackBuffer));
+    if (normalizedLength < sizeof(stackBuffer)) {
+        components[@"normalized"] = @(stackBuffer);
+    } else {
+        NSMutableData *heapBuffer = [NSMutableData dataWithLength:normalizedLength + 1];
+        SRKNormalizeURL(bytes, &parts, heapBuffer.mutableBytes, heapBuffer.length);
+        components[@"normalized"] = @((const char *)heapBuffer.bytes);
+    }
+    components[@"template"] = @((parts.flags & SRKURLIsTemplate) != 0);
+    return components;
+}